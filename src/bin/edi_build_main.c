@@ -17,6 +17,8 @@
 #define EXIT_NOACTION -2
 
 static int _exit_code;
+static Edi_Build_Provider *_provider;
+static const char *_build_type;
 
 static Eina_Bool
 _exe_data(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
@@ -41,7 +43,7 @@ _exe_del(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info EINA_UNUSED)
 
 static const Ecore_Getopt optdesc = {
   "edi_build",
-  "%prog [options] [build|clean|test|create|example]",
+  "%prog [options] [build|clean|test|test-failed|test-affected|stop|daemon|create|example]",
   PACKAGE_VERSION,
   COPYRIGHT,
   "BSD with advertisement clause",
@@ -103,6 +105,106 @@ _edi_build_action_try(Edi_Build_Provider *provider, void (*action)(void), const
    return EXIT_SUCCESS;
 }
 
+static int
+_edi_build_local_start(void)
+{
+   int ret;
+
+   ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _exe_data, NULL);
+   ecore_event_handler_add(ECORE_EXE_EVENT_ERROR, _exe_data, NULL);
+   ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _exe_del, NULL);
+
+   if (
+       ((ret = _edi_build_action_try(_provider, _provider->clean, "clean", _build_type)) == EXIT_NOACTION) &&
+       ((ret = _edi_build_action_try(_provider, _provider->test, "test", _build_type)) == EXIT_NOACTION) &&
+       ((ret = _edi_build_action_try(_provider, (void *)_provider->build, "build", _build_type)) == EXIT_NOACTION))
+     {
+        fprintf(stderr, _("Unrecognized build type - try build, clean, create or test.\n"));
+        return EXIT_FAILURE;
+     }
+
+   return ret;
+}
+
+static void
+_edi_build_output_cb(void *data EINA_UNUSED, const char *line, Eina_Bool err)
+{
+   fprintf(err ? stderr : stdout, "%s\n", line);
+}
+
+static void
+_edi_build_remote_done_cb(void *data EINA_UNUSED, Eina_Bool reached, int status)
+{
+   if (reached)
+     {
+        _exit_code = status ? EXIT_FAILURE : EXIT_SUCCESS;
+        ecore_main_loop_quit();
+        return;
+     }
+
+   // With no edi or daemon open on the project, build in this process as before.
+   if (!strcmp(_build_type, "build") || !strcmp(_build_type, "clean") || !strcmp(_build_type, "test"))
+     {
+        _exit_code = _edi_build_local_start();
+        if (_exit_code == EXIT_SUCCESS)
+          return;
+     }
+   else
+     {
+        fprintf(stderr, _("No edi or edi_build daemon is serving this project for \"%s\".\n"), _build_type);
+        _exit_code = EXIT_FAILURE;
+     }
+
+   ecore_main_loop_quit();
+}
+
+static void
+_edi_build_daemon_started_cb(void *data EINA_UNUSED, const Edi_Build_Job *job)
+{
+   printf(_("Building \"%s\" target [%s] using [%s].\n"), edi_project_name_get(),
+          edi_build_server_request_get(job->type, job->path), _provider->id);
+}
+
+static void
+_edi_build_daemon_done_cb(void *data EINA_UNUSED, const Edi_Build_Job *job, int status)
+{
+   const char *request;
+
+   request = edi_build_server_request_get(job->type, job->path);
+   if (job->cancelled)
+     printf(_("Target [%s] was cancelled.\n"), request);
+   else
+     printf(_("Target [%s] finished with status %d.\n"), request, status);
+}
+
+static Eina_Bool
+_edi_build_daemon_exit_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   edi_build_queue_cancel();
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_edi_build_daemon_start(void)
+{
+   if (!edi_build_server_start())
+     {
+        fprintf(stderr, _("Unable to serve builds, is edi or another edi_build daemon serving this project?\n"));
+        return EINA_FALSE;
+     }
+
+   ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _exe_data, NULL);
+   ecore_event_handler_add(ECORE_EXE_EVENT_ERROR, _exe_data, NULL);
+   ecore_event_handler_add(ECORE_EVENT_SIGNAL_EXIT, _edi_build_daemon_exit_cb, NULL);
+   edi_build_queue_callbacks_set(_edi_build_daemon_started_cb, _edi_build_daemon_done_cb, NULL, NULL);
+   edi_test_runner_callbacks_set(_edi_build_output_cb, NULL, NULL, NULL);
+
+   printf(_("Serving builds of \"%s\" using [%s].\n"), edi_project_name_get(), _provider->id);
+   return EINA_TRUE;
+}
+
 static void
 _edi_build_create_start(int argc, int arg0, char **argv)
 {
@@ -123,10 +225,11 @@ _edi_build_example_start(int argc, int arg0, char **argv)
 EAPI_MAIN int
 main(int argc, char **argv)
 {
-   int args, ret;
+   int args;
    char path[PATH_MAX], *build_type = NULL;
    Eina_Bool quit_option = EINA_FALSE;
-   Edi_Build_Provider *provider;
+   Edi_Build_Job_Type type;
+   const char *file;
 
    Ecore_Getopt_Value values[] = {
      ECORE_GETOPT_VALUE_BOOL(quit_option),
@@ -205,22 +308,29 @@ main(int argc, char **argv)
         goto exit;
      }
 
-   provider = edi_build_provider_for_project_get();
+   _provider = edi_build_provider_for_project_get();
+   _build_type = build_type;
 
-   ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _exe_data, NULL);
-   ecore_event_handler_add(ECORE_EXE_EVENT_ERROR, _exe_data, NULL);
-   ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _exe_del, NULL);
+   if (!strcmp("daemon", build_type))
+     {
+        if (_edi_build_daemon_start())
+          ecore_main_loop_begin();
+        else
+          _exit_code = EXIT_FAILURE;
+        goto end;
+     }
 
-   if (
-       ((ret = _edi_build_action_try(provider, provider->clean, "clean", build_type)) == EXIT_NOACTION) &&
-       ((ret = _edi_build_action_try(provider, provider->test, "test", build_type)) == EXIT_NOACTION) &&
-       ((ret = _edi_build_action_try(provider, (void *)provider->build, "build", build_type)) == EXIT_NOACTION))
+   // Jobs go to the queue of the edi or daemon serving the project, so builds never race.
+   if (!strcmp("stop", build_type) ||
+       (edi_build_server_request_parse(build_type, &type, &file) && type != EDI_BUILD_JOB_COMPILE_FILE))
      {
-        fprintf(stderr, _("Unrecognized build type - try build, clean, create or test.\n"));
+        edi_build_server_submit(build_type, _edi_build_output_cb, _edi_build_remote_done_cb, NULL);
+        ecore_main_loop_begin();
         goto end;
      }
-   if (ret != EXIT_SUCCESS)
-     return ret;
+
+   if ((_exit_code = _edi_build_local_start()) != EXIT_SUCCESS)
+     goto end;
    ecore_main_loop_begin();
 
    end:
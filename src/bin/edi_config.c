@@ -42,7 +42,7 @@
    ((EDI_CONFIG_FILE_EPOCH << 16) | EDI_CONFIG_FILE_GENERATION)
 
 #  define EDI_PROJECT_CONFIG_FILE_EPOCH 0x0002
-#  define EDI_PROJECT_CONFIG_FILE_GENERATION 0x0005
+#  define EDI_PROJECT_CONFIG_FILE_GENERATION 0x0008
 #  define EDI_PROJECT_CONFIG_FILE_VERSION \
    ((EDI_PROJECT_CONFIG_FILE_EPOCH << 16) | EDI_PROJECT_CONFIG_FILE_GENERATION)
 
@@ -287,9 +287,12 @@ _edi_config_init(void)
    EDI_CONFIG_VAL(D, T, gui.tabstop, EET_T_UINT);
    EDI_CONFIG_VAL(D, T, gui.toolbar_hidden, EET_T_UCHAR);
    EDI_CONFIG_VAL(D, T, gui.tab_inserts_spaces, EET_T_UCHAR);
+   EDI_CONFIG_VAL(D, T, gui.show_blame, EET_T_UCHAR);
+   EDI_CONFIG_VAL(D, T, gui.console_lines, EET_T_UINT);
 
    EDI_CONFIG_VAL(D, T, launch.path, EET_T_STRING);
    EDI_CONFIG_VAL(D, T, launch.args, EET_T_STRING);
+   EDI_CONFIG_VAL(D, T, build_cache, EET_T_UCHAR);
    EDI_CONFIG_VAL(D, T, debug_command, EET_T_STRING);
    EDI_CONFIG_VAL(D, T, user_fullname, EET_T_STRING);
    EDI_CONFIG_VAL(D, T, user_email, EET_T_STRING);
@@ -545,6 +548,18 @@ _edi_project_config_load()
    _edi_project_config->gui.alpha = 255;
    IFPCFGEND;
 
+   IFPCFG(0x0006);
+   _edi_project_config->gui.show_blame = EINA_FALSE;
+   IFPCFGEND;
+
+   IFPCFG(0x0007);
+   _edi_project_config->gui.console_lines = 10000;
+   IFPCFGEND;
+
+   IFPCFG(0x0008);
+   _edi_project_config->build_cache = EINA_FALSE;
+   IFPCFGEND;
+
    /* limit config values so they are sane */
    EDI_CONFIG_LIMIT(_edi_project_config->font.size, EDI_FONT_MIN, EDI_FONT_MAX);
    EDI_CONFIG_LIMIT(_edi_project_config->gui.width, 150, 10000);
@@ -552,8 +567,10 @@ _edi_project_config_load()
    EDI_CONFIG_LIMIT(_edi_project_config->gui.leftsize, 0.0, 1.0);
    EDI_CONFIG_LIMIT(_edi_project_config->gui.bottomsize, 0.0, 1.0);
    EDI_CONFIG_LIMIT(_edi_project_config->gui.tabstop, 1, 32);
+   EDI_CONFIG_LIMIT(_edi_project_config->gui.console_lines, 1000, 1000000);
 
    _edi_project_config->version = EDI_PROJECT_CONFIG_FILE_VERSION;
+   edi_build_cache_enabled_set(_edi_project_config->build_cache);
 
    if (save) _edi_project_config_save_no_notify();
 }
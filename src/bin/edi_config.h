@@ -89,9 +89,12 @@ struct _Edi_Project_Config
 
         Eina_Bool toolbar_hidden;
         Eina_Bool tab_inserts_spaces;
+        Eina_Bool show_blame;
+        unsigned int console_lines;
      } gui;
 
    Edi_Project_Config_Launch launch;
+   Eina_Bool build_cache;
    Eina_Stringshare *debug_command;
    Eina_Stringshare *user_fullname;
    Eina_Stringshare *user_email;
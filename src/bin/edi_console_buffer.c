@@ -0,0 +1,545 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Elementary.h>
+
+#include "edi_console_buffer.h"
+#include "edi_config.h"
+
+#include "edi_private.h"
+
+// Lines read back from the log each time the earlier lines are asked for.
+// The buffer may grow this far past the limit before the oldest lines are dropped.
+#define EDI_CONSOLE_BUFFER_PAGE 1000
+
+// The data of the lines from the first one of a run up to the next run.
+typedef struct _Edi_Console_Buffer_Run
+{
+   unsigned int line;
+   Eina_Stringshare *data;
+} Edi_Console_Buffer_Run;
+
+struct _Edi_Console_Buffer
+{
+   Elm_Code *code;
+   Elm_Code_Widget *widget;
+
+   // Every line ever appended, the log is unlinked so it goes away with us.
+   // Only the start of each page of lines is indexed, the rest is found in the log.
+   FILE *log;
+   off_t size;
+   unsigned int count;
+   Eina_Inarray *pages;
+   Eina_Inarray *runs;
+
+   // The lines [first, last) are in the code, with a line standing in for each side on disk.
+   unsigned int first, last;
+   Elm_Code_Line *earlier, *later;
+   Ecore_Job *job;
+
+   Eina_Stringshare *search;
+   unsigned int search_line;
+};
+
+static unsigned int
+_edi_console_buffer_limit(void)
+{
+   return _edi_project_config->gui.console_lines;
+}
+
+static const char *
+_edi_console_buffer_map(Edi_Console_Buffer *buffer)
+{
+   void *map;
+
+   if (!buffer->log || !buffer->size || fflush(buffer->log))
+     return NULL;
+
+   map = mmap(NULL, buffer->size, PROT_READ, MAP_SHARED, fileno(buffer->log), 0);
+   if (map == MAP_FAILED)
+     return NULL;
+
+   return map;
+}
+
+static void
+_edi_console_buffer_unmap(Edi_Console_Buffer *buffer, const char *map)
+{
+   munmap((void *) map, buffer->size);
+}
+
+static void
+_edi_console_buffer_earlier_update(Edi_Console_Buffer *buffer)
+{
+   Elm_Code_File *file = buffer->code->file;
+   char text[128];
+
+   if (!buffer->first)
+     {
+        if (buffer->earlier)
+          elm_code_file_line_remove(file, 1);
+        buffer->earlier = NULL;
+        return;
+     }
+
+   snprintf(text, sizeof(text), _("... %u earlier lines, click to show more"), buffer->first);
+   if (buffer->earlier)
+     {
+        elm_code_line_text_set(buffer->earlier, text, strlen(text));
+        return;
+     }
+
+   elm_code_file_line_insert(file, 1, text, strlen(text), NULL);
+   buffer->earlier = elm_code_file_line_get(file, 1);
+}
+
+static void
+_edi_console_buffer_later_update(Edi_Console_Buffer *buffer)
+{
+   Elm_Code_File *file = buffer->code->file;
+   unsigned int count;
+   char text[128];
+
+   count = buffer->count;
+   if (buffer->last == count)
+     {
+        if (buffer->later)
+          elm_code_file_line_remove(file, elm_code_file_lines_get(file));
+        buffer->later = NULL;
+        return;
+     }
+
+   snprintf(text, sizeof(text), _("... %u later lines, click to show the latest"), count - buffer->last);
+   if (buffer->later)
+     {
+        elm_code_line_text_set(buffer->later, text, strlen(text));
+        return;
+     }
+
+   elm_code_file_line_append(file, text, strlen(text), NULL);
+   buffer->later = elm_code_file_line_get(file, elm_code_file_lines_get(file));
+}
+
+static unsigned int
+_edi_console_buffer_run_find(Edi_Console_Buffer *buffer, unsigned int line)
+{
+   Edi_Console_Buffer_Run *run;
+   unsigned int low = 0, high, mid;
+
+   high = eina_inarray_count(buffer->runs);
+   while (high - low > 1)
+     {
+        mid = (low + high) / 2;
+        run = eina_inarray_nth(buffer->runs, mid);
+        if (run->line <= line)
+          low = mid;
+        else
+          high = mid;
+     }
+
+   return low;
+}
+
+// Where the first line of the page holding a line starts in the log.
+static const char *
+_edi_console_buffer_page_start(Edi_Console_Buffer *buffer, const char *map, unsigned int line)
+{
+   off_t *offset;
+
+   offset = eina_inarray_nth(buffer->pages, line / EDI_CONSOLE_BUFFER_PAGE);
+
+   return map + *offset;
+}
+
+static void
+_edi_console_buffer_show(Edi_Console_Buffer *buffer, unsigned int first, unsigned int last)
+{
+   Edi_Console_Buffer_Run *run, *next;
+   const char *map, *pos, *end, *eol;
+   unsigned int i, r, runs;
+
+   map = _edi_console_buffer_map(buffer);
+   if (!map)
+     return;
+
+   elm_code_file_clear(buffer->code->file);
+   buffer->earlier = buffer->later = NULL;
+
+   end = map + buffer->size;
+   runs = eina_inarray_count(buffer->runs);
+   r = _edi_console_buffer_run_find(buffer, first);
+   run = eina_inarray_nth(buffer->runs, r);
+
+   pos = first < last ? _edi_console_buffer_page_start(buffer, map, first) : end;
+   for (i = first - first % EDI_CONSOLE_BUFFER_PAGE; i < last && pos < end; i++)
+     {
+        eol = memchr(pos, '\n', end - pos);
+        if (!eol)
+          break;
+
+        if (i >= first)
+          {
+             while (r + 1 < runs && (next = eina_inarray_nth(buffer->runs, r + 1))->line <= i)
+               {
+                  run = next;
+                  r++;
+               }
+             elm_code_file_line_append(buffer->code->file, pos, eol - pos, (void *) run->data);
+          }
+        pos = eol + 1;
+     }
+   _edi_console_buffer_unmap(buffer, map);
+
+   buffer->first = first;
+   buffer->last = last;
+   _edi_console_buffer_earlier_update(buffer);
+   _edi_console_buffer_later_update(buffer);
+}
+
+// Drop the oldest lines once a page has built up, rebuilding the window from the log
+// costs less than removing the lines from the top of the code one by one.
+static void
+_edi_console_buffer_trim(Edi_Console_Buffer *buffer)
+{
+   unsigned int limit;
+
+   limit = _edi_console_buffer_limit();
+   if (!buffer->log || buffer->last - buffer->first <= limit + EDI_CONSOLE_BUFFER_PAGE)
+     return;
+
+   _edi_console_buffer_show(buffer, buffer->last - limit, buffer->last);
+}
+
+// Lines are found in the log by counting newlines, so none is written within a line.
+static void
+_edi_console_buffer_log_write(FILE *log, const char *text, unsigned int length)
+{
+   const char *eol;
+
+   while ((eol = memchr(text, '\n', length)))
+     {
+        fwrite(text, 1, eol - text, log);
+        fputc(' ', log);
+        length -= eol - text + 1;
+        text = eol + 1;
+     }
+
+   fwrite(text, 1, length, log);
+   fputc('\n', log);
+}
+
+void
+edi_console_buffer_line_append(Edi_Console_Buffer *buffer, const char *text,
+                               unsigned int length, const char *data)
+{
+   Edi_Console_Buffer_Run run, *previous = NULL;
+   Eina_Bool following;
+
+   if (!(buffer->count % EDI_CONSOLE_BUFFER_PAGE))
+     eina_inarray_push(buffer->pages, &buffer->size);
+
+   if (buffer->count)
+     previous = eina_inarray_nth(buffer->runs, eina_inarray_count(buffer->runs) - 1);
+   run.line = buffer->count;
+   run.data = eina_stringshare_add(data);
+   if (previous && previous->data == run.data)
+     eina_stringshare_del(run.data);
+   else
+     eina_inarray_push(buffer->runs, &run);
+
+   if (buffer->log)
+     {
+        _edi_console_buffer_log_write(buffer->log, text, length);
+        buffer->size += length + 1;
+     }
+
+   following = buffer->last == buffer->count;
+   buffer->count++;
+
+   // Someone is reading earlier output, leave it where it is.
+   if (!following)
+     {
+        _edi_console_buffer_later_update(buffer);
+        return;
+     }
+
+   elm_code_file_line_append(buffer->code->file, text, length, (void *) run.data);
+   buffer->last++;
+
+   _edi_console_buffer_trim(buffer);
+}
+
+void
+edi_console_buffer_clear(Edi_Console_Buffer *buffer)
+{
+   Edi_Console_Buffer_Run *run;
+
+   if (buffer->job)
+     ecore_job_del(buffer->job);
+   buffer->job = NULL;
+
+   elm_code_file_clear(buffer->code->file);
+   buffer->first = buffer->last = 0;
+   buffer->earlier = buffer->later = NULL;
+
+   EINA_INARRAY_FOREACH(buffer->runs, run)
+     eina_stringshare_del(run->data);
+   eina_inarray_flush(buffer->runs);
+   eina_inarray_flush(buffer->pages);
+   buffer->count = 0;
+
+   if (buffer->log)
+     {
+        fflush(buffer->log);
+        if (ftruncate(fileno(buffer->log), 0))
+          ERR("Could not truncate the console log");
+        rewind(buffer->log);
+     }
+   buffer->size = 0;
+
+   eina_stringshare_replace(&buffer->search, NULL);
+}
+
+static void
+_edi_console_buffer_earlier_job(void *data)
+{
+   Edi_Console_Buffer *buffer = data;
+   unsigned int first, last, limit;
+
+   buffer->job = NULL;
+
+   limit = _edi_console_buffer_limit();
+   first = buffer->first > EDI_CONSOLE_BUFFER_PAGE ? buffer->first - EDI_CONSOLE_BUFFER_PAGE : 0;
+   last = buffer->last;
+   if (last - first > limit + EDI_CONSOLE_BUFFER_PAGE)
+     last = first + limit + EDI_CONSOLE_BUFFER_PAGE;
+
+   _edi_console_buffer_show(buffer, first, last);
+}
+
+static void
+_edi_console_buffer_later_job(void *data)
+{
+   Edi_Console_Buffer *buffer = data;
+   unsigned int count, limit;
+
+   buffer->job = NULL;
+
+   limit = _edi_console_buffer_limit();
+   count = buffer->count;
+   _edi_console_buffer_show(buffer, count > limit ? count - limit : 0, count);
+}
+
+// The clicked line is freed when the window moves, so move it once the event is over.
+static void
+_edi_console_buffer_clicked_cb(void *data, const Efl_Event *event)
+{
+   Edi_Console_Buffer *buffer = data;
+   Elm_Code_Line *line;
+
+   line = (Elm_Code_Line *)event->info;
+   if (buffer->job || (line != buffer->earlier && line != buffer->later))
+     return;
+
+   if (line == buffer->earlier)
+     buffer->job = ecore_job_add(_edi_console_buffer_earlier_job, buffer);
+   else
+     buffer->job = ecore_job_add(_edi_console_buffer_later_job, buffer);
+}
+
+static Eina_Bool
+_edi_console_buffer_line_find(const char *start, unsigned int length, const char *term,
+                              unsigned int termlen, unsigned int *offset)
+{
+   unsigned int c;
+
+   for (c = 0; c + termlen <= length; c++)
+     {
+        if (!strncasecmp(start + c, term, termlen))
+          {
+             *offset = c;
+             return EINA_TRUE;
+          }
+     }
+
+   return EINA_FALSE;
+}
+
+static void
+_edi_console_buffer_select(Edi_Console_Buffer *buffer, unsigned int index, unsigned int offset,
+                           unsigned int termlen)
+{
+   Elm_Code_Line *line;
+   unsigned int row, col;
+
+   if (!buffer->widget)
+     return;
+
+   row = index - buffer->first + (buffer->earlier ? 2 : 1);
+   line = elm_code_file_line_get(buffer->code->file, row);
+   if (!line)
+     return;
+
+   col = elm_code_widget_line_text_column_width_to_position(buffer->widget, line, offset);
+   elm_code_widget_cursor_position_set(buffer->widget, row, col);
+   elm_code_widget_selection_start(buffer->widget, row, col);
+   elm_code_widget_selection_end(buffer->widget, row,
+                                 elm_code_widget_line_text_column_width_to_position(buffer->widget, line, offset + termlen) - 1);
+}
+
+// Find the last line of [from, to) holding the term, a page at a time from the end.
+static Eina_Bool
+_edi_console_buffer_last_find(Edi_Console_Buffer *buffer, const char *map, unsigned int from,
+                              unsigned int to, const char *term, unsigned int termlen,
+                              unsigned int *index, unsigned int *offset)
+{
+   const char *pos, *end, *eol;
+   unsigned int start, i, c;
+   Eina_Bool found = EINA_FALSE;
+
+   end = map + buffer->size;
+   while (to > from && !found)
+     {
+        start = (to - 1) - (to - 1) % EDI_CONSOLE_BUFFER_PAGE;
+        pos = _edi_console_buffer_page_start(buffer, map, start);
+        for (i = start; i < to && (eol = memchr(pos, '\n', end - pos)); i++, pos = eol + 1)
+          {
+             if (i < from)
+               continue;
+
+             if (_edi_console_buffer_line_find(pos, eol - pos, term, termlen, &c))
+               {
+                  *index = i;
+                  *offset = c;
+                  found = EINA_TRUE;
+               }
+          }
+        to = start;
+     }
+
+   return found;
+}
+
+Eina_Bool
+edi_console_buffer_search(Edi_Console_Buffer *buffer, const char *term)
+{
+   const char *map;
+   unsigned int count, termlen, index = 0, offset = 0, first, limit;
+   Eina_Bool found;
+
+   count = buffer->count;
+   termlen = term ? strlen(term) : 0;
+   if (!count || !termlen)
+     return EINA_FALSE;
+
+   if (!buffer->search || strcmp(buffer->search, term))
+     {
+        eina_stringshare_replace(&buffer->search, term);
+        buffer->search_line = count;
+     }
+
+   map = _edi_console_buffer_map(buffer);
+   if (!map)
+     return EINA_FALSE;
+
+   // Newest first, the end of a build is where the failure usually is.
+   found = _edi_console_buffer_last_find(buffer, map, 0, buffer->search_line, term, termlen,
+                                         &index, &offset) ||
+           _edi_console_buffer_last_find(buffer, map, buffer->search_line, count, term, termlen,
+                                         &index, &offset);
+   _edi_console_buffer_unmap(buffer, map);
+
+   if (!found)
+     return EINA_FALSE;
+
+   buffer->search_line = index;
+   if (index < buffer->first || index >= buffer->last)
+     {
+        limit = _edi_console_buffer_limit();
+        first = index > limit / 2 ? index - limit / 2 : 0;
+        _edi_console_buffer_show(buffer, first, first + limit < count ? first + limit : count);
+     }
+
+   _edi_console_buffer_select(buffer, index, offset, termlen);
+   return EINA_TRUE;
+}
+
+static void
+_edi_console_buffer_search_cb(void *data, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   Edi_Console_Buffer *buffer = data;
+   char *term;
+
+   term = elm_entry_markup_to_utf8(elm_object_text_get(obj));
+   edi_console_buffer_search(buffer, term);
+   free(term);
+}
+
+Evas_Object *
+edi_console_buffer_view_add(Edi_Console_Buffer *buffer, Evas_Object *parent,
+                            Elm_Code_Widget *widget)
+{
+   Evas_Object *box, *entry;
+
+   buffer->widget = widget;
+   efl_event_callback_add(widget, ELM_OBJ_CODE_WIDGET_EVENT_LINE_CLICKED,
+                          _edi_console_buffer_clicked_cb, buffer);
+
+   box = elm_box_add(parent);
+   evas_object_size_hint_weight_set(box, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(box, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(box);
+
+   entry = elm_entry_add(box);
+   elm_entry_scrollable_set(entry, EINA_TRUE);
+   elm_entry_single_line_set(entry, EINA_TRUE);
+   elm_object_part_text_set(entry, "guide", _("Search output"));
+   evas_object_size_hint_weight_set(entry, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(entry, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_smart_callback_add(entry, "activated", _edi_console_buffer_search_cb, buffer);
+   evas_object_show(entry);
+   elm_box_pack_end(box, entry);
+
+   elm_box_pack_end(box, widget);
+   return box;
+}
+
+Edi_Console_Buffer *
+edi_console_buffer_add(Elm_Code *code)
+{
+   Edi_Console_Buffer *buffer;
+   Eina_Tmpstr *path;
+   int fd;
+
+   buffer = calloc(1, sizeof(Edi_Console_Buffer));
+   buffer->code = code;
+   buffer->pages = eina_inarray_new(sizeof(off_t), 64);
+   buffer->runs = eina_inarray_new(sizeof(Edi_Console_Buffer_Run), 64);
+
+   fd = eina_file_mkstemp("edi_console_XXXXXX", &path);
+   if (fd < 0)
+     {
+        ERR("Could not create a console log, output will not be limited");
+        return buffer;
+     }
+
+   unlink(path);
+   eina_tmpstr_del(path);
+
+   buffer->log = fdopen(fd, "w+");
+   if (!buffer->log)
+     {
+        ERR("Could not open the console log, output will not be limited");
+        close(fd);
+     }
+
+   return buffer;
+}
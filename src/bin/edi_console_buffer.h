@@ -0,0 +1,100 @@
+#ifndef EDI_CONSOLE_BUFFER_H_
+# define EDI_CONSOLE_BUFFER_H_
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for keeping long output in a bounded console.
+ */
+
+/**
+ * A console backed by a log on disk, only a window of its lines is held in memory.
+ */
+typedef struct _Edi_Console_Buffer Edi_Console_Buffer;
+
+/**
+ * @brief Console buffer functions.
+ * @defgroup Console_Buffer
+ *
+ * @{
+ *
+ * Every line is written to an unlinked log file and the Elm_Code file only
+ * holds the latest lines, up to the configured console line limit.
+ * Earlier lines are read back from the log when they are asked for.
+ *
+ */
+
+/**
+ * Create a buffer that appends to the given code.
+ *
+ * @param code The code that shows the lines of the buffer.
+ * @return A new buffer, if no log could be created the lines are never limited.
+ *
+ * @ingroup Console_Buffer
+ */
+Edi_Console_Buffer *edi_console_buffer_add(Elm_Code *code);
+
+/**
+ * Create the view of a buffer, a search entry above the widget.
+ *
+ * Clicking the lines that stand in for the lines on disk shows them.
+ *
+ * @param buffer The buffer to show.
+ * @param parent The parent object of the view.
+ * @param widget The widget of the buffer's code.
+ * @return The view to pack in place of the widget.
+ *
+ * @ingroup Console_Buffer
+ */
+Evas_Object *edi_console_buffer_view_add(Edi_Console_Buffer *buffer, Evas_Object *parent,
+                                         Elm_Code_Widget *widget);
+
+/**
+ * Append a line to the buffer.
+ *
+ * @param buffer The buffer to append to.
+ * @param text The text of the line, not NUL terminated.
+ * @param length The length of the text in bytes.
+ * @param data A string set as the data of the line, or NULL.
+ *
+ * @ingroup Console_Buffer
+ */
+void edi_console_buffer_line_append(Edi_Console_Buffer *buffer, const char *text,
+                                    unsigned int length, const char *data);
+
+/**
+ * Remove every line from the buffer and its log.
+ *
+ * @param buffer The buffer to clear.
+ *
+ * @ingroup Console_Buffer
+ */
+void edi_console_buffer_clear(Edi_Console_Buffer *buffer);
+
+/**
+ * Select the previous line containing a term, reading back the lines on disk if needed.
+ *
+ * Searching for the same term again continues from the last match.
+ *
+ * @param buffer The buffer to search.
+ * @param term The text to look for, ignoring case.
+ * @return EINA_TRUE if a line was found.
+ *
+ * @ingroup Console_Buffer
+ */
+Eina_Bool edi_console_buffer_search(Edi_Console_Buffer *buffer, const char *term);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_CONSOLE_BUFFER_H_ */
@@ -12,10 +12,12 @@
 #include <Ecore.h>
 #include <Elementary.h>
 #include <Elementary_Cursor.h>
-#include <regex.h>
 
 #include "edi_consolepanel.h"
+#include "edi_console_buffer.h"
+#include "editor/edi_editor.h"
 #include "mainview/edi_mainview.h"
+#include "mainview/edi_mainview_panel.h"
 #include "edi_theme.h"
 #include "edi_config.h"
 
@@ -29,43 +31,39 @@ static int _edi_test_count;
 static int _edi_test_pass;
 static int _edi_test_fail;
 
-static Elm_Code *_edi_test_code, *_edi_console_code;
+static Elm_Code *_edi_test_code, *_edi_console_code, *_edi_problems_code;
+static Edi_Console_Buffer *_edi_console_buffer;
 static void _edi_test_line_callback(const char *content);
 
-static Eina_Bool
-_edi_consolepanel_startswith_location(const char *line)
+typedef struct _Edi_Consolepanel_Line
 {
-   regex_t regex;
-   int ret;
-
-   regcomp(&regex, "^[^/].*:[0-9]*:[0-9]*[ :]", 0);
-   ret = !regexec(&regex, line, 0, NULL, 0);
-
-   regfree(&regex);
-   return ret;
-}
+   Eina_Bool err;
+   char text[];
+} Edi_Consolepanel_Line;
 
-static char *
-_edi_consolepanel_extract_location(const char *line, const char *dir, int dirlen)
+typedef struct _Edi_Problems_Batch
 {
-   char *path;
-   const char *pos;
-   int file_len, length;
+   Eina_List *lines;
+   Eina_List *diagnostics;
+   const char *dir;
+   unsigned int generation;
+} Edi_Problems_Batch;
 
-   pos = strstr(line, ":F:");
-   if (!pos)
-     pos = strstr(line, ":P:");
-   if (!pos)
-     pos = strstr(line, " ");
-   file_len = strlen(line) - strlen(pos);
+// Build output waiting for the next frame to be appended to the console.
+static Eina_List *_edi_console_pending = NULL;
+static Ecore_Animator *_edi_console_animator = NULL;
 
-   length = dirlen + file_len + 2;
-   path = malloc(sizeof(char) * length);
-   snprintf(path, dirlen + 2, "%s/", dir);
-   snprintf(path + dirlen + 1, file_len + 1, "%s", line);
+// Build output waiting to be read for diagnostics, a single worker takes one batch at a time.
+static Eina_List *_edi_problems_batches = NULL;
+static Ecore_Thread *_edi_problems_thread = NULL;
+static unsigned int _edi_problems_generation = 0;
 
-   return path;
-}
+// Only used by the worker, which follows the directory changes of the whole build.
+static Edi_Diagnostic_Parser *_edi_problems_parser = NULL;
+static unsigned int _edi_problems_parser_generation = 0;
+
+// The diagnostics of the current build, a list of Edi_Diagnostic for each path.
+static Eina_Hash *_edi_problems = NULL;
 
 static void _edi_consolepanel_parse_directory(const char *line)
 {
@@ -86,9 +84,9 @@ static void
 _edi_consolepanel_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
 {
    Edi_Path_Options *options;
+   Edi_Diagnostic *diagnostic;
    Elm_Code_Line *line;
-   const char *content, *parentdir;
-   char *path, *terminated;
+   const char *content;
    unsigned int length;
 
    line = (Elm_Code_Line *)event->info;
@@ -96,22 +94,19 @@ _edi_consolepanel_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
      return;
    content = elm_code_line_text_get(line, &length);
 
-   terminated = malloc(sizeof(char) * (length + 1));
-   snprintf(terminated, length, "%s", content);
+   diagnostic = edi_diagnostic_parse((const char *)line->data, content, length);
+   if (!diagnostic)
+     return;
 
-   if (_edi_consolepanel_startswith_location(terminated))
+   if (strstr(diagnostic->path, edi_project_get()) == diagnostic->path)
      {
-        parentdir = (const char *)line->data;
-        path = _edi_consolepanel_extract_location(terminated, parentdir, strlen(parentdir));
-
-        if (strstr(path, edi_project_get()) == path)
-          {
-             options = edi_path_options_create(path);
-             edi_mainview_open(options);
-          }
+        options = edi_path_options_create(diagnostic->path);
+        options->line = diagnostic->line;
+        options->character = diagnostic->col;
+        edi_mainview_open(options);
      }
 
-   free(terminated);
+   edi_diagnostic_free(diagnostic);
 }
 
 static void
@@ -129,8 +124,8 @@ static void _edi_consolepanel_append_line_type(const char *line, Eina_Bool err)
 {
    _edi_consolepanel_parse_directory(line);
 
-   elm_code_file_line_append(_edi_console_code->file, line, strlen(line),
-                             err && _current_dir ? strdup(_current_dir) : NULL);
+   edi_console_buffer_line_append(_edi_console_buffer, line, strlen(line),
+                                  err ? _current_dir : NULL);
 
    _edi_test_line_callback(line);
 }
@@ -145,9 +140,272 @@ void edi_consolepanel_append_error_line(const char *line)
    _edi_consolepanel_append_line_type(line, EINA_TRUE);
 }
 
+static void
+_edi_problems_editors_update(const char *path, const Eina_List *diagnostics, Eina_Bool show)
+{
+   Edi_Mainview_Panel *panel;
+   Edi_Mainview_Item *item;
+   Edi_Editor *editor;
+   Eina_List *l;
+   int i;
+
+   for (i = 0; i < edi_mainview_panel_count(); i++)
+     {
+        panel = edi_mainview_panel_by_index(i);
+        EINA_LIST_FOREACH(panel->items, l, item)
+          {
+             if (!item->view || strcmp(item->path, path))
+               continue;
+
+             editor = (Edi_Editor *)evas_object_data_get(item->view, "editor");
+             if (!editor)
+               continue;
+
+             if (show)
+               edi_editor_diagnostics_show(editor, diagnostics);
+             else
+               edi_editor_diagnostics_hide(editor, diagnostics);
+          }
+     }
+}
+
+static void
+_edi_problems_list_free(void *data)
+{
+   Eina_List *diagnostics = data;
+   Edi_Diagnostic *diagnostic;
+
+   EINA_LIST_FREE(diagnostics, diagnostic)
+     edi_diagnostic_free(diagnostic);
+}
+
+static void
+_edi_problems_add(Edi_Diagnostic *diagnostic)
+{
+   Edi_Diagnostic *existing;
+   Eina_List *diagnostics, *l, *single;
+   const char *path, *severity;
+   char *text;
+   size_t projectlen;
+
+   if (!_edi_problems)
+     _edi_problems = eina_hash_string_superfast_new(_edi_problems_list_free);
+
+   // Headers included from several files report the same problem each time.
+   diagnostics = eina_hash_find(_edi_problems, diagnostic->path);
+   EINA_LIST_FOREACH(diagnostics, l, existing)
+     {
+        if (existing->line == diagnostic->line && existing->col == diagnostic->col &&
+            existing->message == diagnostic->message)
+          {
+             edi_diagnostic_free(diagnostic);
+             return;
+          }
+     }
+   if (diagnostics)
+     eina_hash_modify(_edi_problems, diagnostic->path, eina_list_append(diagnostics, diagnostic));
+   else
+     eina_hash_add(_edi_problems, diagnostic->path, eina_list_append(NULL, diagnostic));
+
+   path = diagnostic->path;
+   projectlen = strlen(edi_project_get());
+   if (!strncmp(path, edi_project_get(), projectlen) && path[projectlen] == '/')
+     path += projectlen + 1;
+   severity = diagnostic->severity == EDI_DIAGNOSTIC_SEVERITY_ERROR ? _("error") : _("warning");
+
+   text = malloc(strlen(path) + strlen(severity) + strlen(diagnostic->message) + 32);
+   sprintf(text, "%s:%u:%u: %s: %s", path, diagnostic->line, diagnostic->col, severity,
+           diagnostic->message);
+   elm_code_file_line_append(_edi_problems_code->file, text, strlen(text), diagnostic);
+   free(text);
+
+   single = eina_list_append(NULL, diagnostic);
+   _edi_problems_editors_update(diagnostic->path, single, EINA_TRUE);
+   eina_list_free(single);
+}
+
+static void
+_edi_problems_batch_free(Edi_Problems_Batch *batch)
+{
+   Edi_Consolepanel_Line *line;
+   Edi_Diagnostic *diagnostic;
+
+   EINA_LIST_FREE(batch->lines, line)
+     free(line);
+   EINA_LIST_FREE(batch->diagnostics, diagnostic)
+     edi_diagnostic_free(diagnostic);
+
+   eina_stringshare_del(batch->dir);
+   free(batch);
+}
+
+static void
+_edi_problems_parse_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Problems_Batch *batch = data;
+   Edi_Consolepanel_Line *line;
+   Edi_Diagnostic *diagnostic;
+   Eina_List *l;
+
+   if (!_edi_problems_parser || _edi_problems_parser_generation != batch->generation)
+     {
+        if (_edi_problems_parser)
+          edi_diagnostic_parser_free(_edi_problems_parser);
+
+        _edi_problems_parser = edi_diagnostic_parser_new(batch->dir);
+        _edi_problems_parser_generation = batch->generation;
+     }
+
+   EINA_LIST_FOREACH(batch->lines, l, line)
+     {
+        diagnostic = edi_diagnostic_parser_feed(_edi_problems_parser, line->text, strlen(line->text));
+        if (diagnostic)
+          batch->diagnostics = eina_list_append(batch->diagnostics, diagnostic);
+     }
+}
+
+static void _edi_problems_next(void);
+
+static void
+_edi_problems_parse_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Problems_Batch *batch = data;
+   Edi_Diagnostic *diagnostic;
+
+   _edi_problems_thread = NULL;
+
+   // Diagnostics of a build that has since been cleared are dropped.
+   if (batch->generation == _edi_problems_generation)
+     {
+        EINA_LIST_FREE(batch->diagnostics, diagnostic)
+          {
+             if (diagnostic->severity == EDI_DIAGNOSTIC_SEVERITY_NOTE)
+               edi_diagnostic_free(diagnostic);
+             else
+               _edi_problems_add(diagnostic);
+          }
+     }
+
+   _edi_problems_batch_free(batch);
+   _edi_problems_next();
+}
+
+static void
+_edi_problems_next(void)
+{
+   Edi_Problems_Batch *batch;
+
+   if (_edi_problems_thread || !_edi_problems_batches)
+     return;
+
+   batch = eina_list_data_get(_edi_problems_batches);
+   _edi_problems_batches = eina_list_remove_list(_edi_problems_batches, _edi_problems_batches);
+
+   _edi_problems_thread = ecore_thread_run(_edi_problems_parse_cb, _edi_problems_parse_end_cb,
+                                           _edi_problems_parse_end_cb, batch);
+}
+
+static Eina_Bool
+_edi_problems_editors_hide_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                              void *data, void *fdata EINA_UNUSED)
+{
+   _edi_problems_editors_update(key, data, EINA_FALSE);
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_problems_clear(void)
+{
+   Edi_Problems_Batch *batch;
+
+   _edi_problems_generation++;
+   EINA_LIST_FREE(_edi_problems_batches, batch)
+     _edi_problems_batch_free(batch);
+
+   elm_code_file_clear(_edi_problems_code->file);
+   if (!_edi_problems)
+     return;
+
+   eina_hash_foreach(_edi_problems, _edi_problems_editors_hide_cb, NULL);
+   eina_hash_free(_edi_problems);
+   _edi_problems = NULL;
+}
+
+// Appending once per frame keeps a busy build from redrawing the console for every line.
+static void
+_edi_consolepanel_flush(void)
+{
+   Edi_Problems_Batch *batch;
+   Edi_Consolepanel_Line *line;
+   Eina_List *l;
+
+   if (_edi_console_animator)
+     ecore_animator_del(_edi_console_animator);
+   _edi_console_animator = NULL;
+
+   if (!_edi_console_pending)
+     return;
+
+   EINA_LIST_FOREACH(_edi_console_pending, l, line)
+     _edi_consolepanel_append_line_type(line->text, line->err);
+
+   batch = calloc(1, sizeof(Edi_Problems_Batch));
+   batch->lines = _edi_console_pending;
+   batch->dir = eina_stringshare_add(edi_project_get());
+   batch->generation = _edi_problems_generation;
+   _edi_console_pending = NULL;
+
+   _edi_problems_batches = eina_list_append(_edi_problems_batches, batch);
+   _edi_problems_next();
+}
+
+static Eina_Bool
+_edi_consolepanel_flush_cb(void *data EINA_UNUSED)
+{
+   _edi_console_animator = NULL;
+   _edi_consolepanel_flush();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_consolepanel_queue(const char *text, Eina_Bool err)
+{
+   Edi_Consolepanel_Line *line;
+   size_t length;
+
+   length = strlen(text);
+   line = malloc(sizeof(Edi_Consolepanel_Line) + length + 1);
+   line->err = err;
+   memcpy(line->text, text, length + 1);
+   _edi_console_pending = eina_list_append(_edi_console_pending, line);
+
+   if (!_edi_console_animator)
+     _edi_console_animator = ecore_animator_add(_edi_consolepanel_flush_cb, NULL);
+}
+
+const Eina_List *
+edi_problemspanel_diagnostics_get(const char *path)
+{
+   if (!_edi_problems)
+     return NULL;
+
+   return eina_hash_find(_edi_problems, path);
+}
+
 void edi_consolepanel_clear()
 {
-   elm_code_file_clear(_edi_console_code->file);
+   Edi_Consolepanel_Line *line;
+
+   if (_edi_console_animator)
+     ecore_animator_del(_edi_console_animator);
+   _edi_console_animator = NULL;
+   EINA_LIST_FREE(_edi_console_pending, line)
+     free(line);
+   _edi_problems_clear();
+
+   edi_console_buffer_clear(_edi_console_buffer);
    elm_code_file_clear(_edi_test_code->file);
 
    _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
@@ -180,7 +438,7 @@ _exe_data(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
 
    ev = event_info;
    for (el = ev->lines; el && el->line; el++)
-     edi_consolepanel_append_line(el->line);
+     _edi_consolepanel_queue(el->line, EINA_FALSE);
 
    return ECORE_CALLBACK_RENEW;
 }
@@ -193,42 +451,56 @@ _exe_error(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
 
    ev = event_info;
    for (el = ev->lines; el && el->line; el++)
-     edi_consolepanel_append_error_line(el->line);
+     _edi_consolepanel_queue(el->line, EINA_TRUE);
 
    return ECORE_CALLBACK_RENEW;
 }
 
-static Eina_Bool
-_exe_done(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info EINA_UNUSED)
+void
+edi_consolepanel_output_append(const char *line, Eina_Bool err)
+{
+   _edi_consolepanel_queue(line, err);
+}
+
+void
+edi_consolepanel_output_end(void)
 {
-   if (_edi_test_count == 0)
-     return ECORE_CALLBACK_RENEW;
+   // The suite summary needs every line the command wrote.
+   _edi_consolepanel_flush();
+
+   if (_edi_test_count == 0 || edi_test_runner_running_get())
+     return;
 
    _edi_test_output_suite(_edi_test_count, _edi_test_pass, _edi_test_fail);
    _edi_test_count = 0;
-   return ECORE_CALLBACK_RENEW;
 }
 
 static Eina_Bool
-_edi_test_line_contains(const char *start, unsigned int length, const char *needle)
+_exe_done(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info EINA_UNUSED)
 {
-   unsigned int needlelen, c;
-   char *ptr;
+   edi_consolepanel_output_end();
+
+   return ECORE_CALLBACK_RENEW;
+}
 
-   ptr = (char *) start;
-   needlelen = strlen(needle);
-   if (needlelen > length)
-     return EINA_FALSE;
+// Check writes results as file:line:R:tcase:test, R being P, F or E.
+static char
+_edi_test_line_result_get(const char *start, unsigned int length)
+{
+   const char *ptr, *end;
 
-   for (c = 0; c < length - strlen(needle); c++)
+   end = start + length;
+   for (ptr = start; ptr + 3 <= end; ptr++)
      {
-        if (!strncmp(ptr, needle, needlelen))
-           return EINA_TRUE;
+        ptr = memchr(ptr, ':', end - ptr);
+        if (!ptr || ptr + 3 > end)
+          break;
 
-        ptr++;
+        if (ptr[2] == ':' && (ptr[1] == 'P' || ptr[1] == 'F' || ptr[1] == 'E'))
+          return ptr[1];
      }
 
-   return EINA_FALSE;
+   return '\0';
 }
 
 static void
@@ -239,6 +511,7 @@ _edi_test_line_parse_suite(const char *path)
    Eina_Iterator *it;
    char logfile[PATH_MAX], logpath[PATH_MAX];
    int pathlength;
+   char result;
 
    pathlength = strlen(path);
    snprintf(logfile, pathlength + 4 + 1, "%s.log", path);
@@ -255,25 +528,20 @@ _edi_test_line_parse_suite(const char *path)
    it = eina_file_map_lines(file);
    EINA_ITERATOR_FOREACH(it, line)
      {
-        if (_edi_test_line_contains(line->start, line->length, ":P:"))
+        result = _edi_test_line_result_get(line->start, line->length);
+        if (result == 'P')
           {
              _edi_test_count++;
              _edi_test_pass++;
              continue;
           }
-        else if (_edi_test_line_contains(line->start, line->length, ":F:"))
+        else if (result == 'F' || result == 'E')
           {
              _edi_test_count++;
              _edi_test_fail++;
              elm_code_file_line_append(_edi_test_code->file, line->start, line->length, strdup(_current_test_dir));
           }
-        else if (_edi_test_line_contains(line->start, line->length, ":E:"))
-          {
-             _edi_test_count++;
-             _edi_test_fail++;
-             elm_code_file_line_append(_edi_test_code->file, line->start, line->length, strdup(_current_test_dir));
-          }
-        else if (_edi_test_line_contains(line->start, line->length, "Running"))
+        else if (line->length >= 7 && !strncmp(line->start, "Running", 7))
           {
              _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
              elm_code_file_line_append(_edi_test_code->file, line->start, line->length, NULL);
@@ -306,7 +574,8 @@ _edi_testpanel_line_cb(void *data EINA_UNUSED, const Efl_Event *event)
 
 static void _edi_test_line_callback(const char *content)
 {
-   if (!content)
+   // The test runner reports its results itself.
+   if (!content || edi_test_runner_running_get())
      return;
 
    if (content[0] == '#')
@@ -341,6 +610,74 @@ static void _edi_test_line_callback(const char *content)
      }
 }
 
+static void
+_edi_testpanel_runner_output_cb(void *data EINA_UNUSED, const char *line, Eina_Bool err)
+{
+   _edi_consolepanel_queue(line, err);
+}
+
+static void
+_edi_testpanel_runner_case_cb(void *data EINA_UNUSED, const Edi_Test_Case *test)
+{
+   const char *line, *status;
+
+   if (!_edi_test_count++)
+     edi_testpanel_show();
+
+   if (test->result == EDI_TEST_RESULT_PASS)
+     {
+        _edi_test_pass++;
+        status = _EDI_SUITE_PASSED;
+        line = "PASS:";
+     }
+   else if (test->result == EDI_TEST_RESULT_FAIL)
+     {
+        _edi_test_fail++;
+        status = _EDI_SUITE_FAILED;
+        line = "FAIL:";
+     }
+   else
+     {
+        status = NULL;
+        line = "SKIP:";
+     }
+
+   if (test->duration >= 0)
+     line = eina_slstr_printf("%s %s (%.3fs)", line, test->name, test->duration);
+   else
+     line = eina_slstr_printf("%s %s", line, test->name);
+
+   elm_code_file_line_append(_edi_test_code->file, line, strlen(line), status);
+}
+
+static void
+_edi_testpanel_runner_finished_cb(void *data EINA_UNUSED, const Eina_List *results)
+{
+   const char *report, *line;
+
+   // Scan the rest of the output while the runner still owns it.
+   _edi_consolepanel_flush();
+
+   if (_edi_test_count > 0)
+     _edi_test_output_suite(_edi_test_pass + _edi_test_fail, _edi_test_pass, _edi_test_fail);
+   _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
+
+   // A run that found nothing to test keeps the report of the one before.
+   report = edi_test_runner_report_path_get();
+   if (report && results)
+     {
+        line = eina_slstr_printf(_("Results written to %s"), report);
+        elm_code_file_line_append(_edi_test_code->file, line, strlen(line), NULL);
+     }
+}
+
+void edi_testpanel_clear()
+{
+   elm_code_file_clear(_edi_test_code->file);
+
+   _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
+}
+
 static Eina_Bool
 _edi_consolepanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
 {
@@ -359,17 +696,24 @@ _edi_consolepanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, v
         edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
      }
 
+   EINA_LIST_FOREACH(_edi_problems_code->widgets, item, widget)
+     {
+        elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+        edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+     }
+
    return ECORE_CALLBACK_RENEW;
 }
 
 void edi_consolepanel_add(Evas_Object *parent)
 {
-   Evas_Object *frame;
+   Evas_Object *frame, *view;
    Elm_Code *code;
    Elm_Code_Widget *widget;
 
    code = elm_code_create();
    _edi_console_code = code;
+   _edi_console_buffer = edi_console_buffer_add(code);
 
    frame = elm_frame_add(parent);
    elm_object_text_set(frame, _("Console"));
@@ -388,7 +732,8 @@ void edi_consolepanel_add(Evas_Object *parent)
    evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(widget);
 
-   elm_object_content_set(frame, widget);
+   view = edi_console_buffer_view_add(_edi_console_buffer, frame, widget);
+   elm_object_content_set(frame, view);
    elm_box_pack_end(parent, frame);
 
    ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _exe_data, NULL);
@@ -397,6 +742,41 @@ void edi_consolepanel_add(Evas_Object *parent)
    ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_consolepanel_config_changed, NULL);
 }
 
+static void
+_edi_problemspanel_line_cb(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Elm_Code_Line *line;
+   Edi_Diagnostic *diagnostic;
+
+   line = (Elm_Code_Line *)event->info;
+   diagnostic = line->data;
+   if (!diagnostic)
+     return;
+
+   if (diagnostic->severity == EDI_DIAGNOSTIC_SEVERITY_ERROR)
+     line->status = ELM_CODE_STATUS_TYPE_ERROR;
+   else
+     line->status = ELM_CODE_STATUS_TYPE_WARNING;
+}
+
+static void
+_edi_problemspanel_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Edi_Path_Options *options;
+   Edi_Diagnostic *diagnostic;
+   Elm_Code_Line *line;
+
+   line = (Elm_Code_Line *)event->info;
+   diagnostic = line->data;
+   if (!diagnostic)
+     return;
+
+   options = edi_path_options_create(diagnostic->path);
+   options->line = diagnostic->line;
+   options->character = diagnostic->col;
+   edi_mainview_open(options);
+}
+
 void edi_testpanel_add(Evas_Object *parent)
 {
    Evas_Object *frame;
@@ -425,5 +805,36 @@ void edi_testpanel_add(Evas_Object *parent)
 
    elm_object_content_set(frame, widget);
    elm_box_pack_end(parent, frame);
+
+   edi_test_runner_callbacks_set(_edi_testpanel_runner_output_cb, _edi_testpanel_runner_case_cb,
+                                 _edi_testpanel_runner_finished_cb, NULL);
 }
 
+void edi_problemspanel_add(Evas_Object *parent)
+{
+   Evas_Object *frame;
+   Elm_Code *code;
+   Elm_Code_Widget *widget;
+
+   code = elm_code_create();
+   _edi_problems_code = code;
+
+   frame = elm_frame_add(parent);
+   elm_object_text_set(frame, _("Problems"));
+   evas_object_size_hint_weight_set(frame, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(frame);
+
+   widget = elm_code_widget_add(parent, code);
+   elm_obj_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+   efl_event_callback_add(widget, &ELM_CODE_EVENT_LINE_LOAD_DONE, _edi_problemspanel_line_cb, NULL);
+   efl_event_callback_add(widget, ELM_OBJ_CODE_WIDGET_EVENT_LINE_CLICKED, _edi_problemspanel_clicked_cb, NULL);
+
+   evas_object_size_hint_weight_set(widget, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(widget);
+
+   elm_object_content_set(frame, widget);
+   elm_box_pack_end(parent, frame);
+}
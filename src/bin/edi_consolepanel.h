@@ -54,6 +54,29 @@ void edi_testpanel_add(Evas_Object *parent);
  */
 void edi_testpanel_show();
 
+/**
+ * Clear the results from the Edi testpanel.
+ *
+ * @ingroup UI
+ */
+void edi_testpanel_clear();
+
+/**
+ * Initialise a new Edi problemspanel and add it to the parent panel.
+ *
+ * @param parent The panel into which the panel will be loaded.
+ *
+ * @ingroup UI
+ */
+void edi_problemspanel_add(Evas_Object *parent);
+
+/**
+ * Show the Edi problemspanel - animating on to screen if required.
+ *
+ * @ingroup UI
+ */
+void edi_problemspanel_show();
+
 /**
  * @}
  */
@@ -84,6 +107,36 @@ void edi_consolepanel_append_line(const char *line);
  */
 void edi_consolepanel_append_error_line(const char *line);
 
+/**
+ * Append a line of build output run outside of this process.
+ *
+ * The line is scanned for problems and test results like the output of
+ * the commands edi runs itself.
+ *
+ * @param line The line of output.
+ * @param err Whether the line was written to standard error.
+ *
+ * @ingroup Console
+ */
+void edi_consolepanel_output_append(const char *line, Eina_Bool err);
+
+/**
+ * Finish the output added with edi_consolepanel_output_append.
+ *
+ * @ingroup Console
+ */
+void edi_consolepanel_output_end(void);
+
+/**
+ * Get the diagnostics the current build reported for a file.
+ *
+ * @param path The absolute path of the file.
+ * @return The list of Edi_Diagnostic for the file, or NULL.
+ *
+ * @ingroup Console
+ */
+const Eina_List *edi_problemspanel_diagnostics_get(const char *path);
+
 /**
  * Clear all lines from the console.
  *
@@ -25,11 +25,12 @@ typedef struct _Edi_Dir_Data
    const char *path;
    Eio_Monitor *monitor;
    Eina_Bool isdir;
+   Edi_Scm_Status_Code scm_status;
 } Edi_Dir_Data;
 
 static Elm_Genlist_Item_Class itc, itc2;
 static Evas_Object *list;
-static Eina_Hash *_list_items, *_list_statuses, *mime_entries = NULL;
+static Eina_Hash *_list_items, *mime_entries = NULL;
 static edi_filepanel_item_clicked_cb _open_cb;
 
 static Evas_Object *menu, *_main_win, *_filepanel_box, *_filter_box, *_filter, *_list;
@@ -106,40 +107,6 @@ _icon_status(Edi_Scm_Status_Code code, Eina_Bool *staged)
    return NULL;
 }
 
-static Edi_Scm_Status_Code *
-_file_status_item_find(const char *path)
-{
-   return eina_hash_find(_list_statuses, path);
-}
-
-static void
-_file_status_item_delete(const char *path)
-{
-   Edi_Scm_Status_Code *code;
-
-   code = _file_status_item_find(path);
-   if (!code)
-     return;
-
-   eina_hash_del(_list_statuses, path, NULL);
-}
-
-static void
-_file_status_item_add(const char *path, Edi_Scm_Status_Code status)
-{
-   Edi_Scm_Status_Code *code;
-
-   code = _file_status_item_find(path);
-   if (code)
-     _file_status_item_delete(path);
-
-   code = malloc(sizeof(Edi_Scm_Status_Code));
-
-   *code = status;
-
-   eina_hash_add(_list_statuses, path, code);
-}
-
 typedef enum {
    EDI_FILE_STATUS_UNMODIFIED,
    EDI_FILE_STATUS_STAGED,
@@ -147,18 +114,15 @@ typedef enum {
 } Edi_File_Status;
 
 static Edi_File_Status
-_edi_filepanel_file_scm_status(const char *path)
+_edi_filepanel_file_scm_status(Edi_Dir_Data *sd)
 {
-   Edi_Scm_Status_Code *code;
-   char *escaped = ecore_file_escape_name(path);
-
-   code = _file_status_item_find(escaped);
-   free(escaped);
+   Edi_Scm_Status_Code code;
 
-   if (!code) return EDI_FILE_STATUS_UNMODIFIED;
+   code = sd->scm_status;
+   if (code == EDI_SCM_STATUS_NONE) return EDI_FILE_STATUS_UNMODIFIED;
 
-   if (*code == EDI_SCM_STATUS_RENAMED_STAGED || *code == EDI_SCM_STATUS_DELETED_STAGED ||
-       *code == EDI_SCM_STATUS_ADDED_STAGED || *code == EDI_SCM_STATUS_MODIFIED_STAGED)
+   if (code == EDI_SCM_STATUS_RENAMED_STAGED || code == EDI_SCM_STATUS_DELETED_STAGED ||
+       code == EDI_SCM_STATUS_ADDED_STAGED || code == EDI_SCM_STATUS_MODIFIED_STAGED)
      return EDI_FILE_STATUS_STAGED;
 
    return EDI_FILE_STATUS_UNSTAGED;
@@ -175,50 +139,80 @@ void edi_filepanel_item_update(const char *path)
 
 void edi_filepanel_item_update_all(void)
 {
-  elm_genlist_realized_items_update(_list);
+   Eina_List *items, *l;
+   Elm_Object_Item *item;
+   Edi_Dir_Data *sd;
+   Edi_Scm_Status_Code *codes;
+   const char **paths;
+   unsigned int i, count;
+
+   // Look up every visible item against the same snapshot at once.
+   items = elm_genlist_realized_items_get(_list);
+   count = eina_list_count(items);
+   if (count)
+     {
+        paths = malloc(count * sizeof(const char *));
+        codes = malloc(count * sizeof(Edi_Scm_Status_Code));
+
+        i = 0;
+        EINA_LIST_FOREACH(items, l, item)
+          {
+             sd = elm_object_item_data_get(item);
+             paths[i++] = sd->path;
+          }
+        edi_scm_status_cache_paths_find(paths, count, codes);
+
+        i = 0;
+        EINA_LIST_FOREACH(items, l, item)
+          {
+             sd = elm_object_item_data_get(item);
+             sd->scm_status = codes[i++];
+          }
+
+        free(paths);
+        free(codes);
+     }
+   eina_list_free(items);
+
+   elm_genlist_realized_items_update(_list);
 }
 
-static void _list_status_free_cb(void *data)
+static void
+_edi_filepanel_scm_status_changed_cb(void *data EINA_UNUSED, const char *path,
+                                     Edi_Scm_Status_Code code)
 {
-   Edi_Scm_Status_Code *code = data;
-   free(code);
+   Elm_Object_Item *item;
+   Edi_Dir_Data *sd;
+
+   item = _file_listing_item_find(path);
+   if (!item)
+     return;
+
+   sd = elm_object_item_data_get(item);
+   sd->scm_status = code;
+   elm_genlist_item_update(item);
 }
 
-static void _edi_filepanel_scm_status_reset(void)
+static void
+_edi_filepanel_scm_status_updated_cb(void *data EINA_UNUSED)
 {
-   eina_hash_free_buckets(_list_statuses);
+   edi_scm_status_cache_changed_foreach(_edi_filepanel_scm_status_changed_cb, NULL);
 }
 
 void
 edi_filepanel_scm_status_update(void)
 {
-   Edi_Scm_Engine *e;
-   Edi_Scm_Status *status;
-
-   _edi_filepanel_scm_status_reset();
-
-   e = edi_scm_engine_get();
-   if (!e)
+   if (!edi_scm_engine_get())
      return;
 
-   if (edi_scm_status_get())
-     {
-        EINA_LIST_FREE(e->statuses, status)
-          {
-             _file_status_item_add(status->fullpath, status->change);
-             eina_stringshare_del(status->path);
-             eina_stringshare_del(status->fullpath);
-             eina_stringshare_del(status->unescaped);
-             free(status);
-          }
-        eina_list_free(e->statuses);
-        e->statuses = NULL;
-     }
+   edi_scm_status_cache_check();
 }
 
 void edi_filepanel_status_refresh(void)
 {
-   edi_filepanel_scm_status_update();
+   if (edi_scm_engine_get())
+     edi_scm_status_cache_invalidate();
+
    edi_filepanel_item_update_all();
 }
 
@@ -476,7 +470,7 @@ _item_menu_create(Evas_Object *win, Edi_Dir_Data *sd)
 
    if (edi_scm_enabled())
      {
-        status = _edi_filepanel_file_scm_status(sd->path);
+        status = _edi_filepanel_file_scm_status(sd);
 
         menu_it = elm_menu_item_add(menu, NULL, NULL, eina_slstr_printf("%s...", _("Source Control")), NULL, NULL);
 
@@ -655,8 +649,6 @@ _content_get(void *data, Evas_Object *obj, const char *source)
    Edi_Content_Provider *provider;
    Edi_Dir_Data *sd = data;
    Evas_Object *box, *lbox, *mbox, *rbox, *label, *ic;
-   Edi_Scm_Status_Code *code;
-   char *escaped;
    const char *icon_name, *icon_status;
    Eina_Bool staged = EINA_FALSE;
 
@@ -664,12 +656,7 @@ _content_get(void *data, Evas_Object *obj, const char *source)
      return NULL;
 
    icon_name = icon_status = NULL;
-   escaped = ecore_file_escape_name(sd->path);
-   code = _file_status_item_find(escaped);
-   if (code)
-     icon_status = _icon_status(*code, &staged);
-
-   free(escaped);
+   icon_status = _icon_status(sd->scm_status, &staged);
 
    provider = _get_provider_from_hashset(sd->path);
    if (provider)
@@ -733,7 +720,7 @@ _content_get(void *data, Evas_Object *obj, const char *source)
              evas_object_show(ic);
              elm_box_pack_end(rbox, ic);
 
-             if (*code != EDI_SCM_STATUS_UNTRACKED)
+             if (sd->scm_status != EDI_SCM_STATUS_UNTRACKED)
                elm_object_tooltip_text_set(box, _("Unstaged changes"));
              else
                elm_object_tooltip_text_set(box, _("Untracked changes"));
@@ -933,6 +920,23 @@ static void
 _ls_done_cb(void *data, Eio_File *handler EINA_UNUSED)
 {
    Listing_Request *lreq = data;
+   const Eina_List *l;
+   Elm_Object_Item *subit;
+   Edi_Dir_Data *sd;
+
+   // Git reports an untracked directory as a whole, otherwise only the
+   // changed files in it need a status.
+   if (lreq->parent_it && edi_scm_status_cache_find(lreq->path) == EDI_SCM_STATUS_UNTRACKED)
+     {
+        EINA_LIST_FOREACH(elm_genlist_item_subitems_get(lreq->parent_it), l, subit)
+          {
+             sd = elm_object_item_data_get(subit);
+             sd->scm_status = EDI_SCM_STATUS_UNTRACKED;
+             elm_genlist_item_update(subit);
+          }
+     }
+   else
+     edi_scm_status_cache_dir_foreach(lreq->path, _edi_filepanel_scm_status_changed_cb, NULL);
 
    edi_filepanel_scm_status_update();
    _listing_request_cleanup(lreq);
@@ -1012,8 +1016,9 @@ _file_listing_updated(void *data EINA_UNUSED, int type EINA_UNUSED,
 
    if (ecore_file_file_get(ev->filename)[0] == '.') return;
 
-   edi_filepanel_scm_status_update();
-   edi_filepanel_item_update(ev->filename);
+   if (edi_scm_engine_get())
+     edi_scm_status_cache_invalidate();
+   _edi_filepanel_scm_status_changed_cb(NULL, ev->filename, edi_scm_status_cache_find(ev->filename));
 }
 
 /* Panel filtering */
@@ -1238,9 +1243,8 @@ edi_filepanel_add(Evas_Object *parent, Evas_Object *win,
    _main_win = win;
 
    _list_items = eina_hash_string_superfast_new(NULL);
-   _list_statuses = eina_hash_string_superfast_new(NULL);
-   eina_hash_free_cb_set(_list_statuses, _list_status_free_cb);
 
+   edi_scm_status_cache_callback_set(_edi_filepanel_scm_status_updated_cb, NULL);
    edi_filepanel_scm_status_update();
 
    ecore_timer_add(0.1, _edi_filepanel_select_check, NULL);
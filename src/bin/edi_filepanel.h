@@ -73,7 +73,7 @@ void edi_filepanel_search();
 void edi_filepanel_status_refresh(void);
 
 /**
- * Update the cache of scm statuses in memory.
+ * Check the cache of scm statuses, it is refreshed in the background if out of date.
  *
  * @ingroup UI
  */
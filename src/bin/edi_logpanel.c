@@ -7,6 +7,7 @@
 #include <Elementary.h>
 
 #include "edi_logpanel.h"
+#include "edi_console_buffer.h"
 #include "edi_theme.h"
 #include "edi_config.h"
 
@@ -15,7 +16,7 @@
 #define _EDI_LOG_ERROR "err"
 
 static Evas_Object *_info_widget;
-static Elm_Code *_elm_code;
+static Edi_Console_Buffer *_edi_logpanel_buffer;
 
 static Eina_Bool
 _edi_logpanel_ignore(Eina_Log_Level level, const char *domain, const char *fnc)
@@ -53,8 +54,8 @@ _edi_logpanel_print_cb(const Eina_Log_Domain *domain, Eina_Log_Level level,
 
    ecore_thread_main_loop_begin();
 
-   elm_code_file_line_append(_elm_code->file, buffer, strlen(buffer),
-                             (level <= EINA_LOG_LEVEL_ERR) ? _EDI_LOG_ERROR : NULL);
+   edi_console_buffer_line_append(_edi_logpanel_buffer, buffer, strlen(buffer),
+                                  (level <= EINA_LOG_LEVEL_ERR) ? _EDI_LOG_ERROR : NULL);
    ecore_thread_main_loop_end();
 }
 
@@ -80,7 +81,7 @@ _edi_logpanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, void
 
 void edi_logpanel_add(Evas_Object *parent)
 {
-   Evas_Object *frame;
+   Evas_Object *frame, *view;
    Elm_Code_Widget *widget;
    Elm_Code *code;
 
@@ -100,13 +101,14 @@ void edi_logpanel_add(Evas_Object *parent)
    evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(widget);
 
-   _elm_code = code;
+   _edi_logpanel_buffer = edi_console_buffer_add(code);
    _info_widget = widget;
 
    eina_log_print_cb_set(_edi_logpanel_print_cb, NULL);
    eina_log_color_disable_set(EINA_TRUE);
 
-   elm_object_content_set(frame, widget);
+   view = edi_console_buffer_view_add(_edi_logpanel_buffer, frame, widget);
+   elm_object_content_set(frame, view);
    elm_box_pack_end(parent, frame);
    ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_logpanel_config_changed, NULL);
 }
@@ -20,6 +20,7 @@
 #include "edi_consolepanel.h"
 #include "edi_searchpanel.h"
 #include "edi_debugpanel.h"
+#include "edi_timingpanel.h"
 #include "edi_content_provider.h"
 #include "mainview/edi_mainview.h"
 #include "screens/edi_screens.h"
@@ -46,16 +47,23 @@ typedef struct _Edi_Panel_Slide_Effect
 #define COPYRIGHT "Copyright © 2014-2017 Andy Williams <andy@andyilliams.me> and various contributors (see AUTHORS)."
 
 static Evas_Object *_edi_toolbar, *_edi_leftpanes, *_edi_bottompanes;
-static Evas_Object *_edi_logpanel, *_edi_consolepanel, *_edi_testpanel, *_edi_searchpanel, *_edi_taskspanel, *_edi_debugpanel;
-static Elm_Object_Item *_edi_logpanel_item, *_edi_consolepanel_item, *_edi_testpanel_item, *_edi_searchpanel_item, *_edi_taskspanel_item, *_edi_debugpanel_item;
+static Evas_Object *_edi_logpanel, *_edi_consolepanel, *_edi_testpanel, *_edi_searchpanel, *_edi_taskspanel, *_edi_debugpanel, *_edi_problemspanel, *_edi_timingpanel;
+static Elm_Object_Item *_edi_logpanel_item, *_edi_consolepanel_item, *_edi_testpanel_item, *_edi_searchpanel_item, *_edi_taskspanel_item, *_edi_debugpanel_item, *_edi_problemspanel_item, *_edi_timingpanel_item;
 static Elm_Object_Item *_edi_selected_bottompanel;
 static Evas_Object *_edi_filepanel, *_edi_filepanel_icon;
 
-static Evas_Object *_edi_menu_undo, *_edi_menu_redo, *_edi_toolbar_undo, *_edi_toolbar_redo, *_edi_toolbar_build, *_edi_toolbar_test;
-static Evas_Object *_edi_menu_build, *_edi_menu_clean, *_edi_menu_test;
+static Evas_Object *_edi_menu_undo, *_edi_menu_redo, *_edi_toolbar_undo, *_edi_toolbar_redo, *_edi_toolbar_build_stop;
+static Evas_Object *_edi_menu_build_stop, *_edi_menu_test_failed;
 static Evas_Object *_edi_menu_init, *_edi_menu_commit, *_edi_menu_push, *_edi_menu_pull, *_edi_menu_status, *_edi_menu_stash;
+static Evas_Object *_edi_menu_scm_stop;
+static Edi_Scm_Job *_edi_scm_job = NULL;
+static Eina_Stringshare *_edi_scm_job_stage = NULL;
+static int _edi_scm_job_step = -1;
 static Evas_Object *_edi_menu_save, *_edi_toolbar_save;
 static Evas_Object *_edi_main_win, *_edi_main_box;
+static Eina_Bool _edi_build_remote = EINA_FALSE;
+static unsigned int _edi_build_remote_count = 0;
+static Eina_Bool _edi_build_remote_failed = EINA_FALSE;
 int _edi_log_dom = -1;
 
 
@@ -101,6 +109,10 @@ _edi_panel_tab_for_index(int index)
      return _edi_taskspanel;
    if (index == 5)
      return _edi_debugpanel;
+   if (index == 6)
+     return _edi_problemspanel;
+   if (index == 7)
+     return _edi_timingpanel;
 
    return _edi_logpanel;
 }
@@ -245,7 +257,7 @@ _edi_toggle_panel(void *data, Evas_Object *obj, void *event_info)
    if (obj)
      elm_object_focus_set(obj, EINA_FALSE);
 
-   for (c = 0; c <= 5; c++)
+   for (c = 0; c <= 7; c++)
      if (c != index)
        evas_object_hide(_edi_panel_tab_for_index(c));
 
@@ -288,6 +300,20 @@ edi_consolepanel_show()
      elm_toolbar_item_selected_set(_edi_consolepanel_item, EINA_TRUE);
 }
 
+void
+edi_problemspanel_show()
+{
+   if (_edi_selected_bottompanel != _edi_problemspanel_item)
+     elm_toolbar_item_selected_set(_edi_problemspanel_item, EINA_TRUE);
+}
+
+void
+edi_timingpanel_show()
+{
+   if (_edi_selected_bottompanel != _edi_timingpanel_item)
+     elm_toolbar_item_selected_set(_edi_timingpanel_item, EINA_TRUE);
+}
+
 void
 edi_testpanel_show()
 {
@@ -345,6 +371,8 @@ edi_content_setup(Evas_Object *win, const char *path)
    _edi_searchpanel = elm_box_add(win);
    _edi_taskspanel = elm_box_add(win);
    _edi_debugpanel = elm_box_add(win);
+   _edi_problemspanel = elm_box_add(win);
+   _edi_timingpanel = elm_box_add(win);
 
    // add main content
    content_out = elm_box_add(win);
@@ -425,6 +453,14 @@ edi_content_setup(Evas_Object *win, const char *path)
                                                     _edi_toggle_panel, "1");
    _edi_toolbar_separator_add(tb);
 
+   _edi_problemspanel_item = elm_toolbar_item_append(tb, "go-up", _("Problems"),
+                                                     _edi_toggle_panel, "6");
+   _edi_toolbar_separator_add(tb);
+
+   _edi_timingpanel_item = elm_toolbar_item_append(tb, "go-up", _("Build times"),
+                                                   _edi_toggle_panel, "7");
+   _edi_toolbar_separator_add(tb);
+
    _edi_testpanel_item = elm_toolbar_item_append(tb, "go-up", _("Tests"),
                                                  _edi_toggle_panel, "2");
    _edi_toolbar_separator_add(tb);
@@ -455,6 +491,18 @@ edi_content_setup(Evas_Object *win, const char *path)
    edi_consolepanel_add(_edi_consolepanel);
    elm_table_pack(logpanels, _edi_consolepanel, 0, 0, 1, 1);
 
+   evas_object_size_hint_weight_set(_edi_problemspanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(_edi_problemspanel, EVAS_HINT_FILL, EVAS_HINT_FILL);
+
+   edi_problemspanel_add(_edi_problemspanel);
+   elm_table_pack(logpanels, _edi_problemspanel, 0, 0, 1, 1);
+
+   evas_object_size_hint_weight_set(_edi_timingpanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(_edi_timingpanel, EVAS_HINT_FILL, EVAS_HINT_FILL);
+
+   edi_timingpanel_add(_edi_timingpanel);
+   elm_table_pack(logpanels, _edi_timingpanel, 0, 0, 1, 1);
+
    evas_object_size_hint_weight_set(_edi_testpanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(_edi_testpanel, EVAS_HINT_FILL, EVAS_HINT_FILL);
 
@@ -509,6 +557,16 @@ edi_content_setup(Evas_Object *win, const char *path)
              elm_toolbar_item_icon_set(_edi_debugpanel_item, "go-down");
              _edi_selected_bottompanel = _edi_debugpanel_item;
           }
+        else if (_edi_project_config->gui.bottomtab == 6)
+          {
+             elm_toolbar_item_icon_set(_edi_problemspanel_item, "go-down");
+             _edi_selected_bottompanel = _edi_problemspanel_item;
+          }
+        else if (_edi_project_config->gui.bottomtab == 7)
+          {
+             elm_toolbar_item_icon_set(_edi_timingpanel_item, "go-down");
+             _edi_selected_bottompanel = _edi_timingpanel_item;
+          }
         else
           {
              elm_toolbar_item_icon_set(_edi_logpanel_item, "go-down");
@@ -548,8 +606,9 @@ _edi_icon_update()
    elm_object_disabled_set(_edi_toolbar_redo, !can_redo);
 
    elm_object_item_disabled_set(_edi_menu_init, can_scm);
-   elm_object_item_disabled_set(_edi_menu_push, !can_remote);
-   elm_object_item_disabled_set(_edi_menu_pull, !can_remote);
+   elm_object_item_disabled_set(_edi_menu_push, !can_remote || _edi_scm_job);
+   elm_object_item_disabled_set(_edi_menu_pull, !can_remote || _edi_scm_job);
+   elm_object_item_disabled_set(_edi_menu_scm_stop, !_edi_scm_job);
    elm_object_item_disabled_set(_edi_menu_status, !can_scm);
    elm_object_item_disabled_set(_edi_menu_commit, !can_scm);
    elm_object_item_disabled_set(_edi_menu_stash, !can_scm);
@@ -688,12 +747,31 @@ _tb_goto_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUS
    edi_mainview_goto_popup_show();
 }
 
+// A job of this project is running, here or in the build server that serves it.
+static Eina_Bool
+_edi_build_running_is(void)
+{
+   return edi_build_queue_running_get() || _edi_build_remote_count;
+}
+
+// The build server keeps the failed tests of the jobs it ran, we only know whether ours failed.
+static Eina_Bool
+_edi_build_tests_failed_is(void)
+{
+   if (_edi_build_remote)
+     return _edi_build_remote_failed;
+
+   return edi_test_runner_failed_count() > 0;
+}
+
 static Eina_Bool
 _edi_build_prep(Evas_Object *button)
 {
    elm_toolbar_item_selected_set(elm_toolbar_selected_item_get(button), EINA_FALSE);
 
-   edi_consolepanel_clear();
+   // A running job keeps its output, the new one is queued behind it.
+   if (!_edi_build_running_is())
+     edi_consolepanel_clear();
    edi_consolepanel_show();
 
    if (!edi_builder_can_build())
@@ -717,16 +795,6 @@ _edi_launcher_run(Edi_Project_Config_Launch *launch)
    edi_builder_run(launch->path, launch->args);
 }
 
-static void
-_edi_build_menu_items_disabled_set(Eina_Bool state)
-{
-   elm_object_disabled_set(_edi_toolbar_build, state);
-   elm_object_disabled_set(_edi_toolbar_test, state);
-   elm_object_item_disabled_set(_edi_menu_build, state);
-   elm_object_item_disabled_set(_edi_menu_test, state);
-   elm_object_item_disabled_set(_edi_menu_clean, state);
-}
-
 static void
 _edi_build_display_status_cb(int status, void *data)
 {
@@ -745,11 +813,196 @@ _edi_build_display_status_cb(int status, void *data)
 
    edi_screens_desktop_notify(eina_strbuf_string_get(title), eina_strbuf_string_get(message));
 
-   _edi_build_menu_items_disabled_set(EINA_FALSE);
    eina_strbuf_free(title);
    eina_strbuf_free(message);
 }
 
+static const char *
+_edi_build_job_type_name_get(Edi_Build_Job_Type type)
+{
+   switch (type)
+     {
+      case EDI_BUILD_JOB_TEST:
+      case EDI_BUILD_JOB_TEST_FAILED:
+      case EDI_BUILD_JOB_TEST_AFFECTED:
+        return _("Test");
+      case EDI_BUILD_JOB_CLEAN:
+        return _("Clean");
+      case EDI_BUILD_JOB_COMPILE_FILE:
+        return _("Compile");
+      default:
+        return _("Build");
+     }
+}
+
+static Eina_Bool
+_edi_build_job_type_test_is(Edi_Build_Job_Type type)
+{
+   return type == EDI_BUILD_JOB_TEST || type == EDI_BUILD_JOB_TEST_FAILED ||
+          type == EDI_BUILD_JOB_TEST_AFFECTED;
+}
+
+static const char *
+_edi_build_job_name_get(const Edi_Build_Job *job)
+{
+   return _edi_build_job_type_name_get(job->type);
+}
+
+static void
+_edi_build_queue_started_cb(void *data EINA_UNUSED, const Edi_Build_Job *job)
+{
+   edi_consolepanel_show();
+
+   if (job->type == EDI_BUILD_JOB_BUILD || job->type == EDI_BUILD_JOB_COMPILE_FILE)
+     edi_build_cache_stats_begin();
+
+   if (job->type == EDI_BUILD_JOB_BUILD)
+     edi_timingpanel_build_begin();
+   else if (_edi_build_job_type_test_is(job->type))
+     edi_testpanel_clear();
+}
+
+static void
+_edi_build_cache_report_cb(void *data EINA_UNUSED, const Edi_Build_Cache_Stats *stats)
+{
+   unsigned long total;
+
+   if (!stats)
+     return;
+
+   total = stats->hits + stats->misses;
+   if (!total)
+     return;
+
+   edi_consolepanel_append_line(eina_slstr_printf(_("Compiler cache: %lu hits, %lu misses (%.0f%% hit rate)"),
+                                                  stats->hits, stats->misses, stats->hits * 100.0 / total));
+}
+
+static void
+_edi_build_queue_done_cb(void *data EINA_UNUSED, const Edi_Build_Job *job, int status)
+{
+   const char *name;
+
+   name = _edi_build_job_name_get(job);
+   if (job->cancelled)
+     {
+        edi_consolepanel_append_error_line(eina_slstr_printf(_("%s was cancelled."), name));
+        return;
+     }
+
+   if (job->type == EDI_BUILD_JOB_BUILD)
+     edi_timingpanel_build_end();
+   if (job->type == EDI_BUILD_JOB_BUILD || job->type == EDI_BUILD_JOB_COMPILE_FILE)
+     edi_build_cache_stats_end(_edi_build_cache_report_cb, NULL);
+
+   _edi_build_display_status_cb(status, (void *) name);
+}
+
+static void
+_edi_build_queue_changed_cb(void *data EINA_UNUSED)
+{
+   const Edi_Build_Job *job;
+   unsigned int pending;
+   const char *tooltip;
+
+   job = edi_build_queue_running_get();
+   pending = edi_build_queue_pending_count();
+
+   elm_object_disabled_set(_edi_toolbar_build_stop, !_edi_build_running_is());
+   elm_object_item_disabled_set(_edi_menu_build_stop, !_edi_build_running_is());
+   elm_object_item_disabled_set(_edi_menu_test_failed, !_edi_build_tests_failed_is());
+
+   if (!job)
+     tooltip = _("Stop");
+   else if (!pending)
+     tooltip = eina_slstr_printf(_("Stop %s"), _edi_build_job_name_get(job));
+   else
+     tooltip = eina_slstr_printf(_("Stop %s and %u queued"), _edi_build_job_name_get(job), pending);
+
+   elm_object_tooltip_text_set(_edi_toolbar_build_stop, tooltip);
+}
+
+typedef struct _Edi_Build_Remote_Job
+{
+   Edi_Build_Job_Type type;
+   const char *path;
+} Edi_Build_Remote_Job;
+
+static void
+_edi_build_remote_output_cb(void *data EINA_UNUSED, const char *line, Eina_Bool err)
+{
+   edi_consolepanel_output_append(line, err);
+}
+
+static void
+_edi_build_remote_done_cb(void *data, Eina_Bool reached, int status)
+{
+   Edi_Build_Remote_Job *remote = data;
+   const char *name;
+
+   _edi_build_remote_count--;
+   name = _edi_build_job_type_name_get(remote->type);
+   edi_consolepanel_output_end();
+
+   // The server went away, this process serves the project from now on.
+   if (!reached)
+     {
+        _edi_build_remote = !edi_build_server_start();
+        edi_build_queue_add(remote->type, remote->path);
+     }
+   else if (status == -1)
+     edi_consolepanel_append_error_line(eina_slstr_printf(_("%s was cancelled."), name));
+   else
+     {
+        // Compiler cache statistics are only reported by the process that ran the build.
+        if (remote->type == EDI_BUILD_JOB_BUILD)
+          edi_timingpanel_build_remote_end();
+        if (_edi_build_job_type_test_is(remote->type))
+          _edi_build_remote_failed = status != 0;
+        _edi_build_display_status_cb(status, (void *) name);
+     }
+
+   eina_stringshare_del(remote->path);
+   free(remote);
+   _edi_build_queue_changed_cb(NULL);
+}
+
+// Another process serving the project runs our jobs too, in its queue,
+// so the same tree is never built twice at once.
+static void
+_edi_build_job_add(Edi_Build_Job_Type type, const char *path)
+{
+   Edi_Build_Remote_Job *remote;
+
+   if (!_edi_build_remote)
+     {
+        edi_build_queue_add(type, path);
+        return;
+     }
+
+   edi_consolepanel_show();
+   if (_edi_build_job_type_test_is(type))
+     edi_testpanel_clear();
+
+   remote = calloc(1, sizeof(Edi_Build_Remote_Job));
+   remote->type = type;
+   remote->path = eina_stringshare_add(path);
+   _edi_build_remote_count++;
+   _edi_build_queue_changed_cb(NULL);
+
+   edi_build_server_submit(edi_build_server_request_get(type, path), _edi_build_remote_output_cb,
+                           _edi_build_remote_done_cb, remote);
+}
+
+static void
+_edi_build_cancel(void)
+{
+   if (_edi_build_remote_count)
+     edi_build_server_submit("stop", NULL, NULL, NULL);
+
+   edi_build_queue_cancel();
+}
+
 static void
 _edi_debug_project(void)
 {
@@ -762,12 +1015,32 @@ _edi_build_project(void)
    if (!edi_build_provider_for_project_get())
      return;
 
-   if (edi_exe_notify_handle("edi_build", _edi_build_display_status_cb, _("Build")))
+   _edi_build_job_add(EDI_BUILD_JOB_BUILD, NULL);
+}
+
+static void
+_edi_build_compile_file(void)
+{
+   Edi_Mainview_Item *item;
+
+   item = edi_mainview_item_current_get();
+   if (!item)
+     return;
+
+   if (!_edi_build_running_is())
+     edi_consolepanel_clear();
+   edi_consolepanel_show();
+
+   if (!edi_builder_can_compile_file(item->path))
      {
-        _edi_build_menu_items_disabled_set(EINA_TRUE);
-        edi_consolepanel_show();
-        edi_builder_build();
+        edi_consolepanel_append_error_line(_("The current file is not listed in the project's compile_commands.json."));
+        return;
      }
+
+   // The compiler reads the file from disk.
+   edi_mainview_save();
+
+   _edi_build_job_add(EDI_BUILD_JOB_COMPILE_FILE, item->path);
 }
 
 static void
@@ -776,12 +1049,7 @@ _edi_build_clean_project(void)
    if (!edi_build_provider_for_project_get())
      return;
 
-   if (edi_exe_notify_handle("edi_clean", _edi_build_display_status_cb, _("Clean")))
-     {
-        _edi_build_menu_items_disabled_set(EINA_TRUE);
-        edi_consolepanel_show();
-        edi_builder_clean();
-     }
+   _edi_build_job_add(EDI_BUILD_JOB_CLEAN, NULL);
 }
 
 static void
@@ -790,12 +1058,28 @@ _edi_build_test_project(void)
    if (!edi_build_provider_for_project_get())
      return;
 
-   if (edi_exe_notify_handle("edi_test", _edi_build_display_status_cb, _("Test")))
-     {
-        _edi_build_menu_items_disabled_set(EINA_TRUE);
-        edi_consolepanel_show();
-        edi_builder_test();
-     }
+   _edi_build_job_add(EDI_BUILD_JOB_TEST, NULL);
+}
+
+static void
+_edi_build_test_affected_project(void)
+{
+   if (!edi_build_provider_for_project_get())
+     return;
+
+   // Changes are found from what is on disk, in any of the open files.
+   edi_mainview_save_all();
+
+   _edi_build_job_add(EDI_BUILD_JOB_TEST_AFFECTED, NULL);
+}
+
+static void
+_edi_build_test_failed_project(void)
+{
+   if (!_edi_build_tests_failed_is())
+     return;
+
+   _edi_build_job_add(EDI_BUILD_JOB_TEST_FAILED, NULL);
 }
 
 static void
@@ -812,6 +1096,14 @@ _tb_test_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUS
      _edi_build_test_project();
 }
 
+static void
+_tb_build_stop_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   elm_toolbar_item_selected_set(elm_toolbar_selected_item_get(obj), EINA_FALSE);
+
+   _edi_build_cancel();
+}
+
 static void
 _tb_run_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
 {
@@ -1018,6 +1310,13 @@ _edi_menu_build_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    _edi_build_project();
 }
 
+static void
+_edi_menu_compile_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                     void *event_info EINA_UNUSED)
+{
+   _edi_build_compile_file();
+}
+
 static void
 _edi_menu_test_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                   void *event_info EINA_UNUSED)
@@ -1025,6 +1324,20 @@ _edi_menu_test_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    _edi_build_test_project();
 }
 
+static void
+_edi_menu_test_affected_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                           void *event_info EINA_UNUSED)
+{
+   _edi_build_test_affected_project();
+}
+
+static void
+_edi_menu_test_failed_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                         void *event_info EINA_UNUSED)
+{
+   _edi_build_test_failed_project();
+}
+
 static void
 _edi_menu_run_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                  void *event_info EINA_UNUSED)
@@ -1039,6 +1352,13 @@ _edi_menu_clean_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    _edi_build_clean_project();
 }
 
+static void
+_edi_menu_build_stop_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                        void *event_info EINA_UNUSED)
+{
+   _edi_build_cancel();
+}
+
 static void
 _edi_menu_memcheck_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                      void *event_info EINA_UNUSED)
@@ -1110,11 +1430,71 @@ _edi_menu_scm_commit_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    free(workdir);
 }
 
+
+static void
+_edi_scm_job_line_cb(void *data EINA_UNUSED, const char *line)
+{
+   edi_consolepanel_append_line(line);
+}
+
+static void
+_edi_scm_job_progress_cb(void *data EINA_UNUSED, const Edi_Scm_Job_Progress *progress)
+{
+   char *line;
+   int step;
+
+   // A line for every tenth keeps a slow transfer visibly moving without flooding the console.
+   step = progress->percent / 10;
+   if (step == _edi_scm_job_step && _edi_scm_job_stage && !strcmp(_edi_scm_job_stage, progress->stage))
+     return;
+
+   _edi_scm_job_step = step;
+   eina_stringshare_replace(&_edi_scm_job_stage, progress->stage);
+
+   if (progress->total)
+     line = eina_strdup_printf("%s: %3d%% (%lu/%lu)", progress->stage, progress->percent,
+                               progress->current, progress->total);
+   else
+     line = eina_strdup_printf("%s: %3d%%", progress->stage, progress->percent);
+
+   edi_consolepanel_append_line(line);
+   free(line);
+}
+
+static void
+_edi_scm_job_end_cb(void *data EINA_UNUSED, int status, Eina_Bool cancelled)
+{
+   _edi_scm_job = NULL;
+   _edi_scm_job_step = -1;
+   eina_stringshare_replace(&_edi_scm_job_stage, NULL);
+
+   if (cancelled)
+     edi_consolepanel_append_error_line(_("Source control operation cancelled."));
+   else if (status)
+     edi_consolepanel_append_error_line(_("Source control operation failed."));
+
+   edi_filepanel_scm_status_update();
+   _edi_icon_update();
+}
+
+static void
+_edi_scm_job_start(Edi_Scm_Job *(*start)(Edi_Scm_Job_Line_Cb, Edi_Scm_Job_Progress_Cb,
+                                         Edi_Scm_Job_End_Cb, const void *))
+{
+   if (_edi_scm_job)
+     return;
+
+   edi_consolepanel_clear();
+   edi_consolepanel_show();
+
+   _edi_scm_job = start(_edi_scm_job_line_cb, _edi_scm_job_progress_cb, _edi_scm_job_end_cb, NULL);
+   _edi_icon_update();
+}
+
 static void
 _edi_scm_stash_do_cb(void *data EINA_UNUSED)
 {
-   edi_scm_stash();
-   edi_filepanel_status_refresh();
+   _edi_scm_job_start(edi_scm_stash_job);
 }
 
 static void
@@ -1129,18 +1509,29 @@ static void
 _edi_menu_scm_status_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                         void *event_info EINA_UNUSED)
 {
+   if (_edi_scm_job)
+     return;
+
    edi_consolepanel_clear();
    edi_consolepanel_show();
-   edi_scm_status();
+
+   _edi_scm_job = edi_scm_status_job(_edi_scm_job_line_cb, _edi_scm_job_end_cb, NULL);
+   _edi_icon_update();
 }
 
 static void
 _edi_menu_scm_pull_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                         void *event_info EINA_UNUSED)
 {
-   edi_consolepanel_clear();
-   edi_consolepanel_show();
-   edi_scm_pull();
+   _edi_scm_job_start(edi_scm_pull_job);
+}
+
+static void
+_edi_menu_scm_stop_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                        void *event_info EINA_UNUSED)
+{
+   if (_edi_scm_job)
+     edi_scm_job_cancel(_edi_scm_job);
 }
 
 static void
@@ -1153,9 +1544,7 @@ _edi_menu_scm_push_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
         return;
      }
 
-   edi_consolepanel_clear();
-   edi_consolepanel_show();
-   edi_scm_push();
+   _edi_scm_job_start(edi_scm_push_job);
 }
 
 static void
@@ -1220,10 +1609,14 @@ _edi_menu_setup(Evas_Object *win)
    elm_menu_item_add(menu, menu_it, "edit-find", _("Open Tasks"), _edi_menu_view_tasks_cb, NULL);
 
    menu_it = elm_menu_item_add(menu, NULL, NULL, _("Build"), NULL, NULL);
-   _edi_menu_build = elm_menu_item_add(menu, menu_it, "system-run", _("Build"), _edi_menu_build_cb, NULL);
-   _edi_menu_test = elm_menu_item_add(menu, menu_it, "media-record", _("Test"), _edi_menu_test_cb, NULL);
+   elm_menu_item_add(menu, menu_it, "system-run", _("Build"), _edi_menu_build_cb, NULL);
+   elm_menu_item_add(menu, menu_it, "system-run", _("Compile File"), _edi_menu_compile_cb, NULL);
+   elm_menu_item_add(menu, menu_it, "media-record", _("Test"), _edi_menu_test_cb, NULL);
+   elm_menu_item_add(menu, menu_it, "media-record", _("Test Changes"), _edi_menu_test_affected_cb, NULL);
+   _edi_menu_test_failed = elm_menu_item_add(menu, menu_it, "view-refresh", _("Rerun Failed Tests"), _edi_menu_test_failed_cb, NULL);
    elm_menu_item_add(menu, menu_it, "media-playback-start", _("Run"), _edi_menu_run_cb, NULL);
-   _edi_menu_clean = elm_menu_item_add(menu, menu_it, "edit-clear", _("Clean"), _edi_menu_clean_cb, NULL);
+   elm_menu_item_add(menu, menu_it, "edit-clear", _("Clean"), _edi_menu_clean_cb, NULL);
+   _edi_menu_build_stop = elm_menu_item_add(menu, menu_it, "process-stop", _("Stop"), _edi_menu_build_stop_cb, NULL);
    elm_menu_item_separator_add(menu, menu_it);
    elm_menu_item_add(menu, menu_it, "utilities-terminal", _("Debugger"), _edi_menu_debug_cb, NULL);
    elm_menu_item_add(menu, menu_it, "applications-electronics", _("Memcheck"), _edi_menu_memcheck_cb, NULL);
@@ -1235,6 +1628,7 @@ _edi_menu_setup(Evas_Object *win)
    _edi_menu_status = elm_menu_item_add(menu, menu_it, "dialog-error", _("Status"), _edi_menu_scm_status_cb, NULL);
    _edi_menu_push = elm_menu_item_add(menu, menu_it, "go-up", _("Push"), _edi_menu_scm_push_cb, NULL);
    _edi_menu_pull = elm_menu_item_add(menu, menu_it, "go-down", _("Pull"), _edi_menu_scm_pull_cb, NULL);
+   _edi_menu_scm_stop = elm_menu_item_add(menu, menu_it, "process-stop", _("Stop"), _edi_menu_scm_stop_cb, NULL);
 
 
    menu_it = elm_menu_item_add(menu, NULL, NULL, _("Help"), NULL, NULL);
@@ -1297,8 +1691,9 @@ edi_toolbar_setup(Evas_Object *parent)
    tb_it = elm_toolbar_item_append(tb, "separator", "", NULL, NULL);
    elm_toolbar_item_separator_set(tb_it, EINA_TRUE);
 
-   _edi_toolbar_build = _edi_toolbar_item_add(tb, "system-run", _("Build"), _tb_build_cb);
-   _edi_toolbar_test = _edi_toolbar_item_add(tb, "media-record", _("Test"), _tb_test_cb);
+   _edi_toolbar_item_add(tb, "system-run", _("Build"), _tb_build_cb);
+   _edi_toolbar_item_add(tb, "media-record", _("Test"), _tb_test_cb);
+   _edi_toolbar_build_stop = _edi_toolbar_item_add(tb, "process-stop", _("Stop"), _tb_build_stop_cb);
    _edi_toolbar_item_add(tb, "media-playback-start", _("Run"), _tb_run_cb);
    _edi_toolbar_item_add(tb, "utilities-terminal", _("Debug"), _tb_debug_cb);
 
@@ -1536,6 +1931,13 @@ edi_open(const char *inputpath)
 
    _edi_menu_setup(win);
 
+   edi_build_queue_callbacks_set(_edi_build_queue_started_cb, _edi_build_queue_done_cb,
+                                 _edi_build_queue_changed_cb, NULL);
+   // Builds asked for by edi_build run in this queue while the project is open,
+   // unless another process already serves the project and runs ours as well.
+   _edi_build_remote = !edi_build_server_start();
+   _edi_build_queue_changed_cb(NULL);
+
    content = edi_content_setup(vbx, path);
    evas_object_size_hint_weight_set(content, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(content, EVAS_HINT_FILL, EVAS_HINT_FILL);
@@ -0,0 +1,252 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Elementary.h>
+
+#include "Edi.h"
+#include "edi_scm_avatar.h"
+#include "edi_private.h"
+
+#define EDI_SCM_AVATAR_DEFAULT_ICON "applications-development"
+
+typedef enum {
+   EDI_SCM_AVATAR_UNCHECKED,
+   EDI_SCM_AVATAR_DOWNLOADING,
+   EDI_SCM_AVATAR_ON_DISK,
+   EDI_SCM_AVATAR_DECODING,
+   EDI_SCM_AVATAR_DECODED,
+   EDI_SCM_AVATAR_MISSING,
+} Edi_Scm_Avatar_State;
+
+typedef struct _Edi_Scm_Avatar {
+   Eina_Stringshare *email;
+   Eina_Stringshare *path;
+   Edi_Scm_Avatar_State state;
+
+   Evas_Object *loader;
+   unsigned int *pixels;
+   int w, h;
+   Eina_Bool alpha;
+
+   Eina_List *views;
+} Edi_Scm_Avatar;
+
+// Every avatar asked for in this session, so the disk is only checked once per user.
+// The decoded pixels are shared by the views of the session, across sessions the
+// downloaded file is the cache.
+static Eina_Hash *_edi_scm_avatars = NULL;
+
+static void
+_edi_scm_avatar_view_update(Edi_Scm_Avatar *avatar, Evas_Object *view)
+{
+   Evas_Object *content;
+
+   elm_box_clear(view);
+
+   if (avatar && avatar->state == EDI_SCM_AVATAR_DECODED)
+     {
+        content = evas_object_image_filled_add(evas_object_evas_get(view));
+        evas_object_image_alpha_set(content, avatar->alpha);
+        evas_object_image_size_set(content, avatar->w, avatar->h);
+        evas_object_image_data_copy_set(content, avatar->pixels);
+        evas_object_image_data_update_add(content, 0, 0, avatar->w, avatar->h);
+     }
+   else
+     {
+        content = elm_icon_add(view);
+        elm_icon_standard_set(content, EDI_SCM_AVATAR_DEFAULT_ICON);
+     }
+
+   evas_object_size_hint_weight_set(content, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(content, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(content);
+   elm_box_pack_end(view, content);
+}
+
+static void
+_edi_scm_avatar_views_update(Edi_Scm_Avatar *avatar)
+{
+   Evas_Object *view;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(avatar->views, l, view)
+     _edi_scm_avatar_view_update(avatar, view);
+}
+
+static void
+_edi_scm_avatar_preloaded_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   Edi_Scm_Avatar *avatar = data;
+   unsigned char *pixels, *row;
+   int y, stride;
+
+   avatar->loader = NULL;
+   avatar->state = EDI_SCM_AVATAR_MISSING;
+
+   evas_object_image_size_get(obj, &avatar->w, &avatar->h);
+   pixels = evas_object_image_data_get(obj, EINA_FALSE);
+   if (pixels && avatar->w > 0 && avatar->h > 0)
+     {
+        stride = evas_object_image_stride_get(obj);
+        avatar->pixels = malloc(avatar->w * avatar->h * sizeof(unsigned int));
+        for (y = 0, row = pixels; y < avatar->h; y++, row += stride)
+          memcpy(avatar->pixels + y * avatar->w, row, avatar->w * sizeof(unsigned int));
+        evas_object_image_data_set(obj, pixels);
+
+        avatar->alpha = evas_object_image_alpha_get(obj);
+        avatar->state = EDI_SCM_AVATAR_DECODED;
+     }
+
+   evas_object_del(obj);
+
+   _edi_scm_avatar_views_update(avatar);
+}
+
+// Evas decodes the file in its own thread and tells us once the pixels are ready.
+static void
+_edi_scm_avatar_decode(Edi_Scm_Avatar *avatar, Evas *evas)
+{
+   Evas_Object *loader;
+
+   loader = evas_object_image_add(evas);
+   evas_object_image_file_set(loader, avatar->path, NULL);
+   if (evas_object_image_load_error_get(loader) != EVAS_LOAD_ERROR_NONE)
+     {
+        evas_object_del(loader);
+        ecore_file_remove(avatar->path);
+        avatar->state = EDI_SCM_AVATAR_MISSING;
+        _edi_scm_avatar_views_update(avatar);
+        return;
+     }
+
+   avatar->loader = loader;
+   avatar->state = EDI_SCM_AVATAR_DECODING;
+   evas_object_event_callback_add(loader, EVAS_CALLBACK_IMAGE_PRELOADED, _edi_scm_avatar_preloaded_cb, avatar);
+   evas_object_image_preload(loader, EINA_FALSE);
+}
+
+static void
+_edi_scm_avatar_downloaded_cb(void *data, const char *path EINA_UNUSED, Eina_Bool success)
+{
+   Edi_Scm_Avatar *avatar = data;
+   Evas_Object *view;
+
+   if (!success)
+     {
+        avatar->state = EDI_SCM_AVATAR_MISSING;
+        return;
+     }
+
+   avatar->state = EDI_SCM_AVATAR_ON_DISK;
+
+   view = eina_list_data_get(avatar->views);
+   if (view)
+     _edi_scm_avatar_decode(avatar, evas_object_evas_get(view));
+}
+
+static void
+_edi_scm_avatar_download(Edi_Scm_Avatar *avatar)
+{
+   if (edi_scm_avatar_download(edi_scm_avatar_url_get(avatar->email), avatar->path,
+                               _edi_scm_avatar_downloaded_cb, avatar))
+     avatar->state = EDI_SCM_AVATAR_DOWNLOADING;
+   else
+     avatar->state = EDI_SCM_AVATAR_MISSING;
+}
+
+static void
+_edi_scm_avatar_free(void *data)
+{
+   Edi_Scm_Avatar *avatar = data;
+   Evas_Object *view;
+
+   if (avatar->loader)
+     {
+        evas_object_event_callback_del_full(avatar->loader, EVAS_CALLBACK_IMAGE_PRELOADED,
+                                            _edi_scm_avatar_preloaded_cb, avatar);
+        evas_object_del(avatar->loader);
+     }
+
+   EINA_LIST_FREE(avatar->views, view)
+     evas_object_data_del(view, "edi_scm_avatar");
+
+   eina_stringshare_del(avatar->email);
+   eina_stringshare_del(avatar->path);
+   free(avatar->pixels);
+   free(avatar);
+}
+
+static void
+_edi_scm_avatar_view_del_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   Edi_Scm_Avatar *avatar;
+
+   avatar = evas_object_data_get(obj, "edi_scm_avatar");
+   if (avatar)
+     avatar->views = eina_list_remove(avatar->views, obj);
+}
+
+static Edi_Scm_Avatar *
+_edi_scm_avatar_get(const char *email)
+{
+   Edi_Scm_Avatar *avatar;
+
+   if (!_edi_scm_avatars)
+     _edi_scm_avatars = eina_hash_string_superfast_new(_edi_scm_avatar_free);
+
+   avatar = eina_hash_find(_edi_scm_avatars, email);
+   if (avatar)
+     return avatar;
+
+   avatar = calloc(1, sizeof(Edi_Scm_Avatar));
+   avatar->email = eina_stringshare_add(email);
+   avatar->path = eina_stringshare_printf("%s/%s/avatars/%s.jpeg", efreet_cache_home_get(),
+                                          PACKAGE_NAME, email);
+   eina_hash_add(_edi_scm_avatars, email, avatar);
+
+   return avatar;
+}
+
+Evas_Object *
+edi_scm_avatar_add(Evas_Object *parent, const char *email)
+{
+   Edi_Scm_Avatar *avatar = NULL;
+   Evas_Object *view;
+
+   view = elm_box_add(parent);
+
+   if (email && email[0])
+     avatar = _edi_scm_avatar_get(email);
+   if (!avatar)
+     {
+        _edi_scm_avatar_view_update(NULL, view);
+        return view;
+     }
+
+   avatar->views = eina_list_append(avatar->views, view);
+   evas_object_data_set(view, "edi_scm_avatar", avatar);
+   evas_object_event_callback_add(view, EVAS_CALLBACK_DEL, _edi_scm_avatar_view_del_cb, NULL);
+
+   if (avatar->state == EDI_SCM_AVATAR_UNCHECKED && ecore_file_exists(avatar->path))
+     avatar->state = EDI_SCM_AVATAR_ON_DISK;
+   else if (avatar->state == EDI_SCM_AVATAR_UNCHECKED)
+     _edi_scm_avatar_download(avatar);
+
+   if (avatar->state == EDI_SCM_AVATAR_ON_DISK)
+     _edi_scm_avatar_decode(avatar, evas_object_evas_get(view));
+
+   _edi_scm_avatar_view_update(avatar, view);
+
+   return view;
+}
+
+void
+edi_scm_avatar_shutdown(void)
+{
+   ecore_file_download_abort_all();
+
+   if (_edi_scm_avatars)
+     eina_hash_free(_edi_scm_avatars);
+   _edi_scm_avatars = NULL;
+}
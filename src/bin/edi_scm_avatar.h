@@ -0,0 +1,54 @@
+#ifndef __EDI_SCM_AVATAR_H__
+#define __EDI_SCM_AVATAR_H__
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for showing the avatars of SCM users.
+ */
+
+/**
+ * @brief SCM avatar functions.
+ * @defgroup SCM_Avatar
+ *
+ * @{
+ *
+ * Avatars are downloaded once to the disk cache and decoded in the background,
+ * each one only once per session.
+ *
+ */
+
+/**
+ * Create a view of the avatar for an email address.
+ *
+ * A default icon is shown until the avatar has been fetched and decoded.
+ *
+ * @param parent The parent object of the view.
+ * @param email The email address of the user, or NULL for the default icon.
+ * @return The avatar view.
+ *
+ * @ingroup SCM_Avatar
+ */
+Evas_Object *edi_scm_avatar_add(Evas_Object *parent, const char *email);
+
+/**
+ * Free the avatars held in memory and abort any download in progress.
+ *
+ * @ingroup SCM_Avatar
+ */
+void edi_scm_avatar_shutdown(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #include <Edi.h>
 
 #include "edi_scm_ui.h"
+#include "edi_scm_avatar.h"
 #include "edi_private.h"
 
 #define DEFAULT_WIDTH  560
@@ -105,6 +106,7 @@ int main(int argc, char **argv)
 
    ecore_main_loop_begin();
 
+   edi_scm_avatar_shutdown();
    edi_scm_shutdown();
    ecore_shutdown();
    elm_shutdown();
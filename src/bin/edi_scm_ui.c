@@ -5,80 +5,91 @@
 #include "Edi.h"
 #include <Eio.h>
 #include "edi_scm_ui.h"
+#include "edi_scm_avatar.h"
 #include "edi_private.h"
 
-#define DEFAULT_USER_ICON "applications-development"
+// Lines handed to the main loop at once, or whatever was read in a frame.
+#define DIFF_BATCH_LINES 4096
+#define DIFF_BATCH_TIME (1.0 / 60.0)
+
+// Files are folded to their header line unless expanded, the text stays in diff_text.
+typedef struct _Edi_Scm_Ui_Diff_File {
+   unsigned int line;
+   unsigned int hunk;
+   size_t offset;
+   unsigned int added, removed;
+   Eina_Bool expanded;
+} Edi_Scm_Ui_Diff_File;
+
+typedef struct _Edi_Scm_Ui_Diff_Hunk {
+   unsigned int line;
+   unsigned int file;
+} Edi_Scm_Ui_Diff_Hunk;
+
+// A single file's diff, valid while its index blob and worktree mtime are unchanged.
+typedef struct _Edi_Scm_Ui_Diff_Cache {
+   Eina_Stringshare *path;
+   Eina_Stringshare *id;
+   long long mtime;
+   Eina_Bool staged;
+   char *text;
+} Edi_Scm_Ui_Diff_Cache;
 
 typedef struct _Edi_Scm_Ui_Data {
    Ecore_Thread *thread;
    Eio_Monitor  *monitor;
+   Ecore_Job    *refresh_job;
    Elm_Code     *code;
    const char   *workdir;
-   void         *data;
 
    Eina_Bool is_configured;
-   Eina_Bool in_progress;
 
    Evas_Object *parent;
    Evas_Object *staged_list, *unstaged_list;
    Evas_Object *commit_button;
    Evas_Object *commit_entry;
+   Evas_Object *diff_frame, *diff_widget, *diff_label;
 
-} Edi_Scm_Ui_Data;
+   Eina_Inarray *diff_files;
+   Eina_Inarray *diff_hunks;
+   Eina_Strbuf *diff_text;
+   unsigned int diff_lines;
+   unsigned int diff_generation;
 
-const char *
-_edi_scm_ui_avatar_cache_path_get(const char *email)
-{
-   return eina_stringshare_printf("%s/%s/avatars/%s.jpeg", efreet_cache_home_get(),
-                                  PACKAGE_NAME, email);
-}
+   Eina_Stringshare *diff_path, *diff_unescaped;
+   Eina_Bool diff_staged;
 
-void _edi_scm_ui_screens_avatar_download_complete(void *data, const char *file,
-                                                  int status)
-{
-   Evas_Object *image = data;
+   Eina_Hash *diff_cache;
+   Eina_Lock diff_lock;
 
-   if (status != 200)
-     {
-        ecore_file_remove(file);
-        return;
-     }
+   // The panel and every diff thread still running hold a reference.
+   unsigned int refs;
+} Edi_Scm_Ui_Data;
 
-   elm_photo_file_set(image, file);
-}
+typedef struct _Edi_Scm_Ui_Diff_Batch {
+   unsigned int generation;
+   unsigned int lines;
+   Eina_Strbuf *text;
+   Eina_Inarray *files;
+   Eina_Inarray *hunks;
+} Edi_Scm_Ui_Diff_Batch;
 
-static void
-_edi_scm_ui_screens_avatar_load(Evas_Object *image, const char *email)
-{
-   char *tmp, *tmp2;
-   const char *cache, *cachedir, *cacheparentdir;
+typedef struct _Edi_Scm_Ui_Diff_Job {
+   Edi_Scm_Ui_Data *pd;
+   Ecore_Thread *thread;
+   unsigned int generation;
+   unsigned int line, files, hunks;
+   size_t offset;
+   double flushed;
 
-   cache = _edi_scm_ui_avatar_cache_path_get(email);
-   if (ecore_file_exists(cache))
-     {
-        elm_photo_file_set(image, cache);
-        return;
-     }
+   Edi_Scm_Ui_Diff_Batch *batch;
 
-   tmp = strdup(cache);
-   cachedir = dirname(tmp);
-   tmp2 = strdup(tmp);
-   cacheparentdir = dirname(tmp2);
-   if ((ecore_file_exists(cacheparentdir) || ecore_file_mkdir(cacheparentdir))
-       && (ecore_file_exists(cachedir) || ecore_file_mkdir(cachedir)))
-     {
-        ecore_file_download(edi_scm_avatar_url_get(email), cache,
-                            _edi_scm_ui_screens_avatar_download_complete, NULL,
-                            image, NULL);
-     }
-   else
-     {
-        elm_icon_standard_set(image, DEFAULT_USER_ICON);
-     }
+   Eina_Stringshare *path, *fullpath, *key;
+   Eina_Bool staged;
+   Eina_Strbuf *record;
+} Edi_Scm_Ui_Diff_Job;
 
-   free(tmp2);
-   free(tmp);
-}
+static void _edi_scm_ui_diff_stop(Edi_Scm_Ui_Data *pd);
 
 static void
 _edi_scm_ui_screens_message_close_cb(void *data EINA_UNUSED,
@@ -109,26 +120,46 @@ _edi_scm_ui_screens_message_open(Evas_Object *parent, const char *message)
 }
 
 static void
-_edi_scm_ui_screens_cancel_cb(void *data, Evas_Object *obj EINA_UNUSED,
-                              void *event_info EINA_UNUSED)
+_edi_scm_ui_data_unref(Edi_Scm_Ui_Data *pd)
 {
-   Edi_Scm_Ui_Data *pd = data;
+   if (--pd->refs)
+     return;
 
-   if (pd->thread)
-     ecore_thread_cancel(pd->thread);
+   eina_inarray_free(pd->diff_files);
+   eina_inarray_free(pd->diff_hunks);
+   eina_strbuf_free(pd->diff_text);
+   eina_hash_free(pd->diff_cache);
+   eina_lock_free(&pd->diff_lock);
+   eina_stringshare_del(pd->diff_path);
+   eina_stringshare_del(pd->diff_unescaped);
+   free(pd);
+}
 
-   while ((ecore_thread_wait(pd->thread, 0.1)) != EINA_TRUE);
+static void
+_edi_scm_ui_close(Edi_Scm_Ui_Data *pd)
+{
+   // Diff threads being cancelled keep the data alive until they are done.
+   _edi_scm_ui_diff_stop(pd);
+   if (pd->refresh_job)
+     ecore_job_del(pd->refresh_job);
 
    evas_object_del(pd->parent);
 
    if (pd->monitor)
      eio_monitor_del(pd->monitor);
 
-   free(pd);
+   _edi_scm_ui_data_unref(pd);
 
    elm_exit();
 }
 
+static void
+_edi_scm_ui_screens_cancel_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                              void *event_info EINA_UNUSED)
+{
+   _edi_scm_ui_close(data);
+}
+
 static void
 _edi_scm_ui_screens_commit_cb(void *data,
                               Evas_Object *obj EINA_UNUSED,
@@ -157,19 +188,7 @@ _edi_scm_ui_screens_commit_cb(void *data,
 
    free(message);
 
-   if (pd->thread)
-     ecore_thread_cancel(pd->thread);
-
-   while ((ecore_thread_wait(pd->thread, 0.1)) != EINA_TRUE);
-
-   evas_object_del(pd->parent);
-
-   if (pd->monitor)
-     eio_monitor_del(pd->monitor);
-
-   free(pd);
-
-   elm_exit();
+   _edi_scm_ui_close(pd);
 }
 
 static const char *
@@ -314,6 +333,71 @@ _content_get(void *data, Evas_Object *obj, const char *source)
    return box;
 }
 
+static void
+_edi_scm_ui_diff_select(Edi_Scm_Ui_Data *pd, Edi_Scm_Status *status)
+{
+   eina_stringshare_replace(&pd->diff_path, status ? status->path : NULL);
+   eina_stringshare_replace(&pd->diff_unescaped, status ? status->unescaped : NULL);
+   pd->diff_staged = status ? status->staged : EINA_FALSE;
+}
+
+typedef struct _Edi_Scm_Ui_Diff_Prune {
+   Eina_List *statuses;
+   Eina_List *stale;
+} Edi_Scm_Ui_Diff_Prune;
+
+static Eina_Bool
+_edi_scm_ui_diff_cache_prune_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                                void *data, void *fdata)
+{
+   Edi_Scm_Ui_Diff_Cache *entry = data;
+   Edi_Scm_Ui_Diff_Prune *prune = fdata;
+   Edi_Scm_Status *status;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(prune->statuses, l, status)
+     {
+        if (status->path == entry->path && status->staged == entry->staged)
+          return EINA_TRUE;
+     }
+
+   prune->stale = eina_list_append(prune->stale, key);
+   return EINA_TRUE;
+}
+
+// Drop diffs of files that are no longer changed and follow the selection across lists.
+static void
+_edi_scm_ui_diff_cache_prune(Edi_Scm_Ui_Data *pd, Eina_List *statuses)
+{
+   Edi_Scm_Ui_Diff_Prune prune;
+   Edi_Scm_Status *status, *selected = NULL;
+   Eina_List *l;
+   const char *key;
+
+   prune.statuses = statuses;
+   prune.stale = NULL;
+
+   eina_lock_take(&pd->diff_lock);
+   eina_hash_foreach(pd->diff_cache, _edi_scm_ui_diff_cache_prune_cb, &prune);
+   EINA_LIST_FREE(prune.stale, key)
+     eina_hash_del_by_key(pd->diff_cache, key);
+   eina_lock_release(&pd->diff_lock);
+
+   if (!pd->diff_path)
+     return;
+
+   EINA_LIST_FOREACH(statuses, l, status)
+     {
+        if (status->path != pd->diff_path)
+          continue;
+
+        if (!selected || status->staged == pd->diff_staged)
+          selected = status;
+     }
+
+   _edi_scm_ui_diff_select(pd, selected);
+}
+
 static Eina_Bool
 _edi_scm_ui_status_list_fill(Edi_Scm_Ui_Data *pd)
 {
@@ -327,6 +411,8 @@ _edi_scm_ui_status_list_fill(Edi_Scm_Ui_Data *pd)
    if (!e || !edi_scm_status_get())
      return EINA_FALSE;
 
+   _edi_scm_ui_diff_cache_prune(pd, e->statuses);
+
    itc = elm_genlist_item_class_new();
    itc->item_style = "full";
    itc->func.text_get = NULL;
@@ -354,89 +440,645 @@ _edi_scm_ui_status_list_fill(Edi_Scm_Ui_Data *pd)
    return staged;
 }
 
+static Edi_Scm_Ui_Diff_Batch *
+_edi_scm_ui_diff_batch_new(unsigned int generation)
+{
+   Edi_Scm_Ui_Diff_Batch *batch;
+
+   batch = calloc(1, sizeof(Edi_Scm_Ui_Diff_Batch));
+   batch->generation = generation;
+   batch->text = eina_strbuf_new();
+
+   return batch;
+}
+
 static void
-_diff_widget_lines_append(Ecore_Thread *thread, Elm_Code *code, char *text)
+_edi_scm_ui_diff_batch_free(Edi_Scm_Ui_Diff_Batch *batch)
 {
-   char *pos = text;
-   char *start, *end = NULL;
+   if (!batch)
+     return;
 
-   if (!*pos) return;
+   eina_strbuf_free(batch->text);
+   if (batch->files)
+     eina_inarray_free(batch->files);
+   if (batch->hunks)
+     eina_inarray_free(batch->hunks);
+   free(batch);
+}
 
-   start = pos;
-   while (*pos++ != '\0')
-    {
-       if (*pos == '\n')
-         end = pos;
+static void
+_edi_scm_ui_diff_flush(Edi_Scm_Ui_Diff_Job *job)
+{
+   if (!job->batch->lines)
+     return;
 
-       if (start && end)
-         {
-            ecore_thread_main_loop_begin();
-            elm_code_file_line_append(code->file, start, end - start, NULL);
-            ecore_thread_main_loop_end();
-            start = end + 1;
-            end = NULL;
-            if (ecore_thread_check(thread))
-              return;
-         }
-    }
+   if (ecore_thread_feedback(job->thread, job->batch))
+     job->batch = _edi_scm_ui_diff_batch_new(job->generation);
 
-    end = pos;
+   job->flushed = ecore_time_get();
+}
 
-    if (end > start)
-      {
-         ecore_thread_main_loop_begin();
-         elm_code_file_line_append(code->file, start, end - start, NULL);
-         ecore_thread_main_loop_end();
-      }
+// Runs in the worker, only the index counters and the batch are touched.
+static Eina_Bool
+_edi_scm_ui_diff_line_cb(void *data, const char *line, size_t length)
+{
+   Edi_Scm_Ui_Diff_Job *job = data;
+   Edi_Scm_Ui_Diff_Batch *batch;
+   Edi_Scm_Ui_Diff_File file;
+   Edi_Scm_Ui_Diff_Hunk hunk;
+
+   if (ecore_thread_check(job->thread))
+     return EINA_FALSE;
+
+   batch = job->batch;
+   job->line++;
+
+   if (length > 5 && !strncmp(line, "diff ", 5))
+     {
+        if (!batch->files)
+          batch->files = eina_inarray_new(sizeof(Edi_Scm_Ui_Diff_File), 16);
+
+        memset(&file, 0, sizeof(file));
+        file.line = job->line;
+        file.hunk = job->hunks;
+        file.offset = job->offset;
+        eina_inarray_push(batch->files, &file);
+        job->files++;
+     }
+   else if (length > 2 && !strncmp(line, "@@", 2))
+     {
+        if (!batch->hunks)
+          batch->hunks = eina_inarray_new(sizeof(Edi_Scm_Ui_Diff_Hunk), 64);
+
+        hunk.line = job->line;
+        hunk.file = job->files ? job->files - 1 : 0;
+        eina_inarray_push(batch->hunks, &hunk);
+        job->hunks++;
+     }
+
+   eina_strbuf_append_length(batch->text, line, length);
+   eina_strbuf_append_char(batch->text, '\n');
+   batch->lines++;
+   job->offset += length + 1;
+
+   if (job->record)
+     {
+        eina_strbuf_append_length(job->record, line, length);
+        eina_strbuf_append_char(job->record, '\n');
+     }
+
+   if (batch->lines >= DIFF_BATCH_LINES || ecore_time_get() - job->flushed >= DIFF_BATCH_TIME)
+     _edi_scm_ui_diff_flush(job);
+
+   return EINA_TRUE;
 }
 
 static void
-_edi_scm_diff_thread_cancel_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+_edi_scm_ui_diff_label_update(Edi_Scm_Ui_Data *pd)
 {
-   Edi_Scm_Ui_Data *pd = data;
+   char text[128];
+   unsigned int hunks, files;
+
+   hunks = eina_inarray_count(pd->diff_hunks);
+   files = eina_inarray_count(pd->diff_files);
+
+   if (!files)
+     elm_object_text_set(pd->diff_label, _("No changes"));
+   else
+     {
+        snprintf(text, sizeof(text), _("Changes: %u, files: %u"), hunks, files);
+        elm_object_text_set(pd->diff_label, text);
+     }
+}
+
+// The number of lines a file spans in the diff, its header included.
+static unsigned int
+_edi_scm_ui_diff_file_lines(Edi_Scm_Ui_Data *pd, unsigned int i)
+{
+   Edi_Scm_Ui_Diff_File *file, *next;
+
+   file = eina_inarray_nth(pd->diff_files, i);
+   if (i + 1 >= eina_inarray_count(pd->diff_files))
+     return pd->diff_lines + 1 - file->line;
+
+   next = eina_inarray_nth(pd->diff_files, i + 1);
+   return next->line - file->line;
+}
+
+static unsigned int
+_edi_scm_ui_diff_file_rows(Edi_Scm_Ui_Data *pd, unsigned int i)
+{
+   Edi_Scm_Ui_Diff_File *file;
+
+   file = eina_inarray_nth(pd->diff_files, i);
+   return file->expanded ? _edi_scm_ui_diff_file_lines(pd, i) : 1;
+}
+
+static const char *
+_edi_scm_ui_diff_header_get(Edi_Scm_Ui_Data *pd, Edi_Scm_Ui_Diff_File *file, int *length)
+{
+   const char *text, *end;
+
+   text = eina_strbuf_string_get(pd->diff_text) + file->offset;
+   end = strchr(text, '\n');
+   *length = end ? end - text : (int) strlen(text);
+
+   return text;
+}
+
+static void
+_edi_scm_ui_diff_header_set(Edi_Scm_Ui_Data *pd, Edi_Scm_Ui_Diff_File *file, Elm_Code_Line *line)
+{
+   const char *header, *text;
+   int length;
+
+   header = _edi_scm_ui_diff_header_get(pd, file, &length);
+   if (file->expanded)
+     {
+        elm_code_line_text_set(line, header, length);
+        return;
+     }
+
+   text = eina_slstr_printf("%.*s  [+%u -%u]", length, header, file->added, file->removed);
+   elm_code_line_text_set(line, text, strlen(text));
+}
+
+// Only expanded files have their lines in the widget, the headers of the others stand in for them.
+static void
+_edi_scm_ui_diff_render(Edi_Scm_Ui_Data *pd)
+{
+   Edi_Scm_Ui_Diff_File *file;
+   const char *text, *start, *end;
+   unsigned int i, count, lines;
+
+   elm_code_file_clear(pd->code->file);
+
+   text = eina_strbuf_string_get(pd->diff_text);
+   count = eina_inarray_count(pd->diff_files);
+   for (i = 0; i < count; i++)
+     {
+        file = eina_inarray_nth(pd->diff_files, i);
+        start = text + file->offset;
+        end = strchr(start, '\n');
+
+        elm_code_file_line_append(pd->code->file, start, end ? end - start : (int) strlen(start), NULL);
+        if (!file->expanded)
+          {
+             _edi_scm_ui_diff_header_set(pd, file, elm_code_file_line_get(pd->code->file,
+                                         elm_code_file_lines_get(pd->code->file)));
+             continue;
+          }
+
+        lines = _edi_scm_ui_diff_file_lines(pd, i);
+        while (end && --lines)
+          {
+             start = end + 1;
+             end = strchr(start, '\n');
+             if (end)
+               elm_code_file_line_append(pd->code->file, start, end - start, NULL);
+          }
+     }
+}
+
+static void
+_edi_scm_diff_thread_notify_cb(void *data, Ecore_Thread *thread EINA_UNUSED, void *msg)
+{
+   Edi_Scm_Ui_Diff_Job *job = data;
+   Edi_Scm_Ui_Diff_Batch *batch = msg;
+   Edi_Scm_Ui_Data *pd = job->pd;
+   Edi_Scm_Ui_Diff_File *file = NULL, *next;
+   Edi_Scm_Ui_Diff_Hunk *hunk;
+   const char *text, *start, *end;
+   unsigned int pos = 0, count, first;
+
+   if (batch->generation != pd->diff_generation)
+     {
+        _edi_scm_ui_diff_batch_free(batch);
+        return;
+     }
+
+   count = eina_inarray_count(pd->diff_files);
+   first = count ? count - 1 : 0;
+   if (count)
+     file = eina_inarray_nth(pd->diff_files, count - 1);
+
+   text = eina_strbuf_string_get(batch->text);
+   eina_strbuf_append_length(pd->diff_text, text, eina_strbuf_length_get(batch->text));
 
-   pd->in_progress = EINA_FALSE;
+   // The file being streamed is always the last, its lines go to the end of the widget.
+   start = text;
+   while ((end = strchr(start, '\n')))
+     {
+        pd->diff_lines++;
+
+        next = NULL;
+        if (batch->files && pos < eina_inarray_count(batch->files))
+          next = eina_inarray_nth(batch->files, pos);
+        if (next && next->line == pd->diff_lines)
+          {
+             // The whole diff starts folded, the diff of one file does not.
+             next->expanded = !!pd->diff_path;
+             eina_inarray_push(pd->diff_files, next);
+             file = eina_inarray_nth(pd->diff_files, eina_inarray_count(pd->diff_files) - 1);
+             pos++;
+
+             elm_code_file_line_append(pd->code->file, start, end - start, NULL);
+          }
+        else if (file)
+          {
+             if (start[0] == '+' && strncmp(start, "+++ ", 4))
+               file->added++;
+             else if (start[0] == '-' && strncmp(start, "--- ", 4))
+               file->removed++;
+
+             if (file->expanded)
+               elm_code_file_line_append(pd->code->file, start, end - start, NULL);
+          }
+
+        start = end + 1;
+     }
+
+   // Refresh the counts shown by the folded headers this batch added to.
+   count = eina_inarray_count(pd->diff_files);
+   if (count > first)
+     {
+        unsigned int i, row = 1;
+
+        for (i = 0; i < first; i++)
+          row += _edi_scm_ui_diff_file_rows(pd, i);
+        for (i = first; i < count; i++)
+          {
+             file = eina_inarray_nth(pd->diff_files, i);
+             if (!file->expanded)
+               _edi_scm_ui_diff_header_set(pd, file, elm_code_file_line_get(pd->code->file, row));
+             row += _edi_scm_ui_diff_file_rows(pd, i);
+          }
+     }
+
+   if (batch->hunks)
+     EINA_INARRAY_FOREACH(batch->hunks, hunk)
+       eina_inarray_push(pd->diff_hunks, hunk);
+
+   _edi_scm_ui_diff_label_update(pd);
+   _edi_scm_ui_diff_batch_free(batch);
+}
+
+static void
+_edi_scm_diff_thread_done(Edi_Scm_Ui_Diff_Job *job, Ecore_Thread *thread)
+{
+   if (job->pd->thread == thread)
+     job->pd->thread = NULL;
+   _edi_scm_ui_data_unref(job->pd);
+
+   _edi_scm_ui_diff_batch_free(job->batch);
+   if (job->record)
+     eina_strbuf_free(job->record);
+   eina_stringshare_del(job->path);
+   eina_stringshare_del(job->fullpath);
+   eina_stringshare_del(job->key);
+   free(job);
+}
+
+static void
+_edi_scm_diff_thread_cancel_cb(void *data, Ecore_Thread *thread)
+{
+   _edi_scm_diff_thread_done(data, thread);
+}
+
+static void
+_edi_scm_diff_thread_end_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Scm_Ui_Diff_Job *job = data;
+
+   if (job->generation == job->pd->diff_generation)
+     _edi_scm_ui_diff_label_update(job->pd);
+
+   _edi_scm_diff_thread_done(job, thread);
+}
+
+static void
+_edi_scm_ui_diff_cache_free(void *data)
+{
+   Edi_Scm_Ui_Diff_Cache *entry = data;
+
+   eina_stringshare_del(entry->path);
+   eina_stringshare_del(entry->id);
+   free(entry->text);
+   free(entry);
+}
+
+// Replay a cached file diff through the same path as a fresh one.
+static Eina_Bool
+_edi_scm_ui_diff_cache_replay(Edi_Scm_Ui_Diff_Job *job, Eina_Stringshare *id, long long mtime)
+{
+   Edi_Scm_Ui_Diff_Cache *entry;
+   char *text = NULL, *start, *end;
+
+   eina_lock_take(&job->pd->diff_lock);
+   entry = eina_hash_find(job->pd->diff_cache, job->key);
+   if (entry && entry->id == id && entry->mtime == mtime)
+     text = strdup(entry->text);
+   eina_lock_release(&job->pd->diff_lock);
+
+   if (!text)
+     return EINA_FALSE;
+
+   start = text;
+   while ((end = strchr(start, '\n')))
+     {
+        if (!_edi_scm_ui_diff_line_cb(job, start, end - start))
+          break;
+        start = end + 1;
+     }
+
+   free(text);
+   return EINA_TRUE;
+}
+
+static void
+_edi_scm_ui_diff_cache_store(Edi_Scm_Ui_Diff_Job *job, Eina_Stringshare *id, long long mtime)
+{
+   Edi_Scm_Ui_Diff_Cache *entry;
+
+   entry = calloc(1, sizeof(Edi_Scm_Ui_Diff_Cache));
+   entry->path = eina_stringshare_ref(job->path);
+   entry->id = eina_stringshare_ref(id);
+   entry->mtime = mtime;
+   entry->staged = job->staged;
+   entry->text = eina_strbuf_string_steal(job->record);
+
+   eina_lock_take(&job->pd->diff_lock);
+   eina_hash_set(job->pd->diff_cache, job->key, entry);
+   eina_lock_release(&job->pd->diff_lock);
+}
+
+static void
+_edi_scm_diff_thread_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Scm_Ui_Diff_Job *job = data;
+   Eina_Stringshare *id = NULL;
+   long long mtime = 0;
+
+   job->thread = thread;
+   job->flushed = ecore_time_get();
+
+   if (job->path)
+     {
+        // Staged changes only depend on the index, unstaged ones on the worktree too.
+        id = edi_scm_file_index_id_get(job->path);
+        if (!job->staged)
+          mtime = ecore_file_mod_time(job->fullpath);
+
+        if (_edi_scm_ui_diff_cache_replay(job, id, mtime))
+          goto done;
+
+        job->record = eina_strbuf_new();
+     }
+
+   edi_scm_diff_foreach(job->staged, job->path, _edi_scm_ui_diff_line_cb, job);
+
+   if (job->record && !ecore_thread_check(thread))
+     _edi_scm_ui_diff_cache_store(job, id, mtime);
+
+done:
+   eina_stringshare_del(id);
+
+   if (!ecore_thread_check(thread))
+     _edi_scm_ui_diff_flush(job);
+}
+
+// Any batches still queued by the diff are dropped by generation.
+static void
+_edi_scm_ui_diff_stop(Edi_Scm_Ui_Data *pd)
+{
+   pd->diff_generation++;
+
+   if (!pd->thread)
+     return;
+
+   ecore_thread_cancel(pd->thread);
    pd->thread = NULL;
+}
+
+static void
+_edi_scm_diff_refresh(Edi_Scm_Ui_Data *pd)
+{
+   Edi_Scm_Ui_Diff_Job *job;
+   char title[PATH_MAX];
+
+   _edi_scm_ui_diff_stop(pd);
+
+   if (pd->diff_path)
+     {
+        snprintf(title, sizeof(title), pd->diff_staged ? _("Staged changes: %s") : _("Unstaged changes: %s"),
+                 pd->diff_unescaped);
+        elm_object_text_set(pd->diff_frame, title);
+     }
+   else
+     elm_object_text_set(pd->diff_frame, _("Source changes"));
+
+   elm_code_file_clear(pd->code->file);
+   eina_inarray_flush(pd->diff_files);
+   eina_inarray_flush(pd->diff_hunks);
+   eina_strbuf_reset(pd->diff_text);
+   pd->diff_lines = 0;
+
+   job = calloc(1, sizeof(Edi_Scm_Ui_Diff_Job));
+   job->pd = pd;
+   pd->refs++;
+   job->generation = pd->diff_generation;
+   job->batch = _edi_scm_ui_diff_batch_new(job->generation);
+   job->staged = EINA_TRUE;
+
+   if (pd->diff_path)
+     {
+        job->staged = pd->diff_staged;
+        job->path = eina_stringshare_ref(pd->diff_path);
+        job->fullpath = eina_stringshare_printf("%s/%s", pd->workdir, pd->diff_unescaped);
+        job->key = eina_stringshare_printf("%c%s", job->staged ? 'S' : 'U', pd->diff_path);
+     }
+
+   pd->thread = ecore_thread_feedback_run(_edi_scm_diff_thread_cb, _edi_scm_diff_thread_notify_cb,
+                                          _edi_scm_diff_thread_end_cb, _edi_scm_diff_thread_cancel_cb,
+                                          job, EINA_FALSE);
+}
+
+// Index of the first entry starting after row, both index types lead with their line.
+static unsigned int
+_edi_scm_ui_diff_index_after(Eina_Inarray *index, unsigned int row)
+{
+   unsigned int low = 0, high = eina_inarray_count(index), mid;
 
-   if (pd->data)
+   while (low < high)
      {
-        free(pd->data);
-        pd->data = NULL;
+        mid = low + (high - low) / 2;
+        if (*(unsigned int *) eina_inarray_nth(index, mid) <= row)
+          low = mid + 1;
+        else
+          high = mid;
      }
+
+   return low;
+}
+
+// The widget row showing a line of the diff, the header of its file if folded.
+static unsigned int
+_edi_scm_ui_diff_row_get(Edi_Scm_Ui_Data *pd, unsigned int line)
+{
+   Edi_Scm_Ui_Diff_File *file;
+   unsigned int i, f, row = 1;
+
+   f = _edi_scm_ui_diff_index_after(pd->diff_files, line);
+   if (!f)
+     return 1;
+   f--;
+
+   for (i = 0; i < f; i++)
+     row += _edi_scm_ui_diff_file_rows(pd, i);
+
+   file = eina_inarray_nth(pd->diff_files, f);
+   if (file->expanded)
+     row += line - file->line;
+
+   return row;
+}
+
+// The line of the diff shown at a widget row, and the file it belongs to.
+static unsigned int
+_edi_scm_ui_diff_line_get(Edi_Scm_Ui_Data *pd, unsigned int row, unsigned int *index)
+{
+   Edi_Scm_Ui_Diff_File *file;
+   unsigned int i, count, rows, first = 1;
+
+   count = eina_inarray_count(pd->diff_files);
+   for (i = 0; i < count; i++)
+     {
+        file = eina_inarray_nth(pd->diff_files, i);
+        rows = _edi_scm_ui_diff_file_rows(pd, i);
+        if (row < first + rows)
+          {
+             if (index)
+               *index = i;
+             return file->line + (file->expanded ? row - first : 0);
+          }
+        first += rows;
+     }
+
+   return 0;
 }
 
 static void
-_edi_scm_diff_thread_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+_edi_scm_ui_diff_jump(Edi_Scm_Ui_Data *pd, Eina_Inarray *index, Eina_Bool forward)
+{
+   Edi_Scm_Ui_Diff_File *file;
+   Edi_Scm_Ui_Diff_Hunk *hunk;
+   unsigned int row, col, line, pos, count;
+
+   count = eina_inarray_count(index);
+   if (!count)
+     return;
+
+   elm_code_widget_cursor_position_get(pd->diff_widget, &row, &col);
+   line = _edi_scm_ui_diff_line_get(pd, row, NULL);
+   if (forward)
+     {
+        pos = _edi_scm_ui_diff_index_after(index, line);
+        if (pos >= count)
+          return;
+     }
+   else
+     {
+        pos = _edi_scm_ui_diff_index_after(index, line ? line - 1 : 0);
+        if (pos == 0)
+          return;
+        pos--;
+     }
+
+   line = *(unsigned int *) eina_inarray_nth(index, pos);
+
+   // A change can only be shown with its file unfolded.
+   if (index == pd->diff_hunks)
+     {
+        hunk = eina_inarray_nth(index, pos);
+        file = eina_inarray_nth(pd->diff_files, hunk->file);
+        if (file && !file->expanded)
+          {
+             file->expanded = EINA_TRUE;
+             _edi_scm_ui_diff_render(pd);
+          }
+     }
+
+   elm_code_widget_cursor_position_set(pd->diff_widget, _edi_scm_ui_diff_row_get(pd, line), 1);
+}
+
+static void
+_edi_scm_ui_diff_line_clicked_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info)
 {
    Edi_Scm_Ui_Data *pd = data;
+   Elm_Code_Line *code_line = event_info;
+   Edi_Scm_Ui_Diff_File *file;
+   unsigned int i, line;
 
-   pd->in_progress = EINA_FALSE;
-   pd->thread = NULL;
+   line = _edi_scm_ui_diff_line_get(pd, code_line->number, &i);
+   if (!line)
+     return;
+
+   // Clicking the header of a file folds or unfolds it.
+   file = eina_inarray_nth(pd->diff_files, i);
+   if (file->line != line)
+     return;
+
+   file->expanded = !file->expanded;
+   _edi_scm_ui_diff_render(pd);
+   elm_code_widget_cursor_position_set(pd->diff_widget, _edi_scm_ui_diff_row_get(pd, line), 1);
 }
 
 static void
-_edi_scm_diff_thread_cb(void *data, Ecore_Thread *thread)
+_edi_scm_ui_diff_prev_file_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
    Edi_Scm_Ui_Data *pd = data;
 
-   if (pd->in_progress) return;
+   _edi_scm_ui_diff_jump(pd, pd->diff_files, EINA_FALSE);
+}
 
-   pd->data = edi_scm_diff(EINA_TRUE);
+static void
+_edi_scm_ui_diff_next_file_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Scm_Ui_Data *pd = data;
 
-   pd->in_progress = EINA_TRUE;
-   pd->thread = thread;
+   _edi_scm_ui_diff_jump(pd, pd->diff_files, EINA_TRUE);
+}
 
-   _diff_widget_lines_append(thread, pd->code, pd->data);
+static void
+_edi_scm_ui_diff_prev_hunk_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Scm_Ui_Data *pd = data;
 
-   free(pd->data);
-   pd->data = NULL;
+   _edi_scm_ui_diff_jump(pd, pd->diff_hunks, EINA_FALSE);
 }
 
 static void
-_edi_scm_diff_refresh(Edi_Scm_Ui_Data *pd)
+_edi_scm_ui_diff_next_hunk_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
-   ecore_thread_run(_edi_scm_diff_thread_cb, _edi_scm_diff_thread_end_cb,
-                    _edi_scm_diff_thread_cancel_cb, pd);
+   Edi_Scm_Ui_Data *pd = data;
+
+   _edi_scm_ui_diff_jump(pd, pd->diff_hunks, EINA_TRUE);
+}
+
+static void
+_edi_scm_ui_diff_button_add(Evas_Object *parent, const char *icon, const char *tooltip,
+                            Evas_Smart_Cb func, Edi_Scm_Ui_Data *pd)
+{
+   Evas_Object *button, *ic;
+
+   button = elm_button_add(parent);
+   ic = elm_icon_add(button);
+   elm_icon_standard_set(ic, icon);
+   elm_object_part_content_set(button, "icon", ic);
+   elm_object_tooltip_text_set(button, tooltip);
+   evas_object_smart_callback_add(button, "clicked", func, pd);
+   evas_object_show(button);
+   elm_box_pack_end(parent, button);
 }
 
 static void
@@ -447,8 +1089,6 @@ _edi_scm_ui_refresh(Edi_Scm_Ui_Data *pd)
    elm_genlist_clear(pd->staged_list);
    elm_genlist_clear(pd->unstaged_list);
 
-   elm_code_file_clear(pd->code->file);
-
    staged = _edi_scm_ui_status_list_fill(pd);
 
    if (!pd->is_configured)
@@ -468,13 +1108,32 @@ _edi_scm_ui_refresh(Edi_Scm_Ui_Data *pd)
    _edi_scm_diff_refresh(pd);
 }
 
+static void
+_edi_scm_ui_refresh_job_cb(void *data)
+{
+   Edi_Scm_Ui_Data *pd = data;
+
+   pd->refresh_job = NULL;
+   _edi_scm_ui_refresh(pd);
+}
+
+// Git touches many files for one operation, only refresh once they are all seen.
+static void
+_edi_scm_ui_refresh_queue(Edi_Scm_Ui_Data *pd)
+{
+   if (pd->refresh_job)
+     return;
+
+   pd->refresh_job = ecore_job_add(_edi_scm_ui_refresh_job_cb, pd);
+}
+
 static Eina_Bool
 _edi_scm_ui_file_changes_cb(void *data EINA_UNUSED, int type EINA_UNUSED,
                             void *event EINA_UNUSED)
 {
    Edi_Scm_Ui_Data *pd = data;
 
-   _edi_scm_ui_refresh(pd);
+   _edi_scm_ui_refresh_queue(pd);
 
    return ECORE_CALLBACK_DONE;
 }
@@ -497,7 +1156,7 @@ _item_menu_scm_stage_cb(void *data, Evas_Object *obj,
 
    edi_scm_stage(status->path);
 
-  _edi_scm_ui_refresh(pd);
+  _edi_scm_ui_refresh_queue(pd);
 }
 
 static void
@@ -511,7 +1170,7 @@ _item_menu_scm_unstage_cb(void *data, Evas_Object *obj,
 
    edi_scm_unstage(status->path);
 
-  _edi_scm_ui_refresh(pd);
+  _edi_scm_ui_refresh_queue(pd);
 }
 
 static void
@@ -522,7 +1181,71 @@ _item_menu_scm_staged_toggle(Edi_Scm_Status *status, Edi_Scm_Ui_Data *pd)
    else
      edi_scm_stage(status->path);
 
-  _edi_scm_ui_refresh(pd);
+  _edi_scm_ui_refresh_queue(pd);
+}
+
+static Eina_List *
+_edi_scm_ui_list_paths_get(Evas_Object *list, Eina_Bool deleted_only)
+{
+   Elm_Object_Item *it;
+   Edi_Scm_Status *status;
+   Eina_List *paths = NULL;
+
+   for (it = elm_genlist_first_item_get(list); it; it = elm_genlist_item_next_get(it))
+     {
+        status = elm_object_item_data_get(it);
+        if (!status)
+          continue;
+        if (deleted_only && status->change != EDI_SCM_STATUS_DELETED)
+          continue;
+
+        paths = eina_list_append(paths, status->unescaped);
+     }
+
+   return paths;
+}
+
+static void
+_item_menu_scm_stage_all_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                            void *event_info EINA_UNUSED)
+{
+   Eina_List *paths;
+   Edi_Scm_Ui_Data *pd = evas_object_data_get(obj, "edi_scm_ui");
+
+   paths = _edi_scm_ui_list_paths_get(pd->unstaged_list, EINA_FALSE);
+   edi_scm_stage_list(paths);
+   eina_list_free(paths);
+
+   _edi_scm_ui_refresh_queue(pd);
+}
+
+static void
+_item_menu_scm_unstage_all_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                              void *event_info EINA_UNUSED)
+{
+   Eina_List *paths;
+   Edi_Scm_Ui_Data *pd = evas_object_data_get(obj, "edi_scm_ui");
+
+   paths = _edi_scm_ui_list_paths_get(pd->staged_list, EINA_FALSE);
+   edi_scm_unstage_list(paths);
+   eina_list_free(paths);
+
+   _edi_scm_ui_refresh_queue(pd);
+}
+
+static void
+_item_menu_scm_del_deleted_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                              void *event_info EINA_UNUSED)
+{
+   Eina_List *paths;
+   Edi_Scm_Ui_Data *pd = evas_object_data_get(obj, "edi_scm_ui");
+
+   paths = _edi_scm_ui_list_paths_get(pd->unstaged_list, EINA_TRUE);
+   if (paths)
+     edi_scm_del_list(paths);
+   eina_list_free(paths);
+
+   _edi_scm_ui_refresh_queue(pd);
 }
 
 static Evas_Object *
@@ -549,6 +1272,16 @@ _item_menu_create(Edi_Scm_Ui_Data *pd, Edi_Scm_Status *status)
    if (!status->staged)
      elm_object_item_disabled_set(menu_it, EINA_TRUE);
 
+   elm_menu_item_separator_add(menu, NULL);
+   if (status->staged)
+     elm_menu_item_add(menu, NULL, "edit-undo", _("Unstage All Changes"), _item_menu_scm_unstage_all_cb, NULL);
+   else
+     {
+        elm_menu_item_add(menu, NULL, "document-save-as", _("Stage All Changes"), _item_menu_scm_stage_all_cb, NULL);
+        if (status->change == EDI_SCM_STATUS_DELETED)
+          elm_menu_item_add(menu, NULL, "edit-delete", _("Remove All Deleted Files"), _item_menu_scm_del_deleted_cb, NULL);
+     }
+
    return menu;
 }
 
@@ -573,6 +1306,14 @@ _list_item_clicked_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
      {
         if (ev->button == 1 && ev->flags & EVAS_BUTTON_DOUBLE_CLICK)
           _item_menu_scm_staged_toggle(status, pd);
+        else if (ev->button == 1)
+          {
+             if (pd->diff_path == status->path && pd->diff_staged == status->staged)
+               _edi_scm_ui_diff_select(pd, NULL);
+             else
+               _edi_scm_ui_diff_select(pd, status);
+             _edi_scm_diff_refresh(pd);
+          }
         return;
      }
 
@@ -604,7 +1345,7 @@ void
 edi_scm_ui_add(Evas_Object *parent)
 {
    Evas_Object *layout, *frame, *hbox, *cbox, *label, *avatar, *input, *button;
-   Evas_Object *list, *pbox;
+   Evas_Object *list, *pbox, *nbox;
    Elm_Code_Widget *entry;
    Elm_Code *code;
    Eina_Strbuf *string;
@@ -618,9 +1359,15 @@ edi_scm_ui_add(Evas_Object *parent)
      exit(1 << 1);
 
    pd = calloc(1, sizeof(Edi_Scm_Ui_Data));
+   pd->refs = 1;
    pd->workdir = engine->root_directory;
    pd->monitor = eio_monitor_add(pd->workdir);
    pd->parent = parent;
+   pd->diff_files = eina_inarray_new(sizeof(Edi_Scm_Ui_Diff_File), 16);
+   pd->diff_hunks = eina_inarray_new(sizeof(Edi_Scm_Ui_Diff_Hunk), 64);
+   pd->diff_text = eina_strbuf_new();
+   pd->diff_cache = eina_hash_string_superfast_new(_edi_scm_ui_diff_cache_free);
+   eina_lock_new(&pd->diff_lock);
 
    ecore_event_handler_add(EIO_MONITOR_FILE_CREATED, _edi_scm_ui_file_changes_cb, pd);
    ecore_event_handler_add(EIO_MONITOR_FILE_MODIFIED, _edi_scm_ui_file_changes_cb, pd);
@@ -652,9 +1399,9 @@ edi_scm_ui_add(Evas_Object *parent)
    remote_email = engine->remote_email_get();
 
    if (remote_name && remote_name[0] && remote_email && remote_email[0])
-     avatar = elm_photo_add(parent);
+     avatar = edi_scm_avatar_add(parent, remote_email);
    else
-     avatar = elm_icon_add(parent);
+     avatar = edi_scm_avatar_add(parent, NULL);
 
    evas_object_size_hint_min_set(avatar, 72 * elm_config_scale_get(), 72 * elm_config_scale_get());
    evas_object_size_hint_weight_set(avatar, 0.1, EVAS_HINT_EXPAND);
@@ -681,13 +1428,11 @@ edi_scm_ui_add(Evas_Object *parent)
    if ((!remote_name || !remote_name[0]) && (!remote_email || !remote_email[0]))
      {
         eina_strbuf_append(string, _("Unable to obtain user information."));
-        elm_icon_standard_set(avatar, DEFAULT_USER_ICON);
      }
    else
      {
         eina_strbuf_append_printf(string, "<b>%s</b><br>&lt;%s&gt;",
                                   remote_name, remote_email);
-        _edi_scm_ui_screens_avatar_load(avatar, remote_email);
         _avatar_effect(avatar);
         pd->is_configured = EINA_TRUE;
      }
@@ -761,6 +1506,7 @@ edi_scm_ui_add(Evas_Object *parent)
    evas_object_size_hint_weight_set(frame, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
    elm_object_text_set(frame, _("Source changes"));
+   pd->diff_frame = frame;
    evas_object_show(frame);
 
    cbox = elm_box_add(parent);
@@ -771,12 +1517,31 @@ edi_scm_ui_add(Evas_Object *parent)
    elm_object_content_set(frame, cbox);
    elm_table_pack(layout, frame, 0, 8, 2, 7);
 
+   nbox = elm_box_add(cbox);
+   elm_box_horizontal_set(nbox, EINA_TRUE);
+   evas_object_size_hint_weight_set(nbox, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(nbox, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(nbox);
+   elm_box_pack_end(cbox, nbox);
+
+   _edi_scm_ui_diff_button_add(nbox, "go-first", _("Previous file"), _edi_scm_ui_diff_prev_file_cb, pd);
+   _edi_scm_ui_diff_button_add(nbox, "go-previous", _("Previous change"), _edi_scm_ui_diff_prev_hunk_cb, pd);
+   _edi_scm_ui_diff_button_add(nbox, "go-next", _("Next change"), _edi_scm_ui_diff_next_hunk_cb, pd);
+   _edi_scm_ui_diff_button_add(nbox, "go-last", _("Next file"), _edi_scm_ui_diff_next_file_cb, pd);
+
+   pd->diff_label = label = elm_label_add(nbox);
+   evas_object_size_hint_weight_set(label, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(label, 1.0, EVAS_HINT_FILL);
+   evas_object_show(label);
+   elm_box_pack_end(nbox, label);
+
    pd->code = code = elm_code_create();
-   entry = elm_code_widget_add(cbox, code);
+   pd->diff_widget = entry = elm_code_widget_add(cbox, code);
    elm_code_parser_standard_add(code, ELM_CODE_PARSER_STANDARD_DIFF);
    elm_obj_code_widget_gravity_set(entry, 0.0, 0.0);
    elm_obj_code_widget_editable_set(entry, EINA_FALSE);
    elm_obj_code_widget_line_numbers_set(entry, EINA_FALSE);
+   evas_object_smart_callback_add(entry, "line,clicked", _edi_scm_ui_diff_line_clicked_cb, pd);
    evas_object_size_hint_weight_set(entry, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(entry, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(entry);
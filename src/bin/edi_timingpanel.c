@@ -0,0 +1,225 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <time.h>
+
+#include <Eina.h>
+#include <Elementary.h>
+
+#include "edi_timingpanel.h"
+#include "edi_theme.h"
+#include "edi_config.h"
+
+#include "edi_private.h"
+
+#define _EDI_TIMING_SLOWER "slower"
+
+// Steps listed as the slowest of a build.
+#define EDI_TIMINGPANEL_SLOWEST 20
+
+// A build this much slower than the one before is flagged as a regression.
+#define EDI_TIMINGPANEL_REGRESSION 0.1
+
+static Elm_Code *_edi_timing_code;
+
+static void
+_edi_timingpanel_duration_format(char *buf, size_t size, double seconds)
+{
+   int minutes;
+
+   minutes = (int) (seconds / 60.0);
+   if (minutes)
+     snprintf(buf, size, "%dm %04.1fs", minutes, seconds - minutes * 60.0);
+   else
+     snprintf(buf, size, "%.2fs", seconds);
+}
+
+static void
+_edi_timingpanel_line_append(const char *data, const char *format, ...)
+{
+   char buf[1024];
+   va_list args;
+
+   va_start(args, format);
+   vsnprintf(buf, sizeof(buf), format, args);
+   va_end(args);
+
+   elm_code_file_line_append(_edi_timing_code->file, buf, strlen(buf), (void *) data);
+}
+
+static void
+_edi_timingpanel_step_append(const Edi_Build_Timing_Step *step)
+{
+   char duration[32];
+
+   _edi_timingpanel_duration_format(duration, sizeof(duration), step->end - step->start);
+   _edi_timingpanel_line_append(NULL, "   %10s  %s", duration, step->target);
+}
+
+static void
+_edi_timingpanel_report(const Edi_Build_Timing *timing)
+{
+   Edi_Build_Timing_Step *step, *first, *last;
+   Eina_List *l;
+   char wall[32], cpu[32], busy[32];
+   unsigned int i = 0;
+
+   _edi_timingpanel_duration_format(wall, sizeof(wall), timing->wall);
+   _edi_timingpanel_duration_format(cpu, sizeof(cpu), timing->cpu);
+   _edi_timingpanel_line_append(NULL, _("Build took %s, using %s of CPU time"), wall, cpu);
+
+   if (!timing->count)
+     {
+        _edi_timingpanel_line_append(NULL, _("No step timings are available for this build"));
+        return;
+     }
+
+   _edi_timingpanel_duration_format(busy, sizeof(busy), timing->busy);
+   _edi_timingpanel_line_append(NULL, _("%u steps took %s in total"), timing->count, busy);
+
+   _edi_timingpanel_line_append(NULL, "");
+   _edi_timingpanel_line_append(NULL, _("Slowest steps"));
+   EINA_LIST_FOREACH(timing->steps, l, step)
+     {
+        if (i++ == EDI_TIMINGPANEL_SLOWEST)
+          break;
+        _edi_timingpanel_step_append(step);
+     }
+
+   first = eina_list_data_get(timing->critical);
+   last = eina_list_last_data_get(timing->critical);
+   _edi_timingpanel_duration_format(busy, sizeof(busy), last->end - first->start);
+
+   _edi_timingpanel_line_append(NULL, "");
+   _edi_timingpanel_line_append(NULL, _("Critical path (estimated), %s over %u steps"), busy,
+                                eina_list_count(timing->critical));
+   EINA_LIST_FOREACH(timing->critical, l, step)
+     _edi_timingpanel_step_append(step);
+}
+
+static void
+_edi_timingpanel_history(void)
+{
+   Edi_Build_Timing *timing, *previous;
+   Eina_List *history, *l;
+   char when[32], wall[32], cpu[32], change[32];
+   double ratio;
+
+   history = edi_build_timing_history_get();
+   if (!history)
+     return;
+
+   _edi_timingpanel_line_append(NULL, "");
+   _edi_timingpanel_line_append(NULL, _("Recent builds"));
+
+   EINA_LIST_REVERSE_FOREACH(history, l, timing)
+     {
+        strftime(when, sizeof(when), "%Y-%m-%d %H:%M", localtime(&timing->when));
+        _edi_timingpanel_duration_format(wall, sizeof(wall), timing->wall);
+        _edi_timingpanel_duration_format(cpu, sizeof(cpu), timing->cpu);
+
+        change[0] = '\0';
+        ratio = 0.0;
+        previous = eina_list_data_get(eina_list_prev(l));
+        if (previous && previous->wall > 0.0)
+          {
+             ratio = (timing->wall - previous->wall) / previous->wall;
+             snprintf(change, sizeof(change), "%+.1f%%", ratio * 100.0);
+          }
+
+        _edi_timingpanel_line_append(ratio > EDI_TIMINGPANEL_REGRESSION ? _EDI_TIMING_SLOWER : NULL,
+                                     _("   %s  %10s wall  %10s CPU  %5u steps  %s"),
+                                     when, wall, cpu, timing->count, change);
+     }
+
+   EINA_LIST_FREE(history, timing)
+     edi_build_timing_free(timing);
+}
+
+void
+edi_timingpanel_build_begin(void)
+{
+   edi_build_timing_begin();
+}
+
+void
+edi_timingpanel_build_end(void)
+{
+   Edi_Build_Timing *timing;
+
+   timing = edi_build_timing_end();
+   if (!timing)
+     return;
+
+   elm_code_file_clear(_edi_timing_code->file);
+   _edi_timingpanel_report(timing);
+   _edi_timingpanel_history();
+
+   edi_build_timing_free(timing);
+}
+
+void
+edi_timingpanel_build_remote_end(void)
+{
+   elm_code_file_clear(_edi_timing_code->file);
+   _edi_timingpanel_line_append(NULL, _("This build ran in the process serving the project, step timings are shown there"));
+   _edi_timingpanel_history();
+}
+
+static void
+_edi_timingpanel_line_cb(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Elm_Code_Line *line;
+
+   line = (Elm_Code_Line *)event->info;
+
+   if (line->data)
+     line->status = ELM_CODE_STATUS_TYPE_WARNING;
+}
+
+static Eina_Bool
+_edi_timingpanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Eina_List *item;
+   Eo *widget;
+
+   EINA_LIST_FOREACH(_edi_timing_code->widgets, item, widget)
+     {
+        elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+        edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+void
+edi_timingpanel_add(Evas_Object *parent)
+{
+   Evas_Object *frame;
+   Elm_Code *code;
+   Elm_Code_Widget *widget;
+
+   code = elm_code_create();
+   _edi_timing_code = code;
+
+   frame = elm_frame_add(parent);
+   elm_object_text_set(frame, _("Build times"));
+   evas_object_size_hint_weight_set(frame, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(frame);
+
+   widget = elm_code_widget_add(parent, code);
+   elm_obj_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+   efl_event_callback_add(widget, &ELM_CODE_EVENT_LINE_LOAD_DONE, _edi_timingpanel_line_cb, NULL);
+
+   evas_object_size_hint_weight_set(widget, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(widget);
+
+   elm_object_content_set(frame, widget);
+   elm_box_pack_end(parent, frame);
+
+   ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_timingpanel_config_changed, NULL);
+}
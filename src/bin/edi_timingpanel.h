@@ -0,0 +1,75 @@
+#ifndef EDI_TIMINGPANEL_H_
+# define EDI_TIMINGPANEL_H_
+
+#include <Elementary.h>
+
+#include "Edi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for managing the Edi build timing panel.
+ */
+
+/**
+ * @brief UI management functions.
+ * @defgroup UI
+ *
+ * @{
+ *
+ * Initialisation and management of the build timing panel UI
+ *
+ */
+
+/**
+ * Initialise a new Edi timingpanel and add it to the parent panel.
+ *
+ * @param parent The panel into which the panel will be loaded.
+ *
+ * @ingroup UI
+ */
+void edi_timingpanel_add(Evas_Object *parent);
+
+/**
+ * Show the Edi timingpanel - animating on to screen if required.
+ *
+ * @ingroup UI
+ */
+void edi_timingpanel_show();
+
+/**
+ * Start timing a build of the current project.
+ *
+ * @ingroup UI
+ */
+void edi_timingpanel_build_begin(void);
+
+/**
+ * Report the timing of the build started with edi_timingpanel_build_begin.
+ *
+ * @ingroup UI
+ */
+void edi_timingpanel_build_end(void);
+
+/**
+ * Report a build of the current project that ran in another process.
+ *
+ * Only the history of the project's builds is shown, the step timings
+ * stay with the process that ran the build.
+ *
+ * @ingroup UI
+ */
+void edi_timingpanel_build_remote_end(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_TIMINGPANEL_H_ */
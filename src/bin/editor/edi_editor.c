@@ -10,6 +10,7 @@
 #include "edi_editor.h"
 
 #include "mainview/edi_mainview.h"
+#include "edi_consolepanel.h"
 #include "edi_content.h"
 #include "edi_filepanel.h"
 #include "edi_config.h"
@@ -148,6 +149,8 @@ edi_editor_save(Edi_Editor *editor)
    if (edi_language_provider_has(editor))
      edi_language_provider_get(editor)->refresh(editor);
 
+   edi_editor_blame_refresh(editor);
+
    ecore_event_add(EDI_EVENT_FILE_SAVED, NULL, NULL, NULL);
 }
 
@@ -165,11 +168,60 @@ _edi_editor_autosave_cb(void *data)
    return ECORE_CALLBACK_CANCEL;
 }
 
+// An entry of the editor's undo or redo stack.
+struct _Edi_Editor_Change
+{
+   unsigned int steps; /* Steps of the widget's own stack, or 0 for the lines below */
+   Eina_List *lines;   /* Edi_Editor_Line_Change, the lines the editor changed at once */
+};
+
+typedef struct _Edi_Editor_Line_Change
+{
+   unsigned int number;
+   const char *before, *after;
+} Edi_Editor_Line_Change;
+
 static void
-_changed_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+_edi_editor_change_free(Edi_Editor_Change *change)
 {
-   Edi_Editor *editor = data;
+   Edi_Editor_Line_Change *line;
+
+   EINA_LIST_FREE(change->lines, line)
+     {
+        eina_stringshare_del(line->before);
+        eina_stringshare_del(line->after);
+        free(line);
+     }
+   free(change);
+}
+
+static void
+_edi_editor_stack_clear(Eina_List **stack)
+{
+   Edi_Editor_Change *change;
+
+   EINA_LIST_FREE(*stack, change)
+     _edi_editor_change_free(change);
+}
+
+// Consecutive steps of the widget share one entry.
+static void
+_edi_editor_stack_step_push(Eina_List **stack)
+{
+   Edi_Editor_Change *change;
+
+   change = eina_list_last_data_get(*stack);
+   if (!change || !change->steps)
+     {
+        change = calloc(1, sizeof(Edi_Editor_Change));
+        *stack = eina_list_append(*stack, change);
+     }
+   change->steps++;
+}
 
+static void
+_edi_editor_modified(Edi_Editor *editor)
+{
    editor->modified = EINA_TRUE;
 
    if (editor->save_timer)
@@ -178,6 +230,21 @@ _changed_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUS
      editor->save_timer = ecore_timer_add(EDI_CONTENT_SAVE_TIMEOUT, _edi_editor_autosave_cb, editor);
 }
 
+static void
+_changed_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Editor *editor = data;
+
+   // An edit the widget recorded on its own stack, unless we are replaying one.
+   if (!editor->stepping)
+     {
+        _edi_editor_stack_step_push(&editor->undo_stack);
+        _edi_editor_stack_clear(&editor->redo_stack);
+     }
+
+   _edi_editor_modified(editor);
+}
+
 static char *
 _edi_editor_word_at_position_get(Edi_Editor *editor, unsigned int row, unsigned int col)
 {
@@ -792,6 +859,17 @@ _smart_cb_key_down(void *data EINA_UNUSED, Evas *e EINA_UNUSED,
           {
              edi_editor_save(editor);
           }
+        // Our stack holds changes the widget's does not, so it must not step on its own.
+        else if (!strcmp(ev->key, "z"))
+          {
+             ev->event_flags |= EVAS_EVENT_FLAG_ON_HOLD;
+             edi_editor_undo(editor);
+          }
+        else if (!strcmp(ev->key, "y"))
+          {
+             ev->event_flags |= EVAS_EVENT_FLAG_ON_HOLD;
+             edi_editor_redo(editor);
+          }
         else if (!strcmp(ev->key, "f"))
           {
              edi_editor_search(editor);
@@ -855,57 +933,235 @@ _smart_cb_key_down(void *data EINA_UNUSED, Evas *e EINA_UNUSED,
      }
 }
 
-#if HAVE_LIBCLANG
 static void
-_edi_range_color_set(Edi_Editor *editor, Edi_Range range, Elm_Code_Token_Type type)
+_edi_line_status_set(Edi_Editor *editor, unsigned int number, Elm_Code_Status_Type status,
+                     const char *text)
 {
    Elm_Code *code;
-   Elm_Code_Line *line, *extra_line;
-   unsigned int number;
+   Elm_Code_Line *line;
 
    ecore_thread_main_loop_begin();
 
    code = elm_code_widget_code_get(editor->entry);
-   line = elm_code_file_line_get(code->file, range.start.line);
+   line = elm_code_file_line_get(code->file, number);
+   if (!line)
+     {
+        if (text)
+          ERR("Status on invalid line %d (\"%s\")", number, text);
 
-   elm_code_line_token_add(line, range.start.col - 1, range.end.col - 2,
-                           range.end.line - range.start.line + 1, type);
+        ecore_thread_main_loop_end();
+        return;
+     }
+
+   elm_code_line_status_set(line, status);
+   if (text)
+     elm_code_line_status_text_set(line, text);
 
    elm_code_widget_line_refresh(editor->entry, line);
-   for (number = line->number + 1; number <= range.end.line; number++)
+
+   ecore_thread_main_loop_end();
+}
+
+void
+edi_editor_change_begin(Edi_Editor *editor)
+{
+   if (!editor->change)
+     editor->change = calloc(1, sizeof(Edi_Editor_Change));
+}
+
+void
+edi_editor_line_text_set(Edi_Editor *editor, unsigned int number, const char *text, unsigned int length)
+{
+   Edi_Editor_Line_Change *change;
+   Elm_Code_Line *line;
+   const char *before;
+   unsigned int before_length;
+
+   line = elm_code_file_line_get(elm_code_widget_code_get(editor->entry)->file, number);
+   if (!line)
+     return;
+
+   before = elm_code_line_text_get(line, &before_length);
+
+   change = calloc(1, sizeof(Edi_Editor_Line_Change));
+   change->number = number;
+   change->before = eina_stringshare_add_length(before ? before : "", before ? before_length : 0);
+   change->after = eina_stringshare_add_length(text, length);
+   editor->change->lines = eina_list_append(editor->change->lines, change);
+
+   elm_code_line_text_set(line, text, length);
+}
+
+void
+edi_editor_change_end(Edi_Editor *editor)
+{
+   Edi_Editor_Change *change;
+
+   change = editor->change;
+   editor->change = NULL;
+   if (!change->lines)
      {
-        extra_line = elm_code_file_line_get(code->file, number);
-        elm_code_widget_line_refresh(editor->entry, extra_line);
+        free(change);
+        return;
      }
 
-   ecore_thread_main_loop_end();
+   editor->undo_stack = eina_list_append(editor->undo_stack, change);
+   _edi_editor_stack_clear(&editor->redo_stack);
+   _edi_editor_modified(editor);
+
+   // The widget reports its own edits only.
+   ecore_event_add(EDI_EVENT_FILE_CHANGED, NULL, NULL, NULL);
 }
 
 static void
-_edi_line_status_set(Edi_Editor *editor, unsigned int number, Elm_Code_Status_Type status,
-                     const char *text)
+_edi_editor_lines_apply(Edi_Editor *editor, Edi_Editor_Change *change, Eina_Bool undo)
 {
-   Elm_Code *code;
+   Edi_Editor_Line_Change *line_change;
    Elm_Code_Line *line;
+   Elm_Code *code;
+   Eina_List *l;
+   const char *text;
 
-   ecore_thread_main_loop_begin();
+   code = elm_code_widget_code_get(editor->entry);
+   EINA_LIST_FOREACH(change->lines, l, line_change)
+     {
+        line = elm_code_file_line_get(code->file, line_change->number);
+        if (!line)
+          continue;
+
+        text = undo ? line_change->before : line_change->after;
+        elm_code_line_text_set(line, text, eina_stringshare_strlen(text));
+     }
+}
+
+// Take the change on top of one stack and move it to the other, in the order it was made.
+static void
+_edi_editor_stack_step(Edi_Editor *editor, Eina_List **from, Eina_List **to, Eina_Bool undo)
+{
+   Edi_Editor_Change *change;
+
+   while ((change = eina_list_last_data_get(*from)))
+     {
+        if (!change->steps)
+          {
+             *from = eina_list_remove(*from, change);
+             _edi_editor_lines_apply(editor, change, undo);
+             *to = eina_list_append(*to, change);
+             _edi_editor_modified(editor);
+             ecore_event_add(EDI_EVENT_FILE_CHANGED, NULL, NULL, NULL);
+             break;
+          }
+
+        // Steps the widget merged or dropped itself are not there to take.
+        if (undo ? !elm_code_widget_can_undo_get(editor->entry) : !elm_code_widget_can_redo_get(editor->entry))
+          {
+             *from = eina_list_remove(*from, change);
+             _edi_editor_change_free(change);
+             continue;
+          }
+
+        editor->stepping = EINA_TRUE;
+        if (undo)
+          elm_code_widget_undo(editor->entry);
+        else
+          elm_code_widget_redo(editor->entry);
+        editor->stepping = EINA_FALSE;
+
+        if (!--change->steps)
+          {
+             *from = eina_list_remove(*from, change);
+             free(change);
+          }
+        _edi_editor_stack_step_push(to);
+        break;
+     }
+}
+
+void
+edi_editor_undo(Edi_Editor *editor)
+{
+   _edi_editor_stack_step(editor, &editor->undo_stack, &editor->redo_stack, EINA_TRUE);
+}
+
+void
+edi_editor_redo(Edi_Editor *editor)
+{
+   _edi_editor_stack_step(editor, &editor->redo_stack, &editor->undo_stack, EINA_FALSE);
+}
+
+Eina_Bool
+edi_editor_can_undo(Edi_Editor *editor)
+{
+   return !!editor->undo_stack;
+}
+
+Eina_Bool
+edi_editor_can_redo(Edi_Editor *editor)
+{
+   return !!editor->redo_stack;
+}
+
+void
+edi_editor_diagnostics_show(Edi_Editor *editor, const Eina_List *diagnostics)
+{
+   const Eina_List *l;
+   Edi_Diagnostic *diagnostic;
+
+   EINA_LIST_FOREACH(diagnostics, l, diagnostic)
+     {
+        if (diagnostic->severity == EDI_DIAGNOSTIC_SEVERITY_NOTE)
+          continue;
+
+        _edi_line_status_set(editor, diagnostic->line,
+                             diagnostic->severity == EDI_DIAGNOSTIC_SEVERITY_ERROR ?
+                             ELM_CODE_STATUS_TYPE_ERROR : ELM_CODE_STATUS_TYPE_WARNING,
+                             diagnostic->message);
+     }
+}
+
+void
+edi_editor_diagnostics_hide(Edi_Editor *editor, const Eina_List *diagnostics)
+{
+   const Eina_List *l;
+   Edi_Diagnostic *diagnostic;
+   Elm_Code *code;
+   Elm_Code_Line *line;
 
    code = elm_code_widget_code_get(editor->entry);
-   line = elm_code_file_line_get(code->file, number);
-   if (!line)
+   EINA_LIST_FOREACH(diagnostics, l, diagnostic)
      {
-        if (text)
-          ERR("Status on invalid line %d (\"%s\")", number, text);
+        line = elm_code_file_line_get(code->file, diagnostic->line);
+        if (!line)
+          continue;
 
-        ecore_thread_main_loop_end();
-        return;
+        elm_code_line_status_set(line, ELM_CODE_STATUS_TYPE_DEFAULT);
+        elm_code_line_status_text_set(line, NULL);
+        elm_code_widget_line_refresh(editor->entry, line);
      }
+}
 
-   elm_code_line_status_set(line, status);
-   if (text)
-     elm_code_line_status_text_set(line, text);
+#if HAVE_LIBCLANG
+static void
+_edi_range_color_set(Edi_Editor *editor, Edi_Range range, Elm_Code_Token_Type type)
+{
+   Elm_Code *code;
+   Elm_Code_Line *line, *extra_line;
+   unsigned int number;
+
+   ecore_thread_main_loop_begin();
+
+   code = elm_code_widget_code_get(editor->entry);
+   line = elm_code_file_line_get(code->file, range.start.line);
+
+   elm_code_line_token_add(line, range.start.col - 1, range.end.col - 2,
+                           range.end.line - range.start.line + 1, type);
 
    elm_code_widget_line_refresh(editor->entry, line);
+   for (number = line->number + 1; number <= range.end.line; number++)
+     {
+        extra_line = elm_code_file_line_get(code->file, number);
+        elm_code_widget_line_refresh(editor->entry, extra_line);
+     }
 
    ecore_thread_main_loop_end();
 }
@@ -1196,6 +1452,7 @@ _edi_editor_config_changed(void *data, int type EINA_UNUSED, void *event EINA_UN
 {
    Elm_Code_Widget *widget;
    Elm_Code *code;
+   Edi_Editor *editor;
 
    widget = (Elm_Code_Widget *) data;
    code = elm_code_widget_code_get(widget);
@@ -1210,6 +1467,10 @@ _edi_editor_config_changed(void *data, int type EINA_UNUSED, void *event EINA_UN
    elm_obj_code_widget_line_width_marker_set(widget, _edi_project_config->gui.width_marker);
    elm_obj_code_widget_tabstop_set(widget, _edi_project_config->gui.tabstop);
 
+   editor = evas_object_data_get(widget, "editor");
+   if (editor)
+     edi_editor_blame_set(editor, _edi_project_config->gui.show_blame);
+
    return ECORE_CALLBACK_RENEW;
 }
 
@@ -1227,6 +1488,9 @@ _editor_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *o, void *event_info
 
    ecore_event_handler_del(ev_handler);
 
+   _edi_editor_stack_clear(&editor->undo_stack);
+   _edi_editor_stack_clear(&editor->redo_stack);
+
    if (edi_language_provider_has(editor))
      edi_language_provider_get(editor)->del(editor);
 }
@@ -1244,6 +1508,9 @@ edi_editor_reload(Edi_Editor *editor)
    elm_code_file_clear(code->file);
    code->file = elm_code_file_open(code, path);
    editor->modified = EINA_FALSE;
+   // The changes in the stacks were made to the text that is gone.
+   _edi_editor_stack_clear(&editor->undo_stack);
+   _edi_editor_stack_clear(&editor->redo_stack);
    editor->save_time = ecore_file_mod_time(path);
 
    if (editor->save_timer)
@@ -1252,6 +1519,8 @@ edi_editor_reload(Edi_Editor *editor)
         editor->save_timer = NULL;
      }
 
+   edi_editor_blame_refresh(editor);
+
    free(path);
    ecore_thread_main_loop_end();
 }
@@ -1396,6 +1665,8 @@ edi_editor_add(Evas_Object *parent, Edi_Mainview_Item *item)
 
    edi_content_statusbar_add(statusbar, item);
    edi_editor_search_add(searchbar, editor);
+   edi_editor_blame_set(editor, _edi_project_config->gui.show_blame);
+   edi_editor_diagnostics_show(editor, edi_problemspanel_diagnostics_get(item->path));
 
    e = evas_object_evas_get(widget);
    ctrl = evas_key_modifier_mask_get(e, "Control");
@@ -26,6 +26,18 @@ extern "C" {
  */
 typedef struct _Edi_Editor_Search Edi_Editor_Search;
 
+/**
+ * @typedef Edi_Editor_Blame
+ * An instance of an editor blame gutter.
+ */
+typedef struct _Edi_Editor_Blame Edi_Editor_Blame;
+
+/**
+ * @typedef Edi_Editor_Change
+ * A change on the undo or redo stack of an editor.
+ */
+typedef struct _Edi_Editor_Change Edi_Editor_Change;
+
 /**
  * @typedef Edi_Editor
  * An instance of an editor view.
@@ -44,6 +56,7 @@ struct _Edi_Editor
    Evas_Object *doc_popup; /**< The popup for documentation */
    Evas_Object *popup;
    Eina_List *undo_stack; /**< The list of operations that can be undone */
+   Eina_List *redo_stack; /**< The list of operations that can be redone */
    Eina_List *suggest_list; /**< The list of all possible suggestions for the file */
 
    /* Private */
@@ -68,6 +81,10 @@ struct _Edi_Editor
    const char *mimetype;
 
    /* Add new members here. */
+   Edi_Editor_Blame *blame;
+
+   Edi_Editor_Change *change; /**< The change being made between edi_editor_change_begin and _end */
+   Eina_Bool stepping; /**< The widget is undoing or redoing a step of its own */
 };
 
 /**
@@ -127,6 +144,45 @@ void edi_editor_search_add(Evas_Object *parent, Edi_Editor *editor);
  */
 void edi_editor_search(Edi_Editor *editor);
 
+/**
+ * Show or hide the line authors gutter of the specified editor.
+ *
+ * @param editor the text editor instance to annotate.
+ * @param enabled whether the gutter should be shown.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_blame_set(Edi_Editor *editor, Eina_Bool enabled);
+
+/**
+ * Recompute the line authors of the specified editor from the repository.
+ *
+ * @param editor the text editor instance to annotate.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_blame_refresh(Edi_Editor *editor);
+
+/**
+ * Mark the lines that build diagnostics were reported on in the specified editor.
+ *
+ * @param editor the text editor instance to annotate.
+ * @param diagnostics the list of Edi_Diagnostic reported for the file of the editor.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_diagnostics_show(Edi_Editor *editor, const Eina_List *diagnostics);
+
+/**
+ * Remove the marks of build diagnostics from the specified editor.
+ *
+ * @param editor the text editor instance to clean up.
+ * @param diagnostics the list of Edi_Diagnostic that were shown.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_diagnostics_hide(Edi_Editor *editor, const Eina_List *diagnostics);
+
 /**
  * Save the content of the specified editor.
  *
@@ -136,6 +192,76 @@ void edi_editor_search(Edi_Editor *editor);
  */
 void edi_editor_save(Edi_Editor *editor);
 
+/**
+ * Start a change of the editor's lines that undoes, and redoes, as one.
+ *
+ * @param editor the text editor instance to change.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_change_begin(Edi_Editor *editor);
+
+/**
+ * Set the text of a line as part of the change started with edi_editor_change_begin.
+ *
+ * The line is changed in the file directly, rather than edited through the widget.
+ *
+ * @param editor the text editor instance to change.
+ * @param number the number of the line, starting at 1.
+ * @param text the new text of the line.
+ * @param length the length of the text in bytes.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_line_text_set(Edi_Editor *editor, unsigned int number, const char *text, unsigned int length);
+
+/**
+ * Finish the change started with edi_editor_change_begin and put it on the undo stack.
+ *
+ * @param editor the text editor instance that was changed.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_change_end(Edi_Editor *editor);
+
+/**
+ * Undo the last change of the editor.
+ *
+ * @param editor the text editor instance to undo.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_undo(Edi_Editor *editor);
+
+/**
+ * Redo the last change undone in the editor.
+ *
+ * @param editor the text editor instance to redo.
+ *
+ * @ingroup Widgets
+ */
+void edi_editor_redo(Edi_Editor *editor);
+
+/**
+ * Whether the editor has a change to undo.
+ *
+ * @param editor the text editor instance.
+ * @return EINA_TRUE if edi_editor_undo would undo a change.
+ *
+ * @ingroup Widgets
+ */
+Eina_Bool edi_editor_can_undo(Edi_Editor *editor);
+
+/**
+ * Whether the editor has a change to redo.
+ *
+ * @param editor the text editor instance.
+ * @return EINA_TRUE if edi_editor_redo would redo a change.
+ *
+ * @ingroup Widgets
+ */
+Eina_Bool edi_editor_can_redo(Edi_Editor *editor);
+
 /**
  * Open the document of the entity where the cursor is located.
  *
@@ -0,0 +1,885 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Elementary.h>
+
+#include "Edi.h"
+#include "edi_editor.h"
+#include "edi_config.h"
+
+#include "edi_private.h"
+
+#define EDI_BLAME_NONE UINT_MAX
+#define EDI_BLAME_WIDTH 24
+#define EDI_BLAME_AUTHOR_WIDTH 12
+#define EDI_BLAME_BATCH_TIME (1.0 / 30.0)
+#define EDI_BLAME_CACHE_MAGIC "edi-blame 1"
+
+typedef struct _Edi_Editor_Blame_Commit
+{
+   Eina_Stringshare *id;
+   Eina_Stringshare *author;
+   Eina_Stringshare *summary;
+   long long time;
+} Edi_Editor_Blame_Commit;
+
+/* A range of lines of the file as of HEAD, as stored in the cache */
+typedef struct _Edi_Editor_Blame_Range
+{
+   unsigned int line;
+   unsigned int count;
+   unsigned int commit;
+} Edi_Editor_Blame_Range;
+
+typedef struct _Edi_Editor_Blame_Row
+{
+   unsigned int row;
+   unsigned int commit;
+} Edi_Editor_Blame_Row;
+
+/* A hunk of the diff from HEAD to the file on disk */
+typedef struct _Edi_Editor_Blame_Hunk
+{
+   unsigned int end;    /* The last line of HEAD at or before the hunk */
+   unsigned int start;
+   unsigned int count;
+   int offset;          /* The line offset after the hunk */
+} Edi_Editor_Blame_Hunk;
+
+struct _Edi_Editor_Blame
+{
+   Edi_Editor *editor;
+   Evas_Object *bg, *clip;
+   Eina_List *texts;
+   Evas_Coord char_width;
+
+   Eina_Inarray *commits;
+   Eina_Inarray *rows;
+
+   Ecore_Thread *thread;
+   Ecore_Job *redraw_job;
+   unsigned int generation;
+   unsigned int jobs;
+   Eina_Bool deleted;
+};
+
+typedef struct _Edi_Editor_Blame_Batch
+{
+   unsigned int generation;
+   Eina_Inarray *commits;
+   Eina_Inarray *rows;
+} Edi_Editor_Blame_Batch;
+
+typedef struct _Edi_Editor_Blame_Job
+{
+   Edi_Editor_Blame *blame;
+   Ecore_Thread *thread;
+   unsigned int generation;
+   unsigned int lines;
+   char *escaped, *relative;
+
+   Eina_Inarray *hunks;
+   Eina_Inarray *ranges;
+   Eina_Inarray *commits;
+   Eina_Hash *commit_ids;
+
+   Edi_Editor_Blame_Batch *batch;
+   double flushed;
+} Edi_Editor_Blame_Job;
+
+static void _edi_editor_blame_redraw_queue(Edi_Editor_Blame *blame);
+
+static void
+_edi_editor_blame_commits_clear(Eina_Inarray *commits)
+{
+   Edi_Editor_Blame_Commit *commit;
+
+   EINA_INARRAY_FOREACH(commits, commit)
+     {
+        eina_stringshare_del(commit->id);
+        eina_stringshare_del(commit->author);
+        eina_stringshare_del(commit->summary);
+     }
+   eina_inarray_flush(commits);
+}
+
+static Edi_Editor_Blame_Batch *
+_edi_editor_blame_batch_new(unsigned int generation)
+{
+   Edi_Editor_Blame_Batch *batch;
+
+   batch = calloc(1, sizeof(Edi_Editor_Blame_Batch));
+   batch->generation = generation;
+   batch->commits = eina_inarray_new(sizeof(Edi_Editor_Blame_Commit), 16);
+   batch->rows = eina_inarray_new(sizeof(Edi_Editor_Blame_Row), 256);
+
+   return batch;
+}
+
+static void
+_edi_editor_blame_batch_free(Edi_Editor_Blame_Batch *batch)
+{
+   if (!batch)
+     return;
+
+   _edi_editor_blame_commits_clear(batch->commits);
+   eina_inarray_free(batch->commits);
+   eina_inarray_free(batch->rows);
+   free(batch);
+}
+
+static void
+_edi_editor_blame_flush(Edi_Editor_Blame_Job *job)
+{
+   Edi_Editor_Blame_Batch *batch = job->batch;
+
+   job->flushed = ecore_time_get();
+   if (!eina_inarray_count(batch->commits) && !eina_inarray_count(batch->rows))
+     return;
+
+   if (ecore_thread_feedback(job->thread, batch))
+     job->batch = _edi_editor_blame_batch_new(job->generation);
+}
+
+static char *
+_edi_editor_blame_cache_path_get(Edi_Editor_Blame_Job *job, const char *head)
+{
+   return eina_strdup_printf("%s/%s/blame/%s-%08x", efreet_cache_home_get(), PACKAGE_NAME, head,
+                             (unsigned int) eina_hash_superfast(job->relative, strlen(job->relative)));
+}
+
+// Map a line of HEAD to the file on disk, 0 if the line was changed since.
+static unsigned int
+_edi_editor_blame_line_map(Eina_Inarray *hunks, unsigned int line)
+{
+   Edi_Editor_Blame_Hunk *hunk;
+   unsigned int low = 0, high = eina_inarray_count(hunks), mid;
+   int offset = 0;
+
+   while (low < high)
+     {
+        mid = low + (high - low) / 2;
+        hunk = eina_inarray_nth(hunks, mid);
+        if (hunk->end < line)
+          low = mid + 1;
+        else
+          high = mid;
+     }
+
+   if (low > 0)
+     offset = ((Edi_Editor_Blame_Hunk *) eina_inarray_nth(hunks, low - 1))->offset;
+
+   if (low < eina_inarray_count(hunks))
+     {
+        hunk = eina_inarray_nth(hunks, low);
+        if (hunk->count && hunk->start <= line)
+          return 0;
+     }
+
+   return line + offset;
+}
+
+static Eina_Bool
+_edi_editor_blame_diff_line_cb(void *data, const char *line, size_t length)
+{
+   Edi_Editor_Blame_Job *job = data;
+   Edi_Editor_Blame_Hunk hunk, *last;
+   unsigned long start, count, new_count;
+   char *pos;
+
+   if (ecore_thread_check(job->thread))
+     return EINA_FALSE;
+
+   if (length < 4 || strncmp(line, "@@ -", 4))
+     return EINA_TRUE;
+
+   // A hunk header reads @@ -start[,count] +start[,count] @@
+   start = strtoul(line + 4, &pos, 10);
+   count = 1;
+   if (*pos == ',')
+     count = strtoul(pos + 1, &pos, 10);
+   if (*pos != ' ' || pos[1] != '+')
+     return EINA_TRUE;
+
+   strtoul(pos + 2, &pos, 10);
+   new_count = 1;
+   if (*pos == ',')
+     new_count = strtoul(pos + 1, &pos, 10);
+
+   hunk.start = start;
+   hunk.count = count;
+   hunk.end = count ? start + count - 1 : start;
+   hunk.offset = (int) new_count - (int) count;
+
+   last = eina_inarray_count(job->hunks) ? eina_inarray_nth(job->hunks, eina_inarray_count(job->hunks) - 1) : NULL;
+   if (last)
+     hunk.offset += last->offset;
+
+   eina_inarray_push(job->hunks, &hunk);
+
+   return EINA_TRUE;
+}
+
+static unsigned int
+_edi_editor_blame_commit_add(Edi_Editor_Blame_Job *job, const char *id, const char *author,
+                             const char *summary, long long time)
+{
+   Edi_Editor_Blame_Commit commit;
+   uintptr_t index;
+
+   index = (uintptr_t) eina_hash_find(job->commit_ids, id);
+   if (index)
+     return index - 1;
+
+   commit.id = eina_stringshare_add(id);
+   commit.author = eina_stringshare_add(author);
+   commit.summary = eina_stringshare_add(summary);
+   commit.time = time;
+   eina_inarray_push(job->commits, &commit);
+
+   commit.id = eina_stringshare_ref(commit.id);
+   commit.author = eina_stringshare_ref(commit.author);
+   commit.summary = eina_stringshare_ref(commit.summary);
+   eina_inarray_push(job->batch->commits, &commit);
+
+   index = eina_inarray_count(job->commits);
+   eina_hash_add(job->commit_ids, id, (void *) index);
+
+   return index - 1;
+}
+
+static void
+_edi_editor_blame_range_add(Edi_Editor_Blame_Job *job, Edi_Editor_Blame_Range *range)
+{
+   Edi_Editor_Blame_Row row;
+   unsigned int i, mapped;
+
+   eina_inarray_push(job->ranges, range);
+
+   row.commit = range->commit;
+   for (i = 0; i < range->count; i++)
+     {
+        mapped = _edi_editor_blame_line_map(job->hunks, range->line + i);
+        if (!mapped || mapped > job->lines)
+          continue;
+
+        row.row = mapped;
+        eina_inarray_push(job->batch->rows, &row);
+     }
+
+   if (ecore_time_get() - job->flushed >= EDI_BLAME_BATCH_TIME)
+     _edi_editor_blame_flush(job);
+}
+
+static Eina_Bool
+_edi_editor_blame_range_cb(void *data, const Edi_Scm_Blame_Range *scm_range)
+{
+   Edi_Editor_Blame_Job *job = data;
+   Edi_Editor_Blame_Range range;
+
+   if (ecore_thread_check(job->thread))
+     return EINA_FALSE;
+
+   range.line = scm_range->line;
+   range.count = scm_range->count;
+   range.commit = _edi_editor_blame_commit_add(job, scm_range->id, scm_range->author,
+                                               scm_range->summary, scm_range->time);
+   _edi_editor_blame_range_add(job, &range);
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_editor_blame_cache_value_write(FILE *f, const char *value)
+{
+   for (; *value; value++)
+     fputc((*value == '\t' || *value == '\n') ? ' ' : *value, f);
+}
+
+static void
+_edi_editor_blame_cache_write(Edi_Editor_Blame_Job *job, const char *head)
+{
+   Edi_Editor_Blame_Commit *commit;
+   Edi_Editor_Blame_Range *range;
+   char *path, *dir, *tmp;
+   FILE *f;
+   int fd;
+
+   path = _edi_editor_blame_cache_path_get(job, head);
+   dir = ecore_file_dir_get(path);
+   if (!ecore_file_exists(dir) && !ecore_file_mkpath(dir))
+     {
+        free(dir);
+        free(path);
+        return;
+     }
+   free(dir);
+
+   // Write to a temporary file so a reader never sees a partial cache.
+   tmp = eina_strdup_printf("%s.XXXXXX", path);
+   fd = mkstemp(tmp);
+   if (fd < 0 || !(f = fdopen(fd, "w")))
+     {
+        if (fd >= 0)
+          close(fd);
+        free(tmp);
+        free(path);
+        return;
+     }
+
+   fprintf(f, "%s\n%s\n", EDI_BLAME_CACHE_MAGIC, job->relative);
+   EINA_INARRAY_FOREACH(job->commits, commit)
+     {
+        fprintf(f, "c %lld %s ", commit->time, commit->id);
+        _edi_editor_blame_cache_value_write(f, commit->author);
+        fputc('\t', f);
+        _edi_editor_blame_cache_value_write(f, commit->summary);
+        fputc('\n', f);
+     }
+   EINA_INARRAY_FOREACH(job->ranges, range)
+     fprintf(f, "r %u %u %u\n", range->line, range->count, range->commit);
+
+   if (fclose(f) || rename(tmp, path))
+     ecore_file_unlink(tmp);
+
+   free(tmp);
+   free(path);
+}
+
+static Eina_Bool
+_edi_editor_blame_cache_read(Edi_Editor_Blame_Job *job, const char *head)
+{
+   Edi_Editor_Blame_Range range;
+   Eina_File_Line *line;
+   Eina_Iterator *it;
+   Eina_File *file;
+   char *path, *text, *id, *author, *summary, *pos;
+   unsigned int number = 0, commits = 0;
+   long long time;
+   Eina_Bool valid = EINA_TRUE;
+
+   path = _edi_editor_blame_cache_path_get(job, head);
+   file = eina_file_open(path, EINA_FALSE);
+   free(path);
+   if (!file)
+     return EINA_FALSE;
+
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        if (ecore_thread_check(job->thread))
+          break;
+
+        text = malloc(line->length + 1);
+        memcpy(text, line->start, line->length);
+        text[line->length] = '\0';
+        number++;
+
+        if (number == 1)
+          valid = !strcmp(text, EDI_BLAME_CACHE_MAGIC);
+        else if (number == 2)
+          valid = !strcmp(text, job->relative);
+        else if (text[0] == 'c' && text[1] == ' ')
+          {
+             time = strtoll(text + 2, &pos, 10);
+             id = pos + 1;
+             author = strchr(id, ' ');
+             summary = author ? strchr(author + 1, '\t') : NULL;
+             valid = summary != NULL;
+             if (valid)
+               {
+                  *author++ = '\0';
+                  *summary++ = '\0';
+                  _edi_editor_blame_commit_add(job, id, author, summary, time);
+                  commits++;
+               }
+          }
+        else if (text[0] == 'r' && text[1] == ' ')
+          {
+             valid = sscanf(text + 2, "%u %u %u", &range.line, &range.count, &range.commit) == 3 &&
+                     range.commit < commits;
+             if (valid)
+               _edi_editor_blame_range_add(job, &range);
+          }
+
+        free(text);
+        if (!valid)
+          break;
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+
+   // Anything already sent is replaced when the caller falls back to git blame.
+   return valid && number > 2;
+}
+
+static void
+_edi_editor_blame_thread_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Editor_Blame_Job *job = data;
+   Eina_Stringshare *head;
+
+   job->thread = thread;
+   job->flushed = ecore_time_get();
+
+   head = edi_scm_head_id_get();
+   if (!head)
+     return;
+
+   edi_scm_diff_head_foreach(job->escaped, _edi_editor_blame_diff_line_cb, job);
+
+   if (!ecore_thread_check(thread) && !_edi_editor_blame_cache_read(job, head))
+     {
+        eina_inarray_flush(job->ranges);
+        eina_inarray_flush(job->batch->rows);
+        if (!edi_scm_blame_foreach(job->escaped, _edi_editor_blame_range_cb, job) &&
+            !ecore_thread_check(thread))
+          _edi_editor_blame_cache_write(job, head);
+     }
+
+   eina_stringshare_del(head);
+
+   if (!ecore_thread_check(thread))
+     _edi_editor_blame_flush(job);
+}
+
+static void
+_edi_editor_blame_free(Edi_Editor_Blame *blame)
+{
+   _edi_editor_blame_commits_clear(blame->commits);
+   eina_inarray_free(blame->commits);
+   eina_inarray_free(blame->rows);
+   free(blame);
+}
+
+static void
+_edi_editor_blame_job_free(Edi_Editor_Blame_Job *job, Ecore_Thread *thread)
+{
+   Edi_Editor_Blame *blame = job->blame;
+
+   if (blame->thread == thread)
+     blame->thread = NULL;
+   blame->jobs--;
+
+   _edi_editor_blame_batch_free(job->batch);
+   _edi_editor_blame_commits_clear(job->commits);
+   eina_inarray_free(job->commits);
+   eina_inarray_free(job->ranges);
+   eina_inarray_free(job->hunks);
+   eina_hash_free(job->commit_ids);
+   free(job->escaped);
+   free(job->relative);
+   free(job);
+
+   if (blame->deleted && !blame->jobs)
+     _edi_editor_blame_free(blame);
+}
+
+static void
+_edi_editor_blame_thread_notify_cb(void *data, Ecore_Thread *thread EINA_UNUSED, void *msg)
+{
+   Edi_Editor_Blame_Job *job = data;
+   Edi_Editor_Blame_Batch *batch = msg;
+   Edi_Editor_Blame *blame = job->blame;
+   Edi_Editor_Blame_Commit *commit;
+   Edi_Editor_Blame_Row *row;
+   unsigned int *slot;
+
+   if (blame->deleted || batch->generation != blame->generation)
+     {
+        _edi_editor_blame_batch_free(batch);
+        return;
+     }
+
+   // Commit references move to the session, rows index the session commits.
+   EINA_INARRAY_FOREACH(batch->commits, commit)
+     eina_inarray_push(blame->commits, commit);
+   eina_inarray_flush(batch->commits);
+
+   EINA_INARRAY_FOREACH(batch->rows, row)
+     {
+        slot = eina_inarray_nth(blame->rows, row->row - 1);
+        if (slot)
+          *slot = row->commit;
+     }
+
+   _edi_editor_blame_batch_free(batch);
+   _edi_editor_blame_redraw_queue(blame);
+}
+
+static void
+_edi_editor_blame_thread_end_cb(void *data, Ecore_Thread *thread)
+{
+   _edi_editor_blame_job_free(data, thread);
+}
+
+static void
+_edi_editor_blame_thread_cancel_cb(void *data, Ecore_Thread *thread)
+{
+   _edi_editor_blame_job_free(data, thread);
+}
+
+static void
+_edi_editor_blame_start(Edi_Editor_Blame *blame)
+{
+   Edi_Editor_Blame_Job *job;
+   Elm_Code *code;
+   const char *path, *root;
+   unsigned int i, none = EDI_BLAME_NONE;
+   size_t len;
+
+   blame->generation++;
+   if (blame->thread)
+     {
+        ecore_thread_cancel(blame->thread);
+        blame->thread = NULL;
+     }
+
+   code = elm_code_widget_code_get(blame->editor->entry);
+   _edi_editor_blame_commits_clear(blame->commits);
+   eina_inarray_flush(blame->rows);
+   for (i = 0; i < elm_code_file_lines_get(code->file); i++)
+     eina_inarray_push(blame->rows, &none);
+   _edi_editor_blame_redraw_queue(blame);
+
+   path = elm_code_file_path_get(code->file);
+   root = edi_scm_root_directory_get();
+   len = root ? strlen(root) : 0;
+   if (!path || !root || strncmp(path, root, len) || path[len] != '/')
+     return;
+
+   job = calloc(1, sizeof(Edi_Editor_Blame_Job));
+   job->blame = blame;
+   job->generation = blame->generation;
+   job->lines = eina_inarray_count(blame->rows);
+   job->escaped = ecore_file_escape_name(path);
+   job->relative = strdup(path + len + 1);
+   job->hunks = eina_inarray_new(sizeof(Edi_Editor_Blame_Hunk), 16);
+   job->ranges = eina_inarray_new(sizeof(Edi_Editor_Blame_Range), 64);
+   job->commits = eina_inarray_new(sizeof(Edi_Editor_Blame_Commit), 16);
+   job->commit_ids = eina_hash_string_superfast_new(NULL);
+   job->batch = _edi_editor_blame_batch_new(job->generation);
+
+   blame->jobs++;
+   blame->thread = ecore_thread_feedback_run(_edi_editor_blame_thread_cb, _edi_editor_blame_thread_notify_cb,
+                                             _edi_editor_blame_thread_end_cb, _edi_editor_blame_thread_cancel_cb,
+                                             job, EINA_FALSE);
+}
+
+static void
+_edi_editor_blame_text_get(Edi_Editor_Blame *blame, unsigned int index, char *text, size_t size)
+{
+   Edi_Editor_Blame_Commit *commit;
+   const char *author;
+   char date[16];
+   struct tm tm;
+   time_t time;
+   int idx = 0, chars = 0;
+
+   if (index == EDI_BLAME_NONE)
+     {
+        snprintf(text, size, "%s", _("Not committed"));
+        return;
+     }
+
+   commit = eina_inarray_nth(blame->commits, index);
+   if (!commit)
+     {
+        text[0] = '\0';
+        return;
+     }
+
+   // Cut the author name on a character boundary to keep the date aligned.
+   author = commit->author;
+   while (author[idx] && chars < EDI_BLAME_AUTHOR_WIDTH)
+     {
+        eina_unicode_utf8_next_get(author, &idx);
+        chars++;
+     }
+
+   time = (time_t) commit->time;
+   localtime_r(&time, &tm);
+   strftime(date, sizeof(date), "%Y-%m-%d", &tm);
+
+   snprintf(text, size, "%.*s%*s %s", idx, author, EDI_BLAME_AUTHOR_WIDTH - chars, "", date);
+}
+
+static Evas_Object *
+_edi_editor_blame_text_nth(Edi_Editor_Blame *blame, unsigned int i)
+{
+   Evas_Object *text;
+
+   text = eina_list_nth(blame->texts, i);
+   if (text)
+     return text;
+
+   text = evas_object_text_add(evas_object_evas_get(blame->bg));
+   evas_object_text_font_set(text, _edi_project_config->font.name, _edi_project_config->font.size);
+   evas_object_color_set(text, 160, 160, 160, 255);
+   evas_object_clip_set(text, blame->clip);
+   evas_object_pass_events_set(text, EINA_TRUE);
+   blame->texts = eina_list_append(blame->texts, text);
+
+   return text;
+}
+
+static void
+_edi_editor_blame_redraw(void *data)
+{
+   Edi_Editor_Blame *blame = data;
+   Evas_Object *text;
+   Evas_Coord x, y, w, h, ey, cx, cy, cw, ch;
+   unsigned int row, count, i = 0, *commit, previous = EDI_BLAME_NONE - 1;
+   int col;
+   char label[128];
+   Eina_List *l;
+
+   blame->redraw_job = NULL;
+   if (!blame->bg)
+     return;
+
+   evas_object_geometry_get(blame->bg, &x, &y, &w, &h);
+   evas_object_move(blame->clip, x, y);
+   evas_object_resize(blame->clip, w, h);
+
+   evas_object_geometry_get(blame->editor->entry, NULL, &ey, NULL, NULL);
+   count = eina_inarray_count(blame->rows);
+   if (!elm_code_widget_position_at_coordinates_get(blame->editor->entry, x + w + 1, ey + 1, &row, &col))
+     row = 1;
+
+   // Only the rows on screen get a text object, the first of each range is labelled.
+   for (; row >= 1 && row <= count; row++)
+     {
+        elm_code_widget_geometry_for_position_get(blame->editor->entry, row, 1, &cx, &cy, &cw, &ch);
+        if (cy > y + h)
+          break;
+
+        commit = eina_inarray_nth(blame->rows, row - 1);
+        text = _edi_editor_blame_text_nth(blame, i++);
+        if (i == 1 || *commit != previous)
+          {
+             _edi_editor_blame_text_get(blame, *commit, label, sizeof(label));
+             evas_object_text_text_set(text, label);
+          }
+        else
+          evas_object_text_text_set(text, "");
+
+        previous = *commit;
+        evas_object_move(text, x + blame->char_width / 2, cy + (ch - evas_object_text_max_ascent_get(text)
+                                                             - evas_object_text_max_descent_get(text)) / 2);
+        evas_object_show(text);
+     }
+
+   l = eina_list_nth_list(blame->texts, i);
+   EINA_LIST_FOREACH(l, l, text)
+     evas_object_hide(text);
+}
+
+static void
+_edi_editor_blame_redraw_queue(Edi_Editor_Blame *blame)
+{
+   if (blame->redraw_job || blame->deleted)
+     return;
+
+   blame->redraw_job = ecore_job_add(_edi_editor_blame_redraw, blame);
+}
+
+static void
+_edi_editor_blame_geometry_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                              void *event_info EINA_UNUSED)
+{
+   _edi_editor_blame_redraw_queue(data);
+}
+
+static void
+_edi_editor_blame_mouse_move_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                void *event_info)
+{
+   Evas_Event_Mouse_Move *ev = event_info;
+
+   // Dragging the scrollbar moves the text without any other event.
+   if (ev->buttons)
+     _edi_editor_blame_redraw_queue(data);
+}
+
+static void
+_edi_editor_blame_cursor_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   _edi_editor_blame_redraw_queue(data);
+}
+
+// Keep cached authorship on unchanged lines while the buffer is edited.
+static void
+_edi_editor_blame_changed_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Editor_Blame *blame = data;
+   Elm_Code *code;
+   unsigned int lines, count, row, col, none = EDI_BLAME_NONE;
+
+   code = elm_code_widget_code_get(blame->editor->entry);
+   lines = elm_code_file_lines_get(code->file);
+   count = eina_inarray_count(blame->rows);
+
+   elm_code_widget_cursor_position_get(blame->editor->entry, &row, &col);
+   if (lines > count)
+     {
+        row = row > lines - count ? row - (lines - count) : 0;
+        for (; count < lines; count++)
+          eina_inarray_insert_at(blame->rows, row, &none);
+     }
+   else
+     {
+        for (; count > lines && row < count; count--)
+          eina_inarray_remove_at(blame->rows, row);
+     }
+
+   if (row > 0)
+     {
+        // The line being edited is no longer the committed one.
+        unsigned int *slot = eina_inarray_nth(blame->rows, row - 1);
+        if (slot)
+          *slot = EDI_BLAME_NONE;
+     }
+
+   _edi_editor_blame_redraw_queue(blame);
+}
+
+// The gutter may go with its box before the entry is deleted.
+static void
+_edi_editor_blame_bg_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                            void *event_info EINA_UNUSED)
+{
+   Edi_Editor_Blame *blame = data;
+
+   blame->bg = NULL;
+}
+
+static void
+_edi_editor_blame_del(Edi_Editor_Blame *blame)
+{
+   Evas_Object *text;
+
+   evas_object_event_callback_del_full(blame->editor->entry, EVAS_CALLBACK_MOUSE_WHEEL,
+                                       _edi_editor_blame_geometry_cb, blame);
+   evas_object_event_callback_del_full(blame->editor->entry, EVAS_CALLBACK_MOUSE_MOVE,
+                                       _edi_editor_blame_mouse_move_cb, blame);
+   evas_object_smart_callback_del_full(blame->editor->entry, "cursor,changed",
+                                       _edi_editor_blame_cursor_cb, blame);
+   evas_object_smart_callback_del_full(blame->editor->entry, "changed,user",
+                                       _edi_editor_blame_changed_cb, blame);
+
+   if (blame->redraw_job)
+     ecore_job_del(blame->redraw_job);
+   blame->redraw_job = NULL;
+
+   EINA_LIST_FREE(blame->texts, text)
+     evas_object_del(text);
+   evas_object_del(blame->clip);
+   if (blame->bg)
+     {
+        evas_object_event_callback_del_full(blame->bg, EVAS_CALLBACK_DEL, _edi_editor_blame_bg_del_cb, blame);
+        evas_object_del(blame->bg);
+     }
+
+   blame->editor->blame = NULL;
+   blame->deleted = EINA_TRUE;
+   blame->generation++;
+
+   // The last worker to finish frees the session.
+   if (!blame->jobs)
+     _edi_editor_blame_free(blame);
+   else if (blame->thread)
+     ecore_thread_cancel(blame->thread);
+}
+
+static void
+_edi_editor_blame_entry_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                               void *event_info EINA_UNUSED)
+{
+   _edi_editor_blame_del(data);
+}
+
+static void
+_edi_editor_blame_add(Edi_Editor *editor)
+{
+   Edi_Editor_Blame *blame;
+   Evas_Object *parent, *text;
+   Evas *evas;
+
+   parent = elm_object_parent_widget_get(editor->entry);
+   evas = evas_object_evas_get(editor->entry);
+
+   blame = calloc(1, sizeof(Edi_Editor_Blame));
+   blame->editor = editor;
+   blame->commits = eina_inarray_new(sizeof(Edi_Editor_Blame_Commit), 16);
+   blame->rows = eina_inarray_new(sizeof(unsigned int), 1024);
+   editor->blame = blame;
+
+   text = evas_object_text_add(evas);
+   evas_object_text_font_set(text, _edi_project_config->font.name, _edi_project_config->font.size);
+   evas_object_text_text_set(text, "M");
+   evas_object_geometry_get(text, NULL, NULL, &blame->char_width, NULL);
+   evas_object_del(text);
+
+   blame->clip = evas_object_rectangle_add(evas);
+   evas_object_show(blame->clip);
+
+   blame->bg = evas_object_rectangle_add(evas);
+   evas_object_color_set(blame->bg, 0, 0, 0, 0);
+   evas_object_size_hint_min_set(blame->bg, blame->char_width * (EDI_BLAME_WIDTH + 1), 0);
+   evas_object_size_hint_weight_set(blame->bg, 0.0, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(blame->bg, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_event_callback_add(blame->bg, EVAS_CALLBACK_MOVE, _edi_editor_blame_geometry_cb, blame);
+   evas_object_event_callback_add(blame->bg, EVAS_CALLBACK_RESIZE, _edi_editor_blame_geometry_cb, blame);
+   evas_object_event_callback_add(blame->bg, EVAS_CALLBACK_DEL, _edi_editor_blame_bg_del_cb, blame);
+   evas_object_show(blame->bg);
+   elm_box_pack_start(parent, blame->bg);
+
+   evas_object_event_callback_add(editor->entry, EVAS_CALLBACK_MOUSE_WHEEL,
+                                  _edi_editor_blame_geometry_cb, blame);
+   evas_object_event_callback_add(editor->entry, EVAS_CALLBACK_MOUSE_MOVE,
+                                  _edi_editor_blame_mouse_move_cb, blame);
+   evas_object_smart_callback_add(editor->entry, "cursor,changed", _edi_editor_blame_cursor_cb, blame);
+   evas_object_smart_callback_add(editor->entry, "changed,user", _edi_editor_blame_changed_cb, blame);
+
+   _edi_editor_blame_start(blame);
+}
+
+void
+edi_editor_blame_set(Edi_Editor *editor, Eina_Bool enabled)
+{
+   if (enabled && !edi_scm_enabled())
+     enabled = EINA_FALSE;
+
+   if (enabled == !!editor->blame)
+     return;
+
+   if (enabled)
+     {
+        _edi_editor_blame_add(editor);
+        evas_object_event_callback_add(editor->entry, EVAS_CALLBACK_DEL,
+                                       _edi_editor_blame_entry_del_cb, editor->blame);
+     }
+   else
+     {
+        evas_object_event_callback_del_full(editor->entry, EVAS_CALLBACK_DEL,
+                                            _edi_editor_blame_entry_del_cb, editor->blame);
+        _edi_editor_blame_del(editor->blame);
+     }
+}
+
+void
+edi_editor_blame_refresh(Edi_Editor *editor)
+{
+   if (!editor->blame)
+     return;
+
+   _edi_editor_blame_start(editor->blame);
+}
@@ -10,25 +10,55 @@
  * Replace added by Kelly Wilson
  */
 
+#include <ctype.h>
+#include <regex.h>
+
 #include <Elementary.h>
 #include <Evas.h>
 
 #include "edi_editor.h"
 #include "edi_private.h"
 
+#define EDI_SEARCH_INDEX_CHUNK 512
+
 /**
- * @struct _Edi_Search_Result
- * An instance of a single search.
+ * @struct _Edi_Search_Match
+ * A single match of the search term within the buffer.
  */
-struct _Edi_Search_Result
+typedef struct _Edi_Search_Match
 {
-   int found;
-   Elm_Code_Line *line;
-   unsigned int line_number;
-   unsigned int col;
-   char *text;
-   Eina_Bool success;
-};
+   unsigned int line; /**< The line number the match is on */
+   unsigned int offset; /**< The byte offset of the match within the line */
+   unsigned int length; /**< The length of the match in bytes */
+} Edi_Search_Match;
+
+typedef enum {
+   EDI_SEARCH_ACTION_NONE = 0,
+   EDI_SEARCH_ACTION_FIND,
+   EDI_SEARCH_ACTION_REPLACE,
+   EDI_SEARCH_ACTION_REPLACE_ALL,
+} Edi_Search_Action;
+
+typedef enum {
+   EDI_SEARCH_FLAG_NONE = 0,
+   EDI_SEARCH_FLAG_REGEX = 1 << 0, /**< The term is an extended regular expression */
+   EDI_SEARCH_FLAG_WORD = 1 << 1, /**< Only match whole words */
+   EDI_SEARCH_FLAG_ICASE = 1 << 2, /**< Ignore case when matching */
+} Edi_Search_Flags;
+
+/**
+ * @struct _Edi_Search_Matcher
+ * A compiled search term, shared by the index worker and incremental updates.
+ */
+typedef struct _Edi_Search_Matcher
+{
+   char *term; /**< The term as entered by the user */
+   unsigned int length; /**< The length of the term in bytes */
+   int flags; /**< The Edi_Search_Flags the term was compiled with */
+   regex_t regex; /**< The compiled expression when EDI_SEARCH_FLAG_REGEX is set */
+} Edi_Search_Matcher;
+
+typedef struct _Edi_Search_Index_Job Edi_Search_Index_Job;
 
 /**
  * @struct _Edi_Editor_Search
@@ -40,66 +70,533 @@ struct _Edi_Editor_Search
    Evas_Object *widget; /**< The search UI panel we wish to show and hide */
    Evas_Object *parent; /**< The parent panel we will insert into */
    Evas_Object *checkbox; /**< The checkbox for wrapping search */
-   Evas_Object *wrapped_text; /**< A display that shows the user that the search wrapped */
+   Evas_Object *wrapped_text; /**< A display that shows the user that the search wrapped or failed */
    unsigned int current_search_line; /**< The current search cursor line for this session */
    unsigned int current_search_col; /**< The current search cursor column for this session */
    Eina_Bool term_found;
    Eina_Bool wrap;
    Evas_Object *replace_entry; /**< The replace text widget */
    Evas_Object *replace_btn; /**< The replace button for our search */
-   struct _Edi_Search_Result cache; /**< The first found search instance */
    /* Add new members here. */
+   Edi_Editor *editor; /**< The editor this search session belongs to */
+   char *last_term; /**< The term used by the previous search */
+   int last_flags; /**< The flags used by the previous search */
+
+   Evas_Object *replace_all_btn; /**< The replace all button for our search */
+   Evas_Object *regex_checkbox; /**< The checkbox for regular expression search */
+   Evas_Object *word_checkbox; /**< The checkbox for whole word search */
+   Evas_Object *case_checkbox; /**< The checkbox for case insensitive search */
+   Edi_Search_Match current_match; /**< The match currently selected in the editor */
+   Eina_Bool replacing; /**< Replace all is applying its edits */
+
+   Eina_Inarray *matches; /**< Edi_Search_Match entries ordered by line and offset */
+   Edi_Search_Matcher *matcher; /**< The term the match index was built for */
+   unsigned int generation; /**< Bumped whenever the buffer changes in a way the index can't follow */
+   unsigned int index_generation; /**< The buffer generation the match index is valid for */
+   unsigned int index_line_count; /**< The number of lines in the buffer when the index was updated */
+
+   Ecore_Thread *index_thread; /**< The worker currently building the match index */
+   Edi_Search_Index_Job *index_job; /**< The job of the worker currently building the index */
+   unsigned int index_jobs; /**< Workers that still reference this session */
+   Edi_Search_Action pending; /**< The action to run once the index is ready */
+   Eina_Bool deleted; /**< The editor went away, free once the workers are done */
+   Elm_Code *code; /**< The buffer our parser is registered with */
+   void *parser; /**< Our entry in the buffer's parsers, removed with the editor */
+
+   unsigned int highlight_first; /**< The first line carrying match highlights */
+   unsigned int highlight_last; /**< The last line carrying match highlights */
    Eina_Bool wrapped;
 };
 
+/**
+ * @struct _Edi_Search_Index_Job
+ * The state shared with a worker thread building a match index.
+ */
+struct _Edi_Search_Index_Job
+{
+   Edi_Editor_Search *search;
+   Elm_Code *code;
+   Edi_Search_Matcher *matcher;
+   unsigned int generation;
+   unsigned int line_count;
+   Eina_Inarray *matches;
+};
+
+static Eina_Bool _edi_search_request(Edi_Editor_Search *search, Edi_Search_Action action);
+
+static char *
+_edi_search_term_get(Edi_Editor_Search *search)
+{
+   const char *text_markup;
+
+   text_markup = elm_object_text_get(search->entry);
+   if (!text_markup || !text_markup[0])
+     return NULL;
+
+   return elm_entry_markup_to_utf8(text_markup);
+}
+
+static int
+_edi_search_flags_get(Edi_Editor_Search *search)
+{
+   int flags = EDI_SEARCH_FLAG_NONE;
+
+   if (elm_check_state_get(search->regex_checkbox))
+     flags |= EDI_SEARCH_FLAG_REGEX;
+   if (elm_check_state_get(search->word_checkbox))
+     flags |= EDI_SEARCH_FLAG_WORD;
+   if (elm_check_state_get(search->case_checkbox))
+     flags |= EDI_SEARCH_FLAG_ICASE;
+
+   return flags;
+}
+
+static Edi_Search_Matcher *
+_edi_search_matcher_new(const char *term, int flags)
+{
+   Edi_Search_Matcher *matcher;
+   int cflags;
+
+   matcher = calloc(1, sizeof(*matcher));
+   if (!matcher)
+     return NULL;
+
+   if (flags & EDI_SEARCH_FLAG_REGEX)
+     {
+        cflags = REG_EXTENDED | REG_NEWLINE;
+        if (flags & EDI_SEARCH_FLAG_ICASE)
+          cflags |= REG_ICASE;
+
+        if (regcomp(&matcher->regex, term, cflags))
+          {
+             free(matcher);
+             return NULL;
+          }
+     }
+
+   matcher->term = strdup(term);
+   matcher->length = strlen(term);
+   matcher->flags = flags;
+
+   return matcher;
+}
+
 static void
-_edi_search_cache_reset(Edi_Editor_Search *search)
+_edi_search_matcher_free(Edi_Search_Matcher *matcher)
 {
-   if (search->cache.text)
+   if (!matcher)
+     return;
+
+   if (matcher->flags & EDI_SEARCH_FLAG_REGEX)
+     regfree(&matcher->regex);
+   free(matcher->term);
+   free(matcher);
+}
+
+static Eina_Bool
+_edi_search_matcher_equal(Edi_Search_Matcher *matcher, const char *term, int flags)
+{
+   return matcher && matcher->flags == flags && !strcmp(matcher->term, term);
+}
+
+static Eina_Bool
+_edi_search_word_char(char c)
+{
+   return isalnum((unsigned char) c) || c == '_';
+}
+
+static Eina_Bool
+_edi_search_word_bounded(const char *text, unsigned int length, unsigned int start, unsigned int end)
+{
+   if (start > 0 && _edi_search_word_char(text[start - 1]) && _edi_search_word_char(text[start]))
+     return EINA_FALSE;
+
+   if (end < length && end > start && _edi_search_word_char(text[end - 1]) && _edi_search_word_char(text[end]))
+     return EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
+static const char *
+_edi_search_literal_find(const char *text, unsigned int length, Edi_Search_Matcher *matcher,
+                         unsigned int offset)
+{
+   const char *lookup, *end;
+   char first;
+
+   if (matcher->length > length)
+     return NULL;
+
+   end = text + length - matcher->length + 1;
+   text += offset;
+
+   if (matcher->flags & EDI_SEARCH_FLAG_ICASE)
      {
-        free(search->cache.text);
-        search->cache.text = NULL;
+        first = tolower((unsigned char) *matcher->term);
+        for (; text < end; text++)
+          {
+             if (tolower((unsigned char) *text) == first &&
+                 !strncasecmp(text, matcher->term, matcher->length))
+               return text;
+          }
+
+        return NULL;
      }
-   search->cache.found = ELM_CODE_TEXT_NOT_FOUND;
-   search->cache.success = EINA_FALSE;
+
+   while (text < end)
+     {
+        lookup = memchr(text, *matcher->term, end - text);
+        if (!lookup)
+          return NULL;
+
+        if (!memcmp(lookup, matcher->term, matcher->length))
+          return lookup;
+
+        text = lookup + 1;
+     }
+
+   return NULL;
+}
+
+// Find the next match at or after offset. Text must be nul terminated at length.
+static const char *
+_edi_search_matcher_find(Edi_Search_Matcher *matcher, const char *text, unsigned int length,
+                         unsigned int offset, unsigned int *match_length)
+{
+   const char *found;
+   regmatch_t pmatch[1];
+   unsigned int start, end;
+
+   while (offset <= length)
+     {
+        if (matcher->flags & EDI_SEARCH_FLAG_REGEX)
+          {
+             if (regexec(&matcher->regex, text + offset, 1, pmatch, offset ? REG_NOTBOL : 0))
+               return NULL;
+
+             start = offset + pmatch[0].rm_so;
+             end = offset + pmatch[0].rm_eo;
+          }
+        else
+          {
+             found = _edi_search_literal_find(text, length, matcher, offset);
+             if (!found)
+               return NULL;
+
+             start = found - text;
+             end = start + matcher->length;
+          }
+
+        // Skip empty expression matches and words embedded in other words.
+        if (end > start &&
+            (!(matcher->flags & EDI_SEARCH_FLAG_WORD) || _edi_search_word_bounded(text, length, start, end)))
+          {
+             *match_length = end - start;
+             return text + start;
+          }
+
+        offset = start + 1;
+     }
+
+   return NULL;
+}
+
+static void
+_edi_search_line_matches_append(Eina_Inarray *matches, unsigned int number,
+                                const char *text, unsigned int length,
+                                Edi_Search_Matcher *matcher)
+{
+   Edi_Search_Match match;
+   const char *found;
+   unsigned int offset = 0, match_length;
+
+   while ((found = _edi_search_matcher_find(matcher, text, length, offset, &match_length)))
+     {
+        match.line = number;
+        match.offset = found - text;
+        match.length = match_length;
+        eina_inarray_push(matches, &match);
+
+        // Expressions continue after the match, plain terms may overlap.
+        if (matcher->flags & EDI_SEARCH_FLAG_REGEX)
+          offset = match.offset + match.length;
+        else
+          offset = match.offset + 1;
+     }
+}
+
+// Return the position of the first match at or after line:offset.
+static unsigned int
+_edi_search_match_lower_bound(Eina_Inarray *matches, unsigned int line, unsigned int offset)
+{
+   Edi_Search_Match *match;
+   unsigned int low, high, mid;
+
+   low = 0;
+   high = eina_inarray_count(matches);
+   while (low < high)
+     {
+        mid = low + (high - low) / 2;
+        match = eina_inarray_nth(matches, mid);
+
+        if (match->line < line || (match->line == line && match->offset < offset))
+          low = mid + 1;
+        else
+          high = mid;
+     }
+
+   return low;
 }
 
 static Eina_Bool
-_edi_search_cache_exists(Edi_Editor_Search *search)
+_edi_search_index_current(Edi_Editor_Search *search, const char *text, int flags)
+{
+   if (!search->matches || !search->matcher)
+     return EINA_FALSE;
+
+   if (search->index_generation != search->generation)
+     return EINA_FALSE;
+
+   return _edi_search_matcher_equal(search->matcher, text, flags);
+}
+
+static void
+_edi_search_index_invalidate(Edi_Editor_Search *search)
+{
+   search->generation++;
+}
+
+static void
+_edi_search_index_job_free(Edi_Search_Index_Job *job)
+{
+   if (job->matches)
+     eina_inarray_free(job->matches);
+   _edi_search_matcher_free(job->matcher);
+   free(job);
+}
+
+static void
+_edi_search_free(Edi_Editor_Search *search)
+{
+   if (search->matches)
+     eina_inarray_free(search->matches);
+   _edi_search_matcher_free(search->matcher);
+   free(search->last_term);
+   free(search);
+}
+
+static void
+_edi_search_index_run(void *data, Ecore_Thread *thread)
+{
+   Edi_Search_Index_Job *job;
+   Eina_Strbuf *chunk;
+   Eina_List *item;
+   Elm_Code_Line *line;
+   const char *text;
+   unsigned int lengths[EDI_SEARCH_INDEX_CHUNK];
+   unsigned int number, count, length, i;
+   size_t pos;
+   Eina_Bool stale;
+
+   job = (Edi_Search_Index_Job *)data;
+   chunk = eina_strbuf_new();
+
+   number = 1;
+   stale = EINA_FALSE;
+   while (number <= job->line_count)
+     {
+        eina_strbuf_reset(chunk);
+        count = 0;
+
+        // Copy a chunk of lines while holding the main loop, then match without it.
+        ecore_thread_main_loop_begin();
+        if (job->generation != job->search->generation)
+          stale = EINA_TRUE;
+        else
+          {
+             item = eina_list_nth_list(job->code->file->lines, number - 1);
+             for (; item && count < EDI_SEARCH_INDEX_CHUNK; item = eina_list_next(item))
+               {
+                  line = eina_list_data_get(item);
+                  text = elm_code_line_text_get(line, &length);
+
+                  // Lines are kept nul terminated for the expression matcher.
+                  eina_strbuf_append_length(chunk, text ? text : "", text ? length : 0);
+                  eina_strbuf_append_char(chunk, '\0');
+                  lengths[count++] = text ? length : 0;
+               }
+          }
+        ecore_thread_main_loop_end();
+
+        if (stale || !count || ecore_thread_check(thread))
+          break;
+
+        text = eina_strbuf_string_get(chunk);
+        pos = 0;
+        for (i = 0; i < count; i++)
+          {
+             _edi_search_line_matches_append(job->matches, number + i, text + pos,
+                                             lengths[i], job->matcher);
+             pos += lengths[i] + 1;
+          }
+
+        number += count;
+     }
+
+   eina_strbuf_free(chunk);
+}
+
+static void
+_edi_search_index_done(Edi_Search_Index_Job *job, Ecore_Thread *thread, Eina_Bool complete)
+{
+   Edi_Editor_Search *search;
+   Edi_Search_Action action;
+   Eina_Bool current;
+
+   search = job->search;
+   search->index_jobs--;
+
+   current = (search->index_thread == thread);
+   if (current)
+     {
+        search->index_thread = NULL;
+        search->index_job = NULL;
+     }
+
+   if (search->deleted)
+     {
+        _edi_search_index_job_free(job);
+        if (!search->index_jobs)
+          _edi_search_free(search);
+        return;
+     }
+
+   if (complete && job->generation == search->generation)
+     {
+        if (search->matches)
+          eina_inarray_free(search->matches);
+        _edi_search_matcher_free(search->matcher);
+
+        search->matches = job->matches;
+        search->matcher = job->matcher;
+        search->index_generation = job->generation;
+        search->index_line_count = job->line_count;
+        job->matches = NULL;
+        job->matcher = NULL;
+     }
+   _edi_search_index_job_free(job);
+
+   if (!current || search->pending == EDI_SEARCH_ACTION_NONE)
+     return;
+
+   action = search->pending;
+   search->pending = EDI_SEARCH_ACTION_NONE;
+   _edi_search_request(search, action);
+}
+
+static void
+_edi_search_index_end_cb(void *data, Ecore_Thread *thread)
 {
-   return search->cache.success;
+   _edi_search_index_done((Edi_Search_Index_Job *)data, thread, EINA_TRUE);
 }
 
 static void
-_edi_search_cache_store(Edi_Editor_Search *search, int found, const char *text, Elm_Code_Line *line, unsigned int line_col)
+_edi_search_index_cancel_cb(void *data, Ecore_Thread *thread)
 {
-   search->cache.found = found;
-   search->cache.text = strdup(text);
-   search->cache.line = line;
-   search->cache.line_number = line->number;
-   search->cache.col = line_col;
-   search->cache.success = EINA_TRUE;
+   _edi_search_index_done((Edi_Search_Index_Job *)data, thread, EINA_FALSE);
 }
 
-Eina_Bool
-_edi_search_term_changed(Edi_Editor_Search *search, const char *text)
+static Eina_Bool
+_edi_search_index_build(Edi_Editor_Search *search, const char *text, int flags)
 {
-   if (!strcmp(search->cache.text, text))
+   Edi_Search_Index_Job *job;
+   Edi_Search_Matcher *matcher;
+   Ecore_Thread *thread;
+   Elm_Code *code;
+
+   if (search->index_job && _edi_search_matcher_equal(search->index_job->matcher, text, flags))
+     return EINA_TRUE;
+
+   matcher = _edi_search_matcher_new(text, flags);
+   if (!matcher)
      return EINA_FALSE;
 
+   // Detach the running worker first so its cancel does not replay the pending action.
+   thread = search->index_thread;
+   search->index_thread = NULL;
+   search->index_job = NULL;
+   if (thread)
+     ecore_thread_cancel(thread);
+
+   code = elm_code_widget_code_get(search->editor->entry);
+   _edi_search_index_invalidate(search);
+
+   job = calloc(1, sizeof(*job));
+   job->search = search;
+   job->code = code;
+   job->matcher = matcher;
+   job->generation = search->generation;
+   job->line_count = elm_code_file_lines_get(code->file);
+   job->matches = eina_inarray_new(sizeof(Edi_Search_Match), 64);
+
+   search->index_jobs++;
+   search->index_job = job;
+   search->index_thread = ecore_thread_run(_edi_search_index_run, _edi_search_index_end_cb,
+                                           _edi_search_index_cancel_cb, job);
    return EINA_TRUE;
 }
 
 static void
-_edi_search_cache_use(Edi_Editor_Search *search, char **text, Elm_Code_Line **line, int *found)
+_edi_search_index_line_update(Edi_Editor_Search *search, Elm_Code_Line *line)
 {
-   *text = search->cache.text;
-   *line = search->cache.line;
-   *found = search->cache.found;
-   search->current_search_line = search->cache.line_number;
-   search->current_search_col = search->cache.col;
+   Eina_Inarray *matches, *found;
+   const char *text;
+   char *copy, *members;
+   unsigned int first, last, count, added, length;
+
+   matches = search->matches;
+   first = _edi_search_match_lower_bound(matches, line->number, 0);
+   last = _edi_search_match_lower_bound(matches, line->number + 1, 0);
+
+   found = eina_inarray_new(sizeof(Edi_Search_Match), 4);
+   text = elm_code_line_text_get(line, &length);
+   if (text && length)
+     {
+        copy = strndup(text, length);
+        _edi_search_line_matches_append(found, line->number, copy, length, search->matcher);
+        free(copy);
+     }
+
+   // Replace the matches of the line in place, moving the ones after it once.
+   count = eina_inarray_count(matches);
+   added = eina_inarray_count(found);
+   if (added > last - first)
+     eina_inarray_resize(matches, count - (last - first) + added);
+
+   members = matches->members;
+   memmove(members + (first + added) * matches->member_size, members + last * matches->member_size,
+           (count - last) * matches->member_size);
+   if (added)
+     memcpy(members + first * matches->member_size, found->members, added * matches->member_size);
+
+   if (added < last - first)
+     eina_inarray_resize(matches, count - (last - first) + added);
+   eina_inarray_free(found);
 }
 
+static void
+_edi_search_index_lines_shift(Edi_Editor_Search *search, unsigned int from)
+{
+   Edi_Search_Match *match;
+   unsigned int i, count;
+
+   count = eina_inarray_count(search->matches);
+   for (i = _edi_search_match_lower_bound(search->matches, from, 0); i < count; i++)
+     {
+        match = eina_inarray_nth(search->matches, i);
+        match->line++;
+     }
+}
 
 static Eina_List *
 _edi_search_clear_highlights(Eina_List *tokens)
@@ -119,151 +616,304 @@ _edi_search_clear_highlights(Eina_List *tokens)
 }
 
 static void
-_edi_search_show_highlights(Elm_Code_Line *line, const char *text)
+_edi_search_line_highlight(Edi_Editor_Search *search, Elm_Code_Line *line)
 {
-   int match;
+   Edi_Search_Match *match;
+   unsigned int i, count;
 
-   match = elm_code_line_text_strpos(line, text, 0);
-   while (match != ELM_CODE_TEXT_NOT_FOUND)
+   line->tokens = _edi_search_clear_highlights(line->tokens);
+
+   count = eina_inarray_count(search->matches);
+   for (i = _edi_search_match_lower_bound(search->matches, line->number, 0); i < count; i++)
      {
-        elm_code_line_token_add(line, match, match + strlen(text) - 1, 1, ELM_CODE_TOKEN_TYPE_MATCH);
+        match = eina_inarray_nth(search->matches, i);
+        if (match->line != line->number)
+          break;
 
-        match = elm_code_line_text_strpos(line, text, match + 1);
+        elm_code_line_token_add(line, match->offset, match->offset + match->length - 1,
+                                1, ELM_CODE_TOKEN_TYPE_MATCH);
      }
+
+   elm_code_widget_line_refresh(search->editor->entry, line);
 }
 
-static Eina_Bool
-_edi_search_in_entry(Evas_Object *entry, Edi_Editor_Search *search)
+static void
+_edi_search_highlights_set(Edi_Editor_Search *search, unsigned int first, unsigned int last)
 {
-   Eina_Bool try_next = EINA_FALSE;
-   Eina_List *item;
+   Evas_Object *entry;
    Elm_Code *code;
    Elm_Code_Line *line;
-   const char *text_markup;
-   char *text;
-   unsigned int offset, pos, pos_line, pos_col;
-   int found, match;
-   search->wrap = elm_check_state_get(search->checkbox);
+   Eina_List *item;
+   unsigned int number;
 
-   text_markup = elm_object_text_get(search->entry);
-   if (!text_markup || !text_markup[0])
+   entry = search->editor->entry;
+   code = elm_code_widget_code_get(entry);
+
+   if (search->highlight_first)
      {
-        search->term_found = EINA_FALSE;
-        return EINA_FALSE;
+        item = eina_list_nth_list(code->file->lines, search->highlight_first - 1);
+        for (number = search->highlight_first; item && number <= search->highlight_last;
+             item = eina_list_next(item), number++)
+          {
+             if (number >= first && number <= last)
+               continue;
+
+             line = eina_list_data_get(item);
+             line->tokens = _edi_search_clear_highlights(line->tokens);
+             elm_code_widget_line_refresh(entry, line);
+          }
      }
 
-   text = elm_entry_markup_to_utf8(text_markup);
+   search->highlight_first = first;
+   search->highlight_last = last;
+   if (!first || !search->matches)
+     return;
 
-   code = elm_code_widget_code_get(entry);
-   elm_code_widget_cursor_position_get(entry, &pos_line, &pos_col);
-   if (search->current_search_line == pos_line &&
-       search->current_search_col == pos_col)
-     {
-        try_next = EINA_TRUE;
-     }
+   item = eina_list_nth_list(code->file->lines, first - 1);
+   for (number = first; item && number <= last; item = eina_list_next(item), number++)
+     _edi_search_line_highlight(search, eina_list_data_get(item));
+}
 
-   if (_edi_search_cache_exists(search) &&
-       _edi_search_term_changed(search, text))
-     {
-        _edi_search_cache_reset(search);
-        line = elm_code_file_line_get(elm_code_widget_code_get(entry)->file, 1);
-        elm_code_widget_cursor_position_set(entry, 1, 1);
-        _edi_search_cache_store(search, 0, text, line, 1);
-        _edi_search_in_entry(entry, search);
-        return EINA_TRUE;
-     }
+static void
+_edi_search_highlights_show(Edi_Editor_Search *search, unsigned int number)
+{
+   unsigned int visible, first, last, lines;
 
-   found = ELM_CODE_TEXT_NOT_FOUND;
-   EINA_LIST_FOREACH(code->file->lines, item, line)
+   lines = elm_code_file_lines_get(elm_code_widget_code_get(search->editor->entry)->file);
+   visible = elm_code_widget_lines_visible_get(search->editor->entry);
+   if (!visible)
+     visible = 1;
+
+   first = number > visible ? number - visible : 1;
+   last = number + visible < lines ? number + visible : lines;
+
+   _edi_search_highlights_set(search, first, last);
+}
+
+static void
+_edi_search_notice_show(Edi_Editor_Search *search, const char *text)
+{
+   if (!text)
      {
-        line->tokens = _edi_search_clear_highlights(line->tokens);
-        _edi_search_show_highlights(line, text);
+        evas_object_hide(search->wrapped_text);
+        return;
+     }
 
-        offset = 0;
-        match = elm_code_line_text_strpos(line, text, offset);
-        if (match == ELM_CODE_TEXT_NOT_FOUND)
-          continue;
+   elm_object_text_set(search->wrapped_text, text);
+   evas_object_show(search->wrapped_text);
+}
 
-        pos = elm_code_widget_line_text_column_width_to_position(entry, line, match);
-        if (!_edi_search_cache_exists(search))
-          _edi_search_cache_store(search, match, text, line, pos);
+// Expand \0 to \9 in the replacement with the groups of the expression match at offset.
+static char *
+_edi_search_replacement_get(Edi_Search_Matcher *matcher, const char *replace,
+                            const char *text, unsigned int offset)
+{
+   Eina_Strbuf *buf;
+   regmatch_t pmatch[10];
+   const char *ptr;
+   int group;
 
-        if (line->number < pos_line)
-          continue;
+   if (!(matcher->flags & EDI_SEARCH_FLAG_REGEX) ||
+       regexec(&matcher->regex, text + offset, 10, pmatch, offset ? REG_NOTBOL : 0))
+     return strdup(replace);
 
-        if (line->number == pos_line)
+   buf = eina_strbuf_new();
+   for (ptr = replace; *ptr; ptr++)
+     {
+        if (*ptr == '\\' && isdigit((unsigned char) ptr[1]))
           {
-             offset = elm_code_widget_line_text_position_for_column_get(entry, line, pos_col) + (try_next ? 1 : 0);
+             group = *++ptr - '0';
+             if (pmatch[group].rm_so != -1)
+               eina_strbuf_append_length(buf, text + offset + pmatch[group].rm_so,
+                                         pmatch[group].rm_eo - pmatch[group].rm_so);
+          }
+        else if (*ptr == '\\' && ptr[1] == '\\')
+          eina_strbuf_append_char(buf, *++ptr);
+        else
+          eina_strbuf_append_char(buf, *ptr);
+     }
 
-             match = elm_code_line_text_strpos(line, text, offset);
-             if (match == ELM_CODE_TEXT_NOT_FOUND)
-               continue;
+   return eina_strbuf_release(buf);
+}
 
-             pos = elm_code_widget_line_text_column_width_to_position(entry, line, match);
-          }
+static Eina_Bool
+_edi_search_in_entry(Evas_Object *entry, Edi_Editor_Search *search)
+{
+   Eina_Bool try_next = EINA_FALSE;
+   Elm_Code *code;
+   Elm_Code_Line *line;
+   Edi_Search_Match *match;
+   unsigned int offset, pos_line, pos_col, i;
 
-        if (found == ELM_CODE_TEXT_NOT_FOUND)
-          {
-             // store first occurence of search from cursor position
-             search->current_search_line = line->number;
-             search->current_search_col = pos;
+   search->wrap = elm_check_state_get(search->checkbox);
 
-             found = match;
-          }
+   code = elm_code_widget_code_get(entry);
+   elm_code_widget_cursor_position_get(entry, &pos_line, &pos_col);
+   if (search->current_search_line == pos_line &&
+       search->current_search_col == pos_col)
+     {
+        try_next = EINA_TRUE;
+     }
+
+   // A new term always starts searching from the top of the file.
+   if (search->last_term && !_edi_search_matcher_equal(search->matcher, search->last_term, search->last_flags))
+     {
+        pos_line = 1;
+        pos_col = 1;
+        try_next = EINA_FALSE;
+        elm_code_widget_cursor_position_set(entry, 1, 1);
      }
+   free(search->last_term);
+   search->last_term = strdup(search->matcher->term);
+   search->last_flags = search->matcher->flags;
 
-   search->term_found = found != ELM_CODE_TEXT_NOT_FOUND;
+   line = elm_code_file_line_get(code->file, pos_line);
+   offset = 0;
+   if (line)
+     offset = elm_code_widget_line_text_position_for_column_get(entry, line, pos_col) + (try_next ? 1 : 0);
+
+   i = _edi_search_match_lower_bound(search->matches, pos_line, offset);
+   search->term_found = i < eina_inarray_count(search->matches);
    elm_code_widget_selection_clear(entry);
 
    // nothing found and wrap is disabled
    if (!search->term_found && !search->wrap)
      return EINA_FALSE;
 
-   // No history nor term found so return
-   if (search->wrap && !search->term_found && !_edi_search_cache_exists(search))
-     return EINA_FALSE;
-
-   // EOF reached so go to search found before cursor (first inst).
-   if (search->wrap && !search->term_found && _edi_search_cache_exists(search))
+   // EOF reached so go to the first match in the file
+   search->wrapped = EINA_FALSE;
+   if (!search->term_found)
      {
-        // RESET CURSOR TO BEGINNING OF WIDGET. VISIBLE WIDGET STARTS AT 1, 1.
-        elm_code_widget_cursor_position_set(entry, 0, 0);
+        if (!eina_inarray_count(search->matches))
+          return EINA_FALSE;
 
-        elm_code_widget_selection_clear(entry);
-        line = elm_code_file_line_get(elm_code_widget_code_get(entry)->file, 1);
-        _edi_search_cache_reset(search);
-        _edi_search_cache_use(search, &text, &line, &found);
+        i = 0;
+        search->term_found = EINA_TRUE;
         search->wrapped = EINA_TRUE;
-        _edi_search_in_entry(entry, search);
-        free(text);
-        return EINA_TRUE;
-     }
-   else
-     {
-       if (search->wrapped)
-         {
-            evas_object_show(search->wrapped_text);
-            search->wrapped = EINA_FALSE;
-         }
-       else
-         {
-            evas_object_hide(search->wrapped_text);
-         }
      }
 
-   line = elm_code_file_line_get(elm_code_widget_code_get(entry)->file, search->current_search_line);
+   _edi_search_notice_show(search, search->wrapped ? _("Reached end of file, starting from beginning") : NULL);
+
+   match = eina_inarray_nth(search->matches, i);
+   line = elm_code_file_line_get(code->file, match->line);
+   if (!line)
+     return EINA_FALSE;
+
+   search->current_match = *match;
+   search->current_search_line = match->line;
+   search->current_search_col = elm_code_widget_line_text_column_width_to_position(entry, line, match->offset);
+
+   _edi_search_highlights_show(search, match->line);
+
    elm_code_widget_cursor_position_set(entry, search->current_search_line,
                                               search->current_search_col);
    elm_code_widget_selection_start(entry, search->current_search_line,
                                         search->current_search_col);
    elm_code_widget_selection_end(entry, search->current_search_line,
-                                 elm_code_widget_line_text_column_width_to_position(entry, line, found + strlen(text)) - 1);
-
-   free(text);
+                                 elm_code_widget_line_text_column_width_to_position(entry, line, match->offset + match->length) - 1);
 
    return EINA_TRUE;
 }
 
+static void
+_edi_search_parse_line_cb(Elm_Code_Line *line, void *data)
+{
+   Edi_Editor_Search *search;
+   unsigned int lines;
+
+   search = (Edi_Editor_Search *)data;
+
+   // Replace all refreshes the index once it is done.
+   if (search->replacing || search->deleted)
+     return;
+
+   // A worker may already have copied this line, start over when asked again.
+   if (search->index_thread)
+     {
+        _edi_search_index_invalidate(search);
+        return;
+     }
+
+   if (!search->matches || search->index_generation != search->generation)
+     return;
+
+   lines = elm_code_file_lines_get(line->file);
+   if (lines == search->index_line_count + 1)
+     {
+        // A line was inserted, everything below it moves down by one.
+        _edi_search_index_lines_shift(search, line->number);
+        search->index_line_count = lines;
+     }
+   else if (lines != search->index_line_count)
+     {
+        _edi_search_index_invalidate(search);
+        return;
+     }
+
+   _edi_search_index_line_update(search, line);
+
+   if (line->number >= search->highlight_first && line->number <= search->highlight_last)
+     _edi_search_line_highlight(search, line);
+}
+
+static void
+_edi_search_parse_file_cb(Elm_Code_File *file EINA_UNUSED, void *data)
+{
+   Edi_Editor_Search *search;
+
+   search = (Edi_Editor_Search *)data;
+   if (search->deleted)
+     return;
+
+   _edi_search_index_invalidate(search);
+   search->highlight_first = search->highlight_last = 0;
+}
+
+static void
+_edi_search_changed_cb(void *data, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   Edi_Editor_Search *search;
+   Elm_Code *code;
+
+   search = (Edi_Editor_Search *)data;
+   code = elm_code_widget_code_get(obj);
+
+   // Removed lines are not reported by the parser, so we can't follow them.
+   if (elm_code_file_lines_get(code->file) != search->index_line_count)
+     _edi_search_index_invalidate(search);
+}
+
+static void
+_edi_search_entry_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                         void *event_info EINA_UNUSED)
+{
+   Edi_Editor_Search *search;
+
+   search = (Edi_Editor_Search *)data;
+
+   _edi_search_index_invalidate(search);
+   search->deleted = EINA_TRUE;
+   search->editor->search = NULL;
+
+   // Elm_Code has no call to remove a parser, it frees its own list the same way.
+   if (search->parser)
+     {
+        search->code->parsers = eina_list_remove(search->code->parsers, search->parser);
+        free(search->parser);
+        search->parser = NULL;
+     }
+
+   if (!search->index_jobs)
+     {
+        _edi_search_free(search);
+        return;
+     }
+
+   // The last worker to finish frees the session.
+   if (search->index_thread)
+     ecore_thread_cancel(search->index_thread);
+}
+
 static void
 _edi_replace_entry_changed(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
@@ -275,10 +925,8 @@ _edi_replace_entry_changed(void *data, Evas_Object *obj EINA_UNUSED, void *event
    search = editor->search;
 
    text = elm_object_text_get(search->replace_entry);
-   if (!text || !text[0])
-     elm_object_disabled_set(search->replace_btn, EINA_TRUE);
-   else
-     elm_object_disabled_set(search->replace_btn, EINA_FALSE);
+   elm_object_disabled_set(search->replace_btn, !text || !text[0]);
+   elm_object_disabled_set(search->replace_all_btn, !text || !text[0]);
 
    search->current_search_line = 0;
    search->current_search_col = 0;
@@ -289,9 +937,10 @@ static void
 _edi_replace_in_entry(void *data, Edi_Editor_Search *search)
 {
    Edi_Editor *editor;
-   const char *text_markup;
-   unsigned int line, col;
-   char *text = NULL;
+   Elm_Code_Line *code_line;
+   const char *text_markup, *line_text;
+   unsigned int line, col, length;
+   char *text = NULL, *copy, *replace;
 
    editor = (Edi_Editor *)data;
 
@@ -307,8 +956,17 @@ _edi_replace_in_entry(void *data, Edi_Editor_Search *search)
         text = elm_entry_markup_to_utf8(text_markup);
         if ((text[0]) && search->current_search_line == line && search->current_search_col == col)
           {
+             code_line = elm_code_file_line_get(elm_code_widget_code_get(editor->entry)->file, line);
+             line_text = elm_code_line_text_get(code_line, &length);
+             copy = strndup(line_text ? line_text : "", line_text ? length : 0);
+             replace = _edi_search_replacement_get(search->matcher, text, copy,
+                                                   search->current_match.offset);
+
              elm_code_widget_selection_delete(editor->entry);
-             elm_code_widget_text_at_cursor_insert(editor->entry, text);
+             elm_code_widget_text_at_cursor_insert(editor->entry, replace);
+
+             free(replace);
+             free(copy);
           }
      }
 
@@ -318,6 +976,149 @@ _edi_replace_in_entry(void *data, Edi_Editor_Search *search)
    return;
 }
 
+static void
+_edi_replace_all_in_entry(Edi_Editor_Search *search)
+{
+   Evas_Object *entry;
+   Elm_Code *code;
+   Elm_Code_Line *line;
+   Edi_Search_Match *match;
+   Eina_Strbuf *buf;
+   Eina_List *item;
+   const char *text_markup, *line_text;
+   char *text, *copy, *replace;
+   unsigned int i, count, number, length, end, replaced;
+
+   text_markup = elm_object_text_get(search->replace_entry);
+   if (!text_markup || !text_markup[0])
+     return;
+
+   count = eina_inarray_count(search->matches);
+   search->term_found = count > 0;
+   if (!count)
+     return;
+
+   entry = search->editor->entry;
+   code = elm_code_widget_code_get(entry);
+   text = elm_entry_markup_to_utf8(text_markup);
+   buf = eina_strbuf_new();
+
+   _edi_search_highlights_set(search, 0, 0);
+   elm_code_widget_selection_clear(entry);
+
+   // Build the new text of every changed line in a single pass over the index and
+   // set them as one change. Matches never span lines, so later offsets still hold.
+   search->replacing = EINA_TRUE;
+   edi_editor_change_begin(search->editor);
+   replaced = 0;
+   item = code->file->lines;
+   number = 1;
+   i = 0;
+   while (i < count)
+     {
+        match = eina_inarray_nth(search->matches, i);
+        for (; item && number < match->line; number++)
+          item = eina_list_next(item);
+        if (!item)
+          break;
+
+        line = eina_list_data_get(item);
+        line_text = elm_code_line_text_get(line, &length);
+        copy = strndup(line_text ? line_text : "", line_text ? length : 0);
+        length = strlen(copy);
+
+        eina_strbuf_reset(buf);
+        end = 0;
+        for (; i < count; i++)
+          {
+             match = eina_inarray_nth(search->matches, i);
+             if (match->line != number)
+               break;
+
+             // Overlapping plain matches are consumed by the previous replacement.
+             if (match->offset < end)
+               continue;
+
+             eina_strbuf_append_length(buf, copy + end, match->offset - end);
+             replace = _edi_search_replacement_get(search->matcher, text, copy, match->offset);
+             eina_strbuf_append(buf, replace);
+             free(replace);
+
+             end = match->offset + match->length;
+             replaced++;
+          }
+        if (end < length)
+          eina_strbuf_append_length(buf, copy + end, length - end);
+
+        edi_editor_line_text_set(search->editor, number, eina_strbuf_string_get(buf),
+                                 eina_strbuf_length_get(buf));
+        free(copy);
+     }
+   edi_editor_change_end(search->editor);
+   search->replacing = EINA_FALSE;
+
+   eina_strbuf_free(buf);
+   free(text);
+
+   // The cursor may have been past the end of a line that is now shorter.
+   if (item)
+     elm_code_widget_cursor_position_set(entry, number, 1);
+
+   _edi_search_index_invalidate(search);
+   search->current_search_line = 0;
+   search->current_search_col = 0;
+
+   INF("Replaced %u occurrences of %s", replaced, search->matcher->term);
+}
+
+static Eina_Bool
+_edi_search_request(Edi_Editor_Search *search, Edi_Search_Action action)
+{
+   char *text;
+   int flags;
+
+   text = _edi_search_term_get(search);
+   if (!text || !text[0])
+     {
+        free(text);
+        search->term_found = EINA_FALSE;
+        return EINA_FALSE;
+     }
+
+   // Wait for the match index if it does not reflect the buffer and term yet.
+   flags = _edi_search_flags_get(search);
+   if (!_edi_search_index_current(search, text, flags))
+     {
+        if (!_edi_search_index_build(search, text, flags))
+          {
+             search->pending = EDI_SEARCH_ACTION_NONE;
+             search->term_found = EINA_FALSE;
+             _edi_search_notice_show(search, _("Invalid regular expression"));
+             free(text);
+             return EINA_FALSE;
+          }
+
+        search->pending = action;
+        free(text);
+        return EINA_TRUE;
+     }
+   free(text);
+
+   search->pending = EDI_SEARCH_ACTION_NONE;
+   if (action == EDI_SEARCH_ACTION_REPLACE_ALL)
+     {
+        _edi_replace_all_in_entry(search);
+        return search->term_found;
+     }
+   else if (action == EDI_SEARCH_ACTION_REPLACE)
+     {
+        _edi_replace_in_entry(search->editor, search);
+        return search->term_found;
+     }
+
+   return _edi_search_in_entry(search->editor->entry, search);
+}
+
 static void
 _edi_editor_search_hide(Edi_Editor *editor)
 {
@@ -342,6 +1143,8 @@ _edi_editor_search_hide(Edi_Editor *editor)
      {
         line->tokens = _edi_search_clear_highlights(line->tokens);
      }
+   search->highlight_first = search->highlight_last = 0;
+   search->pending = EDI_SEARCH_ACTION_NONE;
 
    search->current_search_line = 0;
    elm_code_widget_selection_clear(editor->entry);
@@ -364,10 +1167,8 @@ edi_editor_search(Edi_Editor *editor)
 
         // Check if there is already data in the replace entry. Enable the replace
         // button as appropriate
-        if (!elm_entry_is_empty(search->replace_entry))
-          elm_object_disabled_set(search->replace_btn, EINA_FALSE);
-        else
-          elm_object_disabled_set(search->replace_btn, EINA_TRUE);
+        elm_object_disabled_set(search->replace_btn, elm_entry_is_empty(search->replace_entry));
+        elm_object_disabled_set(search->replace_all_btn, elm_entry_is_empty(search->replace_entry));
      }
 
    elm_object_text_set(search->entry, "");
@@ -384,7 +1185,7 @@ _edi_search_clicked(void *data, Evas_Object *obj EINA_UNUSED, void *event_info E
    search = editor->search;
 
    if (search)
-     _edi_search_in_entry(editor->entry, search);
+     _edi_search_request(search, EDI_SEARCH_ACTION_FIND);
 }
 
 static void
@@ -397,7 +1198,34 @@ _edi_replace_clicked(void *data, Evas_Object *obj EINA_UNUSED, void *event_info
    replace = editor->search;
 
    if (replace)
-     _edi_replace_in_entry(data, replace);
+     _edi_search_request(replace, EDI_SEARCH_ACTION_REPLACE);
+}
+
+static void
+_edi_replace_all_clicked(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Editor *editor;
+   Edi_Editor_Search *replace;
+
+   editor = (Edi_Editor *)data;
+   replace = editor->search;
+
+   if (replace)
+     _edi_search_request(replace, EDI_SEARCH_ACTION_REPLACE_ALL);
+}
+
+static void
+_edi_search_option_changed(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Editor *editor;
+   Edi_Editor_Search *search;
+
+   editor = (Edi_Editor *)data;
+   search = editor->search;
+
+   search->current_search_line = 0;
+   search->term_found = EINA_FALSE;
+   _edi_search_notice_show(search, NULL);
 }
 
 static void
@@ -414,6 +1242,8 @@ _edi_search_key_up_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
    Edi_Editor_Search *search;
    Evas_Event_Key_Up *ev = (Evas_Event_Key_Up *)event_info;
    const char *str;
+   char *text;
+   int flags;
 
    editor = (Edi_Editor *)data;
    search = editor->search;
@@ -428,6 +1258,13 @@ _edi_search_key_up_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
      {
         search->current_search_line = 0;
         search->term_found = EINA_FALSE;
+
+        // Start indexing the new term while the user is still typing.
+        text = _edi_search_term_get(search);
+        flags = _edi_search_flags_get(search);
+        if (text && text[0] && !_edi_search_index_current(search, text, flags))
+          _edi_search_index_build(search, text, flags);
+        free(text);
      }
 }
 
@@ -435,8 +1272,8 @@ void
 edi_editor_search_add(Evas_Object *parent, Edi_Editor *editor)
 {
    Evas_Object *entry, *wrapped_text, *lbl, *btn, *box, *big_box, *table;
-   Evas_Object *replace_entry, *replace_lbl, *replace_btn;
-   Evas_Object *checkbox;
+   Evas_Object *replace_entry, *replace_lbl, *replace_btn, *replace_all_btn;
+   Evas_Object *checkbox, *regex_checkbox, *word_checkbox, *case_checkbox;
    Edi_Editor_Search *search;
 
    big_box = elm_box_add(parent);
@@ -511,6 +1348,24 @@ edi_editor_search_add(Evas_Object *parent, Edi_Editor *editor)
    evas_object_show(checkbox);
    elm_box_pack_end(box, checkbox);
 
+   case_checkbox = elm_check_add(parent);
+   elm_object_text_set(case_checkbox, _("Ignore case"));
+   evas_object_show(case_checkbox);
+   elm_box_pack_end(box, case_checkbox);
+   evas_object_smart_callback_add(case_checkbox, "changed", _edi_search_option_changed, editor);
+
+   word_checkbox = elm_check_add(parent);
+   elm_object_text_set(word_checkbox, _("Whole word"));
+   evas_object_show(word_checkbox);
+   elm_box_pack_end(box, word_checkbox);
+   evas_object_smart_callback_add(word_checkbox, "changed", _edi_search_option_changed, editor);
+
+   regex_checkbox = elm_check_add(parent);
+   elm_object_text_set(regex_checkbox, _("Regular expression"));
+   evas_object_show(regex_checkbox);
+   elm_box_pack_end(box, regex_checkbox);
+   evas_object_smart_callback_add(regex_checkbox, "changed", _edi_search_option_changed, editor);
+
    btn = elm_button_add(parent);
    elm_object_text_set(btn, _("Search"));
    evas_object_size_hint_align_set(btn, 1.0, 0.0);
@@ -527,6 +1382,14 @@ edi_editor_search_add(Evas_Object *parent, Edi_Editor *editor)
    elm_box_pack_end(box, replace_btn);
    evas_object_smart_callback_add(replace_btn, "clicked", _edi_replace_clicked, editor);
 
+   replace_all_btn = elm_button_add(parent);
+   elm_object_text_set(replace_all_btn, _("Replace all"));
+   evas_object_size_hint_align_set(replace_all_btn, 1.0, 0.0);
+   evas_object_size_hint_weight_set(replace_all_btn, 0.0, 0.0);
+   evas_object_show(replace_all_btn);
+   elm_box_pack_end(box, replace_all_btn);
+   evas_object_smart_callback_add(replace_all_btn, "clicked", _edi_replace_all_clicked, editor);
+
    btn = elm_button_add(parent);
    elm_object_text_set(btn, _("Cancel"));
    evas_object_size_hint_align_set(btn, 1.0, 0.0);
@@ -540,9 +1403,21 @@ edi_editor_search_add(Evas_Object *parent, Edi_Editor *editor)
    search->wrapped_text = wrapped_text;
    search->replace_entry = replace_entry;
    search->replace_btn = replace_btn;
+   search->replace_all_btn = replace_all_btn;
+   search->regex_checkbox = regex_checkbox;
+   search->word_checkbox = word_checkbox;
+   search->case_checkbox = case_checkbox;
    search->parent = parent;
    search->widget = big_box;
    search->checkbox = checkbox;
+   search->editor = editor;
    editor->search = search;
+
+   search->code = elm_code_widget_code_get(editor->entry);
+   elm_code_parser_add(search->code, _edi_search_parse_line_cb,
+                       _edi_search_parse_file_cb, search);
+   search->parser = eina_list_last_data_get(search->code->parsers);
+   evas_object_smart_callback_add(editor->entry, "changed,user", _edi_search_changed_cb, search);
+   evas_object_event_callback_add(editor->entry, EVAS_CALLBACK_DEL, _edi_search_entry_del_cb, search);
    evas_object_show(parent);
 }
@@ -427,6 +427,28 @@ edi_mainview_save()
    edi_mainview_panel_save(_current_panel);
 }
 
+void
+edi_mainview_save_all(void)
+{
+   Edi_Mainview_Panel *panel;
+   Edi_Mainview_Item *item;
+   Edi_Editor *editor;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_mainview_panels, l, panel)
+     edi_mainview_panel_save_all(panel);
+
+   EINA_LIST_FOREACH(_edi_mainview_wins, l, item)
+     {
+        if (!item->view)
+          continue;
+
+        editor = (Edi_Editor *)evas_object_data_get(item->view, "editor");
+        if (editor)
+          edi_editor_save(editor);
+     }
+}
+
 void
 edi_mainview_new_window()
 {
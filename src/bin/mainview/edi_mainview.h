@@ -128,6 +128,13 @@ void edi_mainview_open_window(Edi_Path_Options *options);
  */
 void edi_mainview_save();
 
+/**
+ * Save every modified file, in all panels and windows.
+ *
+ * @ingroup Content
+ */
+void edi_mainview_save_all(void);
+
 /**
  * Move the current tab to a new window.
  *
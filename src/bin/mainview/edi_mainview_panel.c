@@ -657,6 +657,28 @@ edi_mainview_panel_save(Edi_Mainview_Panel *panel)
    edi_editor_save(editor);
 }
 
+void
+edi_mainview_panel_save_all(Edi_Mainview_Panel *panel)
+{
+   Edi_Mainview_Item *item;
+   Edi_Editor *editor;
+   Eina_List *l;
+
+   if (!panel)
+     return;
+
+   EINA_LIST_FOREACH(panel->items, l, item)
+     {
+        // Tabs that were never shown have no editor and nothing to save.
+        if (!item->view)
+          continue;
+
+        editor = (Edi_Editor *)evas_object_data_get(item->view, "editor");
+        if (editor)
+          edi_editor_save(editor);
+     }
+}
+
 void
 edi_mainview_panel_undo(Edi_Mainview_Panel *panel)
 {
@@ -668,7 +690,7 @@ edi_mainview_panel_undo(Edi_Mainview_Panel *panel)
    editor = (Edi_Editor *)evas_object_data_get(panel->current->view, "editor");
 
    if (editor)
-     elm_code_widget_undo(editor->entry);
+     edi_editor_undo(editor);
 }
 
 Eina_Bool
@@ -684,7 +706,7 @@ edi_mainview_panel_can_undo(Edi_Mainview_Panel *panel)
    if (!editor)
      return EINA_FALSE;
 
-   return elm_code_widget_can_undo_get(editor->entry);
+   return edi_editor_can_undo(editor);
 }
 
 void
@@ -698,7 +720,7 @@ edi_mainview_panel_redo(Edi_Mainview_Panel *panel)
    editor = (Edi_Editor *)evas_object_data_get(panel->current->view, "editor");
 
    if (editor)
-     elm_code_widget_redo(editor->entry);
+     edi_editor_redo(editor);
 }
 
 Eina_Bool
@@ -714,7 +736,7 @@ edi_mainview_panel_can_redo(Edi_Mainview_Panel *panel)
    if (!editor)
      return EINA_FALSE;
 
-   return elm_code_widget_can_redo_get(editor->entry);
+   return edi_editor_can_redo(editor);
 }
 
 Eina_Bool
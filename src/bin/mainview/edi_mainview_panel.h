@@ -162,6 +162,15 @@ Edi_Mainview_Item *edi_mainview_panel_item_current_get(Edi_Mainview_Panel *panel
  */
 void edi_mainview_panel_save(Edi_Mainview_Panel *panel);
 
+/**
+ * Save every modified file open in the panel.
+ *
+ * @param panel the mainview panel context
+ *
+ * @ingroup Content
+ */
+void edi_mainview_panel_save_all(Edi_Mainview_Panel *panel);
+
 /**
  * Move the current tab to a new window.
  *
@@ -76,6 +76,17 @@ _edi_settings_display_tab_inserts_spaces_cb(void *data EINA_UNUSED, Evas_Object
    _edi_project_config_save();
 }
 
+static void
+_edi_settings_display_blame_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                               void *event EINA_UNUSED)
+{
+   Evas_Object *check;
+
+   check = (Evas_Object *)obj;
+   _edi_project_config->gui.show_blame = elm_check_state_get(check);
+   _edi_project_config_save();
+}
+
 static void
 _edi_settings_display_widthmarker_cb(void *data EINA_UNUSED, Evas_Object *obj,
                                      void *event EINA_UNUSED)
@@ -87,6 +98,17 @@ _edi_settings_display_widthmarker_cb(void *data EINA_UNUSED, Evas_Object *obj,
    _edi_project_config_save();
 }
 
+static void
+_edi_settings_display_console_lines_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                                       void *event EINA_UNUSED)
+{
+   Evas_Object *spinner;
+
+   spinner = (Evas_Object *)obj;
+   _edi_project_config->gui.console_lines = (unsigned int) elm_spinner_value_get(spinner);
+   _edi_project_config_save();
+}
+
 static void
 _edi_settings_display_tabstop_cb(void *data EINA_UNUSED, Evas_Object *obj,
                                      void *event EINA_UNUSED)
@@ -420,6 +442,40 @@ _edi_settings_display_create(Evas_Object *parent)
                                   _edi_settings_display_tab_inserts_spaces_cb, NULL);
    elm_table_pack(table, check, 1, 3, 1, 1);
    evas_object_show(check);
+
+   label = elm_label_add(box);
+   elm_object_text_set(label, _("Display line authors"));
+   evas_object_size_hint_align_set(label, EVAS_HINT_EXPAND, 0.5);
+   elm_table_pack(table, label, 0, 4, 1, 1);
+   evas_object_show(label);
+
+   check = elm_check_add(box);
+   elm_check_state_set(check, _edi_project_config->gui.show_blame);
+   evas_object_size_hint_weight_set(check, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(check, 0.0, 0.5);
+   evas_object_smart_callback_add(check, "changed",
+                                  _edi_settings_display_blame_cb, NULL);
+   elm_table_pack(table, check, 1, 4, 1, 1);
+   evas_object_show(check);
+
+   label = elm_label_add(box);
+   elm_object_text_set(label, _("Console line limit"));
+   evas_object_size_hint_align_set(label, EVAS_HINT_EXPAND, 0.5);
+   elm_table_pack(table, label, 0, 5, 1, 1);
+   evas_object_show(label);
+
+   spinner = elm_spinner_add(box);
+   elm_spinner_value_set(spinner, _edi_project_config->gui.console_lines);
+   elm_spinner_editable_set(spinner, EINA_TRUE);
+   elm_spinner_step_set(spinner, 1000);
+   elm_spinner_wrap_set(spinner, EINA_FALSE);
+   elm_spinner_min_max_set(spinner, 1000, 1000000);
+   evas_object_size_hint_weight_set(spinner, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(spinner, 0.0, 0.95);
+   evas_object_smart_callback_add(spinner, "changed",
+                                  _edi_settings_display_console_lines_cb, NULL);
+   elm_table_pack(table, spinner, 1, 5, 1, 1);
+   evas_object_show(spinner);
    elm_box_pack_end(box, table);
 
    return container;
@@ -458,6 +514,18 @@ _edi_settings_builds_args_cb(void *data EINA_UNUSED, Evas_Object *obj,
    _edi_project_config_save();
 }
 
+static void
+_edi_settings_builds_cache_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                              void *event EINA_UNUSED)
+{
+   Evas_Object *check;
+
+   check = (Evas_Object *)obj;
+   _edi_project_config->build_cache = elm_check_state_get(check);
+   edi_build_cache_enabled_set(_edi_project_config->build_cache);
+   _edi_project_config_save();
+}
+
 static char *
 _edi_settings_builds_debug_tool_text_get_cb(void *data, Evas_Object *obj EINA_UNUSED, const char *part EINA_UNUSED)
 {
@@ -489,8 +557,9 @@ static Evas_Object *
 _edi_settings_builds_create(Evas_Object *parent)
 {
    Evas_Object *box, *frame, *table, *label, *ic, *selector, *file, *entry;
-   Evas_Object *combobox;
+   Evas_Object *combobox, *check;
    Elm_Genlist_Item_Class *itc;
+   Edi_Build_Cache_Type cache;
    Edi_Debug_Tool *tools;
    int i;
 
@@ -591,6 +660,31 @@ _edi_settings_builds_create(Evas_Object *parent)
    elm_genlist_realized_items_update(combobox);
    elm_genlist_item_class_free(itc);
 
+   cache = edi_build_cache_type_get();
+   label = elm_label_add(box);
+   if (cache == EDI_BUILD_CACHE_CCACHE)
+     elm_object_text_set(label, _("Compile through ccache"));
+   else if (cache == EDI_BUILD_CACHE_SCCACHE)
+     elm_object_text_set(label, _("Compile through sccache"));
+   else
+     elm_object_text_set(label, _("Compiler cache (not installed)"));
+   evas_object_size_hint_weight_set(label, 0.0, 0.0);
+   evas_object_size_hint_align_set(label, 0.0, EVAS_HINT_FILL);
+   elm_table_pack(table, label, 0, 3, 1, 1);
+   evas_object_show(label);
+
+   check = elm_check_add(box);
+   elm_check_state_set(check, _edi_project_config->build_cache);
+   elm_object_disabled_set(check, cache == EDI_BUILD_CACHE_NONE);
+   if (cache == EDI_BUILD_CACHE_CCACHE)
+     elm_object_tooltip_text_set(check, _("Meson builds use ccache when it is installed, even when this is off"));
+   evas_object_size_hint_weight_set(check, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(check, 0.0, 0.5);
+   evas_object_smart_callback_add(check, "changed",
+                                  _edi_settings_builds_cache_cb, NULL);
+   elm_table_pack(table, check, 1, 3, 2, 1);
+   evas_object_show(check);
+
    return frame;
 }
 
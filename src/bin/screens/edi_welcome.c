@@ -28,6 +28,7 @@ typedef struct _Edi_Template
 typedef struct _Edi_Welcome_Data {
    Evas_Object *pb;
    Evas_Object *button;
+   Edi_Scm_Job *job;
    char *dir;
    char *url;
    int status;
@@ -595,34 +596,45 @@ _edi_welcome_project_new_cb(void *data, Evas_Object *obj EINA_UNUSED, void *even
 }
 
 static void
-_edi_welcome_clone_thread_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+_edi_welcome_clone_progress_cb(void *data, const Edi_Scm_Job_Progress *progress)
 {
    Edi_Welcome_Data *wd = data;
 
+   // Only the transfer has a meaningful size, the other steps are quick.
+   if (strcmp(progress->stage, "Receiving objects"))
+     return;
+
    elm_progressbar_pulse(wd->pb, EINA_FALSE);
+   elm_progressbar_pulse_set(wd->pb, EINA_FALSE);
+   elm_progressbar_value_set(wd->pb, progress->percent / 100.0);
+}
+
+static void
+_edi_welcome_clone_end_cb(void *data, int status, Eina_Bool cancelled)
+{
+   Edi_Welcome_Data *wd = data;
+
+   wd->job = NULL;
+   wd->status = status;
+
+   elm_progressbar_pulse(wd->pb, EINA_FALSE);
+   elm_progressbar_pulse_set(wd->pb, EINA_TRUE);
    evas_object_hide(wd->pb);
-   elm_object_disabled_set(wd->button, EINA_FALSE);
+   elm_object_text_set(wd->button, _("Checkout"));
 
-   if (wd->status)
+   if (!cancelled && wd->status)
      _edi_message_open(_("Unable to clone project, please check URL or try again later"), EINA_FALSE);
-   else
+   else if (!cancelled)
      _edi_welcome_project_open(wd->dir, EINA_FALSE);
 
    free(wd->dir);
    free(wd->url);
+   wd->dir = wd->url = NULL;
 
-   if (!wd->status)
+   if (!wd->status && !cancelled)
      free(wd);
 }
 
-static void
-_edi_welcome_clone_thread_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
-{
-   Edi_Welcome_Data *wd = data;
-
-   wd->status = edi_scm_git_clone(wd->url, wd->dir);
-}
-
 static void
 _edi_welcome_project_clone_click_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
@@ -630,6 +642,12 @@ _edi_welcome_project_clone_click_cb(void *data EINA_UNUSED, Evas_Object *obj EIN
    const char *parent, *name, *url;
    Edi_Welcome_Data *wd = data;
 
+   if (wd->job)
+     {
+        edi_scm_job_cancel(wd->job);
+        return;
+     }
+
    url = elm_object_text_get(_create_inputs[0]);
    entry = elm_layout_content_get(_create_inputs[1], "elm.swallow.entry");
    parent = elm_object_text_get(entry);
@@ -656,11 +674,15 @@ _edi_welcome_project_clone_click_cb(void *data EINA_UNUSED, Evas_Object *obj EIN
    wd->dir = edi_path_append(parent, name);
    wd->url = strdup(url);
 
-   elm_object_disabled_set(wd->button, EINA_TRUE);
    elm_progressbar_pulse(wd->pb, EINA_TRUE);
    evas_object_show(wd->pb);
 
-   ecore_thread_run(_edi_welcome_clone_thread_run_cb, _edi_welcome_clone_thread_end_cb, NULL, wd);
+   wd->job = edi_scm_git_clone_job(wd->url, wd->dir, NULL, _edi_welcome_clone_progress_cb,
+                                   _edi_welcome_clone_end_cb, wd);
+   if (wd->job)
+     elm_object_text_set(wd->button, _("Cancel"));
+   else
+     _edi_welcome_clone_end_cb(wd, -1, EINA_FALSE);
 }
 
 static void
@@ -693,7 +715,7 @@ _edi_welcome_project_clone_cb(void *data, Evas_Object *obj EINA_UNUSED, void *ev
    evas_object_show(button);
    elm_table_pack(content, button, _EDI_WELCOME_PROJECT_NEW_TABLE_WIDTH - 2, row, 2, 1);
 
-   wd = malloc(sizeof(Edi_Welcome_Data));
+   wd = calloc(1, sizeof(Edi_Welcome_Data));
    wd->button = button;
    wd->pb = pb;
 
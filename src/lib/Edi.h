@@ -36,6 +36,14 @@ extern "C" {
 #include <edi_create.h>
 #include <edi_build_provider.h>
 #include <edi_builder.h>
+#include <edi_build_queue.h>
+#include <edi_build_server.h>
+#include <edi_build_cache.h>
+#include <edi_compile_command.h>
+#include <edi_build_timing.h>
+#include <edi_test_runner.h>
+#include <edi_test_affected.h>
+#include <edi_diagnostic.h>
 #include <edi_path.h>
 #include <edi_exe.h>
 #include <edi_scm.h>
@@ -37,6 +37,8 @@ edi_init(void)
    INF("Edi library loaded");
 
    // Put here your initialization logic of your library
+   _edi_exe_init();
+   _edi_build_provider_init();
 
    eina_log_timing(_edi_lib_log_dom, EINA_LOG_STATE_STOP, EINA_LOG_STATE_INIT);
 
@@ -63,6 +65,12 @@ edi_shutdown(void)
    INF("Edi library shut down");
 
    // Put here your shutdown logic
+   _edi_build_server_shutdown();
+   _edi_compile_command_shutdown();
+   _edi_build_queue_shutdown();
+   _edi_test_runner_shutdown();
+   _edi_build_provider_shutdown();
+   _edi_exe_shutdown();
 
    eina_log_domain_unregister(_edi_lib_log_dom);
    _edi_lib_log_dom = -1;
@@ -0,0 +1,289 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+// The statistics of the cache read around one build.
+typedef struct _Edi_Build_Cache_Session
+{
+   Edi_Build_Cache_Type type;
+   Eina_Strbuf *output;
+   Eina_Bool reading; /* A statistics command is running */
+   Eina_Bool started; /* The statistics at the start were read */
+   Eina_Bool valid;   /* And they could be parsed */
+   Eina_Bool ended;   /* The build is over */
+   Edi_Build_Cache_Stats start;
+
+   Edi_Build_Cache_Stats_Cb cb;
+   void *data;
+} Edi_Build_Cache_Session;
+
+static struct {
+   Eina_Bool enabled;
+   Eina_Bool detected;
+   Edi_Build_Cache_Type type;
+
+   Edi_Build_Cache_Session *session;
+} _edi_build_cache;
+
+EAPI void
+edi_build_cache_enabled_set(Eina_Bool enabled)
+{
+   _edi_build_cache.enabled = enabled;
+}
+
+EAPI Edi_Build_Cache_Type
+edi_build_cache_type_get(void)
+{
+   // The PATH is searched once, installing a cache takes a restart to notice.
+   if (!_edi_build_cache.detected)
+     {
+        if (ecore_file_app_installed("ccache"))
+          _edi_build_cache.type = EDI_BUILD_CACHE_CCACHE;
+        else if (ecore_file_app_installed("sccache"))
+          _edi_build_cache.type = EDI_BUILD_CACHE_SCCACHE;
+        else
+          _edi_build_cache.type = EDI_BUILD_CACHE_NONE;
+        _edi_build_cache.detected = EINA_TRUE;
+     }
+
+   return _edi_build_cache.type;
+}
+
+EAPI const char *
+edi_build_cache_launcher_get(void)
+{
+   if (!_edi_build_cache.enabled)
+     return NULL;
+
+   switch (edi_build_cache_type_get())
+     {
+      case EDI_BUILD_CACHE_CCACHE:
+        return "ccache";
+      case EDI_BUILD_CACHE_SCCACHE:
+        return "sccache";
+      default:
+        return NULL;
+     }
+}
+
+EAPI const char *
+edi_build_cache_env_get(void)
+{
+   const char *launcher;
+
+   launcher = edi_build_cache_launcher_get();
+   if (!launcher)
+     return "";
+
+   // Keep the compilers chosen by the user, configure reads them from the environment.
+   return eina_slstr_printf("export CC=\"%s ${CC:-cc}\" CXX=\"%s ${CXX:-c++}\"; ", launcher, launcher);
+}
+
+EAPI const char *
+edi_build_cache_make_args_get(void)
+{
+   if (!edi_build_cache_launcher_get())
+     return "";
+
+   // A Makefile that sets CC itself wins over the environment, but not over the command line.
+   return " CC=\"$CC\" CXX=\"$CXX\"";
+}
+
+// Read the number after a label, if nothing but spaces separate them.
+static Eina_Bool
+_edi_build_cache_count_read(const char *line, const char *label, unsigned long *count)
+{
+   size_t length;
+   char *end;
+
+   length = strlen(label);
+   if (strncmp(line, label, length) || (line[length] != ' ' && line[length] != '\t'))
+     return EINA_FALSE;
+
+   line += length;
+   while (*line == ' ' || *line == '\t')
+     line++;
+   if (*line < '0' || *line > '9')
+     return EINA_FALSE;
+
+   *count += strtoul(line, &end, 10);
+   return *end == '\0' || *end == '\n' || *end == '\r';
+}
+
+EAPI Eina_Bool
+edi_build_cache_stats_parse(Edi_Build_Cache_Type type, const char *output,
+                            Edi_Build_Cache_Stats *stats)
+{
+   const char *line, *end;
+   Eina_Bool hits = EINA_FALSE, misses = EINA_FALSE;
+
+   if (!output || !stats)
+     return EINA_FALSE;
+
+   stats->hits = stats->misses = 0;
+   for (line = output; *line; line = end + 1)
+     {
+        if (type == EDI_BUILD_CACHE_CCACHE)
+          {
+             // One "name<TAB>value" per line.
+             hits |= _edi_build_cache_count_read(line, "direct_cache_hit", &stats->hits);
+             hits |= _edi_build_cache_count_read(line, "preprocessed_cache_hit", &stats->hits);
+             misses |= _edi_build_cache_count_read(line, "cache_miss", &stats->misses);
+          }
+        else if (type == EDI_BUILD_CACHE_SCCACHE)
+          {
+             // The totals, not the lines for each language such as "Cache hits (C/C++)".
+             hits |= _edi_build_cache_count_read(line, "Cache hits", &stats->hits);
+             misses |= _edi_build_cache_count_read(line, "Cache misses", &stats->misses);
+          }
+
+        end = strchr(line, '\n');
+        if (!end)
+          break;
+     }
+
+   return hits && misses;
+}
+
+static void
+_edi_build_cache_session_finish(Edi_Build_Cache_Session *session, const Edi_Build_Cache_Stats *stats)
+{
+   if (session->cb)
+     session->cb(session->data, stats);
+
+   eina_strbuf_free(session->output);
+   free(session);
+}
+
+static Eina_Bool _edi_build_cache_stats_read(Edi_Build_Cache_Session *session);
+
+static void
+_edi_build_cache_stats_data_cb(void *data, Edi_Exe_Stream stream, const char *buf, size_t length)
+{
+   Edi_Build_Cache_Session *session = data;
+
+   if (stream == EDI_EXE_STREAM_OUTPUT)
+     eina_strbuf_append_length(session->output, buf, length);
+}
+
+static void
+_edi_build_cache_stats_done_cb(void *data, int code, Eina_Bool timed_out)
+{
+   Edi_Build_Cache_Session *session = data;
+   Edi_Build_Cache_Stats now = { 0, 0 }, stats;
+   Eina_Bool ok;
+
+   session->reading = EINA_FALSE;
+   ok = !code && !timed_out &&
+        edi_build_cache_stats_parse(session->type, eina_strbuf_string_get(session->output), &now);
+   eina_strbuf_reset(session->output);
+
+   if (!session->started)
+     {
+        session->started = EINA_TRUE;
+        session->valid = ok;
+        session->start = now;
+
+        // The build ended before its start was read, read the end now.
+        if (!session->ended)
+          return;
+        if (!ok || !session->cb || !_edi_build_cache_stats_read(session))
+          _edi_build_cache_session_finish(session, NULL);
+        return;
+     }
+
+   if (!ok)
+     {
+        _edi_build_cache_session_finish(session, NULL);
+        return;
+     }
+
+   // The cache is shared, so other builds running at the same time are counted too.
+   stats.hits = now.hits >= session->start.hits ? now.hits - session->start.hits : 0;
+   stats.misses = now.misses >= session->start.misses ? now.misses - session->start.misses : 0;
+   _edi_build_cache_session_finish(session, &stats);
+}
+
+static Eina_Bool
+_edi_build_cache_stats_read(Edi_Build_Cache_Session *session)
+{
+   const char *command;
+
+   if (session->type == EDI_BUILD_CACHE_CCACHE)
+     command = "ccache --print-stats";
+   else if (session->type == EDI_BUILD_CACHE_SCCACHE)
+     command = "sccache --show-stats";
+   else
+     return EINA_FALSE;
+
+   // sccache may have to start its server first, but should not hold up the report for long.
+   session->reading = edi_exe_run(NULL, NULL, command, 10.0, _edi_build_cache_stats_data_cb,
+                                  _edi_build_cache_stats_done_cb, session) != NULL;
+
+   return session->reading;
+}
+
+EAPI void
+edi_build_cache_stats_begin(void)
+{
+   Edi_Build_Cache_Session *session;
+
+   // A build that never ended, its statistics are no longer wanted.
+   session = _edi_build_cache.session;
+   _edi_build_cache.session = NULL;
+   if (session && session->reading)
+     session->ended = EINA_TRUE;
+   else if (session)
+     _edi_build_cache_session_finish(session, NULL);
+
+   if (!edi_build_cache_launcher_get())
+     return;
+
+   session = calloc(1, sizeof(Edi_Build_Cache_Session));
+   session->type = edi_build_cache_type_get();
+   session->output = eina_strbuf_new();
+   if (!_edi_build_cache_stats_read(session))
+     {
+        _edi_build_cache_session_finish(session, NULL);
+        return;
+     }
+
+   _edi_build_cache.session = session;
+}
+
+EAPI Eina_Bool
+edi_build_cache_stats_end(Edi_Build_Cache_Stats_Cb cb, void *data)
+{
+   Edi_Build_Cache_Session *session;
+
+   session = _edi_build_cache.session;
+   if (!session)
+     return EINA_FALSE;
+   _edi_build_cache.session = NULL;
+
+   session->ended = EINA_TRUE;
+   session->cb = cb;
+   session->data = data;
+
+   // The end is read once the start has been.
+   if (session->reading)
+     return EINA_TRUE;
+
+   if (!session->valid || !_edi_build_cache_stats_read(session))
+     {
+        session->cb = NULL;
+        _edi_build_cache_session_finish(session, NULL);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
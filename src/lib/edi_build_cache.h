@@ -0,0 +1,143 @@
+#ifndef EDI_BUILD_CACHE_H_
+# define EDI_BUILD_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for sending the compiles of a build through a compiler cache.
+ */
+
+/**
+ * The compiler caches that builds can use.
+ */
+typedef enum {
+   EDI_BUILD_CACHE_NONE,
+   EDI_BUILD_CACHE_CCACHE,
+   EDI_BUILD_CACHE_SCCACHE,
+} Edi_Build_Cache_Type;
+
+/**
+ * How well the compiler cache served a build.
+ */
+typedef struct _Edi_Build_Cache_Stats
+{
+   unsigned long hits; /**< The compiles answered from the cache */
+   unsigned long misses; /**< The compiles the compiler had to run */
+} Edi_Build_Cache_Stats;
+
+/**
+ * Called once the statistics of the cache at the end of a build have been read.
+ *
+ * @param data The data passed to edi_build_cache_stats_end.
+ * @param stats The hits and misses of the build, or NULL if they could not be read.
+ */
+typedef void (*Edi_Build_Cache_Stats_Cb)(void *data, const Edi_Build_Cache_Stats *stats);
+
+/**
+ * @brief Compiler cache
+ * @defgroup Build_Cache
+ *
+ * @{
+ *
+ * Find ccache or sccache and count the hits and misses of each build.
+ *
+ */
+
+/**
+ * Set whether builds of the current project should use a compiler cache.
+ *
+ * Meson uses ccache by itself whenever it is installed and CC is not set,
+ * so disabling the cache does not stop meson builds from using it.
+ *
+ * @param enabled EINA_TRUE to send compiles through the cache installed.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI void edi_build_cache_enabled_set(Eina_Bool enabled);
+
+/**
+ * Get the compiler cache installed, ccache being preferred to sccache.
+ *
+ * @return The cache found in the PATH, or EDI_BUILD_CACHE_NONE.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI Edi_Build_Cache_Type edi_build_cache_type_get(void);
+
+/**
+ * Get the command compilers should be launched through.
+ *
+ * @return "ccache" or "sccache", or NULL if the current project uses no cache.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI const char *edi_build_cache_launcher_get(void);
+
+/**
+ * Get shell commands setting CC and CXX to compile through the cache.
+ *
+ * @return Commands to put before a configure or make, empty if the current project uses no cache.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI const char *edi_build_cache_env_get(void);
+
+/**
+ * Get the arguments passing the CC and CXX set by edi_build_cache_env_get() to make.
+ *
+ * Variables given to make on its command line override those its Makefile sets.
+ *
+ * @return Arguments to append to a make command, empty if the current project uses no cache.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI const char *edi_build_cache_make_args_get(void);
+
+/**
+ * Start reading the statistics of the cache at the start of a build.
+ *
+ * The statistics are read in the background, this must be called from the main loop.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI void edi_build_cache_stats_begin(void);
+
+/**
+ * Count the hits and misses of the cache since edi_build_cache_stats_begin.
+ *
+ * The statistics are read in the background, this must be called from the main loop.
+ *
+ * @param cb The function called with the hits and misses of the build.
+ * @param data The data passed to the callback.
+ * @return EINA_FALSE if the current project uses no cache or its start could not be read,
+ *         the callback is not called then.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI Eina_Bool edi_build_cache_stats_end(Edi_Build_Cache_Stats_Cb cb, void *data);
+
+/**
+ * Read the statistics printed by "ccache --print-stats" or "sccache --show-stats".
+ *
+ * @param type The cache that printed the statistics.
+ * @param output The statistics printed.
+ * @param stats Where to store the total hits and misses of the cache.
+ * @return EINA_TRUE if the hits and misses were found.
+ *
+ * @ingroup Build_Cache
+ */
+EAPI Eina_Bool edi_build_cache_stats_parse(Edi_Build_Cache_Type type, const char *output,
+                                           Edi_Build_Cache_Stats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BUILD_CACHE_H_ */
@@ -2,11 +2,43 @@
 # include "config.h"
 #endif
 
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
 #include "Edi.h"
 #include "edi_build_provider.h"
 
 #include "edi_private.h"
 
+// Seconds the build directories found in a directory are trusted before it is read again.
+#define EDI_BUILD_PROVIDER_DIR_CACHE_TIME 2.0
+
+typedef struct _Edi_Build_Dir_Key
+{
+   dev_t dev;
+   ino_t ino;
+} Edi_Build_Dir_Key;
+
+typedef struct _Edi_Build_Dir_Inode
+{
+   time_t mtime;
+   Eina_Bool build;
+} Edi_Build_Dir_Inode;
+
+typedef struct _Edi_Build_Dir_Parent
+{
+   double read;
+   Eina_List *builds;
+} Edi_Build_Dir_Parent;
+
+// The search panel asks from its own thread.
+static Eina_Lock _edi_build_dir_lock;
+static Eina_Hash *_edi_build_dir_inodes = NULL;
+static Eina_Hash *_edi_build_dir_parents = NULL;
+
 extern Edi_Build_Provider _edi_build_provider_make;
 extern Edi_Build_Provider _edi_build_provider_cmake;
 extern Edi_Build_Provider _edi_build_provider_cargo;
@@ -14,6 +46,161 @@ extern Edi_Build_Provider _edi_build_provider_python;
 extern Edi_Build_Provider _edi_build_provider_meson;
 extern Edi_Build_Provider _edi_build_provider_go;
 
+static unsigned int
+_edi_build_dir_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof(Edi_Build_Dir_Key);
+}
+
+static int
+_edi_build_dir_key_cmp(const void *key1, int length1 EINA_UNUSED,
+                       const void *key2, int length2 EINA_UNUSED)
+{
+   return memcmp(key1, key2, sizeof(Edi_Build_Dir_Key));
+}
+
+static int
+_edi_build_dir_key_hash(const void *key, int length)
+{
+   return eina_hash_superfast(key, length);
+}
+
+static void
+_edi_build_dir_parent_free(void *data)
+{
+   Edi_Build_Dir_Parent *parent = data;
+   const char *name;
+
+   EINA_LIST_FREE(parent->builds, name)
+     eina_stringshare_del(name);
+   free(parent);
+}
+
+// The files meson, cmake and cargo leave in the directories they build in.
+static Eina_Bool
+_edi_build_dir_child_is(const char *dir, const char *name)
+{
+   Edi_Build_Dir_Inode *inode;
+   Edi_Build_Dir_Key key;
+   struct stat st;
+   char *path;
+
+   path = edi_path_append(dir, name);
+   if (stat(path, &st) || !S_ISDIR(st.st_mode))
+     {
+        free(path);
+        return EINA_FALSE;
+     }
+
+   memset(&key, 0, sizeof(key));
+   key.dev = st.st_dev;
+   key.ino = st.st_ino;
+
+   inode = eina_hash_find(_edi_build_dir_inodes, &key);
+   if (!inode)
+     {
+        inode = calloc(1, sizeof(Edi_Build_Dir_Inode));
+        eina_hash_add(_edi_build_dir_inodes, &key, inode);
+     }
+   else if (inode->mtime == st.st_mtime)
+     {
+        free(path);
+        return inode->build;
+     }
+
+   inode->mtime = st.st_mtime;
+   inode->build = edi_path_relative_exists(path, "build.ninja") ||
+                  edi_path_relative_exists(path, "CMakeCache.txt") ||
+                  edi_path_relative_exists(path, "CACHEDIR.TAG");
+
+   free(path);
+   return inode->build;
+}
+
+static Edi_Build_Dir_Parent *
+_edi_build_dir_parent_read(const char *dir)
+{
+   Edi_Build_Dir_Parent *parent;
+   struct dirent *entry;
+   DIR *handle;
+
+   parent = calloc(1, sizeof(Edi_Build_Dir_Parent));
+   handle = opendir(dir);
+   if (!handle)
+     return parent;
+
+   while ((entry = readdir(handle)))
+     {
+        // Hidden files are never shown, whatever they hold.
+        if (entry->d_name[0] == '.')
+          continue;
+        if (entry->d_type != DT_DIR && entry->d_type != DT_UNKNOWN)
+          continue;
+
+        if (_edi_build_dir_child_is(dir, entry->d_name))
+          parent->builds = eina_list_append(parent->builds, eina_stringshare_add(entry->d_name));
+     }
+   closedir(handle);
+
+   return parent;
+}
+
+EAPI Eina_Bool
+edi_build_provider_build_dir_is(const char *path)
+{
+   Edi_Build_Dir_Parent *parent;
+   const char *name;
+   char *dir;
+   double now;
+   Eina_Bool build;
+
+   if (!path || !path[0] || !_edi_build_dir_parents)
+     return EINA_FALSE;
+
+   name = ecore_file_file_get(path);
+   if (!name || !name[0] || name[0] == '.')
+     return EINA_FALSE;
+
+   dir = ecore_file_dir_get(path);
+   now = ecore_time_get();
+
+   eina_lock_take(&_edi_build_dir_lock);
+   parent = eina_hash_find(_edi_build_dir_parents, dir);
+   if (!parent || now - parent->read > EDI_BUILD_PROVIDER_DIR_CACHE_TIME)
+     {
+        if (parent)
+          eina_hash_del_by_key(_edi_build_dir_parents, dir);
+
+        parent = _edi_build_dir_parent_read(dir);
+        parent->read = now;
+        eina_hash_add(_edi_build_dir_parents, dir, parent);
+     }
+   build = !!eina_list_search_unsorted(parent->builds, EINA_COMPARE_CB(strcmp), name);
+   eina_lock_release(&_edi_build_dir_lock);
+
+   free(dir);
+   return build;
+}
+
+void
+_edi_build_provider_init(void)
+{
+   eina_lock_new(&_edi_build_dir_lock);
+   _edi_build_dir_inodes = eina_hash_new(_edi_build_dir_key_length, _edi_build_dir_key_cmp,
+                                         _edi_build_dir_key_hash, free, 8);
+   _edi_build_dir_parents = eina_hash_string_superfast_new(_edi_build_dir_parent_free);
+}
+
+void
+_edi_build_provider_shutdown(void)
+{
+   eina_hash_free(_edi_build_dir_parents);
+   _edi_build_dir_parents = NULL;
+   eina_hash_free(_edi_build_dir_inodes);
+   _edi_build_dir_inodes = NULL;
+   eina_lock_free(&_edi_build_dir_lock);
+}
+
 EAPI Edi_Build_Provider *edi_build_provider_for_project_get()
 {
    return edi_build_provider_for_project_path_get(edi_project_get());
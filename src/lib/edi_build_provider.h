@@ -22,6 +22,9 @@ typedef struct _Edi_Build_Provider
    void (*test)(void);
    void (*run)(const char *path, const char *args);
    void (*clean)(void);
+
+   Eina_Bool (*file_compilable_is)(const char *path);
+   void (*compile_file)(const char *path);
 } Edi_Build_Provider;
 
 /**
@@ -70,7 +73,20 @@ EAPI Edi_Build_Provider *edi_build_provider_for_id_get(const char *id);
  * @}
  */
 
-
+/**
+ * Check if a path is a directory that meson, cmake or cargo builds in.
+ *
+ * The directories found in each parent are remembered for a couple of
+ * seconds, and what was found in each directory until it is modified, so
+ * walking a project tree costs a hash lookup for most paths.
+ * This can be called from any thread.
+ *
+ * @param path The path to check.
+ * @return EINA_TRUE if the path holds build.ninja, CMakeCache.txt or CACHEDIR.TAG.
+ *
+ * @ingroup Lookup
+ */
+EAPI Eina_Bool edi_build_provider_build_dir_is(const char *path);
 
 #ifdef __cplusplus
 }
@@ -47,7 +47,7 @@ _cargo_file_hidden_is(const char *file)
    if (eina_str_has_extension(file, ".o") || !strcmp(ecore_file_file_get(file), "target"))
      return EINA_TRUE;
 
-   return EINA_FALSE;
+   return edi_build_provider_build_dir_is(file);
 }
 
 static Eina_Bool
@@ -56,11 +56,13 @@ _cargo_project_runnable_is(const char *file EINA_UNUSED)
    return EINA_TRUE;
 }
 
+// Cargo older than 1.60 has no --timings, build without a report there.
 static void
 _cargo_build(void)
 {
    if (chdir(edi_project_get()) == 0)
-     edi_exe_notify("edi_build", "cargo build");
+     edi_exe_notify("edi_build", "if cargo build --help | grep -q -- --timings; "
+                                 "then cargo build --timings; else cargo build; fi");
 }
 
 static void
@@ -93,5 +95,7 @@ Edi_Build_Provider _edi_build_provider_cargo =
       _cargo_build,
       _cargo_test,
       _cargo_run,
-      _cargo_clean
+      _cargo_clean,
+      NULL,
+      NULL
    };
@@ -10,6 +10,9 @@
 
 #include "edi_private.h"
 
+// Left in the build directory while the compiler launcher in its CMakeCache is ours.
+#define CMAKE_LAUNCHER_MARKER ".edi_compiler_launcher"
+
 static Eina_Bool
 _cmake_project_supported(const char *path)
 {
@@ -34,7 +37,7 @@ _cmake_file_hidden_is(const char *file)
    if (!strcmp(ecore_file_file_get(file), "autom4te.cache"))
      return EINA_TRUE;
 
-   return EINA_FALSE;
+   return edi_build_provider_build_dir_is(file);
 }
 
 static Eina_Bool
@@ -49,10 +52,32 @@ _cmake_project_runnable_is(const char *path)
 static void
 _cmake_build(void)
 {
+   const char *makefile, *launcher, *defines = "", *marker = "", *args = "";
+
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
 
-   edi_exe_notify("edi_build", "mkdir -p build && cd build && cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=1 .. && make && cd ..");
+   // Time each recipe so the build can be reported, see edi_build_timing.
+   makefile = edi_build_timing_make_file_get();
+   if (makefile)
+     args = eina_slstr_printf(" -f '%s'", makefile);
+
+   // The CMakeCache keeps a launcher, so only clear one we set, never the user's own.
+   launcher = edi_build_cache_launcher_get();
+   if (launcher)
+     {
+        defines = eina_slstr_printf(" -DCMAKE_C_COMPILER_LAUNCHER=%s -DCMAKE_CXX_COMPILER_LAUNCHER=%s",
+                                    launcher, launcher);
+        marker = "touch " CMAKE_LAUNCHER_MARKER " && ";
+     }
+   else if (ecore_file_exists("build/" CMAKE_LAUNCHER_MARKER))
+     {
+        defines = " -DCMAKE_C_COMPILER_LAUNCHER= -DCMAKE_CXX_COMPILER_LAUNCHER=";
+        marker = "rm -f " CMAKE_LAUNCHER_MARKER " && ";
+     }
+
+   edi_exe_notify("edi_build", eina_slstr_printf("mkdir -p build && cd build && cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=1%s .. && %smake%s && cd ..",
+                                                 defines, marker, args));
 }
 
 static void
@@ -103,6 +128,33 @@ _cmake_clean(void)
    edi_exe_notify("edi_clean", "make clean");
 }
 
+static Eina_Bool
+_cmake_file_compilable_is(const char *path)
+{
+   Edi_Compile_Command *command;
+
+   command = edi_compile_command_for_project_get(path);
+   if (!command)
+     return EINA_FALSE;
+
+   edi_compile_command_free(command);
+   return EINA_TRUE;
+}
+
+static void
+_cmake_compile_file(const char *path)
+{
+   Edi_Compile_Command *command;
+
+   command = edi_compile_command_for_project_get(path);
+   if (!command)
+     return;
+
+   edi_exe_notify("edi_build", edi_compile_command_shell_get(command));
+   edi_compile_command_free(command);
+}
+
 Edi_Build_Provider _edi_build_provider_cmake =
    {"cmake", _cmake_project_supported, _cmake_file_hidden_is, _cmake_project_runnable_is,
-     _cmake_build, _cmake_test, _cmake_run, _cmake_clean};
+     _cmake_build, _cmake_test, _cmake_run, _cmake_clean,
+     _cmake_file_compilable_is, _cmake_compile_file};
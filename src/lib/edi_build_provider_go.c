@@ -105,5 +105,7 @@ Edi_Build_Provider _edi_build_provider_go =
       _go_build,
       _go_test,
       _go_run,
-      _go_clean
+      _go_clean,
+      NULL,
+      NULL
    };
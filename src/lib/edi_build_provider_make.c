@@ -57,22 +57,34 @@ _make_project_runnable_is(const char *path)
 static const char *
 _make_comand_compound_get(const char *prepend, const char *append)
 {
-   const char *cmd;
    Eina_Strbuf *buf;
 
    buf = eina_strbuf_new();
-   eina_strbuf_append_printf(buf, "%s" BEAR_COMMAND MAKE_COMMAND " -j %d %s", prepend, eina_cpu_count(), append);
-   cmd = eina_strbuf_release(buf);
+   eina_strbuf_append_printf(buf, "%s%s" BEAR_COMMAND MAKE_COMMAND " -j %d %s%s", edi_build_cache_env_get(),
+                             prepend, eina_cpu_count(), append, edi_build_cache_make_args_get());
+
+   return eina_slstr_strbuf_new(buf);
+}
+
+// Time each recipe so the build can be reported, see edi_build_timing.
+static const char *
+_make_build_args_get(void)
+{
+   const char *makefile;
 
-   return cmd;
+   makefile = edi_build_timing_make_file_get();
+   if (!makefile)
+     return "";
+
+   return eina_slstr_printf("-f '%s'", makefile);
 }
 
 static void
 _make_build_make(void)
 {
-   static const char *cmd = NULL;
-   if (!cmd)
-     cmd = _make_comand_compound_get("", "");
+   const char *cmd;
+
+   cmd = _make_comand_compound_get("", _make_build_args_get());
 
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
@@ -83,9 +95,9 @@ _make_build_make(void)
 static void
 _make_build_configure(void)
 {
-   static const char *cmd = NULL;
-   if (!cmd)
-     cmd = _make_comand_compound_get("./configure && ", "");
+   const char *cmd;
+
+   cmd = _make_comand_compound_get("./configure && ", _make_build_args_get());
 
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
@@ -96,9 +108,9 @@ _make_build_configure(void)
 static void
 _make_build_autogen(void)
 {
-   static const char *cmd = NULL;
-   if (!cmd)
-     cmd = _make_comand_compound_get("./autogen.sh && ", "");
+   const char *cmd;
+
+   cmd = _make_comand_compound_get("./autogen.sh && ", _make_build_args_get());
 
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
@@ -120,9 +132,9 @@ _make_build(void)
 static void
 _make_test(void)
 {
-   static const char *cmd = NULL;
-   if (!cmd)
-     cmd = _make_comand_compound_get("env CK_VERBOSITY=verbose ", "check");
+   const char *cmd;
+
+   cmd = _make_comand_compound_get("env CK_VERBOSITY=verbose ", "check");
 
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
@@ -164,9 +176,9 @@ _make_run(const char *path, const char *args)
 static void
 _make_clean(void)
 {
-   static const char *cmd = NULL;
-   if (!cmd)
-     cmd = _make_comand_compound_get("", "clean");
+   const char *cmd;
+
+   cmd = _make_comand_compound_get("", "clean");
 
    if (chdir(edi_project_get()) !=0)
      ERR("Could not chdir");
@@ -174,6 +186,33 @@ _make_clean(void)
    edi_exe_notify("edi_clean", cmd);
 }
 
+static Eina_Bool
+_make_file_compilable_is(const char *path)
+{
+   Edi_Compile_Command *command;
+
+   command = edi_compile_command_for_project_get(path);
+   if (!command)
+     return EINA_FALSE;
+
+   edi_compile_command_free(command);
+   return EINA_TRUE;
+}
+
+static void
+_make_compile_file(const char *path)
+{
+   Edi_Compile_Command *command;
+
+   command = edi_compile_command_for_project_get(path);
+   if (!command)
+     return;
+
+   edi_exe_notify("edi_build", edi_compile_command_shell_get(command));
+   edi_compile_command_free(command);
+}
+
 Edi_Build_Provider _edi_build_provider_make =
    {"make", _make_project_supported, _make_file_hidden_is, _make_project_runnable_is,
-     _make_build, _make_test, _make_run, _make_clean};
+     _make_build, _make_test, _make_run, _make_clean,
+     _make_file_compilable_is, _make_compile_file};
@@ -65,14 +65,11 @@ _meson_file_hidden_is(const char *file)
       "compile_commands.json", "meson-logs", "meson-private", "@exe"
    };
 
-   if (ecore_file_is_dir(file) && _meson_configured_check(file))
-     return EINA_TRUE;
-
    for (k = 0; k < EINA_C_ARRAY_LENGTH(hidden_exts); k++)
      if (eina_str_has_extension(file, hidden_exts[k]))
        return EINA_TRUE;
 
-   return EINA_FALSE;
+   return edi_build_provider_build_dir_is(file);
 }
 
 static Eina_Bool
@@ -109,7 +106,10 @@ _meson_prepare(Meson_Data *md)
    if (_meson_configured_check(md->fulldir)) return EINA_TRUE;
    if (chdir(md->basedir) != 0) return EINA_FALSE;
 
-   cmd = eina_slstr_printf("meson %s && %s", md->builddir, _meson_ninja_cmd(md, ""));
+   // Meson picks its compilers, and any cache wrapping them, once when configuring.
+   // It also wraps them in ccache itself when CC is unset, whatever the setting says.
+   cmd = eina_slstr_printf("%smeson %s && %s", edi_build_cache_env_get(), md->builddir,
+                           _meson_ninja_cmd(md, ""));
 
    edi_exe_notify("edi_build", cmd);
 
@@ -162,7 +162,41 @@ _meson_clean(void)
    _meson_ninja_do(md, "clean");
 }
 
+static Eina_Bool
+_meson_file_compilable_is(const char *path)
+{
+   Meson_Data *md = _meson_data_get();
+   Edi_Compile_Command *command;
+
+   command = edi_compile_command_get(md->fulldir, path);
+   if (!command)
+     return EINA_FALSE;
+
+   edi_compile_command_free(command);
+   return EINA_TRUE;
+}
+
+static void
+_meson_compile_file(const char *path)
+{
+   Meson_Data *md = _meson_data_get();
+   Edi_Compile_Command *command;
+
+   command = edi_compile_command_get(md->fulldir, path);
+   if (!command)
+     return;
+
+   // Building just the object lets ninja skip the rest of the graph and the link.
+   if (command->output)
+     edi_exe_notify("edi_build", _meson_ninja_cmd(md, command->output));
+   else
+     edi_exe_notify("edi_build", edi_compile_command_shell_get(command));
+
+   edi_compile_command_free(command);
+}
+
 Edi_Build_Provider _edi_build_provider_meson =
    {"meson", _meson_project_supported, _meson_file_hidden_is,
     _meson_project_runnable_is, _meson_build, _meson_test,
-    _meson_run, _meson_clean};
+    _meson_run, _meson_clean, _meson_file_compilable_is,
+    _meson_compile_file};
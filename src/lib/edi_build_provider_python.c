@@ -93,5 +93,7 @@ Edi_Build_Provider _edi_build_provider_python =
       _python_build,
       _python_test,
       _python_run,
-      _python_clean
+      _python_clean,
+      NULL,
+      NULL
    };
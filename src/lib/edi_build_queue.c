@@ -0,0 +1,284 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+static struct {
+   Edi_Build_Job *running;
+   Eina_List *pending;
+   Ecore_Job *next;
+
+   Edi_Build_Queue_Started_Cb started_cb;
+   Edi_Build_Queue_Done_Cb done_cb;
+   Edi_Build_Queue_Changed_Cb changed_cb;
+   void *data;
+} _edi_build_queue;
+
+static void _edi_build_queue_next(void);
+
+// The name each provider uses to notify the end of a job.
+const char *
+_edi_build_queue_job_name_get(const Edi_Build_Job *job)
+{
+   if (job->type == EDI_BUILD_JOB_TEST || job->type == EDI_BUILD_JOB_TEST_FAILED ||
+       job->type == EDI_BUILD_JOB_TEST_AFFECTED)
+     return "edi_test";
+   if (job->type == EDI_BUILD_JOB_CLEAN)
+     return "edi_clean";
+
+   return "edi_build";
+}
+
+// Whether running the job does what a job of the type and path asks for.
+Eina_Bool
+_edi_build_queue_job_covers(const Edi_Build_Job *job, Edi_Build_Job_Type type, const char *path)
+{
+   if (job->type == type)
+     return !path || (job->path && !strcmp(job->path, path));
+
+   // A build compiles every file, so it stands in for a compile.
+   return type == EDI_BUILD_JOB_COMPILE_FILE && job->type == EDI_BUILD_JOB_BUILD;
+}
+
+Eina_Bool
+_edi_build_queue_pending_covers(Edi_Build_Job_Type type, const char *path)
+{
+   const Edi_Build_Job *job;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_queue.pending, l, job)
+     {
+        if (_edi_build_queue_job_covers(job, type, path))
+          return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+static void
+_edi_build_queue_job_free(Edi_Build_Job *job)
+{
+   eina_stringshare_del(job->path);
+   free(job);
+}
+
+static void
+_edi_build_queue_changed(void)
+{
+   if (_edi_build_queue.changed_cb)
+     _edi_build_queue.changed_cb(_edi_build_queue.data);
+}
+
+static void
+_edi_build_queue_next_cb(void *data EINA_UNUSED)
+{
+   _edi_build_queue.next = NULL;
+   _edi_build_queue_next();
+}
+
+static void
+_edi_build_queue_done_cb(int status, void *data)
+{
+   Edi_Build_Job *job = data;
+
+   _edi_build_queue.running = NULL;
+   if (_edi_build_queue.done_cb)
+     _edi_build_queue.done_cb(_edi_build_queue.data, job, status);
+   _edi_build_server_job_done(job, status);
+   _edi_build_queue_job_free(job);
+
+   // Let the output of the job be handled before the next one starts.
+   if (_edi_build_queue.pending && !_edi_build_queue.next)
+     _edi_build_queue.next = ecore_job_add(_edi_build_queue_next_cb, NULL);
+
+   _edi_build_queue_changed();
+}
+
+// Tests the runner can list are run by it, so their results are known one by one.
+static Eina_Bool
+_edi_build_queue_job_runner_is(const Edi_Build_Job *job)
+{
+   if (job->type == EDI_BUILD_JOB_TEST_FAILED)
+     return EINA_TRUE;
+
+   return (job->type == EDI_BUILD_JOB_TEST || job->type == EDI_BUILD_JOB_TEST_AFFECTED) &&
+          edi_test_runner_supported();
+}
+
+static void
+_edi_build_queue_start(Edi_Build_Job *job)
+{
+   Edi_Test_Runner_Mode mode;
+   const char *name;
+
+   if (_edi_build_queue_job_runner_is(job))
+     {
+        _edi_build_queue.running = job;
+        if (_edi_build_queue.started_cb)
+          _edi_build_queue.started_cb(_edi_build_queue.data, job);
+        _edi_build_server_job_started(job);
+
+        if (job->type == EDI_BUILD_JOB_TEST_FAILED)
+          mode = EDI_TEST_RUNNER_MODE_FAILED;
+        else if (job->type == EDI_BUILD_JOB_TEST_AFFECTED)
+          mode = EDI_TEST_RUNNER_MODE_AFFECTED;
+        else
+          mode = EDI_TEST_RUNNER_MODE_ALL;
+
+        if (!edi_test_runner_run(mode, _edi_build_queue_done_cb, job))
+          _edi_build_queue_done_cb(-1, job);
+        return;
+     }
+
+   name = _edi_build_queue_job_name_get(job);
+   _edi_build_queue.running = job;
+   edi_exe_notify_handle(name, _edi_build_queue_done_cb, job);
+
+   if (_edi_build_queue.started_cb)
+     _edi_build_queue.started_cb(_edi_build_queue.data, job);
+   _edi_build_server_job_started(job);
+
+   switch (job->type)
+     {
+      case EDI_BUILD_JOB_BUILD:
+        edi_builder_build();
+        break;
+      case EDI_BUILD_JOB_TEST:
+      case EDI_BUILD_JOB_TEST_AFFECTED:
+        edi_builder_test();
+        break;
+      case EDI_BUILD_JOB_CLEAN:
+        edi_builder_clean();
+        break;
+      case EDI_BUILD_JOB_COMPILE_FILE:
+        edi_builder_compile_file(job->path);
+        break;
+      case EDI_BUILD_JOB_TEST_FAILED:
+        break;
+     }
+
+   // Providers start nothing when they cannot act, the queue must not wait for them.
+   if (_edi_build_queue.running == job &&
+       edi_exe_notify_handle_del(name, _edi_build_queue_done_cb, job))
+     _edi_build_queue_done_cb(-1, job);
+}
+
+static void
+_edi_build_queue_next(void)
+{
+   Edi_Build_Job *job;
+
+   if (_edi_build_queue.running || !_edi_build_queue.pending)
+     return;
+
+   job = eina_list_data_get(_edi_build_queue.pending);
+   _edi_build_queue.pending = eina_list_remove_list(_edi_build_queue.pending, _edi_build_queue.pending);
+
+   _edi_build_queue_start(job);
+   _edi_build_queue_changed();
+}
+
+EAPI void
+edi_build_queue_callbacks_set(Edi_Build_Queue_Started_Cb started_cb,
+                              Edi_Build_Queue_Done_Cb done_cb,
+                              Edi_Build_Queue_Changed_Cb changed_cb, void *data)
+{
+   _edi_build_queue.started_cb = started_cb;
+   _edi_build_queue.done_cb = done_cb;
+   _edi_build_queue.changed_cb = changed_cb;
+   _edi_build_queue.data = data;
+}
+
+EAPI Eina_Bool
+edi_build_queue_add(Edi_Build_Job_Type type, const char *path)
+{
+   Edi_Build_Job *job;
+   Eina_List *l, *ll;
+
+   if (type != EDI_BUILD_JOB_COMPILE_FILE)
+     path = NULL;
+
+   EINA_LIST_FOREACH_SAFE(_edi_build_queue.pending, l, ll, job)
+     {
+        if (_edi_build_queue_job_covers(job, type, path))
+          return EINA_FALSE;
+
+        if (type == EDI_BUILD_JOB_BUILD && job->type == EDI_BUILD_JOB_COMPILE_FILE)
+          {
+             _edi_build_queue.pending = eina_list_remove_list(_edi_build_queue.pending, l);
+             _edi_build_queue_job_free(job);
+          }
+     }
+
+   job = calloc(1, sizeof(Edi_Build_Job));
+   job->type = type;
+   job->path = eina_stringshare_add(path);
+   _edi_build_queue.pending = eina_list_append(_edi_build_queue.pending, job);
+
+   if (_edi_build_queue.running || _edi_build_queue.next)
+     _edi_build_queue_changed();
+   else
+     _edi_build_queue_next();
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_Bool
+edi_build_queue_cancel(void)
+{
+   Edi_Build_Job *job;
+   Eina_Bool cancelled = EINA_FALSE;
+
+   EINA_LIST_FREE(_edi_build_queue.pending, job)
+     {
+        _edi_build_queue_job_free(job);
+        cancelled = EINA_TRUE;
+     }
+
+   // The job is done once its processes have exited.
+   job = _edi_build_queue.running;
+   if (job && !job->cancelled)
+     {
+        job->cancelled = EINA_TRUE;
+        if (!edi_test_runner_cancel())
+          edi_exe_notify_terminate(_edi_build_queue_job_name_get(job));
+        cancelled = EINA_TRUE;
+     }
+
+   if (cancelled)
+     _edi_build_queue_changed();
+
+   return cancelled;
+}
+
+EAPI const Edi_Build_Job *
+edi_build_queue_running_get(void)
+{
+   return _edi_build_queue.running;
+}
+
+EAPI unsigned int
+edi_build_queue_pending_count(void)
+{
+   return eina_list_count(_edi_build_queue.pending);
+}
+
+void
+_edi_build_queue_shutdown(void)
+{
+   Edi_Build_Job *job;
+
+   if (_edi_build_queue.next)
+     ecore_job_del(_edi_build_queue.next);
+   _edi_build_queue.next = NULL;
+
+   EINA_LIST_FREE(_edi_build_queue.pending, job)
+     _edi_build_queue_job_free(job);
+
+   memset(&_edi_build_queue, 0, sizeof(_edi_build_queue));
+}
@@ -0,0 +1,133 @@
+#ifndef EDI_BUILD_QUEUE_H_
+# define EDI_BUILD_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for running the build jobs of a project one at a time.
+ */
+
+/**
+ * The kinds of job that can be queued.
+ */
+typedef enum {
+   EDI_BUILD_JOB_BUILD,
+   EDI_BUILD_JOB_TEST,
+   EDI_BUILD_JOB_CLEAN,
+   EDI_BUILD_JOB_COMPILE_FILE,
+   EDI_BUILD_JOB_TEST_FAILED, /**< Run again the tests that failed, see edi_test_runner_run */
+   EDI_BUILD_JOB_TEST_AFFECTED, /**< Run the tests affected by changes, all of them when they cannot be found */
+} Edi_Build_Job_Type;
+
+/**
+ * A job waiting in, or run by, the build queue.
+ */
+typedef struct _Edi_Build_Job
+{
+   Edi_Build_Job_Type type; /**< What the job does */
+   const char *path; /**< The file of an EDI_BUILD_JOB_COMPILE_FILE job, NULL otherwise */
+   Eina_Bool cancelled; /**< Whether the job was stopped by edi_build_queue_cancel */
+} Edi_Build_Job;
+
+/**
+ * Called when a queued job starts running.
+ *
+ * @param data The data passed to edi_build_queue_callbacks_set.
+ * @param job The job that started.
+ */
+typedef void (*Edi_Build_Queue_Started_Cb)(void *data, const Edi_Build_Job *job);
+
+/**
+ * Called when a job has finished.
+ *
+ * @param data The data passed to edi_build_queue_callbacks_set.
+ * @param job The job that finished.
+ * @param status The exit status of the job, -1 if nothing could be started.
+ */
+typedef void (*Edi_Build_Queue_Done_Cb)(void *data, const Edi_Build_Job *job, int status);
+
+/**
+ * Called whenever the running job or the jobs waiting change.
+ *
+ * @param data The data passed to edi_build_queue_callbacks_set.
+ */
+typedef void (*Edi_Build_Queue_Changed_Cb)(void *data);
+
+/**
+ * @brief Build queue
+ * @defgroup Build_Queue
+ *
+ * @{
+ *
+ * Serialise the build, test, clean and compile jobs of the current project.
+ * Tests that edi_test_runner_supported can run are handed to the test runner.
+ *
+ */
+
+/**
+ * Set the functions told about the jobs of the queue.
+ *
+ * @param started_cb Called as each job starts, or NULL.
+ * @param done_cb Called as each job finishes, or NULL.
+ * @param changed_cb Called when the state of the queue changes, or NULL.
+ * @param data The data passed to the callbacks.
+ *
+ * @ingroup Build_Queue
+ */
+EAPI void edi_build_queue_callbacks_set(Edi_Build_Queue_Started_Cb started_cb,
+                                        Edi_Build_Queue_Done_Cb done_cb,
+                                        Edi_Build_Queue_Changed_Cb changed_cb, void *data);
+
+/**
+ * Add a job to the queue, starting it straight away if nothing is running.
+ *
+ * A job that is already waiting is not added again. Compiling a file is not
+ * queued while a build is waiting and a build replaces the compiles waiting.
+ *
+ * @param type The kind of job to run.
+ * @param path The file to compile for EDI_BUILD_JOB_COMPILE_FILE, NULL otherwise.
+ * @return EINA_TRUE if the job was added, EINA_FALSE if it was merged with a waiting job.
+ *
+ * @ingroup Build_Queue
+ */
+EAPI Eina_Bool edi_build_queue_add(Edi_Build_Job_Type type, const char *path);
+
+/**
+ * Stop the running job, terminating every process it started, and drop the jobs waiting.
+ *
+ * @return EINA_TRUE if there was anything to cancel.
+ *
+ * @ingroup Build_Queue
+ */
+EAPI Eina_Bool edi_build_queue_cancel(void);
+
+/**
+ * Get the job that is running.
+ *
+ * @return The running job or NULL if the queue is idle.
+ *
+ * @ingroup Build_Queue
+ */
+EAPI const Edi_Build_Job *edi_build_queue_running_get(void);
+
+/**
+ * Get the number of jobs waiting to run.
+ *
+ * @return The number of jobs queued behind the running one.
+ *
+ * @ingroup Build_Queue
+ */
+EAPI unsigned int edi_build_queue_pending_count(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BUILD_QUEUE_H_ */
@@ -0,0 +1,645 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+#include <Ecore_Con.h>
+
+#include "Edi.h"
+#include "md5.h"
+
+#include "edi_private.h"
+
+// A process connected to the server, waiting for the job it asked for.
+typedef struct _Edi_Build_Server_Client
+{
+   Ecore_Con_Client *client;
+   Eina_Strbuf *buf;
+
+   Edi_Build_Job_Type type;
+   const char *path;
+   Eina_Bool waiting, attached;
+} Edi_Build_Server_Client;
+
+// A request this process sent to a server.
+typedef struct _Edi_Build_Server_Request
+{
+   Ecore_Con_Server *server;
+   Eina_Strbuf *buf;
+   const char *line;
+   Eina_Bool reached;
+
+   Edi_Build_Server_Output_Cb output_cb;
+   Edi_Build_Server_Done_Cb done_cb;
+   void *data;
+} Edi_Build_Server_Request;
+
+static const struct {
+   Edi_Build_Job_Type type;
+   const char *name;
+} _edi_build_server_requests[] = {
+   { EDI_BUILD_JOB_BUILD, "build" },
+   { EDI_BUILD_JOB_TEST, "test" },
+   { EDI_BUILD_JOB_CLEAN, "clean" },
+   { EDI_BUILD_JOB_COMPILE_FILE, "compile" },
+   { EDI_BUILD_JOB_TEST_FAILED, "test-failed" },
+   { EDI_BUILD_JOB_TEST_AFFECTED, "test-affected" },
+};
+
+static struct {
+   Eina_Bool con_init;
+
+   Ecore_Con_Server *server;
+   int lock;
+   Eina_List *clients;
+   Eina_List *handlers;
+
+   Eina_List *requests;
+   Eina_List *request_handlers;
+} _edi_build_server;
+
+EAPI Eina_Bool
+edi_build_server_request_parse(const char *line, Edi_Build_Job_Type *type, const char **path)
+{
+   const char *space;
+   size_t length;
+   unsigned int i;
+
+   if (!line)
+     return EINA_FALSE;
+
+   space = strchr(line, ' ');
+   length = space ? (size_t) (space - line) : strlen(line);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_build_server_requests); i++)
+     {
+        if (strlen(_edi_build_server_requests[i].name) != length ||
+            strncmp(_edi_build_server_requests[i].name, line, length))
+          continue;
+
+        // Only a compile names a file, and it cannot do without one.
+        if ((_edi_build_server_requests[i].type == EDI_BUILD_JOB_COMPILE_FILE) != (space && space[1]))
+          return EINA_FALSE;
+
+        *type = _edi_build_server_requests[i].type;
+        *path = space ? space + 1 : NULL;
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+EAPI const char *
+edi_build_server_request_get(Edi_Build_Job_Type type, const char *path)
+{
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_build_server_requests); i++)
+     {
+        if (_edi_build_server_requests[i].type != type)
+          continue;
+
+        if (type != EDI_BUILD_JOB_COMPILE_FILE)
+          return _edi_build_server_requests[i].name;
+        if (!path || !path[0])
+          return NULL;
+
+        return eina_slstr_printf("%s %s", _edi_build_server_requests[i].name, path);
+     }
+
+   return NULL;
+}
+
+// One socket for each project, so a server only ever runs the jobs of its own.
+static const char *
+_edi_build_server_name_get(void)
+{
+   MD5_CTX ctx;
+   char md5out[(2 * MD5_HASHBYTES) + 1];
+   unsigned char hash[MD5_HASHBYTES];
+   static const char hex[] = "0123456789abcdef";
+   const char *project;
+   int n;
+
+   project = edi_project_get();
+   if (!project)
+     return NULL;
+
+   MD5Init(&ctx);
+   MD5Update(&ctx, (unsigned char const*)project, (unsigned)strlen(project));
+   MD5Final(hash, &ctx);
+
+   for (n = 0; n < MD5_HASHBYTES; n++)
+     {
+        md5out[2 * n] = hex[hash[n] >> 4];
+        md5out[2 * n + 1] = hex[hash[n] & 0x0f];
+     }
+   md5out[2 * MD5_HASHBYTES] = '\0';
+
+   return eina_slstr_printf("edi-build-%s", md5out);
+}
+
+// Ecore replaces the socket of a server that is still running, so a lock decides who serves.
+static int
+_edi_build_server_lock(const char *name)
+{
+   char path[PATH_MAX];
+   const char *dir;
+   int fd;
+
+   dir = getenv("XDG_RUNTIME_DIR");
+   if (dir && dir[0])
+     snprintf(path, sizeof(path), "%s/%s.lock", dir, name);
+   else
+     snprintf(path, sizeof(path), "%s/%s-%u.lock", eina_environment_tmp_get(), name,
+              (unsigned int) getuid());
+
+   fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+   if (fd < 0)
+     return -1;
+
+   if (flock(fd, LOCK_EX | LOCK_NB))
+     {
+        close(fd);
+        return -1;
+     }
+
+   return fd;
+}
+
+static void
+_edi_build_server_con_init(void)
+{
+   if (_edi_build_server.con_init)
+     return;
+
+   ecore_con_init();
+   _edi_build_server.con_init = EINA_TRUE;
+}
+
+// Add the data received to what is left of the last read and hand on every complete line.
+// A line_cb returning EINA_FALSE has freed the buffer, so reading stops.
+static void
+_edi_build_server_lines_read(Eina_Strbuf *buf, const void *data, int size,
+                             Eina_Bool (*line_cb)(void *context, char *line), void *context)
+{
+   char *lines, *line, *end;
+
+   eina_strbuf_append_length(buf, data, size);
+   if (!memchr(data, '\n', size))
+     return;
+
+   lines = eina_strbuf_string_steal(buf);
+   for (line = lines; (end = strchr(line, '\n')); line = end + 1)
+     {
+        *end = '\0';
+        if (end > line && end[-1] == '\r')
+          end[-1] = '\0';
+        if (!line_cb(context, line))
+          {
+             free(lines);
+             return;
+          }
+     }
+
+   eina_strbuf_append(buf, line);
+   free(lines);
+}
+
+static void
+_edi_build_server_client_send(Edi_Build_Server_Client *client, const char *prefix, const char *line)
+{
+   const char *message;
+
+   message = eina_slstr_printf("%s %s\n", prefix, line);
+   ecore_con_client_send(client->client, message, strlen(message));
+}
+
+static void
+_edi_build_server_client_done(Edi_Build_Server_Client *client, int status)
+{
+   _edi_build_server_client_send(client, "done", eina_slstr_printf("%d", status));
+   client->waiting = client->attached = EINA_FALSE;
+}
+
+static Eina_Bool
+_edi_build_server_client_line_cb(void *context, char *line)
+{
+   Edi_Build_Server_Client *client = context;
+   Edi_Build_Job_Type type;
+   const char *path;
+
+   if (!strcmp(line, "stop"))
+     {
+        edi_build_queue_cancel();
+        _edi_build_server_client_done(client, 0);
+        return EINA_TRUE;
+     }
+
+   // A connection asks for one job at a time.
+   if (client->waiting)
+     {
+        _edi_build_server_client_send(client, "err", "A job is already waiting for this connection.");
+        return EINA_TRUE;
+     }
+
+   if (!edi_build_server_request_parse(line, &type, &path))
+     {
+        _edi_build_server_client_send(client, "err", eina_slstr_printf("Unknown request \"%s\".", line));
+        _edi_build_server_client_done(client, -1);
+        return EINA_TRUE;
+     }
+
+   // The job may start, or even finish, before edi_build_queue_add returns.
+   client->type = type;
+   eina_stringshare_replace(&client->path, path);
+   client->waiting = EINA_TRUE;
+
+   edi_build_queue_add(type, path);
+   return EINA_TRUE;
+}
+
+static Edi_Build_Server_Client *
+_edi_build_server_client_find(Ecore_Con_Client *con)
+{
+   Edi_Build_Server_Client *client;
+   Eina_List *l;
+
+   if (!_edi_build_server.server || ecore_con_client_server_get(con) != _edi_build_server.server)
+     return NULL;
+
+   EINA_LIST_FOREACH(_edi_build_server.clients, l, client)
+     {
+        if (client->client == con)
+          return client;
+     }
+
+   return NULL;
+}
+
+static void
+_edi_build_server_client_free(Edi_Build_Server_Client *client)
+{
+   _edi_build_server.clients = eina_list_remove(_edi_build_server.clients, client);
+
+   eina_strbuf_free(client->buf);
+   eina_stringshare_del(client->path);
+   free(client);
+}
+
+static Eina_Bool
+_edi_build_server_client_add_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Client_Add *ev = event;
+   Edi_Build_Server_Client *client;
+
+   if (!_edi_build_server.server || ecore_con_client_server_get(ev->client) != _edi_build_server.server)
+     return ECORE_CALLBACK_PASS_ON;
+
+   client = calloc(1, sizeof(Edi_Build_Server_Client));
+   client->client = ev->client;
+   client->buf = eina_strbuf_new();
+   _edi_build_server.clients = eina_list_append(_edi_build_server.clients, client);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_edi_build_server_client_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Client_Del *ev = event;
+   Edi_Build_Server_Client *client;
+
+   client = _edi_build_server_client_find(ev->client);
+   if (!client)
+     return ECORE_CALLBACK_PASS_ON;
+
+   // The job carries on, whoever asked for it may just have been stopped.
+   _edi_build_server_client_free(client);
+   ecore_con_client_del(ev->client);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_edi_build_server_client_data_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Client_Data *ev = event;
+   Edi_Build_Server_Client *client;
+
+   client = _edi_build_server_client_find(ev->client);
+   if (!client)
+     return ECORE_CALLBACK_PASS_ON;
+
+   _edi_build_server_lines_read(client->buf, ev->data, ev->size, _edi_build_server_client_line_cb, client);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+void
+_edi_build_server_output(const char *line, Eina_Bool err)
+{
+   Edi_Build_Server_Client *client;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_server.clients, l, client)
+     {
+        if (client->attached)
+          _edi_build_server_client_send(client, err ? "err" : "out", line);
+     }
+}
+
+static Eina_Bool
+_edi_build_server_exe_data_cb(void *data EINA_UNUSED, int type, void *event)
+{
+   Ecore_Exe_Event_Data *ev = event;
+   Ecore_Exe_Event_Data_Line *el;
+   const Edi_Build_Job *job;
+   const char *name;
+
+   // Only the commands of the running job, the IDE may be running others.
+   // Providers start a job through edi_exe_notify under its name, configure
+   // steps included. Running the project's program is not a job.
+   job = edi_build_queue_running_get();
+   if (!job || !_edi_build_server.clients)
+     return ECORE_CALLBACK_PASS_ON;
+
+   name = _edi_exe_notify_running_name_get(ecore_exe_pid_get(ev->exe));
+   if (!name || strcmp(name, _edi_build_queue_job_name_get(job)))
+     return ECORE_CALLBACK_PASS_ON;
+
+   for (el = ev->lines; el && el->line; el++)
+     _edi_build_server_output(el->line, type == ECORE_EXE_EVENT_ERROR);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+void
+_edi_build_server_job_started(const Edi_Build_Job *job)
+{
+   Edi_Build_Server_Client *client;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_server.clients, l, client)
+     {
+        if (client->waiting && !client->attached &&
+            _edi_build_queue_job_covers(job, client->type, client->path))
+          client->attached = EINA_TRUE;
+     }
+}
+
+void
+_edi_build_server_job_done(const Edi_Build_Job *job, int status)
+{
+   Edi_Build_Server_Client *client;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_server.clients, l, client)
+     {
+        if (client->attached)
+          _edi_build_server_client_done(client, job->cancelled ? -1 : status);
+        // Cancelling drops the jobs waiting, nothing will start for them.
+        else if (client->waiting && !_edi_build_queue_pending_covers(client->type, client->path))
+          _edi_build_server_client_done(client, -1);
+     }
+}
+
+EAPI Eina_Bool
+edi_build_server_start(void)
+{
+   const char *name;
+
+   if (_edi_build_server.server)
+     return EINA_TRUE;
+
+   name = _edi_build_server_name_get();
+   if (!name)
+     return EINA_FALSE;
+
+   _edi_build_server.lock = _edi_build_server_lock(name);
+   if (_edi_build_server.lock < 0)
+     {
+        INF("Not serving builds on %s, another process is serving them", name);
+        return EINA_FALSE;
+     }
+
+   _edi_build_server_con_init();
+   _edi_build_server.server = ecore_con_server_add(ECORE_CON_LOCAL_USER, name, 0, NULL);
+   if (!_edi_build_server.server)
+     {
+        INF("Could not serve builds on %s", name);
+        close(_edi_build_server.lock);
+        return EINA_FALSE;
+     }
+
+   _edi_build_server.handlers = eina_list_append(_edi_build_server.handlers,
+      ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_ADD, _edi_build_server_client_add_cb, NULL));
+   _edi_build_server.handlers = eina_list_append(_edi_build_server.handlers,
+      ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DEL, _edi_build_server_client_del_cb, NULL));
+   _edi_build_server.handlers = eina_list_append(_edi_build_server.handlers,
+      ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA, _edi_build_server_client_data_cb, NULL));
+   _edi_build_server.handlers = eina_list_append(_edi_build_server.handlers,
+      ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _edi_build_server_exe_data_cb, NULL));
+   _edi_build_server.handlers = eina_list_append(_edi_build_server.handlers,
+      ecore_event_handler_add(ECORE_EXE_EVENT_ERROR, _edi_build_server_exe_data_cb, NULL));
+
+   INF("Serving builds on %s", name);
+   return EINA_TRUE;
+}
+
+EAPI void
+edi_build_server_stop(void)
+{
+   Ecore_Event_Handler *handler;
+
+   if (!_edi_build_server.server)
+     return;
+
+   EINA_LIST_FREE(_edi_build_server.handlers, handler)
+     ecore_event_handler_del(handler);
+
+   while (_edi_build_server.clients)
+     _edi_build_server_client_free(eina_list_data_get(_edi_build_server.clients));
+
+   ecore_con_server_del(_edi_build_server.server);
+   _edi_build_server.server = NULL;
+   close(_edi_build_server.lock);
+}
+
+static Edi_Build_Server_Request *
+_edi_build_server_request_find(Ecore_Con_Server *server)
+{
+   Edi_Build_Server_Request *request;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_server.requests, l, request)
+     {
+        if (request->server == server)
+          return request;
+     }
+
+   return NULL;
+}
+
+static void
+_edi_build_server_request_free(Edi_Build_Server_Request *request)
+{
+   _edi_build_server.requests = eina_list_remove(_edi_build_server.requests, request);
+
+   if (request->server)
+     ecore_con_server_del(request->server);
+   eina_strbuf_free(request->buf);
+   eina_stringshare_del(request->line);
+   free(request);
+}
+
+static void
+_edi_build_server_request_done(Edi_Build_Server_Request *request, int status)
+{
+   Edi_Build_Server_Done_Cb done_cb;
+   Eina_Bool reached;
+   void *data;
+
+   done_cb = request->done_cb;
+   reached = request->reached;
+   data = request->data;
+   _edi_build_server_request_free(request);
+
+   if (done_cb)
+     done_cb(data, reached, status);
+}
+
+static Eina_Bool
+_edi_build_server_request_line_cb(void *context, char *line)
+{
+   Edi_Build_Server_Request *request = context;
+
+   if (!strncmp(line, "out ", 4) || !strncmp(line, "err ", 4))
+     {
+        if (request->output_cb)
+          request->output_cb(request->data, line + 4, line[0] == 'e');
+     }
+   else if (!strncmp(line, "done ", 5))
+     {
+        // Nothing more is read from the connection once it is closed.
+        ecore_con_server_del(request->server);
+        request->server = NULL;
+        _edi_build_server_request_done(request, atoi(line + 5));
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edi_build_server_request_add_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Server_Add *ev = event;
+   Edi_Build_Server_Request *request;
+   const char *message;
+
+   request = _edi_build_server_request_find(ev->server);
+   if (!request)
+     return ECORE_CALLBACK_PASS_ON;
+
+   request->reached = EINA_TRUE;
+   message = eina_slstr_printf("%s\n", request->line);
+   ecore_con_server_send(request->server, message, strlen(message));
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_edi_build_server_request_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Server_Del *ev = event;
+   Edi_Build_Server_Request *request;
+
+   request = _edi_build_server_request_find(ev->server);
+   if (!request)
+     return ECORE_CALLBACK_PASS_ON;
+
+   // Either nothing is listening or the server went away before the job was done.
+   _edi_build_server_request_done(request, -1);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_edi_build_server_request_data_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Con_Event_Server_Data *ev = event;
+   Edi_Build_Server_Request *request;
+
+   request = _edi_build_server_request_find(ev->server);
+   if (!request)
+     return ECORE_CALLBACK_PASS_ON;
+
+   _edi_build_server_lines_read(request->buf, ev->data, ev->size, _edi_build_server_request_line_cb, request);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+EAPI Eina_Bool
+edi_build_server_submit(const char *line, Edi_Build_Server_Output_Cb output_cb,
+                        Edi_Build_Server_Done_Cb done_cb, void *data)
+{
+   Edi_Build_Server_Request *request;
+   Edi_Build_Job_Type type;
+   const char *path, *name;
+
+   if (!line || (strcmp(line, "stop") && !edi_build_server_request_parse(line, &type, &path)))
+     return EINA_FALSE;
+
+   request = calloc(1, sizeof(Edi_Build_Server_Request));
+   request->buf = eina_strbuf_new();
+   request->line = eina_stringshare_add(line);
+   request->output_cb = output_cb;
+   request->done_cb = done_cb;
+   request->data = data;
+   _edi_build_server.requests = eina_list_append(_edi_build_server.requests, request);
+
+   _edi_build_server_con_init();
+   if (!_edi_build_server.request_handlers)
+     {
+        _edi_build_server.request_handlers = eina_list_append(_edi_build_server.request_handlers,
+           ecore_event_handler_add(ECORE_CON_EVENT_SERVER_ADD, _edi_build_server_request_add_cb, NULL));
+        _edi_build_server.request_handlers = eina_list_append(_edi_build_server.request_handlers,
+           ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DEL, _edi_build_server_request_del_cb, NULL));
+        _edi_build_server.request_handlers = eina_list_append(_edi_build_server.request_handlers,
+           ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA, _edi_build_server_request_data_cb, NULL));
+     }
+
+   name = _edi_build_server_name_get();
+   if (name)
+     request->server = ecore_con_server_connect(ECORE_CON_LOCAL_USER, name, 0, NULL);
+   if (!request->server)
+     _edi_build_server_request_done(request, -1);
+
+   return EINA_TRUE;
+}
+
+void
+_edi_build_server_shutdown(void)
+{
+   Ecore_Event_Handler *handler;
+
+   edi_build_server_stop();
+
+   while (_edi_build_server.requests)
+     _edi_build_server_request_free(eina_list_data_get(_edi_build_server.requests));
+   EINA_LIST_FREE(_edi_build_server.request_handlers, handler)
+     ecore_event_handler_del(handler);
+
+   if (_edi_build_server.con_init)
+     ecore_con_shutdown();
+
+   memset(&_edi_build_server, 0, sizeof(_edi_build_server));
+}
@@ -0,0 +1,113 @@
+#ifndef EDI_BUILD_SERVER_H_
+# define EDI_BUILD_SERVER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for sharing the build queue of a project between processes.
+ */
+
+/**
+ * Called for each line of output the build server streams for a request.
+ * @param data The data passed to edi_build_server_submit.
+ * @param line The line written, without its newline.
+ * @param err Whether the line was written to the error stream.
+ */
+typedef void (*Edi_Build_Server_Output_Cb)(void *data, const char *line, Eina_Bool err);
+
+/**
+ * Called once a request to the build server is over.
+ * @param data The data passed to edi_build_server_submit.
+ * @param reached EINA_FALSE if no build server is running for the project.
+ * @param status The exit status of the job, -1 if it was cancelled or could not be started.
+ */
+typedef void (*Edi_Build_Server_Done_Cb)(void *data, Eina_Bool reached, int status);
+
+/**
+ * @brief Build server
+ * @defgroup Build_Server
+ *
+ * @{
+ *
+ * Listen on a local socket for the jobs of the current project and run them
+ * in the build queue of this process, so the IDE and edi_build share one queue.
+ *
+ * Requests are lines such as "build", "test-affected", "compile <path>" or
+ * "stop". The server answers with "out <line>" and "err <line>" for the output
+ * of the job and a final "done <status>".
+ *
+ * Only output lines and the status are sent. A client can find problems and
+ * test results in the lines. Step timings, compiler cache statistics and the
+ * list of failed tests stay with the serving process.
+ *
+ */
+
+/**
+ * Start serving the build queue of the current project.
+ *
+ * A lock file in the runtime directory makes sure only one process serves each
+ * project, a second one fails to start rather than taking over the socket.
+ *
+ * @return EINA_FALSE if the socket could not be created, such as when
+ *         another process serves the project.
+ *
+ * @ingroup Build_Server
+ */
+EAPI Eina_Bool edi_build_server_start(void);
+
+/**
+ * Stop serving the build queue, the jobs already queued still run.
+ *
+ * @ingroup Build_Server
+ */
+EAPI void edi_build_server_stop(void);
+
+/**
+ * Send a request to the build server of the current project.
+ *
+ * @param line A request line, without its newline.
+ * @param output_cb Called for the output of the job, or NULL.
+ * @param done_cb Called once the job is over or the server cannot be reached.
+ * @param data The data passed to the callbacks.
+ * @return EINA_FALSE if the request is not valid.
+ *
+ * @ingroup Build_Server
+ */
+EAPI Eina_Bool edi_build_server_submit(const char *line, Edi_Build_Server_Output_Cb output_cb,
+                                       Edi_Build_Server_Done_Cb done_cb, void *data);
+
+/**
+ * Read the job asked for by a request line.
+ *
+ * @param line The request, without its newline.
+ * @param type Where to store the kind of job.
+ * @param path Where to store the file of a compile request, NULL otherwise. It points into line.
+ * @return EINA_FALSE if the line does not ask for a job.
+ *
+ * @ingroup Build_Server
+ */
+EAPI Eina_Bool edi_build_server_request_parse(const char *line, Edi_Build_Job_Type *type, const char **path);
+
+/**
+ * Get the request line asking for a job.
+ *
+ * @param type The kind of job.
+ * @param path The file to compile for EDI_BUILD_JOB_COMPILE_FILE, NULL otherwise.
+ * @return The request, without its newline, or NULL if a compile has no path.
+ *
+ * @ingroup Build_Server
+ */
+EAPI const char *edi_build_server_request_get(Edi_Build_Job_Type type, const char *path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BUILD_SERVER_H_ */
@@ -0,0 +1,670 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+// Builds of a project kept in its history.
+#define EDI_BUILD_TIMING_HISTORY_MAX 50
+
+static struct {
+   Eina_Bool running;
+   double start, cpu;
+   time_t started;
+   long ninja_offset;
+} _edi_build_timing_run;
+
+static double
+_edi_build_timing_cpu_get(void)
+{
+   struct rusage usage;
+
+   // Children are only counted once reaped, which Ecore does as each one exits.
+   if (getrusage(RUSAGE_CHILDREN, &usage))
+     return 0.0;
+
+   return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1000000.0 +
+          usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1000000.0;
+}
+
+static char *
+_edi_build_timing_path_get(const char *file)
+{
+   char *dir, *path;
+
+   dir = malloc(PATH_MAX);
+   snprintf(dir, PATH_MAX, "%s/%s/%s", efreet_cache_home_get(), PACKAGE_NAME,
+            edi_project_name_get());
+   if (!ecore_file_exists(dir) && !ecore_file_mkpath(dir))
+     {
+        free(dir);
+        return NULL;
+     }
+
+   path = edi_path_append(dir, file);
+   free(dir);
+   return path;
+}
+
+static long
+_edi_build_timing_file_size(const char *path)
+{
+   struct stat st;
+
+   if (stat(path, &st))
+     return 0;
+
+   return st.st_size;
+}
+
+static Edi_Build_Timing_Step *
+_edi_build_timing_step_add(Edi_Build_Timing *timing, const char *target, size_t length,
+                           double start, double end)
+{
+   Edi_Build_Timing_Step *step;
+
+   step = malloc(sizeof(Edi_Build_Timing_Step));
+   step->target = eina_stringshare_add_length(target, length);
+   step->start = start;
+   step->end = end;
+
+   timing->steps = eina_list_append(timing->steps, step);
+   return step;
+}
+
+static int
+_edi_build_timing_duration_cmp(const void *data1, const void *data2)
+{
+   const Edi_Build_Timing_Step *step1 = data1, *step2 = data2;
+   double diff;
+
+   diff = (step2->end - step2->start) - (step1->end - step1->start);
+   return (diff > 0) - (diff < 0);
+}
+
+static int
+_edi_build_timing_end_cmp(const void *data1, const void *data2)
+{
+   const Edi_Build_Timing_Step *step1 = *(Edi_Build_Timing_Step **) data1;
+   const Edi_Build_Timing_Step *step2 = *(Edi_Build_Timing_Step **) data2;
+
+   return (step1->end > step2->end) - (step1->end < step2->end);
+}
+
+// Without the dependency graph, assume each step waited for the one that finished
+// last before it started, walking back from the step that finished the build.
+static void
+_edi_build_timing_critical_path(Edi_Build_Timing *timing)
+{
+   Edi_Build_Timing_Step **steps, *step;
+   Eina_List *l;
+   unsigned int i = 0, low, high, mid, current;
+
+   steps = malloc(timing->count * sizeof(Edi_Build_Timing_Step *));
+   EINA_LIST_FOREACH(timing->steps, l, step)
+     steps[i++] = step;
+   qsort(steps, timing->count, sizeof(Edi_Build_Timing_Step *), _edi_build_timing_end_cmp);
+
+   current = timing->count - 1;
+   timing->critical = eina_list_prepend(NULL, steps[current]);
+   while (current > 0)
+     {
+        low = 0;
+        high = current;
+        while (low < high)
+          {
+             mid = (low + high) / 2;
+             if (steps[mid]->end <= steps[current]->start)
+               low = mid + 1;
+             else
+               high = mid;
+          }
+        if (!low)
+          break;
+
+        current = low - 1;
+        timing->critical = eina_list_prepend(timing->critical, steps[current]);
+     }
+
+   free(steps);
+}
+
+// Make the steps relative to the start of the build and work out the totals.
+static void
+_edi_build_timing_finish(Edi_Build_Timing *timing)
+{
+   Edi_Build_Timing_Step *step;
+   Eina_List *l;
+   double first = 0.0, last = 0.0;
+
+   timing->count = eina_list_count(timing->steps);
+   if (!timing->count)
+     return;
+
+   EINA_LIST_FOREACH(timing->steps, l, step)
+     {
+        if (l == timing->steps || step->start < first)
+          first = step->start;
+        if (step->end > last)
+          last = step->end;
+     }
+
+   EINA_LIST_FOREACH(timing->steps, l, step)
+     {
+        step->start -= first;
+        step->end -= first;
+        timing->busy += step->end - step->start;
+     }
+
+   timing->wall = last - first;
+   timing->steps = eina_list_sort(timing->steps, 0, _edi_build_timing_duration_cmp);
+   _edi_build_timing_critical_path(timing);
+}
+
+static Edi_Build_Timing *
+_edi_build_timing_new(void)
+{
+   Edi_Build_Timing *timing;
+
+   timing = calloc(1, sizeof(Edi_Build_Timing));
+   timing->when = time(NULL);
+
+   return timing;
+}
+
+EAPI void
+edi_build_timing_free(Edi_Build_Timing *timing)
+{
+   Edi_Build_Timing_Step *step;
+
+   eina_list_free(timing->critical);
+   EINA_LIST_FREE(timing->steps, step)
+     {
+        eina_stringshare_del(step->target);
+        free(step);
+     }
+
+   free(timing);
+}
+
+static const char *
+_edi_build_timing_field_next(const char *pos, const char *end)
+{
+   pos = memchr(pos, '\t', end - pos);
+
+   return pos ? pos + 1 : NULL;
+}
+
+EAPI Edi_Build_Timing *
+edi_build_timing_ninja_read(const char *path, long offset)
+{
+   Edi_Build_Timing *timing;
+   Edi_Build_Timing_Step *last = NULL;
+   Eina_File *file;
+   const char *map, *end, *line, *eol, *pos, *output;
+   double start, finish;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map)
+     {
+        eina_file_close(file);
+        return NULL;
+     }
+
+   // Ninja rewrites the log when it gets too long, then all of it is read.
+   end = map + eina_file_size_get(file);
+   if (offset < 0 || map + offset > end)
+     offset = 0;
+
+   timing = _edi_build_timing_new();
+   for (line = map + offset; line < end; line = eol + 1)
+     {
+        eol = memchr(line, '\n', end - line);
+        if (!eol)
+          eol = end;
+        if (eol == line || line[0] == '#')
+          continue;
+
+        // start, end, mtime, output, hash with the times in milliseconds.
+        start = strtod(line, NULL) / 1000.0;
+        pos = _edi_build_timing_field_next(line, eol);
+        if (!pos)
+          continue;
+        finish = strtod(pos, NULL) / 1000.0;
+        pos = _edi_build_timing_field_next(pos, eol);
+        output = pos ? _edi_build_timing_field_next(pos, eol) : NULL;
+        if (!output)
+          continue;
+        pos = memchr(output, '\t', eol - output);
+        if (!pos)
+          pos = eol;
+
+        // A step with several outputs is logged once for each of them.
+        if (last && last->start == start && last->end == finish)
+          continue;
+
+        last = _edi_build_timing_step_add(timing, output, pos - output, start, finish);
+     }
+
+   eina_file_map_free(file, (void *) map);
+   eina_file_close(file);
+
+   _edi_build_timing_finish(timing);
+   return timing;
+}
+
+// Prefer the output of a compiler command over the whole command line.
+static void
+_edi_build_timing_make_target(const char *command, const char *end, const char **target,
+                              size_t *length)
+{
+   const char *pos, *last;
+
+   for (pos = command; pos + 4 < end; pos++)
+     {
+        if (strncmp(pos, " -o ", 4))
+          continue;
+
+        pos += 4;
+        last = pos;
+        while (last < end && *last != ' ')
+          last++;
+
+        *target = pos;
+        *length = last - pos;
+        return;
+     }
+
+   *target = command;
+   *length = end - command;
+}
+
+EAPI Edi_Build_Timing *
+edi_build_timing_make_read(const char *path)
+{
+   Edi_Build_Timing *timing;
+   Eina_File *file;
+   Eina_Iterator *it;
+   Eina_File_Line *line;
+   const char *pos, *target;
+   char *next;
+   double start, finish;
+   size_t length;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   timing = _edi_build_timing_new();
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        // start, end, command with the times in seconds since the epoch.
+        start = strtod(line->start, &next);
+        if (next == line->start || *next != '\t')
+          continue;
+        pos = next + 1;
+        finish = strtod(pos, &next);
+        if (next == pos || *next != '\t' || finish < start)
+          continue;
+
+        _edi_build_timing_make_target(next + 1, line->end, &target, &length);
+        _edi_build_timing_step_add(timing, target, length, start, finish);
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+
+   _edi_build_timing_finish(timing);
+   return timing;
+}
+
+static const char *
+_edi_build_timing_find(const char *start, const char *end, const char *needle)
+{
+   const char *pos;
+   size_t length;
+
+   length = strlen(needle);
+   for (pos = start; pos + length <= end; pos++)
+     if (!memcmp(pos, needle, length))
+       return pos;
+
+   return NULL;
+}
+
+static const char *
+_edi_build_timing_json_value(const char *start, const char *end, const char *key)
+{
+   const char *pos;
+   size_t length;
+
+   length = strlen(key);
+   for (pos = start; pos + length + 2 < end; pos++)
+     {
+        if (*pos != '"' || strncmp(pos + 1, key, length) || pos[length + 1] != '"')
+          continue;
+
+        pos += length + 2;
+        while (pos < end && (*pos == ' ' || *pos == ':'))
+          pos++;
+        return pos < end ? pos : NULL;
+     }
+
+   return NULL;
+}
+
+static const char *
+_edi_build_timing_json_string(const char *start, const char *end, const char *key,
+                              size_t *length)
+{
+   const char *pos, *last;
+
+   pos = _edi_build_timing_json_value(start, end, key);
+   if (!pos || *pos != '"')
+     return NULL;
+
+   pos++;
+   for (last = pos; last < end && *last != '"'; last++)
+     if (*last == '\\')
+       last++;
+   if (last >= end)
+     return NULL;
+
+   *length = last - pos;
+   return pos;
+}
+
+// The report keeps a JSON array of the units it built for its own charts.
+EAPI Edi_Build_Timing *
+edi_build_timing_cargo_read(const char *path)
+{
+   Edi_Build_Timing *timing;
+   Eina_File *file;
+   const char *map, *end, *pos, *unit, *close, *name, *version, *target, *value;
+   size_t name_len, version_len, target_len;
+   double start, duration;
+   char *label;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map)
+     {
+        eina_file_close(file);
+        return NULL;
+     }
+
+   timing = _edi_build_timing_new();
+   end = map + eina_file_size_get(file);
+   pos = _edi_build_timing_find(map, end, "UNIT_DATA");
+   if (pos)
+     pos = memchr(pos, '[', end - pos);
+
+   while (pos && (unit = memchr(pos, '{', end - pos)))
+     {
+        // The array ends before the next object.
+        close = memchr(pos, ']', unit - pos);
+        if (close)
+          break;
+
+        pos = memchr(unit, '}', end - unit);
+        if (!pos)
+          break;
+
+        name = _edi_build_timing_json_string(unit, pos, "name", &name_len);
+        version = _edi_build_timing_json_string(unit, pos, "version", &version_len);
+        target = _edi_build_timing_json_string(unit, pos, "target", &target_len);
+        value = _edi_build_timing_json_value(unit, pos, "start");
+        if (!name || !version || !target || !value)
+          continue;
+        start = strtod(value, NULL);
+        value = _edi_build_timing_json_value(unit, pos, "duration");
+        if (!value)
+          continue;
+        duration = strtod(value, NULL);
+
+        label = malloc(name_len + version_len + target_len + 3);
+        sprintf(label, "%.*s v%.*s%.*s", (int) name_len, name, (int) version_len, version,
+                (int) target_len, target);
+        _edi_build_timing_step_add(timing, label, strlen(label), start, start + duration);
+        free(label);
+     }
+
+   eina_file_map_free(file, (void *) map);
+   eina_file_close(file);
+
+   _edi_build_timing_finish(timing);
+   return timing;
+}
+
+EAPI const char *
+edi_build_timing_make_file_get(void)
+{
+   char *makefile, *shell, *log;
+   FILE *f;
+
+   makefile = _edi_build_timing_path_get("make-timing.mk");
+   shell = _edi_build_timing_path_get("make-timing.sh");
+   log = _edi_build_timing_path_get("make-timing.log");
+   if (!makefile || !shell || !log || !(f = fopen(shell, "w")))
+     goto error;
+
+   // Recipes still run with the shell the makefile asked for, which is passed on to us.
+   fprintf(f, "#!/bin/sh\n"
+              "# Written by Edi to time the recipes of a make build.\n"
+              "start=$(date +%%s.%%N)\n"
+              "\"${EDI_MAKE_SHELL:-/bin/sh}\" \"$@\"\n"
+              "status=$?\n"
+              "eval \"command=\\${$#}\"\n"
+              "printf '%%s\\t%%s\\t%%s\\n' \"$start\" \"$(date +%%s.%%N)\" "
+              "\"$(printf '%%s' \"$command\" | tr '\\t\\n' '  ')\" >> '%s'\n"
+              "exit $status\n", log);
+   fclose(f);
+   if (chmod(shell, 0755))
+     goto error;
+
+   // SHELL given on the command line would override the one set by the makefile,
+   // so the makefile of the directory is read first and its shell kept.
+   f = fopen(makefile, "w");
+   if (!f)
+     goto error;
+   fprintf(f, "# Written by Edi to time the recipes of a make build.\n"
+              "include $(firstword $(wildcard GNUmakefile makefile Makefile))\n"
+              "EDI_MAKE_SHELL := $(SHELL)\n"
+              "export EDI_MAKE_SHELL\n"
+              "SHELL := %s\n", shell);
+   fclose(f);
+
+   free(shell);
+   free(log);
+   return eina_slstr_steal_new(makefile);
+
+error:
+   free(makefile);
+   free(shell);
+   free(log);
+   return NULL;
+}
+
+static void
+_edi_build_timing_history_write(FILE *f, const Edi_Build_Timing *timing)
+{
+   fprintf(f, "%lld %.3f %.3f %.3f %u\n", (long long) timing->when, timing->wall,
+           timing->cpu, timing->busy, timing->count);
+}
+
+EAPI Eina_List *
+edi_build_timing_history_get(void)
+{
+   Edi_Build_Timing *timing;
+   Eina_List *history = NULL;
+   Eina_File *file;
+   Eina_Iterator *it;
+   Eina_File_Line *line;
+   char *path, buf[128];
+   long long when;
+
+   path = _edi_build_timing_path_get("build-times");
+   file = path ? eina_file_open(path, EINA_FALSE) : NULL;
+   free(path);
+   if (!file)
+     return NULL;
+
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        if (line->length >= sizeof(buf))
+          continue;
+        memcpy(buf, line->start, line->length);
+        buf[line->length] = '\0';
+
+        timing = _edi_build_timing_new();
+        if (sscanf(buf, "%lld %lf %lf %lf %u", &when, &timing->wall, &timing->cpu,
+                   &timing->busy, &timing->count) != 5)
+          {
+             free(timing);
+             continue;
+          }
+        timing->when = when;
+
+        history = eina_list_append(history, timing);
+        if (eina_list_count(history) > EDI_BUILD_TIMING_HISTORY_MAX)
+          {
+             edi_build_timing_free(eina_list_data_get(history));
+             history = eina_list_remove_list(history, history);
+          }
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+
+   return history;
+}
+
+// Rewrite the history with the build added, keeping only the most recent builds.
+static void
+_edi_build_timing_history_append(Edi_Build_Timing *timing)
+{
+   Edi_Build_Timing *previous;
+   Eina_List *history, *l;
+   const char *tmp;
+   char *path;
+   FILE *f;
+
+   path = _edi_build_timing_path_get("build-times");
+   if (!path)
+     return;
+
+   history = edi_build_timing_history_get();
+   if (eina_list_count(history) >= EDI_BUILD_TIMING_HISTORY_MAX)
+     {
+        edi_build_timing_free(eina_list_data_get(history));
+        history = eina_list_remove_list(history, history);
+     }
+
+   tmp = eina_slstr_printf("%s.tmp", path);
+   f = fopen(tmp, "w");
+   if (f)
+     {
+        EINA_LIST_FOREACH(history, l, previous)
+          _edi_build_timing_history_write(f, previous);
+        _edi_build_timing_history_write(f, timing);
+        if (fclose(f) || rename(tmp, path))
+          ecore_file_remove(tmp);
+     }
+
+   EINA_LIST_FREE(history, previous)
+     edi_build_timing_free(previous);
+   free(path);
+}
+
+static char *
+_edi_build_timing_build_file_get(const char *file)
+{
+   char *dir, *path;
+
+   dir = edi_project_file_path_get("build");
+   path = edi_path_append(dir, file);
+   free(dir);
+
+   return path;
+}
+
+EAPI void
+edi_build_timing_begin(void)
+{
+   char *path;
+
+   _edi_build_timing_run.running = EINA_TRUE;
+   _edi_build_timing_run.start = ecore_time_get();
+   _edi_build_timing_run.started = time(NULL);
+   _edi_build_timing_run.cpu = _edi_build_timing_cpu_get();
+
+   path = _edi_build_timing_build_file_get(".ninja_log");
+   _edi_build_timing_run.ninja_offset = _edi_build_timing_file_size(path);
+   free(path);
+
+   path = _edi_build_timing_path_get("make-timing.log");
+   if (path)
+     ecore_file_remove(path);
+   free(path);
+}
+
+EAPI Edi_Build_Timing *
+edi_build_timing_end(void)
+{
+   Edi_Build_Provider *provider;
+   Edi_Build_Timing *timing = NULL;
+   struct stat st;
+   char *path = NULL;
+
+   if (!_edi_build_timing_run.running)
+     return NULL;
+   _edi_build_timing_run.running = EINA_FALSE;
+
+   provider = edi_build_provider_for_project_get();
+   if (provider && !strcmp(provider->id, "meson"))
+     {
+        path = _edi_build_timing_build_file_get(".ninja_log");
+        timing = edi_build_timing_ninja_read(path, _edi_build_timing_run.ninja_offset);
+     }
+   else if (provider && (!strcmp(provider->id, "make") || !strcmp(provider->id, "cmake")))
+     {
+        path = _edi_build_timing_path_get("make-timing.log");
+        if (path)
+          timing = edi_build_timing_make_read(path);
+     }
+   else if (provider && !strcmp(provider->id, "cargo"))
+     {
+        // A build that stopped early leaves the report of the one before.
+        path = edi_project_file_path_get("target/cargo-timings/cargo-timing.html");
+        if (!stat(path, &st) && st.st_mtime >= _edi_build_timing_run.started)
+          timing = edi_build_timing_cargo_read(path);
+     }
+   free(path);
+
+   if (!timing)
+     timing = _edi_build_timing_new();
+
+   timing->wall = ecore_time_get() - _edi_build_timing_run.start;
+   timing->cpu = _edi_build_timing_cpu_get() - _edi_build_timing_run.cpu;
+   _edi_build_timing_history_append(timing);
+
+   return timing;
+}
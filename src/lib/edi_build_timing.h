@@ -0,0 +1,139 @@
+#ifndef EDI_BUILD_TIMING_H_
+# define EDI_BUILD_TIMING_H_
+
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for measuring where the time of a build goes.
+ */
+
+/**
+ * A single step of a build, such as compiling one translation unit.
+ */
+typedef struct _Edi_Build_Timing_Step
+{
+   const char *target; /**< The output of the step, or its command if the output is not known */
+   double start; /**< When the step started, in seconds from the start of the build */
+   double end; /**< When the step finished, in seconds from the start of the build */
+} Edi_Build_Timing_Step;
+
+/**
+ * The timing of a whole build.
+ */
+typedef struct _Edi_Build_Timing
+{
+   time_t when; /**< When the build finished */
+   double wall; /**< The wall clock time of the build in seconds */
+   double cpu; /**< The CPU time used by the build in seconds, 0 if it was not measured */
+   double busy; /**< The sum of the time taken by each step in seconds */
+   unsigned int count; /**< The number of steps in the build */
+
+   Eina_List *steps; /**< The Edi_Build_Timing_Step of the build, slowest first */
+   Eina_List *critical; /**< The steps on the estimated critical path, first to last */
+} Edi_Build_Timing;
+
+/**
+ * @brief Build timing
+ * @defgroup Build_Timing
+ *
+ * @{
+ *
+ * Read the step timings of ninja, make and cargo builds and keep a history of them.
+ *
+ */
+
+/**
+ * Note the start of a build of the current project.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI void edi_build_timing_begin(void);
+
+/**
+ * Collect the timing of the build started with edi_build_timing_begin.
+ *
+ * The build is added to the history of the project, which keeps the last 50 builds.
+ *
+ * @return The timing of the build, free it with edi_build_timing_free, or NULL if no build was started.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI Edi_Build_Timing *edi_build_timing_end(void);
+
+/**
+ * Get a makefile that logs the time taken by each recipe of the current project.
+ *
+ * It reads the makefile of the directory make runs in, and runs each recipe
+ * through a timing shell that starts the shell that makefile asked for.
+ *
+ * @return The path to pass to make with -f, or NULL if it could not be written.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI const char *edi_build_timing_make_file_get(void);
+
+/**
+ * Read the steps of a build from a ninja log.
+ *
+ * @param path The path of the .ninja_log file.
+ * @param offset The size of the log before the build, only later entries are read.
+ * @return The timing of the steps, NULL if the log could not be read.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI Edi_Build_Timing *edi_build_timing_ninja_read(const char *path, long offset);
+
+/**
+ * Read the steps of a build from the log written by the make shell.
+ *
+ * @param path The path of the log.
+ * @return The timing of the steps, NULL if the log could not be read.
+ *
+ * @see edi_build_timing_make_file_get().
+ *
+ * @ingroup Build_Timing
+ */
+EAPI Edi_Build_Timing *edi_build_timing_make_read(const char *path);
+
+/**
+ * Read the steps of a build from the report written by cargo build --timings.
+ *
+ * @param path The path of the cargo-timing.html report.
+ * @return The timing of the steps, NULL if the report could not be read.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI Edi_Build_Timing *edi_build_timing_cargo_read(const char *path);
+
+/**
+ * Get the recent builds of the current project.
+ *
+ * @return A list of Edi_Build_Timing without steps, oldest first.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI Eina_List *edi_build_timing_history_get(void);
+
+/**
+ * Free a build timing and its steps.
+ *
+ * @param timing The timing to free.
+ *
+ * @ingroup Build_Timing
+ */
+EAPI void edi_build_timing_free(Edi_Build_Timing *timing);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BUILD_TIMING_H_ */
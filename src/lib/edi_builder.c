@@ -29,6 +29,17 @@ edi_builder_can_run(const char *runpath)
    return provider && provider->project_runnable_is(runpath);
 }
 
+EAPI Eina_Bool
+edi_builder_can_compile_file(const char *path)
+{
+   Edi_Build_Provider *provider;
+
+   provider = edi_build_provider_for_project_get();
+
+   return provider && provider->file_compilable_is &&
+          provider->file_compilable_is(path);
+}
+
 EAPI void
 edi_builder_build(void)
 {
@@ -77,4 +88,16 @@ edi_builder_clean(void)
    provider->clean();
 }
 
+EAPI void
+edi_builder_compile_file(const char *path)
+{
+   Edi_Build_Provider *provider;
+
+   provider = edi_build_provider_for_project_get();
+   if (!provider || !provider->compile_file)
+     return;
+
+   provider->compile_file(path);
+}
+
 
@@ -45,6 +45,20 @@ edi_builder_can_build(void);
 EAPI Eina_Bool
 edi_builder_can_run(const char *runpath);
 
+/**
+ * Check if Edi can compile a single file of the current project.
+ * This depends on the file being listed in the project's compile_commands.json.
+ *
+ * @param path The path of the source file.
+ * @return Whether or not the file can be compiled on its own.
+ *
+ * @see edi_builder_compile_file().
+ *
+ * @ingroup Builder
+ */
+EAPI Eina_Bool
+edi_builder_can_compile_file(const char *path);
+
 /**
  * Run a build for the current project.
  *
@@ -85,6 +99,18 @@ edi_builder_run(const char *runpath, const char *args);
 EAPI void
 edi_builder_clean(void);
 
+/**
+ * Compile a single file of the current project, without linking.
+ *
+ * @param path The path of the source file.
+ *
+ * @see edi_builder_can_compile_file().
+ *
+ * @ingroup Builder
+ */
+EAPI void
+edi_builder_compile_file(const char *path);
+
 /**
  * @}
  */
@@ -0,0 +1,374 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+typedef struct _Edi_Compile_Command_Entry
+{
+   char *directory, *file, *command, *output;
+} Edi_Compile_Command_Entry;
+
+// A parsed compile_commands.json, kept until the file changes.
+typedef struct _Edi_Compile_Command_Database
+{
+   time_t mtime;
+   size_t size;
+   Eina_Hash *commands; /* Resolved source path to Edi_Compile_Command */
+} Edi_Compile_Command_Database;
+
+static Eina_Hash *_edi_compile_command_databases = NULL; /* Database path to Edi_Compile_Command_Database */
+
+static void
+_edi_compile_command_quote(Eina_Strbuf *buf, const char *arg)
+{
+   const char *ptr;
+
+   if (arg[0] && !arg[strspn(arg, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-+=/.,:@%")])
+     {
+        eina_strbuf_append(buf, arg);
+        return;
+     }
+
+   eina_strbuf_append_char(buf, '\'');
+   for (ptr = arg; *ptr; ptr++)
+     {
+        if (*ptr == '\'')
+          eina_strbuf_append(buf, "'\\''");
+        else
+          eina_strbuf_append_char(buf, *ptr);
+     }
+   eina_strbuf_append_char(buf, '\'');
+}
+
+// Join an "arguments" array into a single command line.
+static char *
+_edi_compile_command_arguments_read(const char **pos, const char *end)
+{
+   Eina_Strbuf *buf;
+   const char *ptr = *pos + 1;
+   char *arg;
+
+   buf = eina_strbuf_new();
+   while (1)
+     {
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr < end && *ptr == ']')
+          break;
+
+        arg = _edi_json_string_read(&ptr, end);
+        if (!arg)
+          {
+             eina_strbuf_free(buf);
+             return NULL;
+          }
+
+        if (eina_strbuf_length_get(buf))
+          eina_strbuf_append_char(buf, ' ');
+        _edi_compile_command_quote(buf, arg);
+        free(arg);
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr < end && *ptr == ',')
+          ptr++;
+     }
+
+   *pos = ptr + 1;
+   return eina_strbuf_release(buf);
+}
+
+static void
+_edi_compile_command_entry_clear(Edi_Compile_Command_Entry *entry)
+{
+   free(entry->directory);
+   free(entry->file);
+   free(entry->command);
+   free(entry->output);
+   memset(entry, 0, sizeof(Edi_Compile_Command_Entry));
+}
+
+// Read the object at pos into entry, leaving pos after its closing brace.
+static Eina_Bool
+_edi_compile_command_entry_read(const char **pos, const char *end, Edi_Compile_Command_Entry *entry)
+{
+   const char *ptr = *pos + 1;
+   char *key, **value;
+
+   while (1)
+     {
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr < end && *ptr == '}')
+          break;
+
+        key = _edi_json_string_read(&ptr, end);
+        if (!key)
+          return EINA_FALSE;
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != ':')
+          {
+             free(key);
+             return EINA_FALSE;
+          }
+        ptr = _edi_json_space_skip(ptr + 1, end);
+
+        value = NULL;
+        if (!strcmp(key, "directory"))
+          value = &entry->directory;
+        else if (!strcmp(key, "file"))
+          value = &entry->file;
+        else if (!strcmp(key, "command") || !strcmp(key, "arguments"))
+          value = &entry->command;
+        else if (!strcmp(key, "output"))
+          value = &entry->output;
+        free(key);
+
+        if (value && ptr < end && *ptr == '"')
+          {
+             free(*value);
+             *value = _edi_json_string_read(&ptr, end);
+          }
+        else if (value == &entry->command && ptr < end && *ptr == '[')
+          {
+             free(*value);
+             *value = _edi_compile_command_arguments_read(&ptr, end);
+          }
+        else if (!_edi_json_value_skip(&ptr, end))
+          return EINA_FALSE;
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr < end && *ptr == ',')
+          ptr++;
+        else if (ptr >= end || *ptr != '}')
+          return EINA_FALSE;
+     }
+
+   *pos = ptr + 1;
+   return EINA_TRUE;
+}
+
+static Edi_Compile_Command *
+_edi_compile_command_copy(const Edi_Compile_Command *command)
+{
+   Edi_Compile_Command *copy;
+
+   copy = calloc(1, sizeof(Edi_Compile_Command));
+   copy->directory = eina_stringshare_ref(command->directory);
+   copy->command = eina_stringshare_ref(command->command);
+   copy->output = eina_stringshare_ref(command->output);
+
+   return copy;
+}
+
+static void
+_edi_compile_command_free_cb(void *data)
+{
+   edi_compile_command_free(data);
+}
+
+static void
+_edi_compile_command_database_free_cb(void *data)
+{
+   Edi_Compile_Command_Database *database = data;
+
+   eina_hash_free(database->commands);
+   free(database);
+}
+
+static void
+_edi_compile_command_entry_add(Eina_Hash *commands, const Edi_Compile_Command_Entry *entry)
+{
+   Edi_Compile_Command *command;
+   char resolved[PATH_MAX];
+   const char *key;
+   char *file;
+
+   if (!entry->file || !entry->command || !entry->directory)
+     return;
+
+   if (entry->file[0] == '/')
+     file = strdup(entry->file);
+   else
+     file = edi_path_append(entry->directory, entry->file);
+
+   // Meson lists sources relative to the build directory, as ../src/file.c.
+   key = realpath(file, resolved) ? resolved : file;
+
+   // The first entry listed for a file is the one used.
+   if (!eina_hash_find(commands, key))
+     {
+        command = calloc(1, sizeof(Edi_Compile_Command));
+        command->directory = eina_stringshare_add(entry->directory);
+        command->command = eina_stringshare_add(entry->command);
+        command->output = eina_stringshare_add(entry->output);
+        eina_hash_add(commands, key, command);
+     }
+
+   free(file);
+}
+
+static Eina_Hash *
+_edi_compile_command_database_parse(Eina_File *file)
+{
+   Edi_Compile_Command_Entry entry;
+   Eina_Hash *commands;
+   const char *map, *ptr, *end;
+
+   commands = eina_hash_string_superfast_new(_edi_compile_command_free_cb);
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map)
+     return commands;
+   ptr = map;
+   end = map + eina_file_size_get(file);
+
+   memset(&entry, 0, sizeof(Edi_Compile_Command_Entry));
+   ptr = _edi_json_space_skip(ptr, end);
+   if (ptr < end && *ptr == '[')
+     ptr++;
+
+   while (1)
+     {
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != '{')
+          break;
+        if (!_edi_compile_command_entry_read(&ptr, end, &entry))
+          break;
+
+        _edi_compile_command_entry_add(commands, &entry);
+        _edi_compile_command_entry_clear(&entry);
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr < end && *ptr == ',')
+          ptr++;
+     }
+
+   _edi_compile_command_entry_clear(&entry);
+   eina_file_map_free(file, (void *) map);
+
+   return commands;
+}
+
+// Parse a database only when it was written since it was last read.
+static Edi_Compile_Command_Database *
+_edi_compile_command_database_get(const char *path)
+{
+   Edi_Compile_Command_Database *database;
+   Eina_File *file;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     {
+        if (_edi_compile_command_databases)
+          eina_hash_del_by_key(_edi_compile_command_databases, path);
+        return NULL;
+     }
+
+   if (!_edi_compile_command_databases)
+     _edi_compile_command_databases = eina_hash_string_superfast_new(_edi_compile_command_database_free_cb);
+
+   database = eina_hash_find(_edi_compile_command_databases, path);
+   if (database && database->mtime == eina_file_mtime_get(file) &&
+       database->size == eina_file_size_get(file))
+     {
+        eina_file_close(file);
+        return database;
+     }
+
+   if (database)
+     eina_hash_del_by_key(_edi_compile_command_databases, path);
+
+   database = calloc(1, sizeof(Edi_Compile_Command_Database));
+   database->mtime = eina_file_mtime_get(file);
+   database->size = eina_file_size_get(file);
+   database->commands = _edi_compile_command_database_parse(file);
+   eina_hash_add(_edi_compile_command_databases, path, database);
+
+   eina_file_close(file);
+   return database;
+}
+
+void
+_edi_compile_command_shutdown(void)
+{
+   if (_edi_compile_command_databases)
+     eina_hash_free(_edi_compile_command_databases);
+   _edi_compile_command_databases = NULL;
+}
+
+EAPI Edi_Compile_Command *
+edi_compile_command_get(const char *dir, const char *path)
+{
+   Edi_Compile_Command_Database *database;
+   Edi_Compile_Command *command;
+   char *file, resolved[PATH_MAX];
+
+   if (!dir || !path)
+     return NULL;
+
+   file = edi_path_append(dir, "compile_commands.json");
+   database = _edi_compile_command_database_get(file);
+   free(file);
+   if (!database)
+     return NULL;
+
+   if (realpath(path, resolved))
+     path = resolved;
+
+   command = eina_hash_find(database->commands, path);
+   if (!command)
+     return NULL;
+
+   return _edi_compile_command_copy(command);
+}
+
+EAPI Edi_Compile_Command *
+edi_compile_command_for_project_get(const char *path)
+{
+   Edi_Compile_Command *command = NULL;
+   char *dir;
+
+   if (edi_project_file_exists("build/compile_commands.json"))
+     {
+        dir = edi_project_file_path_get("build");
+        command = edi_compile_command_get(dir, path);
+        free(dir);
+     }
+
+   if (!command)
+     command = edi_compile_command_get(edi_project_get(), path);
+
+   return command;
+}
+
+EAPI const char *
+edi_compile_command_shell_get(const Edi_Compile_Command *command)
+{
+   Eina_Strbuf *buf;
+
+   buf = eina_strbuf_new();
+   eina_strbuf_append(buf, "cd ");
+   _edi_compile_command_quote(buf, command->directory);
+   eina_strbuf_append_printf(buf, " && echo \"edi: Entering directory '$PWD'\" && %s", command->command);
+
+   return eina_slstr_strbuf_new(buf);
+}
+
+EAPI void
+edi_compile_command_free(Edi_Compile_Command *command)
+{
+   if (!command)
+     return;
+
+   eina_stringshare_del(command->directory);
+   eina_stringshare_del(command->command);
+   eina_stringshare_del(command->output);
+   free(command);
+}
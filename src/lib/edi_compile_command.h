@@ -0,0 +1,87 @@
+#ifndef EDI_COMPILE_COMMAND_H_
+# define EDI_COMPILE_COMMAND_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for compiling a single file of a project.
+ */
+
+/**
+ * The command that compiles one source file, as listed in a compile_commands.json.
+ */
+typedef struct _Edi_Compile_Command
+{
+   const char *directory; /**< The directory the command runs in */
+   const char *command; /**< The command line, quoted for the shell */
+   const char *output; /**< The file produced, relative to the directory, or NULL if it was not listed */
+} Edi_Compile_Command;
+
+/**
+ * @brief Compile commands
+ * @defgroup Compile_Command
+ *
+ * @{
+ *
+ * Look up the command for a source file in a compilation database.
+ *
+ */
+
+/**
+ * Find the command that compiles a file.
+ *
+ * The database is parsed once and kept until its modification time or size change.
+ *
+ * @param dir The directory holding compile_commands.json.
+ * @param path The path of the source file to look up.
+ * @return The command, free it with edi_compile_command_free, or NULL if the file is not listed.
+ *
+ * @ingroup Compile_Command
+ */
+EAPI Edi_Compile_Command *edi_compile_command_get(const char *dir, const char *path);
+
+/**
+ * Find the command that compiles a file of the current project.
+ *
+ * The database is looked for in the build directory and then the project root.
+ *
+ * @param path The path of the source file to look up.
+ * @return The command, free it with edi_compile_command_free, or NULL if the file is not listed.
+ *
+ * @ingroup Compile_Command
+ */
+EAPI Edi_Compile_Command *edi_compile_command_for_project_get(const char *path);
+
+/**
+ * Get a shell command line that runs a compile command in its directory.
+ *
+ * The directory is announced as make does so that diagnostics can be resolved.
+ *
+ * @param command The command to run.
+ * @return The command line, valid until the next main loop iteration.
+ *
+ * @ingroup Compile_Command
+ */
+EAPI const char *edi_compile_command_shell_get(const Edi_Compile_Command *command);
+
+/**
+ * Free a compile command.
+ *
+ * @param command The command to free.
+ *
+ * @ingroup Compile_Command
+ */
+EAPI void edi_compile_command_free(Edi_Compile_Command *command);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_COMPILE_COMMAND_H_ */
@@ -25,7 +25,7 @@ typedef struct _Edi_Create
 
 typedef struct _Edi_Create_Example
 {
-   char *path, *name;
+   char *path, *name, *examples;
 
    Edi_Create_Cb callback;
 
@@ -173,26 +173,23 @@ _edi_create_done_cb(void *data EINA_UNUSED, Eio_File *file EINA_UNUSED)
    // we're using the filter processes to determine when we're done
 }
 
-static Eina_Bool
-_edi_create_project_done(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+static void
+_edi_create_project_done(void *data, int code EINA_UNUSED, Eina_Bool timed_out EINA_UNUSED)
 {
    Edi_Create *create;
 
    create = (Edi_Create *)data;
 
-   ecore_event_handler_del(create->handler);
    if (create->callback)
      create->callback(create->path, EINA_TRUE);
 
    _edi_create_free_data();
-   return ECORE_CALLBACK_DONE; // or ECORE_CALLBACK_PASS_ON
 }
 
 static Eina_Bool
 _edi_create_filter_file_done(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
 {
    Edi_Create *create;
-   Ecore_Event_Handler *handler;
    Eina_Strbuf *command;
    char *escaped;
 
@@ -202,16 +199,11 @@ _edi_create_filter_file_done(void *data, int type EINA_UNUSED, void *event EINA_
      return ECORE_CALLBACK_PASS_ON;
 
    ecore_event_handler_del(create->handler);
-
-   handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_create_project_done, data);
-   create->handler = handler;
-
-   if (chdir(create->path) != 0)
-     ERR("Could not chdir");
+   create->handler = NULL;
 
    command = eina_strbuf_new();
 
-   eina_strbuf_append(command, "sh -c \"git init && git add .");
+   eina_strbuf_append(command, "git init && git add .");
 
    if (create->user && strlen(create->user))
      {
@@ -227,9 +219,9 @@ _edi_create_filter_file_done(void *data, int type EINA_UNUSED, void *event EINA_
         free(escaped);
      }
 
-   eina_strbuf_append(command, " \" ");
-
-   ecore_exe_run(eina_strbuf_string_get(command), data);
+   if (!edi_exe_run(create->path, NULL, eina_strbuf_string_get(command), 0,
+                    NULL, _edi_create_project_done, data))
+     _edi_create_project_done(data, -1, EINA_FALSE);
 
    eina_strbuf_free(command);
 
@@ -374,6 +366,15 @@ _edi_create_example_done_cb(void *data, Eio_File *file EINA_UNUSED)
      create->callback(create->path, EINA_TRUE);
 }
 
+static void
+_edi_create_example_free(Edi_Create_Example *create)
+{
+   free(create->path);
+   free(create->name);
+   free(create->examples);
+   free(create);
+}
+
 static void
 _edi_create_example_extract_dir(char *examples_path, Edi_Create_Example *create)
 {
@@ -387,12 +388,29 @@ _edi_create_example_extract_dir(char *examples_path, Edi_Create_Example *create)
    free(examples_path);
 }
 
+static void
+_edi_create_example_clone_end_cb(void *data, int status, Eina_Bool cancelled EINA_UNUSED)
+{
+   Edi_Create_Example *create = data;
+
+   if (status)
+     {
+        ERR("git error: [%d]\n", status);
+
+        if (create->callback)
+          create->callback(create->path, EINA_FALSE);
+        _edi_create_example_free(create);
+        return;
+     }
+
+   _edi_create_example_extract_dir(strdup(create->examples), create);
+}
+
 EAPI void
 edi_create_example(const char *example_name, const char *parentdir,
                    const char *name, Edi_Create_Cb func)
 {
    char dest[PATH_MAX], examplepath[PATH_MAX];
-   int status = 0;
    Edi_Create_Example *data;
 
    snprintf(dest, sizeof(dest), "%s/%s", parentdir, name);
@@ -402,24 +420,20 @@ edi_create_example(const char *example_name, const char *parentdir,
    data = calloc(1, sizeof(Edi_Create_Example));
    data->path = strdup(dest);
    data->name = strdup(example_name);
+   data->examples = strdup(examplepath);
    data->callback = func;
 
    INF("Extracting example project \"%s\" at path %s\n", example_name, dest);
 
    if (ecore_file_exists(examplepath))
-     ERR("TODO: UPDATE NOT IMPLEMENTED");
-//     status = edi_scm_git_update(examplepath);
-   else
-     status = edi_scm_git_clone(EXAMPLES_GIT_URL, examplepath);
-
-   if (status)
      {
-        ERR("git error: [%d]\n", status);
-
-        if (func)
-          func(dest, EINA_FALSE);
+        ERR("TODO: UPDATE NOT IMPLEMENTED");
+//     status = edi_scm_git_update(examplepath);
+        _edi_create_example_extract_dir(strdup(examplepath), data);
      }
-   else
-     _edi_create_example_extract_dir(strdup(examplepath), data);
+   // The clone reaches the network, so it must not hold up the main loop.
+   else if (!edi_scm_git_clone_job(EXAMPLES_GIT_URL, examplepath, NULL, NULL,
+                                   _edi_create_example_clone_end_cb, data))
+     _edi_create_example_clone_end_cb(data, -1, EINA_FALSE);
 }
 
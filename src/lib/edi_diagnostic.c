@@ -0,0 +1,313 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <strings.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+struct _Edi_Diagnostic_Parser
+{
+   const char *base;
+   const char *dir;
+
+   // A rustc header waiting for the "-->" line that carries its location.
+   Eina_Bool pending;
+   Edi_Diagnostic_Severity severity;
+   const char *message;
+};
+
+static const struct {
+   const char *word;
+   Edi_Diagnostic_Severity severity;
+} _edi_diagnostic_severities[] = {
+   { "fatal error", EDI_DIAGNOSTIC_SEVERITY_ERROR },
+   { "error", EDI_DIAGNOSTIC_SEVERITY_ERROR },
+   { "warning", EDI_DIAGNOSTIC_SEVERITY_WARNING },
+   { "note", EDI_DIAGNOSTIC_SEVERITY_NOTE },
+};
+
+static const char *
+_edi_diagnostic_space_skip(const char *pos, const char *end)
+{
+   while (pos < end && (*pos == ' ' || *pos == '\t'))
+     pos++;
+
+   return pos;
+}
+
+static Eina_Bool
+_edi_diagnostic_number_parse(const char **pos, const char *end, unsigned int *number)
+{
+   const char *start = *pos;
+
+   *number = 0;
+   while (*pos < end && isdigit((unsigned char) **pos))
+     {
+        *number = *number * 10 + (**pos - '0');
+        (*pos)++;
+     }
+
+   return *pos > start;
+}
+
+// Matches "error:", "warning:", "ERROR:" from meson and "error[E0308]:" from rustc.
+static Eina_Bool
+_edi_diagnostic_severity_parse(const char *start, const char *end,
+                               Edi_Diagnostic_Severity *severity, const char **message)
+{
+   const char *pos;
+   size_t len;
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_diagnostic_severities); i++)
+     {
+        len = strlen(_edi_diagnostic_severities[i].word);
+        if ((size_t) (end - start) <= len ||
+            strncasecmp(start, _edi_diagnostic_severities[i].word, len))
+          continue;
+
+        pos = start + len;
+        if (*pos == '[')
+          {
+             pos = memchr(pos, ']', end - pos);
+             if (!pos)
+               continue;
+             pos++;
+          }
+        if (pos >= end || *pos != ':')
+          continue;
+
+        *severity = _edi_diagnostic_severities[i].severity;
+        *message = _edi_diagnostic_space_skip(pos + 1, end);
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+// A location is "path:line:" or "path:line:col:", the path may not contain spaces.
+static Eina_Bool
+_edi_diagnostic_location_parse(const char *start, const char *end, size_t *pathlen,
+                               unsigned int *line, unsigned int *col, const char **rest)
+{
+   const char *pos, *num;
+   Eina_Bool numeric = EINA_TRUE;
+
+   for (pos = start; pos < end; pos++)
+     {
+        if (*pos == ' ' || *pos == '\t')
+          return EINA_FALSE;
+        if (*pos != ':' || pos == start)
+          {
+             numeric = numeric && isdigit((unsigned char) *pos);
+             continue;
+          }
+
+        // A time stamp such as 12:30:45 is not a location.
+        if (numeric)
+          return EINA_FALSE;
+
+        num = pos + 1;
+        if (!_edi_diagnostic_number_parse(&num, end, line) || (num < end && *num != ':'))
+          continue;
+
+        *pathlen = pos - start;
+        if (num < end)
+          num++;
+
+        pos = num;
+        if (!_edi_diagnostic_number_parse(&pos, end, col) || (pos < end && *pos != ':'))
+          {
+             *col = 0;
+             pos = num;
+          }
+        else if (pos < end)
+          pos++;
+
+        *rest = _edi_diagnostic_space_skip(pos, end);
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+static const char *
+_edi_diagnostic_path_resolve(const char *dir, const char *path, size_t len)
+{
+   const char *ret;
+   char *joined, *clean;
+
+   if (!dir && path[0] != '/')
+     return eina_stringshare_add_length(path, len);
+
+   if (path[0] == '/')
+     joined = strndup(path, len);
+   else
+     {
+        joined = malloc(strlen(dir) + len + 2);
+        sprintf(joined, "%s/%.*s", dir, (int) len, path);
+     }
+
+   clean = eina_file_path_sanitize(joined);
+   ret = eina_stringshare_add(clean ? clean : joined);
+
+   free(clean);
+   free(joined);
+   return ret;
+}
+
+static Edi_Diagnostic *
+_edi_diagnostic_new(const char *dir, const char *start, const char *end,
+                    Eina_Bool known, Edi_Diagnostic_Severity severity, const char *message,
+                    size_t message_len)
+{
+   Edi_Diagnostic *diagnostic;
+   const char *rest;
+   size_t pathlen;
+   unsigned int line, col;
+
+   if (!_edi_diagnostic_location_parse(start, end, &pathlen, &line, &col, &rest))
+     return NULL;
+
+   if (!known)
+     {
+        // Go and check report failures without naming a severity.
+        if (!_edi_diagnostic_severity_parse(rest, end, &severity, &message))
+          {
+             severity = EDI_DIAGNOSTIC_SEVERITY_ERROR;
+             message = rest;
+          }
+        message_len = end - message;
+        if (!message_len)
+          return NULL;
+     }
+
+   diagnostic = calloc(1, sizeof(Edi_Diagnostic));
+   diagnostic->path = _edi_diagnostic_path_resolve(dir, start, pathlen);
+   diagnostic->line = line;
+   diagnostic->col = col;
+   diagnostic->severity = severity;
+   diagnostic->message = eina_stringshare_add_length(message, message_len);
+
+   return diagnostic;
+}
+
+EAPI Edi_Diagnostic *
+edi_diagnostic_parse(const char *dir, const char *line, size_t length)
+{
+   const char *end = line + length;
+
+   return _edi_diagnostic_new(dir, _edi_diagnostic_space_skip(line, end), end,
+                              EINA_FALSE, EDI_DIAGNOSTIC_SEVERITY_ERROR, NULL, 0);
+}
+
+EAPI void
+edi_diagnostic_free(Edi_Diagnostic *diagnostic)
+{
+   eina_stringshare_del(diagnostic->path);
+   eina_stringshare_del(diagnostic->message);
+   free(diagnostic);
+}
+
+EAPI Edi_Diagnostic_Parser *
+edi_diagnostic_parser_new(const char *dir)
+{
+   Edi_Diagnostic_Parser *parser;
+
+   parser = calloc(1, sizeof(Edi_Diagnostic_Parser));
+   parser->base = eina_stringshare_add(dir);
+   parser->dir = eina_stringshare_ref(parser->base);
+
+   return parser;
+}
+
+EAPI void
+edi_diagnostic_parser_free(Edi_Diagnostic_Parser *parser)
+{
+   eina_stringshare_del(parser->base);
+   eina_stringshare_del(parser->dir);
+   eina_stringshare_del(parser->message);
+   free(parser);
+}
+
+static void
+_edi_diagnostic_parser_pending_set(Edi_Diagnostic_Parser *parser, Eina_Bool pending,
+                                   Edi_Diagnostic_Severity severity, const char *message,
+                                   size_t length)
+{
+   parser->pending = pending;
+   parser->severity = severity;
+   if (pending)
+     eina_stringshare_replace_length(&parser->message, message, length);
+   else
+     eina_stringshare_replace(&parser->message, NULL);
+}
+
+// Follows make's "Entering directory '...'" and ninja's "Entering directory `...'".
+static Eina_Bool
+_edi_diagnostic_parser_directory(Edi_Diagnostic_Parser *parser, const char *line, const char *end)
+{
+   const char *pos, *last;
+   const char *entering = "Entering directory ";
+   size_t len = strlen(entering);
+
+   for (pos = line; pos + len < end; pos++)
+     {
+        if (strncmp(pos, entering, len))
+          continue;
+
+        pos += len + 1;
+        last = end - 1;
+        while (last > pos && *last != '\'')
+          last--;
+        if (last <= pos)
+          return EINA_FALSE;
+
+        eina_stringshare_del(parser->dir);
+        parser->dir = _edi_diagnostic_path_resolve(parser->base, pos, last - pos);
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+EAPI Edi_Diagnostic *
+edi_diagnostic_parser_feed(Edi_Diagnostic_Parser *parser, const char *line, size_t length)
+{
+   Edi_Diagnostic *diagnostic;
+   Edi_Diagnostic_Severity severity;
+   const char *end = line + length;
+   const char *start, *message;
+
+   if (_edi_diagnostic_parser_directory(parser, line, end))
+     {
+        _edi_diagnostic_parser_pending_set(parser, EINA_FALSE, 0, NULL, 0);
+        return NULL;
+     }
+
+   start = _edi_diagnostic_space_skip(line, end);
+   if (end - start > 4 && !strncmp(start, "--> ", 4))
+     {
+        diagnostic = NULL;
+        if (parser->pending)
+          diagnostic = _edi_diagnostic_new(parser->dir, start + 4, end, EINA_TRUE,
+                                           parser->severity, parser->message,
+                                           eina_stringshare_strlen(parser->message));
+
+        _edi_diagnostic_parser_pending_set(parser, EINA_FALSE, 0, NULL, 0);
+        return diagnostic;
+     }
+
+   diagnostic = _edi_diagnostic_new(parser->dir, start, end, EINA_FALSE, 0, NULL, 0);
+   if (!diagnostic && start == line &&
+       _edi_diagnostic_severity_parse(line, end, &severity, &message))
+     _edi_diagnostic_parser_pending_set(parser, EINA_TRUE, severity, message, end - message);
+   else
+     _edi_diagnostic_parser_pending_set(parser, EINA_FALSE, 0, NULL, 0);
+
+   return diagnostic;
+}
@@ -0,0 +1,112 @@
+#ifndef EDI_DIAGNOSTIC_H_
+# define EDI_DIAGNOSTIC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for reading diagnostics from build output.
+ */
+
+/**
+ * The severity of a build diagnostic.
+ */
+typedef enum {
+   EDI_DIAGNOSTIC_SEVERITY_ERROR,
+   EDI_DIAGNOSTIC_SEVERITY_WARNING,
+   EDI_DIAGNOSTIC_SEVERITY_NOTE,
+} Edi_Diagnostic_Severity;
+
+/**
+ * A single error, warning or note reported by a build tool.
+ */
+typedef struct _Edi_Diagnostic
+{
+   const char *path; /**< The file reported, absolute when the build directory is known */
+   unsigned int line; /**< The line reported, starting at 1 */
+   unsigned int col; /**< The column reported, or 0 if there was none */
+   Edi_Diagnostic_Severity severity; /**< How serious the diagnostic is */
+   const char *message; /**< The text of the diagnostic */
+} Edi_Diagnostic;
+
+/**
+ * A parser following the directory changes and multi line records of a build.
+ */
+typedef struct _Edi_Diagnostic_Parser Edi_Diagnostic_Parser;
+
+/**
+ * @brief Diagnostic parsing
+ * @defgroup Diagnostic
+ *
+ * @{
+ *
+ * Recognise the locations reported by gcc, clang, rustc, go and meson.
+ *
+ */
+
+/**
+ * Create a parser for the output of a build.
+ *
+ * A parser holds no global state, each one may be fed from its own thread.
+ *
+ * @param dir The directory the build runs in, relative paths are resolved from it.
+ * @return A new parser, free it with edi_diagnostic_parser_free.
+ *
+ * @ingroup Diagnostic
+ */
+EAPI Edi_Diagnostic_Parser *edi_diagnostic_parser_new(const char *dir);
+
+/**
+ * Free a parser and any record it was part way through.
+ *
+ * @param parser The parser to free.
+ *
+ * @ingroup Diagnostic
+ */
+EAPI void edi_diagnostic_parser_free(Edi_Diagnostic_Parser *parser);
+
+/**
+ * Pass the next line of build output to a parser.
+ *
+ * @param parser The parser reading the build.
+ * @param line The line of output without its trailing newline, not NUL terminated.
+ * @param length The length of the line in bytes.
+ * @return The diagnostic completed by this line, or NULL.
+ *
+ * @ingroup Diagnostic
+ */
+EAPI Edi_Diagnostic *edi_diagnostic_parser_feed(Edi_Diagnostic_Parser *parser, const char *line,
+                                                size_t length);
+
+/**
+ * Read a diagnostic from a single line that starts with its location.
+ *
+ * @param dir The directory relative paths are resolved from, or NULL to leave them relative.
+ * @param line The line of output, not NUL terminated.
+ * @param length The length of the line in bytes.
+ * @return The diagnostic on this line, or NULL.
+ *
+ * @ingroup Diagnostic
+ */
+EAPI Edi_Diagnostic *edi_diagnostic_parse(const char *dir, const char *line, size_t length);
+
+/**
+ * Free a diagnostic returned by the parser.
+ *
+ * @param diagnostic The diagnostic to free.
+ *
+ * @ingroup Diagnostic
+ */
+EAPI void edi_diagnostic_free(Edi_Diagnostic *diagnostic);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_DIAGNOSTIC_H_ */
@@ -3,10 +3,12 @@
 #endif
 
 #include <sys/wait.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
 
 #include <Ecore.h>
-#include <Ecore_File.h>
-#include <Ecore_Con.h>
 
 #include "Edi.h"
 #include "edi_private.h"
@@ -14,107 +16,144 @@
 typedef struct _Edi_Exe_Args {
    void ((*func)(int, void *));
    void *data;
+   const char *name;
    pid_t pid;
-   Ecore_Event_Handler *handler;
 } Edi_Exe_Args;
 
+// Handlers waiting for a command of their name to start, oldest first.
+static Eina_Hash *_edi_exe_notify_waiting = NULL;
+
+// Handlers of commands that are running, matched to their exit by pid.
+static Eina_List *_edi_exe_notify_running = NULL;
+static Ecore_Event_Handler *_edi_exe_notify_handler = NULL;
+
 static Eina_Bool
-_edi_exe_notify_client_data_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+_edi_exe_notify_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
 {
-   int *status;
+   Ecore_Exe_Event_Del *ev = event;
    Edi_Exe_Args *args;
-   Ecore_Con_Event_Client_Data *ev = event;
-
-   status = ev->data;
+   Eina_List *l;
 
-   args = data;
-   ecore_event_handler_del(args->handler);
-
-   args->func(*status, args->data);
-
-   ecore_con_client_send(ev->client, status, sizeof(int));
-
-   free(args);
+   EINA_LIST_FOREACH(_edi_exe_notify_running, l, args)
+     {
+        if (args->pid != ev->pid)
+          continue;
+
+        _edi_exe_notify_running = eina_list_remove_list(_edi_exe_notify_running, l);
+        args->func(ev->signalled ? 128 + ev->exit_signal : ev->exit_code, args->data);
+        eina_stringshare_del(args->name);
+        free(args);
+        break;
+     }
 
-   return ECORE_CALLBACK_DONE;
+   return ECORE_CALLBACK_PASS_ON;
 }
 
 EAPI Eina_Bool
 edi_exe_notify_handle(const char *name, void ((*func)(int, void *)), void *data)
 {
-   Ecore_Con_Server *srv;
    Edi_Exe_Args *args;
+   Eina_List *waiting;
 
-   srv = ecore_con_server_add(ECORE_CON_LOCAL_USER, name, 0, NULL);
-   if (!srv)
-     return EINA_FALSE;
+   if (!_edi_exe_notify_waiting)
+     _edi_exe_notify_waiting = eina_hash_string_superfast_new(NULL);
 
-   args = malloc(sizeof(Edi_Exe_Args));
+   args = calloc(1, sizeof(Edi_Exe_Args));
    args->func = func;
    args->data = data;
-   args->handler = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA, (Ecore_Event_Handler_Cb) _edi_exe_notify_client_data_cb, args);
+   args->name = eina_stringshare_add(name);
+
+   waiting = eina_hash_find(_edi_exe_notify_waiting, name);
+   eina_hash_set(_edi_exe_notify_waiting, name, eina_list_append(waiting, args));
 
    return EINA_TRUE;
 }
 
-static Eina_Bool
-_edi_exe_notify_server_data_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+static Edi_Exe_Args *
+_edi_exe_notify_args_take(const char *name)
 {
    Edi_Exe_Args *args;
-   char *path;
-   Ecore_Con_Event_Server_Data *ev = event;
+   Eina_List *waiting;
 
-   path = ecore_con_local_path_new(ECORE_CON_LOCAL_USER, ecore_con_server_name_get(ev->server), 0);
+   if (!_edi_exe_notify_waiting)
+     return NULL;
 
-   args = data;
+   waiting = eina_hash_find(_edi_exe_notify_waiting, name);
+   if (!waiting)
+     return NULL;
 
-   ecore_event_handler_del(args->handler);
-   ecore_con_server_del(ev->server);
+   args = eina_list_data_get(waiting);
+   waiting = eina_list_remove_list(waiting, waiting);
+   if (waiting)
+     eina_hash_modify(_edi_exe_notify_waiting, name, waiting);
+   else
+     eina_hash_del_by_key(_edi_exe_notify_waiting, name);
 
-   // FIXME: workaround.
-   if (path)
-     {
-        if (ecore_file_exists(path))
-          unlink(path);
+   return args;
+}
 
-        free(path);
-     }
+EAPI Eina_Bool
+edi_exe_notify_handle_del(const char *name, void ((*func)(int, void *)), void *data)
+{
+   Edi_Exe_Args *args;
+   Eina_List *waiting, *l;
 
-   free(args);
+   if (!_edi_exe_notify_waiting)
+     return EINA_FALSE;
 
-   return ECORE_CALLBACK_DONE;
+   waiting = eina_hash_find(_edi_exe_notify_waiting, name);
+   EINA_LIST_FOREACH(waiting, l, args)
+     {
+        if (args->func != func || args->data != data)
+          continue;
+
+        waiting = eina_list_remove_list(waiting, l);
+        if (waiting)
+          eina_hash_modify(_edi_exe_notify_waiting, name, waiting);
+        else
+          eina_hash_del_by_key(_edi_exe_notify_waiting, name);
+
+        eina_stringshare_del(args->name);
+        free(args);
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
 }
 
-static Eina_Bool
-_edi_exe_event_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+const char *
+_edi_exe_notify_running_name_get(pid_t pid)
 {
-  Ecore_Exe_Event_Del *ev;
-  const char *name;
-  Ecore_Con_Server *srv;
-  Edi_Exe_Args *args = data;
+   Edi_Exe_Args *args;
+   Eina_List *l;
 
-  ev = event;
+   EINA_LIST_FOREACH(_edi_exe_notify_running, l, args)
+     {
+        if (args->pid == pid)
+          return args->name;
+     }
+
+   return NULL;
+}
 
-  if (!ev->exe) return ECORE_CALLBACK_RENEW;
-  if (ecore_exe_pid_get(ev->exe) != args->pid) return ECORE_CALLBACK_RENEW;
+EAPI Eina_Bool
+edi_exe_notify_terminate(const char *name)
+{
+   Edi_Exe_Args *args;
+   Eina_List *l;
+   Eina_Bool found = EINA_FALSE;
 
-  name = args->data;
+   EINA_LIST_FOREACH(_edi_exe_notify_running, l, args)
+     {
+        if (strcmp(args->name, name))
+          continue;
 
-  srv = ecore_con_server_connect(ECORE_CON_LOCAL_USER, name, 0, NULL);
-  if (srv)
-    {
-       ecore_event_handler_del(args->handler);
-       args->handler = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA, _edi_exe_notify_server_data_cb, args);
-       ecore_con_server_send(srv, &ev->exit_code, sizeof(int));
-       ecore_con_server_flush(srv);
-    }
-  else
-    {
-       ecore_event_handler_del(args->handler);
-       free(args);
-    }
+        // Ecore makes each command a session leader, so this reaches everything it started.
+        kill(-args->pid, SIGTERM);
+        found = EINA_TRUE;
+     }
 
-  return ECORE_CALLBACK_DONE;
+   return found;
 }
 
 EAPI void
@@ -128,59 +167,606 @@ edi_exe_notify(const char *name, const char *command)
                       ECORE_EXE_PIPE_ERROR_LINE_BUFFERED | ECORE_EXE_PIPE_ERROR |
                       ECORE_EXE_PIPE_WRITE | ECORE_EXE_USE_SH, NULL);
 
-   args = malloc(sizeof(Edi_Exe_Args));
-   args->data = (char *)name;
+   args = _edi_exe_notify_args_take(name);
+   if (!args)
+     return;
+
+   if (!exe)
+     {
+        args->func(-1, args->data);
+        eina_stringshare_del(args->name);
+        free(args);
+        return;
+     }
+
+   if (!_edi_exe_notify_handler)
+     _edi_exe_notify_handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_exe_notify_done_cb, NULL);
+
    args->pid = ecore_exe_pid_get(exe);
-   args->handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_exe_event_done_cb, args);
+   _edi_exe_notify_running = eina_list_append(_edi_exe_notify_running, args);
 }
 
 EAPI int
 edi_exe_wait(const char *command)
 {
+   return edi_exe_wait_in(NULL, command);
+}
+
+EAPI char *
+edi_exe_response(const char *command)
+{
+   return edi_exe_response_in(NULL, command);
+}
+
+// Only async-signal-safe calls are made in the child, we may be forked from a thread.
+static pid_t
+_edi_exe_spawn(const char *dir, const char *command, int out, int err, char **envp,
+               Eina_Bool group)
+{
+   char *argv[] = { "sh", "-c", (char *) command, NULL };
    pid_t pid;
-   Ecore_Exe *exe;
-   int exit;
+   int null;
 
-   ecore_thread_main_loop_begin();
-   exe = ecore_exe_pipe_run(command,
-                            ECORE_EXE_PIPE_READ_LINE_BUFFERED | ECORE_EXE_PIPE_READ |
-                            ECORE_EXE_PIPE_ERROR_LINE_BUFFERED | ECORE_EXE_PIPE_ERROR |
-                            ECORE_EXE_PIPE_WRITE | ECORE_EXE_USE_SH, NULL);
-   pid = ecore_exe_pid_get(exe);
-   ecore_thread_main_loop_end();
+   pid = fork();
+   if (pid > 0 && group)
+     setpgid(pid, pid);
+   if (pid != 0)
+     return pid;
 
-   waitpid(pid, &exit, 0);
-   return exit;
+   // A group of its own lets a cancel reach whatever the shell started.
+   if (group)
+     setpgid(0, 0);
+
+   if (dir && chdir(dir))
+     _exit(127);
+
+   null = open("/dev/null", O_RDWR);
+   if (null >= 0)
+     {
+        dup2(null, STDIN_FILENO);
+        if (out < 0)
+          {
+             dup2(null, STDOUT_FILENO);
+             dup2(null, STDERR_FILENO);
+          }
+     }
+   if (out >= 0)
+     dup2(out, STDOUT_FILENO);
+   if (err >= 0)
+     dup2(err, STDERR_FILENO);
+
+   if (envp)
+     execve("/bin/sh", argv, envp);
+   else
+     execv("/bin/sh", argv);
+   _exit(127);
 }
 
-EAPI char *
-edi_exe_response(const char *command)
+typedef struct _Edi_Exe_Exit {
+   int status;
+   Eina_Bool exited;
+} Edi_Exe_Exit;
+
+// Commands run by the blocking calls that are still to be reaped, by pid.
+static Eina_Hash *_edi_exe_reaping = NULL;
+static Ecore_Event_Handler *_edi_exe_reap_handler = NULL;
+static Eina_Lock _edi_exe_reap_lock;
+static Eina_Condition _edi_exe_reap_cond;
+
+// Ecore reaps every child on SIGCHLD, so it may beat a thread blocked in waitpid.
+static Eina_Bool
+_edi_exe_reaped_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
 {
-   FILE *p;
-   char buf[8192];
-   Eina_Strbuf *lines;
-   char *out;
+   Ecore_Exe_Event_Del *ev = event;
+   Edi_Exe_Exit *reaped;
+
+   eina_lock_take(&_edi_exe_reap_lock);
+   reaped = eina_hash_find(_edi_exe_reaping, &ev->pid);
+   if (reaped)
+     {
+        // Encoded the way waitpid would have returned it.
+        reaped->status = ev->signalled ? ev->exit_signal : (ev->exit_code & 0xff) << 8;
+        reaped->exited = EINA_TRUE;
+        eina_condition_broadcast(&_edi_exe_reap_cond);
+     }
+   eina_lock_release(&_edi_exe_reap_lock);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+void
+_edi_exe_init(void)
+{
+   eina_lock_new(&_edi_exe_reap_lock);
+   eina_condition_new(&_edi_exe_reap_cond, &_edi_exe_reap_lock);
+   _edi_exe_reaping = eina_hash_int32_new(free);
+   _edi_exe_reap_handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_exe_reaped_cb, NULL);
+}
+
+void
+_edi_exe_shutdown(void)
+{
+   if (!_edi_exe_reaping)
+     return;
+
+   ecore_event_handler_del(_edi_exe_reap_handler);
+   _edi_exe_reap_handler = NULL;
+   eina_hash_free(_edi_exe_reaping);
+   _edi_exe_reaping = NULL;
+   eina_condition_free(&_edi_exe_reap_cond);
+   eina_lock_free(&_edi_exe_reap_lock);
+}
+
+// The pid is registered before the main loop can see the child exit.
+static pid_t
+_edi_exe_spawn_waited(const char *dir, const char *command, int out, int err, Eina_Bool group)
+{
+   pid_t pid;
+
+   if (!_edi_exe_reaping)
+     return _edi_exe_spawn(dir, command, out, err, NULL, group);
+
+   eina_lock_take(&_edi_exe_reap_lock);
+   pid = _edi_exe_spawn(dir, command, out, err, NULL, group);
+   if (pid > 0)
+     eina_hash_add(_edi_exe_reaping, &pid, calloc(1, sizeof(Edi_Exe_Exit)));
+   eina_lock_release(&_edi_exe_reap_lock);
+
+   return pid;
+}
+
+static int
+_edi_exe_reap(pid_t pid)
+{
+   Edi_Exe_Exit *reaped;
+   int status;
+
+   while (waitpid(pid, &status, 0) < 0)
+     {
+        if (errno == EINTR)
+          continue;
+
+        status = -1;
+        break;
+     }
+
+   if (!_edi_exe_reaping)
+     return status;
+
+   eina_lock_take(&_edi_exe_reap_lock);
+   reaped = eina_hash_find(_edi_exe_reaping, &pid);
+
+   // The main loop reaped it first, its exit is on the way as an event.
+   // The main loop cannot reap while it is blocked here, so only threads wait.
+   if (reaped && status < 0 && !eina_main_loop_is())
+     {
+        while (!reaped->exited)
+          eina_condition_wait(&_edi_exe_reap_cond);
+     }
+   if (reaped && reaped->exited)
+     status = reaped->status;
+
+   eina_hash_del_by_key(_edi_exe_reaping, &pid);
+   eina_lock_release(&_edi_exe_reap_lock);
+
+   return status;
+}
+
+EAPI int
+edi_exe_wait_in(const char *dir, const char *command)
+{
+   pid_t pid;
+
+   pid = _edi_exe_spawn_waited(dir, command, -1, -1, EINA_FALSE);
+   if (pid < 0)
+     return -1;
+
+   return _edi_exe_reap(pid);
+}
+
+static Eina_Strbuf *
+_edi_exe_output_read(const char *dir, const char *command)
+{
+   Eina_Strbuf *output;
+   char buf[65536];
    ssize_t len;
+   pid_t pid;
+   int fds[2];
 
-   p = popen(command, "r");
-   if (!p)
+   if (pipe(fds))
      return NULL;
 
-   lines = eina_strbuf_new();
+   // Keep other threads' children from holding our pipe open.
+   fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+   fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+   pid = _edi_exe_spawn_waited(dir, command, fds[1], -1, EINA_FALSE);
+   close(fds[1]);
+   if (pid < 0)
+     {
+        close(fds[0]);
+        return NULL;
+     }
 
-   while ((fgets(buf, sizeof(buf), p)) != NULL)
+   output = eina_strbuf_new();
+   while ((len = read(fds[0], buf, sizeof(buf))) != 0)
      {
-        eina_strbuf_append(lines, buf);
+        if (len < 0)
+          {
+             if (errno == EINTR)
+               continue;
+             break;
+          }
+
+        eina_strbuf_append_length(output, buf, len);
      }
+   close(fds[0]);
 
-   pclose(p);
+   _edi_exe_reap(pid);
 
-   len = eina_strbuf_length_get(lines);
-   eina_strbuf_remove(lines, len - 1, len);
+   return output;
+}
+
+EAPI char *
+edi_exe_response_in(const char *dir, const char *command)
+{
+   Eina_Strbuf *lines;
+   char *out;
+   size_t len;
 
-   out = strdup(eina_strbuf_string_get(lines));
+   lines = _edi_exe_output_read(dir, command);
+   if (!lines)
+     return NULL;
+
+   len = eina_strbuf_length_get(lines);
+   if (len && eina_strbuf_string_get(lines)[len - 1] == '\n')
+     eina_strbuf_remove(lines, len - 1, len);
 
+   out = eina_strbuf_string_steal(lines);
    eina_strbuf_free(lines);
 
    return out;
 }
+
+EAPI char *
+edi_exe_output_in(const char *dir, const char *command, size_t *length)
+{
+   Eina_Strbuf *output;
+   char *out;
+
+   output = _edi_exe_output_read(dir, command);
+   if (!output)
+     return NULL;
+
+   if (length)
+     *length = eina_strbuf_length_get(output);
+   out = eina_strbuf_string_steal(output);
+   eina_strbuf_free(output);
+
+   return out;
+}
+
+static const char *
+_edi_exe_line_end(const char *start, const char *end, Eina_Bool progress)
+{
+   const char *pos;
+
+   if (!progress)
+     return memchr(start, '\n', end - start);
+
+   for (pos = start; pos < end; pos++)
+     {
+        if (*pos == '\n' || *pos == '\r')
+          return pos;
+     }
+
+   return NULL;
+}
+
+static int
+_edi_exe_lines_read(const char *dir, const char *command, Eina_Bool progress,
+                    Edi_Exe_Started_Cb started_cb, Edi_Exe_Line_Cb cb, void *data)
+{
+   Eina_Strbuf *partial;
+   char buf[8192];
+   const char *start, *end, *pos;
+   ssize_t len;
+   pid_t pid;
+   int fds[2];
+   Eina_Bool stopped = EINA_FALSE;
+
+   if (pipe(fds))
+     return -1;
+
+   fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+   fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+   pid = _edi_exe_spawn_waited(dir, command, fds[1], progress ? fds[1] : -1, progress);
+   close(fds[1]);
+   if (pid < 0)
+     {
+        close(fds[0]);
+        return -1;
+     }
+
+   if (started_cb)
+     started_cb(data, pid);
+
+   partial = eina_strbuf_new();
+   while (!stopped && (len = read(fds[0], buf, sizeof(buf))) != 0)
+     {
+        if (len < 0)
+          {
+             if (errno == EINTR)
+               continue;
+             break;
+          }
+
+        start = buf;
+        end = buf + len;
+        while (!stopped && (pos = _edi_exe_line_end(start, end, progress)))
+          {
+             if (eina_strbuf_length_get(partial))
+               {
+                  eina_strbuf_append_length(partial, start, pos - start);
+                  stopped = !cb(data, eina_strbuf_string_get(partial),
+                                eina_strbuf_length_get(partial));
+                  eina_strbuf_reset(partial);
+               }
+             else if (!progress || pos > start)
+               stopped = !cb(data, start, pos - start);
+
+             start = pos + 1;
+          }
+
+        if (!stopped && start < end)
+          eina_strbuf_append_length(partial, start, end - start);
+     }
+
+   if (!stopped && eina_strbuf_length_get(partial))
+     cb(data, eina_strbuf_string_get(partial), eina_strbuf_length_get(partial));
+
+   if (stopped)
+     kill(progress ? -pid : pid, SIGTERM);
+
+   close(fds[0]);
+   eina_strbuf_free(partial);
+
+   return _edi_exe_reap(pid);
+}
+
+EAPI int
+edi_exe_lines_in(const char *dir, const char *command, Edi_Exe_Line_Cb cb, void *data)
+{
+   return _edi_exe_lines_read(dir, command, EINA_FALSE, NULL, cb, data);
+}
+
+EAPI int
+edi_exe_progress_in(const char *dir, const char *command, Edi_Exe_Started_Cb started_cb,
+                    Edi_Exe_Line_Cb cb, void *data)
+{
+   return _edi_exe_lines_read(dir, command, EINA_TRUE, started_cb, cb, data);
+}
+
+struct _Edi_Exe_Process {
+   pid_t pid;
+   int code;
+   Eina_Bool exited, timed_out;
+
+   Ecore_Fd_Handler *out, *err;
+   Ecore_Event_Handler *handler;
+   Ecore_Timer *timer;
+
+   Edi_Exe_Data_Cb data_cb;
+   Edi_Exe_Done_Cb done_cb;
+   void *data;
+};
+
+static Eina_Bool
+_edi_exe_environ_overridden(const char *var, const char * const *env)
+{
+   size_t len;
+
+   for (; *env; env++)
+     {
+        len = strcspn(*env, "=");
+        if (!strncmp(var, *env, len) && var[len] == '=')
+          return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+// The environment is built before forking, the child only has to exec it.
+static char **
+_edi_exe_environ_new(const char * const *env)
+{
+   extern char **environ;
+   char **envp;
+   int count = 0, i = 0, j;
+
+   for (j = 0; environ[j]; j++)
+     count++;
+   for (j = 0; env[j]; j++)
+     count++;
+
+   envp = malloc((count + 1) * sizeof(char *));
+   for (j = 0; environ[j]; j++)
+     {
+        if (!_edi_exe_environ_overridden(environ[j], env))
+          envp[i++] = environ[j];
+     }
+   for (j = 0; env[j]; j++)
+     {
+        if (strchr(env[j], '='))
+          envp[i++] = (char *) env[j];
+     }
+   envp[i] = NULL;
+
+   return envp;
+}
+
+static void
+_edi_exe_process_finish(Edi_Exe_Process *process)
+{
+   if (!process->exited || process->out || process->err)
+     return;
+
+   if (process->timer)
+     ecore_timer_del(process->timer);
+   ecore_event_handler_del(process->handler);
+
+   if (process->done_cb)
+     process->done_cb(process->data, process->code, process->timed_out);
+
+   free(process);
+}
+
+static Eina_Bool
+_edi_exe_process_read_cb(void *data, Ecore_Fd_Handler *handler)
+{
+   Edi_Exe_Process *process = data;
+   Edi_Exe_Stream stream;
+   char buf[65536];
+   ssize_t len;
+   int fd;
+
+   fd = ecore_main_fd_handler_fd_get(handler);
+   stream = handler == process->out ? EDI_EXE_STREAM_OUTPUT : EDI_EXE_STREAM_ERROR;
+
+   len = read(fd, buf, sizeof(buf));
+   if (len < 0 && (errno == EINTR || errno == EAGAIN))
+     return ECORE_CALLBACK_RENEW;
+
+   if (len > 0)
+     {
+        process->data_cb(process->data, stream, buf, len);
+        return ECORE_CALLBACK_RENEW;
+     }
+
+   close(fd);
+   if (stream == EDI_EXE_STREAM_OUTPUT)
+     process->out = NULL;
+   else
+     process->err = NULL;
+
+   _edi_exe_process_finish(process);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+// Ecore reaps every child on SIGCHLD, so the exit arrives as an event rather than from waitpid.
+static Eina_Bool
+_edi_exe_process_exit_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   Edi_Exe_Process *process = data;
+   Ecore_Exe_Event_Del *ev = event;
+
+   if (ev->pid != process->pid)
+     return ECORE_CALLBACK_RENEW;
+
+   process->code = ev->signalled ? 128 + ev->exit_signal : ev->exit_code;
+   process->exited = EINA_TRUE;
+
+   _edi_exe_process_finish(process);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static Eina_Bool
+_edi_exe_process_timeout_cb(void *data)
+{
+   Edi_Exe_Process *process = data;
+
+   process->timer = NULL;
+   process->timed_out = EINA_TRUE;
+   kill(-process->pid, SIGTERM);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Ecore_Fd_Handler *
+_edi_exe_process_watch(Edi_Exe_Process *process, int fd)
+{
+   fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+   return ecore_main_fd_handler_add(fd, ECORE_FD_READ | ECORE_FD_ERROR,
+                                    _edi_exe_process_read_cb, process, NULL, NULL);
+}
+
+EAPI Edi_Exe_Process *
+edi_exe_run(const char *dir, const char * const *env, const char *command, double timeout,
+            Edi_Exe_Data_Cb data_cb, Edi_Exe_Done_Cb done_cb, void *data)
+{
+   Edi_Exe_Process *process;
+   char **envp = NULL;
+   int out[2] = { -1, -1 }, err[2] = { -1, -1 };
+
+   if (data_cb && (pipe(out) || pipe(err)))
+     goto error;
+
+   if (data_cb)
+     {
+        fcntl(out[0], F_SETFD, FD_CLOEXEC);
+        fcntl(out[1], F_SETFD, FD_CLOEXEC);
+        fcntl(err[0], F_SETFD, FD_CLOEXEC);
+        fcntl(err[1], F_SETFD, FD_CLOEXEC);
+     }
+
+   if (env)
+     envp = _edi_exe_environ_new(env);
+
+   process = calloc(1, sizeof(Edi_Exe_Process));
+   process->data_cb = data_cb;
+   process->done_cb = done_cb;
+   process->data = data;
+
+   process->pid = _edi_exe_spawn(dir, command, out[1], err[1], envp, EINA_TRUE);
+   free(envp);
+   if (process->pid < 0)
+     {
+        free(process);
+        goto error;
+     }
+
+   if (data_cb)
+     {
+        close(out[1]);
+        close(err[1]);
+        process->out = _edi_exe_process_watch(process, out[0]);
+        process->err = _edi_exe_process_watch(process, err[0]);
+     }
+
+   process->handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_exe_process_exit_cb, process);
+   if (timeout > 0.0)
+     process->timer = ecore_timer_add(timeout, _edi_exe_process_timeout_cb, process);
+
+   return process;
+
+error:
+   if (out[0] >= 0)
+     {
+        close(out[0]);
+        close(out[1]);
+     }
+   if (err[0] >= 0)
+     {
+        close(err[0]);
+        close(err[1]);
+     }
+
+   return NULL;
+}
+
+EAPI pid_t
+edi_exe_process_pid_get(const Edi_Exe_Process *process)
+{
+   return process->pid;
+}
+
+EAPI void
+edi_exe_process_cancel(Edi_Exe_Process *process)
+{
+   if (!process->exited)
+     kill(-process->pid, SIGTERM);
+}
@@ -1,6 +1,8 @@
 #ifndef EDI_EXE_H_
 # define EDI_EXE_H_
 
+#include <sys/types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,6 +12,56 @@ extern "C" {
  * @brief These routines are used for Edi executable management.
  */
 
+/**
+ * Called for each line of output read from a child process.
+ *
+ * @param data The data passed when starting the command.
+ * @param line The line without its trailing newline, not NUL terminated.
+ * @param length The length of the line in bytes.
+ * @return EINA_FALSE to stop reading and terminate the child.
+ */
+typedef Eina_Bool (*Edi_Exe_Line_Cb)(void *data, const char *line, size_t length);
+
+/**
+ * Called once a child process is running, before any of its output is read.
+ *
+ * @param data The data passed when starting the command.
+ * @param pid The process id of the child, which also leads its process group.
+ */
+typedef void (*Edi_Exe_Started_Cb)(void *data, pid_t pid);
+
+/**
+ * The output streams of a child process.
+ */
+typedef enum {
+   EDI_EXE_STREAM_OUTPUT,
+   EDI_EXE_STREAM_ERROR,
+} Edi_Exe_Stream;
+
+/**
+ * A child process started by edi_exe_run.
+ */
+typedef struct _Edi_Exe_Process Edi_Exe_Process;
+
+/**
+ * Called each time a child process writes to one of its output streams.
+ *
+ * @param data The data passed when starting the command.
+ * @param stream The stream the output was written to.
+ * @param buf The output read, only valid until the callback returns.
+ * @param length The length of the output in bytes.
+ */
+typedef void (*Edi_Exe_Data_Cb)(void *data, Edi_Exe_Stream stream, const char *buf, size_t length);
+
+/**
+ * Called once a child process has exited and all of its output was passed on.
+ *
+ * @param data The data passed when starting the command.
+ * @param code The exit code of the command, or 128 plus the signal number that killed it.
+ * @param timed_out Whether the command was terminated for running too long.
+ */
+typedef void (*Edi_Exe_Done_Cb)(void *data, int code, Eina_Bool timed_out);
+
 /**
  * @brief Executable helpers
  * @defgroup Exe
@@ -40,9 +92,135 @@ EAPI int edi_exe_wait(const char *command);
  */
 EAPI char *edi_exe_response(const char *command);
 
+/**
+ * Run an executable command in a directory and wait for it to return.
+ *
+ * The working directory is only changed in the child, so this is safe to
+ * call from several threads at once.
+ *
+ * @param dir The directory to run the command in, or NULL for the current one.
+ * @param command The command to execute in a child process.
+ * @return The return code of the executable.
+ *
+ * @ingroup Exe
+ */
+EAPI int edi_exe_wait_in(const char *dir, const char *command);
+
+/**
+ * Run an executable command in a directory and return command string.
+ *
+ * The working directory is only changed in the child, so this is safe to
+ * call from several threads at once.
+ *
+ * @param dir The directory to run the command in, or NULL for the current one.
+ * @param command The command to execute in a child process.
+ * @return The output string of the command.
+ *
+ * @ingroup Exe
+ */
+EAPI char *edi_exe_response_in(const char *dir, const char *command);
+
+/**
+ * Run an executable command in a directory and return all of its output.
+ *
+ * Unlike edi_exe_response_in the output is returned as is, so it may hold
+ * NUL bytes and keeps its final newline.
+ *
+ * @param dir The directory to run the command in, or NULL for the current one.
+ * @param command The command to execute in a child process.
+ * @param length Where to store the length of the output in bytes, or NULL.
+ * @return The NUL terminated output of the command, or NULL if it could not run.
+ *
+ * @ingroup Exe
+ */
+EAPI char *edi_exe_output_in(const char *dir, const char *command, size_t *length);
+
+/**
+ * Run an executable command in a directory and pass its output line by line.
+ *
+ * The output is handed to the callback as it is read, so large outputs are
+ * never held in memory at once.
+ *
+ * @param dir The directory to run the command in, or NULL for the current one.
+ * @param command The command to execute in a child process.
+ * @param cb The function called for each line of output.
+ * @param data The data passed to the callback.
+ * @return The return code of the executable.
+ *
+ * @ingroup Exe
+ */
+EAPI int edi_exe_lines_in(const char *dir, const char *command, Edi_Exe_Line_Cb cb, void *data);
+
+/**
+ * Run an executable command in a directory and pass its progress output line by line.
+ *
+ * Standard error is merged into the output and a carriage return also ends
+ * a line, so each redraw of a progress meter is passed on as it happens.
+ * The child leads a process group of its own, signalling -pid reaches every
+ * process it started.
+ *
+ * @param dir The directory to run the command in, or NULL for the current one.
+ * @param command The command to execute in a child process.
+ * @param started_cb The function called with the child pid once it runs, or NULL.
+ * @param cb The function called for each line of output.
+ * @param data The data passed to the callbacks.
+ * @return The return code of the executable.
+ *
+ * @ingroup Exe
+ */
+EAPI int edi_exe_progress_in(const char *dir, const char *command, Edi_Exe_Started_Cb started_cb,
+                             Edi_Exe_Line_Cb cb, void *data);
+
+/**
+ * Start an executable command without waiting for it.
+ *
+ * The output is read by the main loop and handed over in the chunks it was
+ * read in, without being copied. The child leads a process group of its
+ * own so a cancel or timeout terminates everything it started.
+ * This must be called from the main loop.
+ *
+ * @param dir The directory to run the command in, or NULL for the current one.
+ * @param env A NULL terminated array of "NAME=value" entries to set, or "NAME"
+ *            to unset, in the environment of the child. NULL to inherit ours.
+ * @param command The command to execute in a child process.
+ * @param timeout The seconds after which the command is terminated, 0 for none.
+ * @param data_cb The function called with output, or NULL to discard it.
+ * @param done_cb The function called once the command has completed, or NULL.
+ * @param data The data passed to the callbacks.
+ * @return The running process, valid until done_cb returns, or NULL if it could not start.
+ *
+ * @ingroup Exe
+ */
+EAPI Edi_Exe_Process *edi_exe_run(const char *dir, const char * const *env, const char *command,
+                                  double timeout, Edi_Exe_Data_Cb data_cb,
+                                  Edi_Exe_Done_Cb done_cb, void *data);
+
+/**
+ * Get the process id of a running command, which also identifies its process group.
+ *
+ * @param process The process started by edi_exe_run.
+ * @return The process id of the child.
+ *
+ * @ingroup Exe
+ */
+EAPI pid_t edi_exe_process_pid_get(const Edi_Exe_Process *process);
+
+/**
+ * Terminate a running command and every process it started.
+ *
+ * The done callback is still called once the command has exited.
+ *
+ * @param process The process started by edi_exe_run.
+ *
+ * @ingroup Exe
+ */
+EAPI void edi_exe_process_cancel(Edi_Exe_Process *process);
+
 /**
  * Run an executable command with notifcation enabled.
  *
+ * The oldest handler waiting on the name is called once the command exits.
+ *
  * @param name The name of the resource used to identify the notification.
  * @param command The command to execute in a child process.
  *
@@ -51,17 +229,44 @@ EAPI char *edi_exe_response(const char *command);
 EAPI void edi_exe_notify(const char *name, const char *command);
 
 /**
- * This function is used to set a callback that will execute when an
- * edi_exe_response has terminated and supplied its exit status.
+ * This function is used to set a callback that will execute when the next
+ * edi_exe_notify of the same name has terminated and supplied its exit status.
+ *
+ * Handlers are queued per name, so commands sharing a name each notify their own.
  *
  * @param name The name of the resource used to identify the notification.
  * @param func Function that will execute upon receiving exit code of exe.
  * @param data Additional data to pass to the callback.
+ * @return EINA_TRUE once the handler is registered.
  *
  * @ingroup Exe
  */
 EAPI Eina_Bool edi_exe_notify_handle(const char *name, void ((*func)(int, void *)), void *data);
 
+/**
+ * Remove a handler that is still waiting for a command to start.
+ *
+ * @param name The name the handler was registered with.
+ * @param func The function passed to edi_exe_notify_handle.
+ * @param data The data passed to edi_exe_notify_handle.
+ * @return EINA_TRUE if the handler was waiting, EINA_FALSE if it was already taken by a command.
+ *
+ * @ingroup Exe
+ */
+EAPI Eina_Bool edi_exe_notify_handle_del(const char *name, void ((*func)(int, void *)), void *data);
+
+/**
+ * Terminate the running notified commands of a name and every process they started.
+ *
+ * Only commands that took a handler are known, their handlers are still called once they exit.
+ *
+ * @param name The name of the resource used to identify the notification.
+ * @return EINA_TRUE if a command was signalled.
+ *
+ * @ingroup Exe
+ */
+EAPI Eina_Bool edi_exe_notify_terminate(const char *name);
+
 /**
  * @}
  */
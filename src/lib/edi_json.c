@@ -0,0 +1,185 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+const char *
+_edi_json_space_skip(const char *pos, const char *end)
+{
+   while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r'))
+     pos++;
+
+   return pos;
+}
+
+static void
+_edi_json_utf8_append(Eina_Strbuf *buf, unsigned int code)
+{
+   if (code < 0x80)
+     {
+        eina_strbuf_append_char(buf, code);
+     }
+   else if (code < 0x800)
+     {
+        eina_strbuf_append_char(buf, 0xc0 | (code >> 6));
+        eina_strbuf_append_char(buf, 0x80 | (code & 0x3f));
+     }
+   else
+     {
+        eina_strbuf_append_char(buf, 0xe0 | (code >> 12));
+        eina_strbuf_append_char(buf, 0x80 | ((code >> 6) & 0x3f));
+        eina_strbuf_append_char(buf, 0x80 | (code & 0x3f));
+     }
+}
+
+// Read a JSON string at pos, leaving pos after its closing quote.
+char *
+_edi_json_string_read(const char **pos, const char *end)
+{
+   Eina_Strbuf *buf;
+   const char *ptr = *pos;
+   char hex[5];
+
+   if (ptr >= end || *ptr != '"')
+     return NULL;
+
+   buf = eina_strbuf_new();
+   for (ptr++; ptr < end && *ptr != '"'; ptr++)
+     {
+        if (*ptr != '\\')
+          {
+             eina_strbuf_append_char(buf, *ptr);
+             continue;
+          }
+
+        if (++ptr == end)
+          break;
+
+        switch (*ptr)
+          {
+           case 'b': eina_strbuf_append_char(buf, '\b'); break;
+           case 'f': eina_strbuf_append_char(buf, '\f'); break;
+           case 'n': eina_strbuf_append_char(buf, '\n'); break;
+           case 'r': eina_strbuf_append_char(buf, '\r'); break;
+           case 't': eina_strbuf_append_char(buf, '\t'); break;
+           case 'u':
+             if (end - ptr < 5)
+               {
+                  ptr = end;
+                  break;
+               }
+             memcpy(hex, ptr + 1, 4);
+             hex[4] = '\0';
+             _edi_json_utf8_append(buf, strtoul(hex, NULL, 16));
+             ptr += 4;
+             break;
+           default: eina_strbuf_append_char(buf, *ptr); break;
+          }
+     }
+
+   if (ptr >= end)
+     {
+        eina_strbuf_free(buf);
+        return NULL;
+     }
+
+   *pos = ptr + 1;
+   return eina_strbuf_release(buf);
+}
+
+// Skip a JSON value we are not interested in, nested or not.
+Eina_Bool
+_edi_json_value_skip(const char **pos, const char *end)
+{
+   const char *ptr = *pos;
+   char *string;
+   int depth = 0;
+
+   while (ptr < end)
+     {
+        if (*ptr == '"')
+          {
+             string = _edi_json_string_read(&ptr, end);
+             if (!string)
+               return EINA_FALSE;
+             free(string);
+          }
+        else if (*ptr == '[' || *ptr == '{')
+          {
+             depth++;
+             ptr++;
+          }
+        else if (*ptr == ']' || *ptr == '}')
+          {
+             if (!depth)
+               break;
+             depth--;
+             ptr++;
+          }
+        else if (*ptr == ',' && !depth)
+          break;
+        else
+          ptr++;
+
+        if (!depth && (ptr >= end || *ptr == ',' || *ptr == ']' || *ptr == '}'))
+          break;
+     }
+
+   *pos = ptr;
+   return ptr < end;
+}
+
+// Find the value of a key in a JSON object, strings are unquoted and other values kept as written.
+char *
+_edi_json_field_get(const char *json, size_t length, const char *key)
+{
+   const char *ptr = json, *end = json + length, *value;
+   char *name;
+   Eina_Bool found;
+
+   ptr = _edi_json_space_skip(ptr, end);
+   if (ptr >= end || *ptr != '{')
+     return NULL;
+   ptr++;
+
+   while (1)
+     {
+        ptr = _edi_json_space_skip(ptr, end);
+        name = _edi_json_string_read(&ptr, end);
+        if (!name)
+          return NULL;
+
+        found = !strcmp(name, key);
+        free(name);
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != ':')
+          return NULL;
+        ptr = _edi_json_space_skip(ptr + 1, end);
+
+        if (found && ptr < end && *ptr == '"')
+          return _edi_json_string_read(&ptr, end);
+
+        value = ptr;
+        if (!_edi_json_value_skip(&ptr, end))
+          return NULL;
+        if (found)
+          {
+             while (ptr > value && (ptr[-1] == ' ' || ptr[-1] == '\t' || ptr[-1] == '\n' || ptr[-1] == '\r'))
+               ptr--;
+             return strndup(value, ptr - value);
+          }
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != ',')
+          return NULL;
+        ptr++;
+     }
+}
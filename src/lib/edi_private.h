@@ -7,6 +7,39 @@
 extern int _edi_lib_log_dom;
 char *edi_create_escape_quotes(const char *in);
 
+struct _Edi_Scm_Status *_edi_scm_status_parse_line(char *line);
+void _edi_scm_status_fill(struct _Edi_Scm_Status *status, const char *change, const char *path, size_t length);
+Edi_Scm_Status_Code _edi_scm_status_code_get(const char *change, Eina_Bool *staged);
+
+void _edi_build_provider_init(void);
+void _edi_build_provider_shutdown(void);
+void _edi_build_queue_shutdown(void);
+void _edi_test_runner_shutdown(void);
+void _edi_build_server_shutdown(void);
+void _edi_compile_command_shutdown(void);
+
+const char *_edi_build_queue_job_name_get(const Edi_Build_Job *job);
+Eina_Bool _edi_build_queue_job_covers(const Edi_Build_Job *job, Edi_Build_Job_Type type, const char *path);
+Eina_Bool _edi_build_queue_pending_covers(Edi_Build_Job_Type type, const char *path);
+void _edi_build_server_job_started(const Edi_Build_Job *job);
+void _edi_build_server_job_done(const Edi_Build_Job *job, int status);
+void _edi_build_server_output(const char *line, Eina_Bool err);
+const char *_edi_exe_notify_running_name_get(pid_t pid);
+void _edi_exe_init(void);
+void _edi_exe_shutdown(void);
+
+const char *_edi_json_space_skip(const char *pos, const char *end);
+char *_edi_json_string_read(const char **pos, const char *end);
+Eina_Bool _edi_json_value_skip(const char **pos, const char *end);
+char *_edi_json_field_get(const char *json, size_t length, const char *key);
+
+#if HAVE_LIBGIT2
+struct _Edi_Scm_Engine;
+
+Eina_Bool _edi_scm_libgit2_setup(struct _Edi_Scm_Engine *engine);
+void _edi_scm_libgit2_shutdown(void);
+#endif
+
 #ifdef ERR
 # undef ERR
 #endif
@@ -2,6 +2,11 @@
 # include "config.h"
 #endif
 
+#include <ctype.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+
 #include <Eina.h>
 #include <Ecore.h>
 #include <Ecore_File.h>
@@ -16,60 +21,79 @@
 
 Edi_Scm_Engine *_edi_scm_global_object = NULL;
 
+typedef struct _Edi_Scm_Status_Snapshot
+{
+   Eina_Hash *statuses; /* Full unescaped path to Edi_Scm_Status_Code */
+   Eina_Hash *dirs;     /* Full unescaped directory to Eina_List of changed paths in it */
+   Eina_List *untracked; /* Untracked directories, full path with a trailing slash */
+   Eina_Bool failed;
+} Edi_Scm_Status_Snapshot;
+
+typedef struct _Edi_Scm_Status_Cache
+{
+   Eina_Hash *statuses;
+   Eina_Hash *dirs;
+   Eina_List *untracked;
+   Eina_List *changed;  /* Paths whose status differs from the previous snapshot */
+   Eina_Bool valid;
+   Eina_Bool dirty;
+   long long index_mtime;
+   Ecore_Thread *thread;
+
+   Edi_Scm_Status_Cache_Cb cb;
+   void *cb_data;
+} Edi_Scm_Status_Cache;
+
+static Edi_Scm_Status_Cache _edi_scm_status_cache;
+
+static void _edi_scm_status_cache_stale(void);
+static void _edi_scm_status_cache_changed_clear(void);
+static void _edi_scm_status_cache_untracked_free(Eina_List *untracked);
+
 static int
 _edi_scm_exec(const char *command)
 {
-   int code;
-   char *oldpwd;
    Edi_Scm_Engine *self = _edi_scm_global_object;
 
    if (!self) return -1;
 
-   oldpwd = getcwd(NULL, PATH_MAX);
+   return edi_exe_wait_in(self->root_directory, command);
+}
 
-   chdir(self->root_directory);
-   code = edi_exe_wait(command);
-   chdir(oldpwd);
+static Eina_Bool
+_edi_scm_exec_print_line_cb(void *data EINA_UNUSED, const char *line, size_t length)
+{
+   printf("%.*s\n", (int) length, line);
+   fflush(stdout);
 
-   free(oldpwd);
+   return EINA_TRUE;
+}
 
-   return code;
+// Commands the user asked for print what they say, edi shows our output in its console.
+static int
+_edi_scm_exec_print(const char *command)
+{
+   Edi_Scm_Engine *self = _edi_scm_global_object;
+
+   if (!self) return -1;
+
+   return edi_exe_progress_in(self->root_directory, command, NULL, _edi_scm_exec_print_line_cb, NULL);
 }
 
 static char *
 _edi_scm_exec_response(const char *command)
 {
-   char *oldpwd, *response;
    Edi_Scm_Engine *self = _edi_scm_global_object;
 
    if (!self) return NULL;
 
-   oldpwd = getcwd(NULL, PATH_MAX);
-
-   chdir(self->root_directory);
-   response = edi_exe_response(command);
-   chdir(oldpwd);
-
-   free(oldpwd);
-
-   return response;
+   return edi_exe_response_in(self->root_directory, command);
 }
 
 EAPI int
 edi_scm_git_new(void)
 {
-   int code;
-   char *oldpwd;
-
-   oldpwd = getcwd(NULL, PATH_MAX);
-
-   chdir(edi_project_get());
-   code = edi_exe_wait("git init .");
-   chdir(oldpwd);
-
-   free(oldpwd);
-
-   return code;
+   return edi_exe_wait_in(edi_project_get(), "git init .");
 }
 
 EAPI int
@@ -169,6 +193,94 @@ _edi_scm_git_file_del(const char *path)
    return code;
 }
 
+// Longest command line built from a path list before git reads the paths from a file instead.
+#define EDI_SCM_PATHS_ARGS_MAX 16384
+
+static int
+_edi_scm_git_paths_exec(const char *command, const Eina_List *paths)
+{
+   Eina_Strbuf *buf;
+   const Eina_List *l;
+   const char *path;
+   Eina_Tmpstr *file = NULL;
+   char *escaped;
+   FILE *f;
+   int fd, code;
+
+   if (!paths)
+     return 0;
+
+   buf = eina_strbuf_new();
+   eina_strbuf_append_printf(buf, "git --literal-pathspecs %s --", command);
+   EINA_LIST_FOREACH(paths, l, path)
+     {
+        escaped = ecore_file_escape_name(path);
+        eina_strbuf_append_printf(buf, " %s", escaped);
+        free(escaped);
+
+        if (eina_strbuf_length_get(buf) > EDI_SCM_PATHS_ARGS_MAX)
+          break;
+     }
+
+   if (l)
+     {
+        fd = eina_file_mkstemp("edi_scm_paths_XXXXXX", &file);
+        if (fd < 0 || !(f = fdopen(fd, "w")))
+          {
+             if (fd >= 0)
+               close(fd);
+             eina_tmpstr_del(file);
+             eina_strbuf_free(buf);
+             return -1;
+          }
+
+        EINA_LIST_FOREACH(paths, l, path)
+          fwrite(path, 1, strlen(path) + 1, f);
+        fclose(f);
+
+        escaped = ecore_file_escape_name(file);
+        eina_strbuf_reset(buf);
+        eina_strbuf_append_printf(buf, "git --literal-pathspecs %s --pathspec-from-file=%s --pathspec-file-nul",
+                                  command, escaped);
+        free(escaped);
+     }
+
+   code = _edi_scm_exec(eina_strbuf_string_get(buf));
+
+   if (file)
+     {
+        ecore_file_unlink(file);
+        eina_tmpstr_del(file);
+     }
+   eina_strbuf_free(buf);
+
+   return code;
+}
+
+static int
+_edi_scm_git_file_stage_list(const Eina_List *paths)
+{
+   return _edi_scm_git_paths_exec("add", paths);
+}
+
+static int
+_edi_scm_git_file_unstage_list(const Eina_List *paths)
+{
+   if (!paths)
+     return 0;
+
+   if (_edi_scm_exec("git remote get-url origin") == 0)
+     return _edi_scm_git_paths_exec("reset -q HEAD", paths);
+   else
+     return _edi_scm_git_paths_exec("rm -q --cached", paths);
+}
+
+static int
+_edi_scm_git_file_del_list(const Eina_List *paths)
+{
+   return _edi_scm_git_paths_exec("rm -q", paths);
+}
+
 static int
 _edi_scm_git_status(void)
 {
@@ -177,76 +289,107 @@ _edi_scm_git_status(void)
 
    eina_strbuf_append(command, "git status");
 
-   code = _edi_scm_exec(eina_strbuf_string_get(command));
+   code = _edi_scm_exec_print(eina_strbuf_string_get(command));
 
    eina_strbuf_free(command);
 
    return code;
 }
 
-static Edi_Scm_Status *
-_parse_line(char *line)
+Edi_Scm_Status_Code
+_edi_scm_status_code_get(const char *change, Eina_Bool *staged)
 {
-   char *esc_path, *path, *fullpath, *change;
-   Edi_Scm_Status *status;
-
-   change = line;
-   line[2] = '\0';
-   path = line + 3;
-
-   status = malloc(sizeof(Edi_Scm_Status));
-   if (!status)
-     return NULL;
-
-   status->staged = EINA_FALSE;
+   *staged = EINA_FALSE;
 
    if (change[0] == 'A' || change[1] == 'A')
      {
-        status->change = EDI_SCM_STATUS_ADDED;
         if (change[0] == 'A')
           {
-            status->staged = status->change = EDI_SCM_STATUS_ADDED_STAGED;
+             *staged = EINA_TRUE;
+             return EDI_SCM_STATUS_ADDED_STAGED;
           }
+        return EDI_SCM_STATUS_ADDED;
      }
    else if (change[0] == 'R' || change[1] == 'R')
      {
-        status->change = EDI_SCM_STATUS_RENAMED;
         if (change[0] == 'R')
           {
-             status->staged = status->change = EDI_SCM_STATUS_RENAMED_STAGED;
+             *staged = EINA_TRUE;
+             return EDI_SCM_STATUS_RENAMED_STAGED;
           }
+        return EDI_SCM_STATUS_RENAMED;
      }
    else if (change[0] == 'M' || change[1] == 'M')
      {
-        status->change = EDI_SCM_STATUS_MODIFIED;
         if (change[0] == 'M')
           {
-             status->staged = status->change = EDI_SCM_STATUS_MODIFIED_STAGED;
+             *staged = EINA_TRUE;
+             return EDI_SCM_STATUS_MODIFIED_STAGED;
           }
+        return EDI_SCM_STATUS_MODIFIED;
      }
    else if (change[0] == 'D' || change[1] == 'D')
      {
-        status->change = EDI_SCM_STATUS_DELETED;
         if (change[0] == 'D')
           {
-             status->staged = status->change = EDI_SCM_STATUS_DELETED_STAGED;
+             *staged = EINA_TRUE;
+             return EDI_SCM_STATUS_DELETED_STAGED;
           }
+        return EDI_SCM_STATUS_DELETED;
      }
    else if (change[0] == '?' && change[1] == '?')
+     return EDI_SCM_STATUS_UNTRACKED;
+
+   return EDI_SCM_STATUS_UNKNOWN;
+}
+
+// Most paths hold nothing the shell would need escaped, they can share one string.
+static Eina_Bool
+_edi_scm_status_path_plain(const char *path, size_t length)
+{
+   size_t i;
+   char c;
+
+   for (i = 0; i < length; i++)
      {
-        status->change = EDI_SCM_STATUS_UNTRACKED;
+        c = path[i];
+        if (!isalnum((unsigned char) c) && c != '.' && c != '_' && c != '-' && c != '+' && c != '/')
+          return EINA_FALSE;
      }
+
+   return EINA_TRUE;
+}
+
+void
+_edi_scm_status_fill(Edi_Scm_Status *status, const char *change, const char *path, size_t length)
+{
+   char *escaped;
+
+   status->change = _edi_scm_status_code_get(change, &status->staged);
+   status->unescaped = eina_stringshare_add_length(path, length);
+
+   if (_edi_scm_status_path_plain(path, length))
+     status->path = eina_stringshare_ref(status->unescaped);
    else
-        status->change = EDI_SCM_STATUS_UNKNOWN;
+     {
+        escaped = ecore_file_escape_name(status->unescaped);
+        status->path = eina_stringshare_add(escaped);
+        free(escaped);
+     }
+
+   status->fullpath = eina_stringshare_printf("%s/%s", edi_scm_engine_get()->root_directory, status->path);
+}
+
+Edi_Scm_Status *
+_edi_scm_status_parse_line(char *line)
+{
+   Edi_Scm_Status *status;
 
-   esc_path = ecore_file_escape_name(path);
-   status->path = eina_stringshare_add(esc_path);
-   fullpath = edi_path_append(edi_scm_engine_get()->root_directory, esc_path);
-   status->fullpath = eina_stringshare_add(fullpath);
-   status->unescaped = eina_stringshare_add(path);
+   status = malloc(sizeof(Edi_Scm_Status));
+   if (!status)
+     return NULL;
 
-   free(fullpath);
-   free(esc_path);
+   _edi_scm_status_fill(status, line, line + 3, strlen(line + 3));
 
    return status;
 }
@@ -269,7 +412,7 @@ _edi_scm_git_file_status(const char *path)
      }
    else
      {
-        status = _parse_line(line);
+        status = _edi_scm_status_parse_line(line);
         result = status->change;
         eina_stringshare_del(status->path);
         eina_stringshare_del(status->fullpath);
@@ -282,67 +425,125 @@ _edi_scm_git_file_status(const char *path)
    return result;
 }
 
-static Eina_List *
-_edi_scm_git_status_get(void)
+// Skip the space separated fields that come before the path of a porcelain v2 record.
+static const char *
+_edi_scm_status_fields_skip(const char *pos, const char *end, int count)
 {
-   char *output, *pos, *start, *end;
-   char *line;
-   size_t size;
-   Eina_Strbuf *command;
-   Edi_Scm_Status *status;
-   Eina_List *list = NULL;
-
-   command = eina_strbuf_new();
+   while (count-- > 0)
+     {
+        pos = memchr(pos, ' ', end - pos);
+        if (!pos)
+          return NULL;
+        pos++;
+     }
 
-   eina_strbuf_append(command, "git status --porcelain");
+   return pos;
+}
 
-   output = _edi_scm_exec_response(eina_strbuf_string_get(command));
+static Eina_Inarray *
+_edi_scm_git_status_array_get(void)
+{
+   Edi_Scm_Engine *self = _edi_scm_global_object;
+   Eina_Inarray *statuses;
+   Edi_Scm_Status status;
+   const char *pos, *end, *record_end, *path;
+   char *output;
+   char change[2];
+   size_t length, count = 0, path_length;
+   int fields;
 
-   eina_strbuf_free(command);
+   if (!self)
+     return NULL;
 
-   end = NULL;
+   output = edi_exe_output_in(self->root_directory, "git status --porcelain=v2 -z", &length);
+   if (!output)
+     return NULL;
 
-   pos = output;
-   start = pos;
+   // Every record ends with a NUL, counting them sizes the array in one allocation.
+   end = output + length;
+   for (pos = output; pos < end && (pos = memchr(pos, '\0', end - pos)); pos++)
+     count++;
+   statuses = eina_inarray_new(sizeof(Edi_Scm_Status), count ? count : 1);
 
-   while (*pos++)
+   // Paths are read in place, they are only copied once they are interned.
+   for (pos = output; pos < end; pos = record_end + 1)
      {
-        if (*pos == '\n')
-          end = pos;
-        if (start && end)
+        record_end = memchr(pos, '\0', end - pos);
+        if (!record_end)
+          record_end = end;
+
+        switch (pos[0])
+          {
+           case '1':
+             fields = 8;
+             break;
+           case '2':
+             fields = 9;
+             break;
+           case 'u':
+             fields = 10;
+             break;
+           case '?':
+             fields = 1;
+             break;
+           default:
+             continue;
+          }
+
+        if (pos[0] == '?')
+          change[0] = change[1] = '?';
+        else if (record_end - pos > 4)
           {
-             size = end - start;
-             line = malloc(size + 1);
-             memcpy(line, start, size);
-             line[size] = '\0';
-
-             status = _parse_line(line);
-             if (status)
-               list = eina_list_append(list, status);
-
-             free(line);
-             start = end + 1;
-             end = NULL;
+             change[0] = pos[2];
+             change[1] = pos[3];
           }
-     }
+        else
+          continue;
 
-   end = pos;
-   size = end - start;
-   if (size > 1)
-     {
-        line = malloc(size + 1);
-        memcpy(line, start, size);
-        line[size] = '\0';
+        path = _edi_scm_status_fields_skip(pos, record_end, fields);
+        path_length = path ? (size_t) (record_end - path) : 0;
+
+        // A rename is followed by the path it was renamed from.
+        if (pos[0] == '2' && record_end < end)
+          {
+             record_end = memchr(record_end + 1, '\0', end - record_end - 1);
+             if (!record_end)
+               record_end = end;
+          }
 
-        status = _parse_line(line);
-        if (status)
-          list = eina_list_append(list, status);
+        if (!path_length)
+          continue;
 
-        free(line);
-    }
+        _edi_scm_status_fill(&status, change, path, path_length);
+        eina_inarray_push(statuses, &status);
+     }
 
    free(output);
 
+   return statuses;
+}
+
+static Eina_List *
+_edi_scm_status_list_get(void)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+   Eina_Inarray *statuses;
+   Edi_Scm_Status *status, *copy;
+   Eina_List *list = NULL;
+
+   statuses = e->status_array_get();
+   if (!statuses)
+     return NULL;
+
+   // The copies take over the string references of the array.
+   EINA_INARRAY_FOREACH(statuses, status)
+     {
+        copy = malloc(sizeof(Edi_Scm_Status));
+        *copy = *status;
+        list = eina_list_append(list, copy);
+     }
+   eina_inarray_free(statuses);
+
    return list;
 }
 
@@ -366,6 +567,204 @@ _edi_scm_git_diff(Eina_Bool cached)
    return output;
 }
 
+static int
+_edi_scm_git_diff_foreach(Eina_Bool cached, const char *path, Edi_Exe_Line_Cb cb, void *data)
+{
+   Edi_Scm_Engine *self = _edi_scm_global_object;
+   Eina_Strbuf *command;
+   int code;
+
+   if (!self) return -1;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append(command, cached ? "git diff --cached" : "git diff");
+   if (path)
+     eina_strbuf_append_printf(command, " -- %s", path);
+
+   code = edi_exe_lines_in(self->root_directory, eina_strbuf_string_get(command), cb, data);
+
+   eina_strbuf_free(command);
+
+   return code;
+}
+
+static Eina_Stringshare *
+_edi_scm_git_file_index_id(const char *path)
+{
+   Eina_Stringshare *id = NULL;
+   Eina_Strbuf *command;
+   char *output;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git rev-parse -q --verify :%s", path);
+
+   output = _edi_scm_exec_response(eina_strbuf_string_get(command));
+   if (output && output[0])
+     id = eina_stringshare_add(output);
+
+   free(output);
+   eina_strbuf_free(command);
+
+   return id;
+}
+
+static Eina_Stringshare *
+_edi_scm_git_head_id(void)
+{
+   Eina_Stringshare *id = NULL;
+   char *output;
+
+   output = _edi_scm_exec_response("git rev-parse -q --verify HEAD");
+   if (output && output[0])
+     id = eina_stringshare_add(output);
+
+   free(output);
+
+   return id;
+}
+
+static int
+_edi_scm_git_diff_head_foreach(const char *path, Edi_Exe_Line_Cb cb, void *data)
+{
+   Edi_Scm_Engine *self = _edi_scm_global_object;
+   Eina_Strbuf *command;
+   int code;
+
+   if (!self) return -1;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git diff -U0 --no-color HEAD -- %s", path);
+
+   code = edi_exe_lines_in(self->root_directory, eina_strbuf_string_get(command), cb, data);
+
+   eina_strbuf_free(command);
+
+   return code;
+}
+
+typedef struct _Edi_Scm_Git_Blame_Commit
+{
+   char *author;
+   char *summary;
+   long long time;
+} Edi_Scm_Git_Blame_Commit;
+
+typedef struct _Edi_Scm_Git_Blame
+{
+   Edi_Scm_Blame_Cb cb;
+   void *data;
+
+   Eina_Hash *commits;
+   Edi_Scm_Git_Blame_Commit *commit;
+   Edi_Scm_Blame_Range range;
+   char id[41];
+   Eina_Bool in_group;
+} Edi_Scm_Git_Blame;
+
+static void
+_edi_scm_git_blame_commit_free(void *data)
+{
+   Edi_Scm_Git_Blame_Commit *commit = data;
+
+   free(commit->author);
+   free(commit->summary);
+   free(commit);
+}
+
+static char *
+_edi_scm_git_blame_value(const char *line, size_t length, size_t key)
+{
+   char *value;
+
+   value = malloc(length - key + 1);
+   memcpy(value, line + key, length - key);
+   value[length - key] = '\0';
+
+   return value;
+}
+
+// Parse the output of git blame --incremental, each group ends with a filename line.
+static Eina_Bool
+_edi_scm_git_blame_line_cb(void *data, const char *line, size_t length)
+{
+   Edi_Scm_Git_Blame *blame = data;
+   Edi_Scm_Git_Blame_Commit *commit;
+   unsigned int orig, final, count;
+   char header[128];
+
+   if (!blame->in_group)
+     {
+        if (length < 41 || length >= sizeof(header))
+          return EINA_TRUE;
+
+        memcpy(header, line, length);
+        header[length] = '\0';
+        if (sscanf(header, "%40s %u %u %u", blame->id, &orig, &final, &count) != 4)
+          return EINA_TRUE;
+
+        commit = eina_hash_find(blame->commits, blame->id);
+        if (!commit)
+          {
+             commit = calloc(1, sizeof(Edi_Scm_Git_Blame_Commit));
+             eina_hash_add(blame->commits, blame->id, commit);
+          }
+
+        blame->commit = commit;
+        blame->range.line = final;
+        blame->range.count = count;
+        blame->in_group = EINA_TRUE;
+        return EINA_TRUE;
+     }
+
+   commit = blame->commit;
+   if (!strncmp(line, "author ", 7) && !commit->author)
+     commit->author = _edi_scm_git_blame_value(line, length, 7);
+   else if (!strncmp(line, "author-time ", 12))
+     commit->time = strtoll(line + 12, NULL, 10);
+   else if (!strncmp(line, "summary ", 8) && !commit->summary)
+     commit->summary = _edi_scm_git_blame_value(line, length, 8);
+   else if (!strncmp(line, "filename ", 9))
+     {
+        blame->in_group = EINA_FALSE;
+
+        blame->range.id = blame->id;
+        blame->range.author = commit->author ? commit->author : "";
+        blame->range.summary = commit->summary ? commit->summary : "";
+        blame->range.time = commit->time;
+
+        return blame->cb(blame->data, &blame->range);
+     }
+
+   return EINA_TRUE;
+}
+
+static int
+_edi_scm_git_blame(const char *path, Edi_Scm_Blame_Cb cb, void *data)
+{
+   Edi_Scm_Engine *self = _edi_scm_global_object;
+   Edi_Scm_Git_Blame blame;
+   Eina_Strbuf *command;
+   int code;
+
+   if (!self) return -1;
+
+   memset(&blame, 0, sizeof(blame));
+   blame.cb = cb;
+   blame.data = data;
+   blame.commits = eina_hash_string_superfast_new(_edi_scm_git_blame_commit_free);
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git blame --incremental HEAD -- %s", path);
+
+   code = edi_exe_lines_in(self->root_directory, eina_strbuf_string_get(command),
+                           _edi_scm_git_blame_line_cb, &blame);
+
+   eina_strbuf_free(command);
+   eina_hash_free(blame.commits);
+
+   return code;
+}
+
 static int
 _edi_scm_git_commit(const char *message)
 {
@@ -374,7 +773,7 @@ _edi_scm_git_commit(const char *message)
 
    eina_strbuf_append_printf(command, "git commit -m \"%s\"", message);
 
-   code = _edi_scm_exec(eina_strbuf_string_get(command));
+   code = _edi_scm_exec_print(eina_strbuf_string_get(command));
 
    eina_strbuf_free(command);
 
@@ -384,7 +783,7 @@ _edi_scm_git_commit(const char *message)
 static int
 _edi_scm_git_push(void)
 {
-   return _edi_scm_exec("git push");
+   return _edi_scm_exec_print("git push");
 }
 
 static int
@@ -395,7 +794,7 @@ _edi_scm_git_pull(void)
 
    eina_strbuf_append(command, "git pull");
 
-   code = _edi_scm_exec(eina_strbuf_string_get(command));
+   code = _edi_scm_exec_print(eina_strbuf_string_get(command));
 
    eina_strbuf_free(command);
 
@@ -410,7 +809,7 @@ _edi_scm_git_stash(void)
 
    eina_strbuf_append(command, "git stash");
 
-   code = _edi_scm_exec(eina_strbuf_string_get(command));
+   code = _edi_scm_exec_print(eina_strbuf_string_get(command));
 
    eina_strbuf_free(command);
 
@@ -429,7 +828,7 @@ _edi_scm_git_remote_add(const char *remote_url)
    eina_strbuf_free(command);
 
    if (code == 0)
-     code = _edi_scm_exec("git push --set-upstream origin master");
+     code = _edi_scm_exec_print("git push --set-upstream origin master");
 
    return code;
 }
@@ -573,6 +972,26 @@ edi_scm_shutdown()
    if (!engine)
      return;
 
+   if (_edi_scm_status_cache.thread)
+     {
+        ecore_thread_cancel(_edi_scm_status_cache.thread);
+        while ((ecore_thread_wait(_edi_scm_status_cache.thread, 0.1)) != EINA_TRUE);
+     }
+   if (_edi_scm_status_cache.statuses)
+     eina_hash_free(_edi_scm_status_cache.statuses);
+   if (_edi_scm_status_cache.dirs)
+     eina_hash_free(_edi_scm_status_cache.dirs);
+   _edi_scm_status_cache_untracked_free(_edi_scm_status_cache.untracked);
+   _edi_scm_status_cache_changed_clear();
+   _edi_scm_status_cache.statuses = NULL;
+   _edi_scm_status_cache.dirs = NULL;
+   _edi_scm_status_cache.untracked = NULL;
+   _edi_scm_status_cache.valid = EINA_FALSE;
+
+#if HAVE_LIBGIT2
+   _edi_scm_libgit2_shutdown();
+#endif
+
    eina_stringshare_del(engine->path);
    free(engine->root_directory);
    free(engine);
@@ -590,6 +1009,7 @@ edi_scm_stage(const char *path)
    escaped = ecore_file_escape_name(path);
 
    result = e->file_stage(escaped);
+   _edi_scm_status_cache_stale();
 
    free(escaped);
 
@@ -606,6 +1026,7 @@ edi_scm_del(const char *path)
    escaped = ecore_file_escape_name(path);
 
    result = e->file_del(escaped);
+   _edi_scm_status_cache_stale();
 
    free(escaped);
 
@@ -622,6 +1043,7 @@ edi_scm_unstage(const char *path)
    escaped = ecore_file_escape_name(path);
 
    result = e->file_unstage(escaped);
+   _edi_scm_status_cache_stale();
 
    free(escaped);
 
@@ -629,7 +1051,43 @@ edi_scm_unstage(const char *path)
 }
 
 EAPI int
-edi_scm_move(const char *src, const char *dest)
+edi_scm_stage_list(const Eina_List *paths)
+{
+   int result;
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   result = e->file_stage_list(paths);
+   _edi_scm_status_cache_stale();
+
+   return result;
+}
+
+EAPI int
+edi_scm_unstage_list(const Eina_List *paths)
+{
+   int result;
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   result = e->file_unstage_list(paths);
+   _edi_scm_status_cache_stale();
+
+   return result;
+}
+
+EAPI int
+edi_scm_del_list(const Eina_List *paths)
+{
+   int result;
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   result = e->file_del_list(paths);
+   _edi_scm_status_cache_stale();
+
+   return result;
+}
+
+EAPI int
+edi_scm_move(const char *src, const char *dest)
 {
    char *esc_src, *esc_dst;
    int result;
@@ -639,6 +1097,7 @@ edi_scm_move(const char *src, const char *dest)
    esc_dst = ecore_file_escape_name(dest);
 
    result = e->move(esc_src, esc_dst);
+   _edi_scm_status_cache_stale();
 
    free(esc_src);
    free(esc_dst);
@@ -659,6 +1118,361 @@ edi_scm_status_get(void)
    return EINA_TRUE;
 }
 
+EAPI Eina_Inarray *
+edi_scm_status_array_get(void)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return e->status_array_get();
+}
+
+EAPI void
+edi_scm_status_array_free(Eina_Inarray *statuses)
+{
+   Edi_Scm_Status *status;
+
+   if (!statuses)
+     return;
+
+   EINA_INARRAY_FOREACH(statuses, status)
+     {
+        eina_stringshare_del(status->path);
+        eina_stringshare_del(status->fullpath);
+        eina_stringshare_del(status->unescaped);
+     }
+   eina_inarray_free(statuses);
+}
+
+static void
+_edi_scm_status_cache_free_cb(void *data)
+{
+   free(data);
+}
+
+static void
+_edi_scm_status_cache_dir_free_cb(void *data)
+{
+   Eina_List *paths = data;
+   Eina_Stringshare *path;
+
+   EINA_LIST_FREE(paths, path)
+     eina_stringshare_del(path);
+}
+
+static void
+_edi_scm_status_cache_untracked_free(Eina_List *untracked)
+{
+   Eina_Stringshare *dir;
+
+   EINA_LIST_FREE(untracked, dir)
+     eina_stringshare_del(dir);
+}
+
+static void
+_edi_scm_status_cache_snapshot_free(Edi_Scm_Status_Snapshot *snapshot)
+{
+   eina_hash_free(snapshot->statuses);
+   eina_hash_free(snapshot->dirs);
+   _edi_scm_status_cache_untracked_free(snapshot->untracked);
+   free(snapshot);
+}
+
+static void
+_edi_scm_status_cache_changed_clear(void)
+{
+   Eina_Stringshare *path;
+
+   EINA_LIST_FREE(_edi_scm_status_cache.changed, path)
+     eina_stringshare_del(path);
+}
+
+static Eina_Bool
+_edi_scm_status_cache_changed_old_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                                     void *data, void *fdata)
+{
+   Edi_Scm_Status_Code *code, *old = data;
+   Eina_Hash *statuses = fdata;
+
+   code = eina_hash_find(statuses, key);
+   if (!code || *code != *old)
+     _edi_scm_status_cache.changed = eina_list_append(_edi_scm_status_cache.changed,
+                                                      eina_stringshare_add(key));
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edi_scm_status_cache_changed_new_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                                     void *data EINA_UNUSED, void *fdata)
+{
+   Eina_Hash *statuses = fdata;
+
+   if (!statuses || !eina_hash_find(statuses, key))
+     _edi_scm_status_cache.changed = eina_list_append(_edi_scm_status_cache.changed,
+                                                      eina_stringshare_add(key));
+
+   return EINA_TRUE;
+}
+
+// Only a handful of files are changed at any time, so comparing snapshots is cheap.
+static void
+_edi_scm_status_cache_changed_update(Eina_Hash *old, Eina_Hash *statuses)
+{
+   _edi_scm_status_cache_changed_clear();
+
+   if (old)
+     eina_hash_foreach(old, _edi_scm_status_cache_changed_old_cb, statuses);
+   eina_hash_foreach(statuses, _edi_scm_status_cache_changed_new_cb, old);
+}
+
+static char *
+_edi_scm_status_cache_index_path_get(Edi_Scm_Engine *e)
+{
+   char *gitdir, *path;
+
+   gitdir = edi_path_append(e->root_directory, e->directory);
+   path = edi_path_append(gitdir, "index");
+   free(gitdir);
+
+   return path;
+}
+
+static void
+_edi_scm_status_cache_thread_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Scm_Engine *e;
+   Edi_Scm_Status *status;
+   Edi_Scm_Status_Code *code;
+   Edi_Scm_Status_Snapshot *snapshot;
+   Eina_Inarray *statuses;
+   Eina_List *paths;
+   char *path, *dir;
+   size_t len;
+
+   e = edi_scm_engine_get();
+   snapshot = data;
+
+   statuses = e->status_array_get();
+   if (!statuses)
+     {
+        snapshot->failed = EINA_TRUE;
+        return;
+     }
+
+   EINA_INARRAY_FOREACH(statuses, status)
+     {
+        if (!ecore_thread_check(thread))
+          {
+             path = edi_path_append(e->root_directory, status->unescaped);
+
+             // Untracked directories are reported with a trailing slash,
+             // git does not list the files inside them.
+             len = strlen(path);
+             if (len > 1 && path[len - 1] == '/')
+               {
+                  if (status->change == EDI_SCM_STATUS_UNTRACKED)
+                    snapshot->untracked = eina_list_append(snapshot->untracked,
+                                                           eina_stringshare_add(path));
+                  path[len - 1] = '\0';
+               }
+
+             code = malloc(sizeof(Edi_Scm_Status_Code));
+             *code = status->change;
+             eina_hash_set(snapshot->statuses, path, code);
+
+             dir = ecore_file_dir_get(path);
+             paths = eina_hash_find(snapshot->dirs, dir);
+             paths = eina_list_append(paths, eina_stringshare_add(path));
+             eina_hash_set(snapshot->dirs, dir, paths);
+             free(dir);
+             free(path);
+          }
+     }
+
+   edi_scm_status_array_free(statuses);
+}
+
+static void _edi_scm_status_cache_refresh(void);
+
+static void
+_edi_scm_status_cache_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Scm_Status_Cache *cache = &_edi_scm_status_cache;
+   Edi_Scm_Status_Snapshot *snapshot = data;
+   Edi_Scm_Engine *e;
+   char *index;
+
+   cache->thread = NULL;
+
+   // Keep answering from the previous snapshot when git status could not run.
+   if (snapshot->failed)
+     {
+        _edi_scm_status_cache_snapshot_free(snapshot);
+        cache->valid = EINA_FALSE;
+        if (cache->dirty)
+          _edi_scm_status_cache_refresh();
+        return;
+     }
+
+   _edi_scm_status_cache_changed_update(cache->statuses, snapshot->statuses);
+
+   if (cache->statuses)
+     eina_hash_free(cache->statuses);
+   if (cache->dirs)
+     eina_hash_free(cache->dirs);
+   _edi_scm_status_cache_untracked_free(cache->untracked);
+   cache->statuses = snapshot->statuses;
+   cache->dirs = snapshot->dirs;
+   cache->untracked = snapshot->untracked;
+   free(snapshot);
+
+   // git status may refresh the index itself, so only take the time once it has run.
+   e = edi_scm_engine_get();
+   index = _edi_scm_status_cache_index_path_get(e);
+   cache->index_mtime = ecore_file_mod_time(index);
+   free(index);
+
+   cache->valid = !cache->dirty;
+   cache->dirty = EINA_FALSE;
+
+   if (cache->cb)
+     cache->cb(cache->cb_data);
+
+   if (!cache->valid)
+     _edi_scm_status_cache_refresh();
+}
+
+static void
+_edi_scm_status_cache_cancel_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   _edi_scm_status_cache.thread = NULL;
+   _edi_scm_status_cache_snapshot_free(data);
+}
+
+static void
+_edi_scm_status_cache_refresh(void)
+{
+   Edi_Scm_Status_Cache *cache = &_edi_scm_status_cache;
+   Edi_Scm_Status_Snapshot *snapshot;
+
+   if (!edi_scm_enabled())
+     return;
+
+   if (cache->thread)
+     {
+        cache->dirty = EINA_TRUE;
+        return;
+     }
+
+   snapshot = calloc(1, sizeof(Edi_Scm_Status_Snapshot));
+   snapshot->statuses = eina_hash_string_superfast_new(_edi_scm_status_cache_free_cb);
+   snapshot->dirs = eina_hash_string_superfast_new(_edi_scm_status_cache_dir_free_cb);
+   cache->dirty = EINA_FALSE;
+   cache->thread = ecore_thread_run(_edi_scm_status_cache_thread_cb, _edi_scm_status_cache_end_cb,
+                                    _edi_scm_status_cache_cancel_cb, snapshot);
+}
+
+static void
+_edi_scm_status_cache_stale(void)
+{
+   _edi_scm_status_cache.valid = EINA_FALSE;
+   if (_edi_scm_status_cache.thread)
+     _edi_scm_status_cache.dirty = EINA_TRUE;
+}
+
+EAPI void
+edi_scm_status_cache_callback_set(Edi_Scm_Status_Cache_Cb cb, void *data)
+{
+   _edi_scm_status_cache.cb = cb;
+   _edi_scm_status_cache.cb_data = data;
+}
+
+EAPI void
+edi_scm_status_cache_invalidate(void)
+{
+   _edi_scm_status_cache_stale();
+   _edi_scm_status_cache_refresh();
+}
+
+EAPI void
+edi_scm_status_cache_check(void)
+{
+   Edi_Scm_Status_Cache *cache = &_edi_scm_status_cache;
+   Edi_Scm_Engine *e;
+   char *index;
+
+   e = edi_scm_engine_get();
+   if (!e || cache->thread)
+     return;
+
+   if (cache->valid)
+     {
+        index = _edi_scm_status_cache_index_path_get(e);
+        if (ecore_file_mod_time(index) != cache->index_mtime)
+          cache->valid = EINA_FALSE;
+        free(index);
+     }
+
+   if (!cache->valid)
+     _edi_scm_status_cache_refresh();
+}
+
+EAPI Edi_Scm_Status_Code
+edi_scm_status_cache_find(const char *path)
+{
+   Edi_Scm_Status_Code *code;
+   Eina_Stringshare *dir;
+   Eina_List *l;
+
+   if (!path || !_edi_scm_status_cache.statuses)
+     return EDI_SCM_STATUS_NONE;
+
+   code = eina_hash_find(_edi_scm_status_cache.statuses, path);
+   if (code)
+     return *code;
+
+   EINA_LIST_FOREACH(_edi_scm_status_cache.untracked, l, dir)
+     {
+        if (!strncmp(path, dir, eina_stringshare_strlen(dir)))
+          return EDI_SCM_STATUS_UNTRACKED;
+     }
+
+   return EDI_SCM_STATUS_NONE;
+}
+
+EAPI void
+edi_scm_status_cache_dir_foreach(const char *dir, Edi_Scm_Status_Cache_Foreach_Cb cb, void *data)
+{
+   Eina_Stringshare *path;
+   Eina_List *paths, *l;
+
+   if (!dir || !_edi_scm_status_cache.dirs)
+     return;
+
+   paths = eina_hash_find(_edi_scm_status_cache.dirs, dir);
+   EINA_LIST_FOREACH(paths, l, path)
+     cb(data, path, edi_scm_status_cache_find(path));
+}
+
+EAPI void
+edi_scm_status_cache_paths_find(const char **paths, unsigned int count, Edi_Scm_Status_Code *codes)
+{
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     codes[i] = edi_scm_status_cache_find(paths[i]);
+}
+
+EAPI void
+edi_scm_status_cache_changed_foreach(Edi_Scm_Status_Cache_Foreach_Cb cb, void *data)
+{
+   Eina_Stringshare *path;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_scm_status_cache.changed, l, path)
+     cb(data, path, edi_scm_status_cache_find(path));
+}
+
 EAPI Edi_Scm_Status_Code
 edi_scm_file_status(const char *path)
 {
@@ -666,6 +1480,10 @@ edi_scm_file_status(const char *path)
    int result;
    Edi_Scm_Engine *e = edi_scm_engine_get();
 
+   // Answer from the last snapshot while nothing has changed since.
+   if (_edi_scm_status_cache.valid && !_edi_scm_status_cache.thread)
+     return edi_scm_status_cache_find(path);
+
    escaped = ecore_file_escape_name(path);
 
    result = e->file_status(escaped);
@@ -681,6 +1499,7 @@ edi_scm_commit(const char *message)
    Edi_Scm_Engine *e = edi_scm_engine_get();
 
    e->commit(message);
+   _edi_scm_status_cache_stale();
 }
 
 static void
@@ -717,12 +1536,53 @@ edi_scm_diff(Eina_Bool cached)
    return e->diff(cached);
 }
 
+EAPI int
+edi_scm_diff_foreach(Eina_Bool cached, const char *path, Edi_Exe_Line_Cb cb, void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return e->diff_foreach(cached, path, cb, data);
+}
+
+EAPI Eina_Stringshare *
+edi_scm_file_index_id_get(const char *path)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return e->file_index_id(path);
+}
+
+EAPI Eina_Stringshare *
+edi_scm_head_id_get(void)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return e->head_id();
+}
+
+EAPI int
+edi_scm_diff_head_foreach(const char *path, Edi_Exe_Line_Cb cb, void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return e->diff_head_foreach(path, cb, data);
+}
+
+EAPI int
+edi_scm_blame_foreach(const char *path, Edi_Scm_Blame_Cb cb, void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return e->blame(path, cb, data);
+}
+
 EAPI void
 edi_scm_stash(void)
 {
    Edi_Scm_Engine *e = edi_scm_engine_get();
 
    e->stash();
+   _edi_scm_status_cache_stale();
 }
 
 EAPI int
@@ -769,6 +1629,284 @@ edi_scm_push(void)
    ecore_thread_run(_edi_scm_push_thread_cb, NULL, NULL, e);
 }
 
+struct _Edi_Scm_Job
+{
+   char *dir, *command;
+   Edi_Scm_Job_Line_Cb line_cb;
+   Edi_Scm_Job_Progress_Cb progress_cb;
+   Edi_Scm_Job_End_Cb end_cb;
+   void *data;
+
+   Ecore_Thread *thread;
+   Ecore_Thread *worker; /* The same thread, as seen by the worker before thread is set */
+   Eina_Lock lock;
+   pid_t pid;
+   Eina_Bool cancelled;
+   int status;
+
+   char stage[128];
+   int percent;
+};
+
+typedef struct _Edi_Scm_Job_Message
+{
+   char *line;       /* An output line, or NULL for a progress update */
+   char *stage;
+   int percent;
+   unsigned long current, total;
+} Edi_Scm_Job_Message;
+
+// Read a git progress meter such as "remote: Counting objects:  45% (9/20)".
+static Eina_Bool
+_edi_scm_job_progress_parse(char *text, Edi_Scm_Job_Message *msg)
+{
+   char *stage, *pos, *end;
+   long percent;
+
+   stage = text;
+   if (!strncmp(stage, "remote: ", 8))
+     stage += 8;
+
+   pos = strstr(stage, ": ");
+   if (!pos)
+     return EINA_FALSE;
+
+   percent = strtol(pos + 2, &end, 10);
+   if (end == pos + 2 || *end != '%' || percent < 0 || percent > 100)
+     return EINA_FALSE;
+
+   msg->stage = strndup(stage, pos - stage);
+   msg->percent = percent;
+   msg->current = msg->total = 0;
+   if (end[1] == ' ' && end[2] == '(')
+     {
+        msg->current = strtoul(end + 3, &pos, 10);
+        if (*pos == '/')
+          msg->total = strtoul(pos + 1, NULL, 10);
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_scm_job_message_free(Edi_Scm_Job_Message *msg)
+{
+   free(msg->line);
+   free(msg->stage);
+   free(msg);
+}
+
+static void
+_edi_scm_job_started_cb(void *data, pid_t pid)
+{
+   Edi_Scm_Job *job = data;
+
+   eina_lock_take(&job->lock);
+   job->pid = pid;
+   if (job->cancelled)
+     kill(-pid, SIGTERM);
+   eina_lock_release(&job->lock);
+}
+
+static Eina_Bool
+_edi_scm_job_line_cb(void *data, const char *line, size_t length)
+{
+   Edi_Scm_Job *job = data;
+   Edi_Scm_Job_Message *msg;
+   char *text;
+
+   if (ecore_thread_check(job->worker))
+     return EINA_FALSE;
+
+   text = strndup(line, length);
+   msg = calloc(1, sizeof(Edi_Scm_Job_Message));
+
+   // A meter is redrawn many times, only pass changes and its final state.
+   if (_edi_scm_job_progress_parse(text, msg))
+     {
+        if (msg->percent != job->percent || strcmp(msg->stage, job->stage))
+          {
+             job->percent = msg->percent;
+             eina_strlcpy(job->stage, msg->stage, sizeof(job->stage));
+             ecore_thread_feedback(job->worker, msg);
+             msg = calloc(1, sizeof(Edi_Scm_Job_Message));
+          }
+
+        if (!eina_str_has_suffix(text, "done."))
+          {
+             _edi_scm_job_message_free(msg);
+             free(text);
+             return EINA_TRUE;
+          }
+        free(msg->stage);
+        msg->stage = NULL;
+     }
+
+   msg->line = text;
+   ecore_thread_feedback(job->worker, msg);
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_scm_job_thread_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Scm_Job *job = data;
+
+   // The thread may run before ecore_thread_feedback_run has returned it.
+   job->worker = thread;
+
+   job->status = edi_exe_progress_in(job->dir, job->command, _edi_scm_job_started_cb,
+                                     _edi_scm_job_line_cb, job);
+
+   eina_lock_take(&job->lock);
+   job->pid = 0;
+   eina_lock_release(&job->lock);
+}
+
+static void
+_edi_scm_job_notify_cb(void *data, Ecore_Thread *thread EINA_UNUSED, void *msgdata)
+{
+   Edi_Scm_Job *job = data;
+   Edi_Scm_Job_Message *msg = msgdata;
+   Edi_Scm_Job_Progress progress;
+
+   if (msg->line && job->line_cb)
+     job->line_cb(job->data, msg->line);
+   else if (!msg->line && job->progress_cb)
+     {
+        progress.stage = msg->stage;
+        progress.percent = msg->percent;
+        progress.current = msg->current;
+        progress.total = msg->total;
+        job->progress_cb(job->data, &progress);
+     }
+
+   _edi_scm_job_message_free(msg);
+}
+
+static void
+_edi_scm_job_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Scm_Job *job = data;
+
+   _edi_scm_status_cache_stale();
+
+   if (job->end_cb)
+     job->end_cb(job->data, job->status, job->cancelled);
+
+   eina_lock_free(&job->lock);
+   free(job->dir);
+   free(job->command);
+   free(job);
+}
+
+static Edi_Scm_Job *
+_edi_scm_job_run(const char *dir, const char *command, Edi_Scm_Job_Line_Cb line_cb,
+                 Edi_Scm_Job_Progress_Cb progress_cb, Edi_Scm_Job_End_Cb end_cb, const void *data)
+{
+   Edi_Scm_Job *job;
+
+   job = calloc(1, sizeof(Edi_Scm_Job));
+   job->dir = dir ? strdup(dir) : NULL;
+   job->command = strdup(command);
+   job->line_cb = line_cb;
+   job->progress_cb = progress_cb;
+   job->end_cb = end_cb;
+   job->data = (void *) data;
+   job->percent = -1;
+   job->status = -1;
+   eina_lock_new(&job->lock);
+
+   job->thread = ecore_thread_feedback_run(_edi_scm_job_thread_cb, _edi_scm_job_notify_cb,
+                                           _edi_scm_job_end_cb, _edi_scm_job_end_cb,
+                                           job, EINA_FALSE);
+   if (!job->thread)
+     {
+        eina_lock_free(&job->lock);
+        free(job->dir);
+        free(job->command);
+        free(job);
+        return NULL;
+     }
+
+   return job;
+}
+
+EAPI Edi_Scm_Job *
+edi_scm_push_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_Progress_Cb progress_cb,
+                 Edi_Scm_Job_End_Cb end_cb, const void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e)
+     return NULL;
+
+   return _edi_scm_job_run(e->root_directory, "git push --progress", line_cb, progress_cb, end_cb, data);
+}
+
+EAPI Edi_Scm_Job *
+edi_scm_pull_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_Progress_Cb progress_cb,
+                 Edi_Scm_Job_End_Cb end_cb, const void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e)
+     return NULL;
+
+   return _edi_scm_job_run(e->root_directory, "git pull --progress", line_cb, progress_cb, end_cb, data);
+}
+
+EAPI Edi_Scm_Job *
+edi_scm_status_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_End_Cb end_cb, const void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e)
+     return NULL;
+
+   return _edi_scm_job_run(e->root_directory, "git status", line_cb, NULL, end_cb, data);
+}
+
+EAPI Edi_Scm_Job *
+edi_scm_stash_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_Progress_Cb progress_cb,
+                  Edi_Scm_Job_End_Cb end_cb, const void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e)
+     return NULL;
+
+   return _edi_scm_job_run(e->root_directory, "git stash", line_cb, progress_cb, end_cb, data);
+}
+
+EAPI Edi_Scm_Job *
+edi_scm_git_clone_job(const char *url, const char *dir, Edi_Scm_Job_Line_Cb line_cb,
+                      Edi_Scm_Job_Progress_Cb progress_cb, Edi_Scm_Job_End_Cb end_cb,
+                      const void *data)
+{
+   Edi_Scm_Job *job;
+   Eina_Strbuf *command = eina_strbuf_new();
+
+   eina_strbuf_append_printf(command, "git clone --progress '%s' '%s'", url, dir);
+   job = _edi_scm_job_run(NULL, eina_strbuf_string_get(command), line_cb, progress_cb, end_cb, data);
+
+   eina_strbuf_free(command);
+   return job;
+}
+
+EAPI void
+edi_scm_job_cancel(Edi_Scm_Job *job)
+{
+   eina_lock_take(&job->lock);
+   job->cancelled = EINA_TRUE;
+   if (job->pid > 0)
+     kill(-job->pid, SIGTERM);
+   eina_lock_release(&job->lock);
+
+   ecore_thread_cancel(job->thread);
+}
+
 EAPI const char *
 edi_scm_root_directory_get(void)
 {
@@ -792,25 +1930,40 @@ _edi_scm_git_init(const char *rootdir)
    engine->file_mod = _edi_scm_git_file_mod;
    engine->file_del = _edi_scm_git_file_del;
    engine->file_unstage = _edi_scm_git_file_unstage;
+   engine->file_stage_list = _edi_scm_git_file_stage_list;
+   engine->file_del_list = _edi_scm_git_file_del_list;
+   engine->file_unstage_list = _edi_scm_git_file_unstage_list;
    engine->move = _edi_scm_git_file_move;
    engine->status = _edi_scm_git_status;
    engine->diff = _edi_scm_git_diff;
+   engine->diff_foreach = _edi_scm_git_diff_foreach;
    engine->commit = _edi_scm_git_commit;
    engine->pull = _edi_scm_git_pull;
    engine->push = _edi_scm_git_push;
    engine->stash = _edi_scm_git_stash;
    engine->file_status = _edi_scm_git_file_status;
+   engine->file_index_id = _edi_scm_git_file_index_id;
+   engine->head_id = _edi_scm_git_head_id;
+   engine->diff_head_foreach = _edi_scm_git_diff_head_foreach;
+   engine->blame = _edi_scm_git_blame;
 
    engine->remote_add = _edi_scm_git_remote_add;
    engine->remote_name_get = _edi_scm_git_remote_name_get;
    engine->remote_email_get = _edi_scm_git_remote_email_get;
    engine->remote_url_get = _edi_scm_git_remote_url_get;
    engine->credentials_set = _edi_scm_git_credentials_set;
-   engine->status_get = _edi_scm_git_status_get;
+   engine->status_get = _edi_scm_status_list_get;
+   engine->status_array_get = _edi_scm_git_status_array_get;
 
    engine->root_directory = strdup(rootdir);
    engine->initialized = EINA_TRUE;
 
+#if HAVE_LIBGIT2
+   _edi_scm_libgit2_setup(engine);
+#endif
+
+   _edi_scm_status_cache_stale();
+
    return engine;
 }
 
@@ -908,3 +2061,53 @@ edi_scm_avatar_url_get(const char *email)
    return url;
 }
 
+typedef struct _Edi_Scm_Avatar_Download
+{
+   Edi_Scm_Avatar_Cb cb;
+   void *data;
+} Edi_Scm_Avatar_Download;
+
+static void
+_edi_scm_avatar_download_complete_cb(void *data, const char *file, int status)
+{
+   Edi_Scm_Avatar_Download *download = data;
+   Eina_Bool success = status == 200;
+
+   // Do not leave an error page or a partial image in the cache.
+   if (!success)
+     ecore_file_remove(file);
+
+   if (download->cb)
+     download->cb(download->data, file, success);
+   free(download);
+}
+
+EAPI Eina_Bool
+edi_scm_avatar_download(const char *url, const char *path, Edi_Scm_Avatar_Cb cb, void *data)
+{
+   Edi_Scm_Avatar_Download *download;
+   char *dir;
+   Eina_Bool ok;
+
+   if (!url || !path)
+     return EINA_FALSE;
+
+   dir = ecore_file_dir_get(path);
+   ok = ecore_file_exists(dir) || ecore_file_mkpath(dir);
+   free(dir);
+   if (!ok)
+     return EINA_FALSE;
+
+   download = calloc(1, sizeof(Edi_Scm_Avatar_Download));
+   download->cb = cb;
+   download->data = data;
+
+   if (!ecore_file_download(url, path, _edi_scm_avatar_download_complete_cb, NULL, download, NULL))
+     {
+        free(download);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
@@ -24,6 +24,36 @@ typedef enum {
    EDI_SCM_STATUS_UNKNOWN,
 } Edi_Scm_Status_Code;
 
+typedef struct _Edi_Scm_Blame_Range
+{
+   const char *id;      /* The commit that last changed the lines */
+   const char *author;
+   const char *summary;
+   long long time;      /* The author time, in seconds since the epoch */
+   unsigned int line;   /* The first line in the blamed revision, starting at 1 */
+   unsigned int count;
+} Edi_Scm_Blame_Range;
+
+typedef Eina_Bool (*Edi_Scm_Blame_Cb)(void *data, const Edi_Scm_Blame_Range *range);
+
+/**
+ * @typedef Edi_Scm_Job
+ * A push, pull or clone running in the background.
+ */
+typedef struct _Edi_Scm_Job Edi_Scm_Job;
+
+typedef struct _Edi_Scm_Job_Progress
+{
+   const char *stage;      /* The step being run, such as "Receiving objects" */
+   int percent;            /* How much of the step is complete, from 0 to 100 */
+   unsigned long current;
+   unsigned long total;    /* 0 if the step does not count its items */
+} Edi_Scm_Job_Progress;
+
+typedef void (*Edi_Scm_Job_Line_Cb)(void *data, const char *line);
+typedef void (*Edi_Scm_Job_Progress_Cb)(void *data, const Edi_Scm_Job_Progress *progress);
+typedef void (*Edi_Scm_Job_End_Cb)(void *data, int status, Eina_Bool cancelled);
+
 typedef struct _Edi_Scm_Status
 {
    Eina_Stringshare *path;
@@ -38,13 +68,21 @@ typedef int (scm_fn_unstage)(const char *path);
 typedef int (scm_fn_mod)(const char *path);
 typedef int (scm_fn_del)(const char *path);
 typedef int (scm_fn_move)(const char *src, const char *dest);
+typedef int (scm_fn_stage_list)(const Eina_List *paths);
+typedef int (scm_fn_unstage_list)(const Eina_List *paths);
+typedef int (scm_fn_del_list)(const Eina_List *paths);
 typedef int (scm_fn_commit)(const char *message);
 typedef int (scm_fn_status)(void);
 typedef char *(scm_fn_diff)(Eina_Bool);
+typedef int (scm_fn_diff_foreach)(Eina_Bool cached, const char *path, Edi_Exe_Line_Cb cb, void *data);
 typedef int (scm_fn_push)(void);
 typedef int (scm_fn_pull)(void);
 typedef int (scm_fn_stash)(void);
 typedef Edi_Scm_Status_Code (scm_fn_file_status)(const char *path);
+typedef Eina_Stringshare *(scm_fn_file_index_id)(const char *path);
+typedef Eina_Stringshare *(scm_fn_head_id)(void);
+typedef int (scm_fn_diff_head_foreach)(const char *path, Edi_Exe_Line_Cb cb, void *data);
+typedef int (scm_fn_blame)(const char *path, Edi_Scm_Blame_Cb cb, void *data);
 
 typedef int (scm_fn_remote_add)(const char *remote_url);
 typedef const char * (scm_fn_remote_name)(void);
@@ -52,6 +90,11 @@ typedef const char * (scm_fn_remote_email)(void);
 typedef const char * (scm_fn_remote_url)(void);
 typedef int (scm_fn_credentials)(const char *name, const char *email);
 typedef Eina_List * (scm_fn_status_get)(void);
+typedef Eina_Inarray * (scm_fn_status_array_get)(void);
+
+typedef void (*Edi_Scm_Status_Cache_Cb)(void *data);
+typedef void (*Edi_Scm_Status_Cache_Foreach_Cb)(void *data, const char *path, Edi_Scm_Status_Code code);
+typedef void (*Edi_Scm_Avatar_Cb)(void *data, const char *path, Eina_Bool success);
 
 typedef struct _Edi_Scm_Engine
 {
@@ -66,10 +109,18 @@ typedef struct _Edi_Scm_Engine
    scm_fn_mod         *file_mod;
    scm_fn_del         *file_del;
    scm_fn_move        *move;
+   scm_fn_stage_list  *file_stage_list;
+   scm_fn_unstage_list *file_unstage_list;
+   scm_fn_del_list    *file_del_list;
    scm_fn_commit      *commit;
    scm_fn_status      *status;
    scm_fn_diff        *diff;
+   scm_fn_diff_foreach *diff_foreach;
    scm_fn_file_status *file_status;
+   scm_fn_file_index_id *file_index_id;
+   scm_fn_head_id     *head_id;
+   scm_fn_diff_head_foreach *diff_head_foreach;
+   scm_fn_blame       *blame;
    scm_fn_push        *push;
    scm_fn_pull        *pull;
    scm_fn_stash       *stash;
@@ -80,6 +131,7 @@ typedef struct _Edi_Scm_Engine
    scm_fn_remote_url   *remote_url_get;
    scm_fn_credentials  *credentials_set;
    scm_fn_status_get   *status_get;
+   scm_fn_status_array_get *status_array_get;
    Eina_Bool           initialized;
 } Edi_Scm_Engine;
 
@@ -128,6 +180,9 @@ EAPI int edi_scm_git_new(void);
 /**
  * Clone an existing git repository from the provided url.
  *
+ * This blocks until the clone has finished, use edi_scm_git_clone_job()
+ * from the main loop.
+ *
  * @param url the URL to clone from.
  * @param dir the new directory that will be created to clone into
  * @return The status code of the clone command.
@@ -175,6 +230,36 @@ int edi_scm_unstage(const char *path);
  */
 int edi_scm_del(const char *path);
 
+/**
+ * Stage several files for commit with a single SCM command.
+ *
+ * @param paths The list of unescaped file paths, absolute or relative to the root directory.
+ * @return The status code of command executed.
+ *
+ * @ingroup Scm
+ */
+EAPI int edi_scm_stage_list(const Eina_List *paths);
+
+/**
+ * Unstage several files from commit with a single SCM command.
+ *
+ * @param paths The list of unescaped file paths, absolute or relative to the root directory.
+ * @return The status code of command executed.
+ *
+ * @ingroup Scm
+ */
+EAPI int edi_scm_unstage_list(const Eina_List *paths);
+
+/**
+ * Remove several files from those monitored by SCM with a single SCM command.
+ *
+ * @param paths The list of unescaped file paths, absolute or relative to the root directory.
+ * @return The status code of command executed.
+ *
+ * @ingroup Scm
+ */
+EAPI int edi_scm_del_list(const Eina_List *paths);
+
 /**
  * Set commit message for next commit to SCM.
  *
@@ -208,6 +293,109 @@ Edi_Scm_Status_Code edi_scm_file_status(const char *path);
 */
 Eina_Bool edi_scm_status_get(void);
 
+/**
+ * Get the status of every changed file in the repository at once.
+ *
+ * The statuses are stored one after the other in a single array, each
+ * path is shared with any other use of the same string.
+ *
+ * @return An array of Edi_Scm_Status, to free with edi_scm_status_array_free(), or NULL.
+ *
+ * @ingroup Scm
+ */
+EAPI Eina_Inarray *edi_scm_status_array_get(void);
+
+/**
+ * Free an array of statuses along with the paths it holds.
+ *
+ * @param statuses The array returned by edi_scm_status_array_get().
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_array_free(Eina_Inarray *statuses);
+
+/**
+ * Look up the status of a file in the repository status cache.
+ *
+ * This does not run the SCM, the cache is refreshed in the background by
+ * edi_scm_status_cache_check() and edi_scm_status_cache_invalidate().
+ *
+ * Files inside an untracked directory are reported as untracked. If the last
+ * refresh failed the previous snapshot is kept.
+ *
+ * @param path The full path of the file.
+ * @return The cached status code of the file, EDI_SCM_STATUS_NONE if unchanged or unknown.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_Status_Code edi_scm_status_cache_find(const char *path);
+
+/**
+ * Check whether the repository status cache is still current.
+ *
+ * The cache is refreshed asynchronously when it has been invalidated or the
+ * modification time of the SCM index has changed since the last refresh.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_cache_check(void);
+
+/**
+ * Mark the repository status cache as out of date and refresh it asynchronously.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_cache_invalidate(void);
+
+/**
+ * Set the function to call whenever the repository status cache was refreshed.
+ *
+ * @param cb The function to call on the main loop after each refresh.
+ * @param data The data passed to the callback.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_cache_callback_set(Edi_Scm_Status_Cache_Cb cb, void *data);
+
+/**
+ * Call a function for each changed file directly inside a directory.
+ *
+ * All results come from the same status cache snapshot and no SCM command is run.
+ *
+ * @param dir The full path of the directory.
+ * @param cb The function called with the full path and status of each changed file.
+ * @param data The data passed to the callback.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_cache_dir_foreach(const char *dir, Edi_Scm_Status_Cache_Foreach_Cb cb, void *data);
+
+/**
+ * Look up the status of a set of files in the repository status cache.
+ *
+ * All results come from the same status cache snapshot and no SCM command is run.
+ *
+ * @param paths The full paths of the files.
+ * @param count The number of paths.
+ * @param codes Filled with the status code of each path, in the same order.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_cache_paths_find(const char **paths, unsigned int count, Edi_Scm_Status_Code *codes);
+
+/**
+ * Call a function for each file whose status changed in the last cache refresh.
+ *
+ * This is intended to be called from the callback set with
+ * edi_scm_status_cache_callback_set() to update only what changed.
+ *
+ * @param cb The function called with the full path and new status of each file.
+ * @param data The data passed to the callback.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_status_cache_changed_foreach(Edi_Scm_Status_Cache_Foreach_Cb cb, void *data);
+
 /**
  * Get diff of changes in repository.
  *
@@ -217,6 +405,70 @@ Eina_Bool edi_scm_status_get(void);
 */
 char *edi_scm_diff(Eina_Bool cached);
 
+/**
+ * Pass the diff of changes in repository to a callback line by line.
+ *
+ * The diff is streamed as it is produced, without building the whole output
+ * in memory. Returning EINA_FALSE from the callback stops the diff early.
+ *
+ * @param cached Whether the results are general or cached changes.
+ * @param path The escaped path, relative to the root, to limit the diff to or NULL for all.
+ * @param cb The function called for each line of the diff.
+ * @param data The data passed to the callback.
+ *
+ * @return The status code of command executed.
+ * @ingroup Scm
+ */
+EAPI int edi_scm_diff_foreach(Eina_Bool cached, const char *path, Edi_Exe_Line_Cb cb, void *data);
+
+/**
+ * Get the object id of a file as it is currently staged in the index.
+ *
+ * @param path The escaped path, relative to the root, of the file.
+ *
+ * @return The id as a stringshare or NULL if the file is not in the index.
+ * @ingroup Scm
+ */
+EAPI Eina_Stringshare *edi_scm_file_index_id_get(const char *path);
+
+/**
+ * Get the id of the commit currently checked out.
+ *
+ * @return The id as a stringshare or NULL if there is no commit yet.
+ * @ingroup Scm
+ */
+EAPI Eina_Stringshare *edi_scm_head_id_get(void);
+
+/**
+ * Pass the diff of a file in the working tree against HEAD line by line.
+ *
+ * The diff has no context lines so it can be used to map lines of HEAD to
+ * the current content of the file.
+ *
+ * @param path The escaped path of the file.
+ * @param cb The function called for each line of the diff.
+ * @param data The data passed to the callback.
+ *
+ * @return The status code of command executed.
+ * @ingroup Scm
+ */
+EAPI int edi_scm_diff_head_foreach(const char *path, Edi_Exe_Line_Cb cb, void *data);
+
+/**
+ * Find the commit that last changed each line of a file as of HEAD.
+ *
+ * The ranges are passed to the callback as they are found, in no
+ * particular order. Returning EINA_FALSE from the callback stops the blame.
+ *
+ * @param path The escaped path of the file.
+ * @param cb The function called for each range of lines.
+ * @param data The data passed to the callback.
+ *
+ * @return The status code of command executed.
+ * @ingroup Scm
+ */
+EAPI int edi_scm_blame_foreach(const char *path, Edi_Scm_Blame_Cb cb, void *data);
+
 /**
  * Move from src to dest.
  *
@@ -254,6 +506,104 @@ void edi_scm_push(void);
  */
 void edi_scm_pull(void);
 
+/**
+ * Push to SCM remote repository in the background, reporting its progress.
+ *
+ * The callbacks are called in the main loop. The job is freed once end_cb
+ * has returned.
+ *
+ * @param line_cb Called for each line of output, or NULL.
+ * @param progress_cb Called as the completion of each step changes, or NULL.
+ * @param end_cb Called with the status code of the command once it exits, or NULL.
+ * @param data The data passed to the callbacks.
+ * @return The running job, or NULL if it could not be started.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_Job *edi_scm_push_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_Progress_Cb progress_cb,
+                                   Edi_Scm_Job_End_Cb end_cb, const void *data);
+
+/**
+ * Pull from SCM remote repository in the background, reporting its progress.
+ *
+ * The callbacks are called in the main loop. The job is freed once end_cb
+ * has returned.
+ *
+ * @param line_cb Called for each line of output, or NULL.
+ * @param progress_cb Called as the completion of each step changes, or NULL.
+ * @param end_cb Called with the status code of the command once it exits, or NULL.
+ * @param data The data passed to the callbacks.
+ * @return The running job, or NULL if it could not be started.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_Job *edi_scm_pull_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_Progress_Cb progress_cb,
+                                   Edi_Scm_Job_End_Cb end_cb, const void *data);
+
+/**
+ * Show the SCM status of the working tree in the background.
+ *
+ * The callbacks are called in the main loop. The job is freed once end_cb
+ * has returned.
+ *
+ * @param line_cb Called for each line of output, or NULL.
+ * @param end_cb Called with the status code of the command once it exits, or NULL.
+ * @param data The data passed to the callbacks.
+ * @return The running job, or NULL if it could not be started.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_Job *edi_scm_status_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_End_Cb end_cb,
+                                     const void *data);
+
+/**
+ * Stash the local changes in the background, reporting its progress.
+ *
+ * The callbacks are called in the main loop. The job is freed once end_cb
+ * has returned.
+ *
+ * @param line_cb Called for each line of output, or NULL.
+ * @param progress_cb Called as the completion of each step changes, or NULL.
+ * @param end_cb Called with the status code of the command once it exits, or NULL.
+ * @param data The data passed to the callbacks.
+ * @return The running job, or NULL if it could not be started.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_Job *edi_scm_stash_job(Edi_Scm_Job_Line_Cb line_cb, Edi_Scm_Job_Progress_Cb progress_cb,
+                                    Edi_Scm_Job_End_Cb end_cb, const void *data);
+
+/**
+ * Clone an existing git repository in the background, reporting its progress.
+ *
+ * The callbacks are called in the main loop. The job is freed once end_cb
+ * has returned.
+ *
+ * @param url the URL to clone from.
+ * @param dir the new directory that will be created to clone into
+ * @param line_cb Called for each line of output, or NULL.
+ * @param progress_cb Called as the completion of each step changes, or NULL.
+ * @param end_cb Called with the status code of the command once it exits, or NULL.
+ * @param data The data passed to the callbacks.
+ * @return The running job, or NULL if it could not be started.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_Job *edi_scm_git_clone_job(const char *url, const char *dir, Edi_Scm_Job_Line_Cb line_cb,
+                                        Edi_Scm_Job_Progress_Cb progress_cb, Edi_Scm_Job_End_Cb end_cb,
+                                        const void *data);
+
+/**
+ * Cancel a background SCM job, terminating the commands it runs.
+ *
+ * The end callback of the job is still called, with cancelled set.
+ *
+ * @param job The job to cancel.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_job_cancel(Edi_Scm_Job *job);
+
 /**
  * Stash local changes.
  *
@@ -299,6 +649,21 @@ Eina_Bool edi_scm_remote_enabled(void);
  */
 const char *edi_scm_avatar_url_get(const char *email);
 
+/**
+ * Download an avatar image to a file, creating its directory if needed.
+ *
+ * The file is removed if the server does not return the image.
+ *
+ * @param url The URL of the image, as returned by edi_scm_avatar_url_get.
+ * @param path The file to save the image to.
+ * @param cb Called once the download is over, or NULL.
+ * @param data The data passed to the callback.
+ * @return EINA_FALSE if the download could not be started.
+ *
+ * @ingroup Scm
+ */
+Eina_Bool edi_scm_avatar_download(const char *url, const char *path, Edi_Scm_Avatar_Cb cb, void *data);
+
 
 /**
  * Return the root directory of the SCM.
@@ -0,0 +1,471 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+/*
+ * In-process implementation of the hot read paths of the git engine.
+ *
+ * Status, file status, diff and configuration lookups are answered from the
+ * repository directly instead of forking git. Everything that modifies the
+ * repository keeps using the git command line.
+ */
+
+#if HAVE_LIBGIT2
+
+#include <git2.h>
+
+#include <Eina.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+#include "edi_private.h"
+#include "edi_path.h"
+#include "edi_scm.h"
+
+static git_repository *_edi_scm_libgit2_repo = NULL;
+static Eina_Lock _edi_scm_libgit2_lock;
+
+static char *_edi_scm_libgit2_remote_name = NULL;
+static char *_edi_scm_libgit2_remote_email = NULL;
+static char *_edi_scm_libgit2_remote_url = NULL;
+
+static void
+_edi_scm_libgit2_status_chars(unsigned int flags, char *change)
+{
+   change[0] = ' ';
+   change[1] = ' ';
+
+   if (flags & GIT_STATUS_WT_NEW)
+     {
+        change[0] = change[1] = '?';
+        return;
+     }
+
+   if (flags & GIT_STATUS_INDEX_NEW)
+     change[0] = 'A';
+   else if (flags & GIT_STATUS_INDEX_RENAMED)
+     change[0] = 'R';
+   else if (flags & GIT_STATUS_INDEX_MODIFIED)
+     change[0] = 'M';
+   else if (flags & GIT_STATUS_INDEX_DELETED)
+     change[0] = 'D';
+   else if (flags & GIT_STATUS_INDEX_TYPECHANGE)
+     change[0] = 'T';
+
+   if (flags & GIT_STATUS_WT_RENAMED)
+     change[1] = 'R';
+   else if (flags & GIT_STATUS_WT_MODIFIED)
+     change[1] = 'M';
+   else if (flags & GIT_STATUS_WT_DELETED)
+     change[1] = 'D';
+   else if (flags & GIT_STATUS_WT_TYPECHANGE)
+     change[1] = 'T';
+}
+
+// Statuses use the git status --porcelain letters, so they share the classification.
+static Eina_Inarray *
+_edi_scm_libgit2_status_array_get(void)
+{
+   git_status_options opts = GIT_STATUS_OPTIONS_INIT;
+   git_status_list *list;
+   const git_status_entry *entry;
+   Eina_Inarray *statuses;
+   Edi_Scm_Status status;
+   const char *path;
+   char change[2];
+   size_t i, count;
+
+   opts.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
+   opts.flags = GIT_STATUS_OPT_INCLUDE_UNTRACKED | GIT_STATUS_OPT_RENAMES_HEAD_TO_INDEX |
+                GIT_STATUS_OPT_SORT_CASE_SENSITIVELY;
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   if (git_status_list_new(&list, _edi_scm_libgit2_repo, &opts) < 0)
+     {
+        eina_lock_release(&_edi_scm_libgit2_lock);
+        return NULL;
+     }
+
+   count = git_status_list_entrycount(list);
+   statuses = eina_inarray_new(sizeof(Edi_Scm_Status), count ? count : 1);
+   for (i = 0; i < count; i++)
+     {
+        entry = git_status_byindex(list, i);
+        if (entry->status == GIT_STATUS_CURRENT || entry->status & GIT_STATUS_IGNORED)
+          continue;
+
+        if (entry->index_to_workdir)
+          path = entry->index_to_workdir->new_file.path;
+        else
+          path = entry->head_to_index->new_file.path;
+
+        _edi_scm_libgit2_status_chars(entry->status, change);
+        _edi_scm_status_fill(&status, change, path, strlen(path));
+        eina_inarray_push(statuses, &status);
+     }
+
+   git_status_list_free(list);
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   return statuses;
+}
+
+// The engine API receives shell escaped paths, undo that for libgit2.
+static char *
+_edi_scm_libgit2_path_relative(const char *escaped)
+{
+   const char *root, *ptr;
+   char *path, *out;
+   size_t len;
+
+   path = out = malloc(strlen(escaped) + 1);
+   if (!path)
+     return NULL;
+
+   for (ptr = escaped; *ptr; ptr++)
+     {
+        if (*ptr == '\\' && ptr[1])
+          ptr++;
+        *out++ = *ptr;
+     }
+   *out = '\0';
+
+   root = edi_scm_engine_get()->root_directory;
+   len = strlen(root);
+   if (!strncmp(path, root, len) && path[len] == '/')
+     memmove(path, path + len + 1, strlen(path + len + 1) + 1);
+
+   return path;
+}
+
+static Edi_Scm_Status_Code
+_edi_scm_libgit2_file_status(const char *escaped)
+{
+   Edi_Scm_Status_Code result;
+   Eina_Bool staged;
+   unsigned int flags;
+   char change[2];
+   char *path;
+   int error;
+
+   path = _edi_scm_libgit2_path_relative(escaped);
+   if (!path)
+     return EDI_SCM_STATUS_NONE;
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   error = git_status_file(&flags, _edi_scm_libgit2_repo, path);
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   if (error < 0 || flags == GIT_STATUS_CURRENT || flags & GIT_STATUS_IGNORED)
+     {
+        free(path);
+        return EDI_SCM_STATUS_NONE;
+     }
+
+   _edi_scm_libgit2_status_chars(flags, change);
+   result = _edi_scm_status_code_get(change, &staged);
+
+   free(path);
+   return result;
+}
+
+static int
+_edi_scm_libgit2_diff_line_cb(const git_diff_delta *delta EINA_UNUSED, const git_diff_hunk *hunk EINA_UNUSED,
+                              const git_diff_line *line, void *payload)
+{
+   Eina_Strbuf *buf = payload;
+
+   if (line->origin == GIT_DIFF_LINE_CONTEXT || line->origin == GIT_DIFF_LINE_ADDITION ||
+       line->origin == GIT_DIFF_LINE_DELETION)
+     eina_strbuf_append_char(buf, line->origin);
+
+   eina_strbuf_append_length(buf, line->content, line->content_len);
+
+   return 0;
+}
+
+// Called with the repository lock held, path is relative and unescaped.
+static git_diff *
+_edi_scm_libgit2_diff_new(Eina_Bool cached, char *path)
+{
+   git_diff_options opts = GIT_DIFF_OPTIONS_INIT;
+   git_diff *diff = NULL;
+   git_object *head = NULL;
+   git_tree *tree = NULL;
+   int error;
+
+   if (path)
+     {
+        opts.flags |= GIT_DIFF_DISABLE_PATHSPEC_MATCH;
+        opts.pathspec.strings = &path;
+        opts.pathspec.count = 1;
+     }
+
+   if (cached)
+     {
+        // An unborn HEAD diffs the index against the empty tree.
+        if (!git_revparse_single(&head, _edi_scm_libgit2_repo, "HEAD^{tree}"))
+          tree = (git_tree *) head;
+
+        error = git_diff_tree_to_index(&diff, _edi_scm_libgit2_repo, tree, NULL, &opts);
+     }
+   else
+     error = git_diff_index_to_workdir(&diff, _edi_scm_libgit2_repo, NULL, &opts);
+
+   git_object_free(head);
+   if (error)
+     return NULL;
+
+   return diff;
+}
+
+static char *
+_edi_scm_libgit2_diff(Eina_Bool cached)
+{
+   git_diff *diff;
+   Eina_Strbuf *buf;
+   char *output;
+   size_t len;
+
+   buf = eina_strbuf_new();
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   diff = _edi_scm_libgit2_diff_new(cached, NULL);
+   if (diff)
+     git_diff_print(diff, GIT_DIFF_FORMAT_PATCH, _edi_scm_libgit2_diff_line_cb, buf);
+
+   git_diff_free(diff);
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   len = eina_strbuf_length_get(buf);
+   if (len && eina_strbuf_string_get(buf)[len - 1] == '\n')
+     eina_strbuf_remove(buf, len - 1, len);
+
+   output = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+
+   return output;
+}
+
+typedef struct _Edi_Scm_Libgit2_Lines
+{
+   Edi_Exe_Line_Cb cb;
+   void *data;
+   Eina_Strbuf *line;
+} Edi_Scm_Libgit2_Lines;
+
+// File headers arrive as several lines at once, split them for the caller.
+static int
+_edi_scm_libgit2_diff_foreach_cb(const git_diff_delta *delta EINA_UNUSED, const git_diff_hunk *hunk EINA_UNUSED,
+                                 const git_diff_line *line, void *payload)
+{
+   Edi_Scm_Libgit2_Lines *lines = payload;
+   const char *start, *end, *pos;
+
+   if (line->origin == GIT_DIFF_LINE_CONTEXT || line->origin == GIT_DIFF_LINE_ADDITION ||
+       line->origin == GIT_DIFF_LINE_DELETION)
+     eina_strbuf_append_char(lines->line, line->origin);
+
+   start = line->content;
+   end = line->content + line->content_len;
+   while ((pos = memchr(start, '\n', end - start)))
+     {
+        eina_strbuf_append_length(lines->line, start, pos - start);
+        if (!lines->cb(lines->data, eina_strbuf_string_get(lines->line),
+                       eina_strbuf_length_get(lines->line)))
+          return GIT_EUSER;
+
+        eina_strbuf_reset(lines->line);
+        start = pos + 1;
+     }
+   eina_strbuf_append_length(lines->line, start, end - start);
+
+   return 0;
+}
+
+static int
+_edi_scm_libgit2_diff_foreach(Eina_Bool cached, const char *escaped, Edi_Exe_Line_Cb cb, void *data)
+{
+   Edi_Scm_Libgit2_Lines lines;
+   git_diff *diff;
+   char *path = NULL;
+   int error = -1;
+
+   if (escaped && !(path = _edi_scm_libgit2_path_relative(escaped)))
+     return -1;
+
+   lines.cb = cb;
+   lines.data = data;
+   lines.line = eina_strbuf_new();
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   diff = _edi_scm_libgit2_diff_new(cached, path);
+   if (diff)
+     error = git_diff_print(diff, GIT_DIFF_FORMAT_PATCH, _edi_scm_libgit2_diff_foreach_cb, &lines);
+
+   git_diff_free(diff);
+   eina_lock_release(&_edi_scm_libgit2_lock);
+   free(path);
+
+   if (!error && eina_strbuf_length_get(lines.line))
+     cb(data, eina_strbuf_string_get(lines.line), eina_strbuf_length_get(lines.line));
+   eina_strbuf_free(lines.line);
+
+   if (error == GIT_EUSER)
+     return 0;
+
+   return error < 0 ? 1 : 0;
+}
+
+static Eina_Stringshare *
+_edi_scm_libgit2_file_index_id(const char *escaped)
+{
+   const git_index_entry *entry;
+   git_index *index;
+   Eina_Stringshare *id = NULL;
+   char *path;
+
+   path = _edi_scm_libgit2_path_relative(escaped);
+   if (!path)
+     return NULL;
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   if (!git_repository_index(&index, _edi_scm_libgit2_repo))
+     {
+        // Pick up anything staged by the git command since the last read.
+        git_index_read(index, 0);
+        entry = git_index_get_bypath(index, path, 0);
+        if (entry)
+          id = eina_stringshare_add(git_oid_tostr_s(&entry->id));
+
+        git_index_free(index);
+     }
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   free(path);
+   return id;
+}
+
+static Eina_Stringshare *
+_edi_scm_libgit2_head_id(void)
+{
+   Eina_Stringshare *id = NULL;
+   git_oid oid;
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   if (!git_reference_name_to_id(&oid, _edi_scm_libgit2_repo, "HEAD"))
+     id = eina_stringshare_add(git_oid_tostr_s(&oid));
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   return id;
+}
+
+static char *
+_edi_scm_libgit2_config_get(const char *name)
+{
+   git_config *config;
+   const char *value;
+   char *result = NULL;
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   if (!git_repository_config_snapshot(&config, _edi_scm_libgit2_repo))
+     {
+        if (!git_config_get_string(&value, config, name) && value[0])
+          result = strdup(value);
+
+        git_config_free(config);
+     }
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   return result;
+}
+
+static const char *
+_edi_scm_libgit2_remote_name_get(void)
+{
+   if (!_edi_scm_libgit2_remote_name)
+     _edi_scm_libgit2_remote_name = _edi_scm_libgit2_config_get("user.name");
+
+   return _edi_scm_libgit2_remote_name;
+}
+
+static const char *
+_edi_scm_libgit2_remote_email_get(void)
+{
+   if (!_edi_scm_libgit2_remote_email)
+     _edi_scm_libgit2_remote_email = _edi_scm_libgit2_config_get("user.email");
+
+   return _edi_scm_libgit2_remote_email;
+}
+
+static const char *
+_edi_scm_libgit2_remote_url_get(void)
+{
+   git_remote *remote;
+   const char *url;
+
+   if (_edi_scm_libgit2_remote_url)
+     return _edi_scm_libgit2_remote_url;
+
+   eina_lock_take(&_edi_scm_libgit2_lock);
+   if (!git_remote_lookup(&remote, _edi_scm_libgit2_repo, "origin"))
+     {
+        url = git_remote_url(remote);
+        if (url && url[0])
+          _edi_scm_libgit2_remote_url = strdup(url);
+
+        git_remote_free(remote);
+     }
+   eina_lock_release(&_edi_scm_libgit2_lock);
+
+   return _edi_scm_libgit2_remote_url;
+}
+
+void
+_edi_scm_libgit2_shutdown(void)
+{
+   if (!_edi_scm_libgit2_repo)
+     return;
+
+   git_repository_free(_edi_scm_libgit2_repo);
+   _edi_scm_libgit2_repo = NULL;
+
+   free(_edi_scm_libgit2_remote_name);
+   free(_edi_scm_libgit2_remote_email);
+   free(_edi_scm_libgit2_remote_url);
+   _edi_scm_libgit2_remote_name = _edi_scm_libgit2_remote_email = _edi_scm_libgit2_remote_url = NULL;
+
+   eina_lock_free(&_edi_scm_libgit2_lock);
+   git_libgit2_shutdown();
+}
+
+Eina_Bool
+_edi_scm_libgit2_setup(struct _Edi_Scm_Engine *engine)
+{
+   _edi_scm_libgit2_shutdown();
+
+   git_libgit2_init();
+   if (git_repository_open(&_edi_scm_libgit2_repo, engine->root_directory) < 0)
+     {
+        WRN("Could not open %s with libgit2, using the git command", engine->root_directory);
+        _edi_scm_libgit2_repo = NULL;
+        git_libgit2_shutdown();
+        return EINA_FALSE;
+     }
+   eina_lock_new(&_edi_scm_libgit2_lock);
+
+   engine->status_array_get = _edi_scm_libgit2_status_array_get;
+   engine->file_status = _edi_scm_libgit2_file_status;
+   engine->diff = _edi_scm_libgit2_diff;
+   engine->diff_foreach = _edi_scm_libgit2_diff_foreach;
+   engine->file_index_id = _edi_scm_libgit2_file_index_id;
+   engine->head_id = _edi_scm_libgit2_head_id;
+   engine->remote_name_get = _edi_scm_libgit2_remote_name_get;
+   engine->remote_email_get = _edi_scm_libgit2_remote_email_get;
+   engine->remote_url_get = _edi_scm_libgit2_remote_url_get;
+
+   INF("Using libgit2 for git queries in %s", engine->root_directory);
+   return EINA_TRUE;
+}
+
+#endif
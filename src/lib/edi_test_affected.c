@@ -0,0 +1,460 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+// The most targets given to a single "ninja -t query".
+#define EDI_TEST_AFFECTED_QUERY_BATCH 64
+
+static char *
+_edi_test_affected_build_dir_get(void)
+{
+   // The meson provider always builds in "build".
+   return edi_project_file_path_get("build");
+}
+
+EAPI Eina_Bool
+edi_test_affected_supported(void)
+{
+   Edi_Build_Provider *provider;
+   char *dir, *path;
+   Eina_Bool ret;
+
+   provider = edi_build_provider_for_project_get();
+   if (!provider || strcmp(provider->id, "meson"))
+     return EINA_FALSE;
+
+   dir = _edi_test_affected_build_dir_get();
+   path = edi_path_append(dir, "build.ninja");
+   ret = ecore_file_exists(path);
+
+   free(path);
+   free(dir);
+   return ret;
+}
+
+// Ninja keeps paths as they were written, so "../src/a.c" and "/p/src/a.c" need comparing by hand.
+static char *
+_edi_test_affected_path_normalise(const char *dir, const char *path, size_t length)
+{
+   const char *pos, *end, *next;
+   char *joined, *out;
+   size_t o = 0;
+
+   if (path[0] == '/' || !dir)
+     joined = strndup(path, length);
+   else
+     {
+        joined = malloc(strlen(dir) + length + 2);
+        sprintf(joined, "%s/%.*s", dir, (int) length, path);
+     }
+
+   out = malloc(strlen(joined) + 2);
+   end = joined + strlen(joined);
+   for (pos = joined; pos < end; pos = next + 1)
+     {
+        next = strchr(pos, '/');
+        if (!next)
+          next = end;
+
+        if (next == pos || (next - pos == 1 && pos[0] == '.'))
+          continue;
+        if (next - pos == 2 && pos[0] == '.' && pos[1] == '.')
+          {
+             while (o > 0 && out[--o] != '/')
+               ;
+             continue;
+          }
+
+        out[o++] = '/';
+        memcpy(out + o, pos, next - pos);
+        o += next - pos;
+     }
+
+   if (!o)
+     out[o++] = '/';
+   out[o] = '\0';
+
+   free(joined);
+   return out;
+}
+
+static Eina_Bool
+_edi_test_affected_hash_add(Eina_Hash *hash, const char *path)
+{
+   if (eina_hash_find(hash, path))
+     return EINA_FALSE;
+
+   eina_hash_add(hash, path, eina_stringshare_add(path));
+   return EINA_TRUE;
+}
+
+static void
+_edi_test_affected_hash_free_cb(void *data)
+{
+   eina_stringshare_del(data);
+}
+
+EAPI Eina_List *
+edi_test_affected_deps_find(const char *builddir, const char *deps, const Eina_Hash *changed)
+{
+   Eina_List *outputs = NULL;
+   const char *line, *end, *pos, *output = NULL;
+   size_t output_length = 0;
+   Eina_Bool found = EINA_FALSE;
+   char *path;
+
+   if (!deps || !changed)
+     return NULL;
+
+   for (line = deps; *line; line = *end ? end + 1 : end)
+     {
+        end = strchr(line, '\n');
+        if (!end)
+          end = line + strlen(line);
+
+        // Each output is followed by the files it was compiled from, indented.
+        if (*line != ' ')
+          {
+             pos = strstr(line, ": #deps ");
+             output = (pos && pos < end) ? line : NULL;
+             output_length = output ? (size_t) (pos - line) : 0;
+             found = EINA_FALSE;
+             continue;
+          }
+        if (!output || found)
+          continue;
+
+        for (pos = line; pos < end && *pos == ' '; pos++)
+          ;
+        if (pos == end)
+          continue;
+
+        path = _edi_test_affected_path_normalise(builddir, pos, end - pos);
+        if (eina_hash_find(changed, path))
+          {
+             outputs = eina_list_append(outputs, eina_stringshare_add_length(output, output_length));
+             found = EINA_TRUE;
+          }
+        free(path);
+     }
+
+   return outputs;
+}
+
+static Eina_List *
+_edi_test_affected_query_read(const char *query, unsigned int *answered)
+{
+   Eina_List *outputs = NULL;
+   const char *line, *end, *pos;
+   Eina_Bool in_outputs = EINA_FALSE;
+
+   if (answered)
+     *answered = 0;
+   if (!query)
+     return NULL;
+
+   for (line = query; *line; line = *end ? end + 1 : end)
+     {
+        end = strchr(line, '\n');
+        if (!end)
+          end = line + strlen(line);
+        if (end == line)
+          continue;
+
+        // A target, then its "input:" and "outputs:" sections listing files indented twice.
+        if (*line != ' ')
+          {
+             if (answered)
+               (*answered)++;
+             in_outputs = EINA_FALSE;
+             continue;
+          }
+        if (end - line < 4 || strncmp(line, "    ", 4))
+          {
+             in_outputs = end - line == 10 && !strncmp(line, "  outputs:", 10);
+             continue;
+          }
+        if (!in_outputs)
+          continue;
+
+        for (pos = line; pos < end && *pos == ' '; pos++)
+          ;
+        if (pos < end)
+          outputs = eina_list_append(outputs, eina_stringshare_add_length(pos, end - pos));
+     }
+
+   return outputs;
+}
+
+EAPI Eina_List *
+edi_test_affected_query_outputs_get(const char *query)
+{
+   return _edi_test_affected_query_read(query, NULL);
+}
+
+static Eina_Bool
+_edi_test_affected_cmd_used(const char *cmd, const Eina_Hash *used)
+{
+   const char *ptr, *end;
+   char *arg, *path;
+   Eina_Bool found = EINA_FALSE;
+
+   end = cmd + strlen(cmd);
+   ptr = _edi_json_space_skip(cmd, end);
+   if (ptr >= end || *ptr != '[')
+     return EINA_FALSE;
+   ptr++;
+
+   while (!found)
+     {
+        ptr = _edi_json_space_skip(ptr, end);
+        arg = _edi_json_string_read(&ptr, end);
+        if (!arg)
+          break;
+
+        if (arg[0] == '/')
+          {
+             path = _edi_test_affected_path_normalise(NULL, arg, strlen(arg));
+             found = !!eina_hash_find(used, path);
+             free(path);
+          }
+        free(arg);
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != ',')
+          break;
+        ptr++;
+     }
+
+   return found;
+}
+
+EAPI Eina_List *
+edi_test_affected_tests_find(const char *tests, const Eina_Hash *used)
+{
+   Eina_List *found = NULL;
+   const char *ptr, *end, *start;
+   char *name, *cmd;
+
+   if (!tests || !used)
+     return NULL;
+
+   end = tests + strlen(tests);
+   ptr = _edi_json_space_skip(tests, end);
+   if (ptr >= end || *ptr != '[')
+     return NULL;
+   ptr++;
+
+   while (1)
+     {
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != '{')
+          break;
+
+        start = ptr;
+        if (!_edi_json_value_skip(&ptr, end))
+          break;
+
+        // A test uses what it runs, be it the program built or a script and the files it is given.
+        name = _edi_json_field_get(start, ptr - start, "name");
+        cmd = _edi_json_field_get(start, ptr - start, "cmd");
+        if (name && cmd && _edi_test_affected_cmd_used(cmd, used) &&
+            !eina_list_search_unsorted(found, EINA_COMPARE_CB(strcmp), name))
+          found = eina_list_append(found, eina_stringshare_add(name));
+        free(name);
+        free(cmd);
+
+        ptr = _edi_json_space_skip(ptr, end);
+        if (ptr >= end || *ptr != ',')
+          break;
+        ptr++;
+     }
+
+   return found;
+}
+
+// Ninja names files in the source tree relative to the build directory.
+static const char *
+_edi_test_affected_node_get(const char *project, const char *builddir, const char *path)
+{
+   size_t length;
+
+   length = strlen(builddir);
+   if (!strncmp(path, builddir, length) && path[length] == '/')
+     return eina_stringshare_add(path + length + 1);
+
+   length = strlen(project);
+   if (!strncmp(path, project, length) && path[length] == '/')
+     return eina_stringshare_printf("../%s", path + length + 1);
+
+   return eina_stringshare_add(path);
+}
+
+static Eina_Bool
+_edi_test_affected_config_is(const char *path)
+{
+   const char *name;
+
+   name = ecore_file_file_get(path);
+
+   return !strcmp(name, "meson.build") || !strcmp(name, "meson_options.txt") ||
+          !strcmp(name, "meson.options");
+}
+
+static char *
+_edi_test_affected_query_command_get(const Eina_List *nodes, unsigned int *count)
+{
+   Eina_Strbuf *command;
+   const Eina_List *l;
+   const char *node;
+   char *escaped;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append(command, "ninja -t query");
+
+   *count = 0;
+   EINA_LIST_FOREACH(nodes, l, node)
+     {
+        if (*count == EDI_TEST_AFFECTED_QUERY_BATCH)
+          break;
+
+        escaped = ecore_file_escape_name(node);
+        eina_strbuf_append_printf(command, " %s", escaped);
+        free(escaped);
+        (*count)++;
+     }
+
+   return eina_strbuf_release(command);
+}
+
+// Follow what is built from each node until nothing more is, noting every file reached.
+static Eina_Bool
+_edi_test_affected_outputs_follow(const char *builddir, Eina_List *nodes, Eina_Hash *used)
+{
+   Eina_List *outputs, *l;
+   Eina_Hash *seen;
+   const char *node;
+   unsigned int count, answered, i;
+   char *command, *query, *path;
+   Eina_Bool ret = EINA_TRUE;
+
+   seen = eina_hash_string_superfast_new(_edi_test_affected_hash_free_cb);
+   EINA_LIST_FOREACH(nodes, l, node)
+     _edi_test_affected_hash_add(seen, node);
+
+   nodes = eina_list_clone(nodes);
+   while (nodes)
+     {
+        command = _edi_test_affected_query_command_get(nodes, &count);
+        query = edi_exe_output_in(builddir, command, NULL);
+        free(command);
+        if (!query)
+          {
+             ret = EINA_FALSE;
+             break;
+          }
+
+        // Ninja stops at the first file it does not know, such as a new one, which is skipped.
+        outputs = _edi_test_affected_query_read(query, &answered);
+        free(query);
+        if (answered < count)
+          count = answered + 1;
+        for (i = 0; i < count; i++)
+          nodes = eina_list_remove_list(nodes, nodes);
+
+        EINA_LIST_FREE(outputs, node)
+          {
+             if (_edi_test_affected_hash_add(seen, node))
+               {
+                  path = _edi_test_affected_path_normalise(builddir, node, strlen(node));
+                  _edi_test_affected_hash_add(used, path);
+                  free(path);
+
+                  nodes = eina_list_append(nodes, eina_hash_find(seen, node));
+               }
+             eina_stringshare_del(node);
+          }
+     }
+
+   eina_list_free(nodes);
+   eina_hash_free(seen);
+   return ret;
+}
+
+EAPI Eina_Bool
+edi_test_affected_get(const Eina_List *changed, Eina_List **tests)
+{
+   Eina_Hash *sources, *used;
+   Eina_List *nodes = NULL, *objects;
+   const Eina_List *l;
+   const char *file, *node;
+   char *builddir, *project, *path, *deps, *introspect;
+   Eina_Bool ret = EINA_FALSE;
+
+   *tests = NULL;
+   if (!edi_test_affected_supported())
+     return EINA_FALSE;
+
+   // A change to the build files can change any test.
+   EINA_LIST_FOREACH(changed, l, file)
+     {
+        if (_edi_test_affected_config_is(file))
+          return EINA_FALSE;
+     }
+
+   builddir = _edi_test_affected_build_dir_get();
+   project = _edi_test_affected_path_normalise(NULL, edi_project_get(), strlen(edi_project_get()));
+   sources = eina_hash_string_superfast_new(_edi_test_affected_hash_free_cb);
+   used = eina_hash_string_superfast_new(_edi_test_affected_hash_free_cb);
+
+   EINA_LIST_FOREACH(changed, l, file)
+     {
+        path = _edi_test_affected_path_normalise(project, file, strlen(file));
+        if (_edi_test_affected_hash_add(sources, path))
+          {
+             _edi_test_affected_hash_add(used, path);
+             nodes = eina_list_append(nodes, _edi_test_affected_node_get(project, builddir, path));
+          }
+        free(path);
+     }
+
+   // Headers are only known to ninja from the dependencies its compilers reported.
+   deps = edi_exe_output_in(builddir, "ninja -t deps", NULL);
+   if (!deps)
+     goto end;
+   objects = edi_test_affected_deps_find(builddir, deps, sources);
+   nodes = eina_list_merge(nodes, objects);
+   free(deps);
+
+   if (!_edi_test_affected_outputs_follow(builddir, nodes, used))
+     goto end;
+
+   introspect = edi_exe_output_in(builddir, "meson introspect --tests", NULL);
+   if (!introspect)
+     goto end;
+   if (*_edi_json_space_skip(introspect, introspect + strlen(introspect)) == '[')
+     {
+        *tests = edi_test_affected_tests_find(introspect, used);
+        ret = EINA_TRUE;
+     }
+   free(introspect);
+
+end:
+   EINA_LIST_FREE(nodes, node)
+     eina_stringshare_del(node);
+   eina_hash_free(used);
+   eina_hash_free(sources);
+   free(project);
+   free(builddir);
+
+   return ret;
+}
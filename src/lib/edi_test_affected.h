@@ -0,0 +1,87 @@
+#ifndef EDI_TEST_AFFECTED_H_
+# define EDI_TEST_AFFECTED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for finding the tests that changed files can affect.
+ */
+
+/**
+ * @brief Affected tests
+ * @defgroup Test_Affected
+ *
+ * @{
+ *
+ * Follow the build graph from changed files to the tests that use what they build.
+ *
+ */
+
+/**
+ * Check if the tests affected by changes can be found for the current project.
+ *
+ * @return EINA_TRUE for meson projects that have been configured.
+ *
+ * @ingroup Test_Affected
+ */
+EAPI Eina_Bool edi_test_affected_supported(void);
+
+/**
+ * Find the tests of the current project that use any of the files changed.
+ *
+ * This runs ninja and meson introspect and waits for them, so it is best
+ * called from a thread.
+ *
+ * @param changed A list of the absolute paths of the files changed.
+ * @param tests Where to store the list of stringshare names of the tests affected.
+ * @return EINA_FALSE if the changes cannot be followed and every test should run.
+ *
+ * @ingroup Test_Affected
+ */
+EAPI Eina_Bool edi_test_affected_get(const Eina_List *changed, Eina_List **tests);
+
+/**
+ * Find the outputs that were compiled from any of the files changed.
+ *
+ * @param builddir The absolute path of the build directory.
+ * @param deps The output of "ninja -t deps".
+ * @param changed A hash of the absolute paths of the files changed.
+ * @return A list of the stringshare outputs, relative to the build directory.
+ *
+ * @ingroup Test_Affected
+ */
+EAPI Eina_List *edi_test_affected_deps_find(const char *builddir, const char *deps, const Eina_Hash *changed);
+
+/**
+ * Read the outputs built from the targets of "ninja -t query".
+ *
+ * @param query The output of "ninja -t query".
+ * @return A list of the stringshare outputs, relative to the build directory.
+ *
+ * @ingroup Test_Affected
+ */
+EAPI Eina_List *edi_test_affected_query_outputs_get(const char *query);
+
+/**
+ * Find the tests that run a file built or changed.
+ *
+ * @param tests The output of "meson introspect --tests".
+ * @param used A hash of the absolute paths of the files built or changed.
+ * @return A list of the stringshare names of the tests running any of the files.
+ *
+ * @ingroup Test_Affected
+ */
+EAPI Eina_List *edi_test_affected_tests_find(const char *tests, const Eina_Hash *used);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_TEST_AFFECTED_H_ */
@@ -0,0 +1,1058 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+#include <Efreet.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+// The name meson gives the logs of a run, in the meson-logs of the build directory.
+#define EDI_TEST_RUNNER_MESON_LOG "edi-tests"
+
+typedef struct _Edi_Test_Runner_Shard
+{
+   Edi_Exe_Process *process;
+   Eina_Strbuf *partial[2];
+   double last;
+} Edi_Test_Runner_Shard;
+
+static struct {
+   const char *provider;
+   Eina_Bool running, cancelled;
+   int status;
+
+   Edi_Test_Runner_Shard list;
+   Eina_List *names;
+
+   Eina_List *shards;
+   Eina_List *results;
+
+   Edi_Test_Runner_Done_Cb done_cb;
+   void *done_data;
+
+   Edi_Test_Runner_Output_Cb output_cb;
+   Edi_Test_Runner_Case_Cb case_cb;
+   Edi_Test_Runner_Finished_Cb finished_cb;
+   void *data;
+
+   // Kept between runs.
+   Eina_List *failed;
+   Eina_Hash *durations;
+   char *report;
+} _edi_test_runner;
+
+typedef struct _Edi_Test_Runner_Affected
+{
+   Eina_List *tests;
+   Eina_Bool found;
+} Edi_Test_Runner_Affected;
+
+typedef void (*Edi_Test_Runner_Line_Cb)(Edi_Test_Runner_Shard *shard, const char *line, Eina_Bool err);
+
+static void
+_edi_test_runner_output(const char *line, Eina_Bool err)
+{
+   if (_edi_test_runner.output_cb)
+     _edi_test_runner.output_cb(_edi_test_runner.data, line, err);
+   _edi_build_server_output(line, err);
+}
+
+static char *
+_edi_test_runner_build_dir_get(void)
+{
+   // The meson provider always builds in "build".
+   return edi_project_file_path_get("build");
+}
+
+static char *
+_edi_test_runner_meson_log_get(void)
+{
+   char *dir, *path;
+
+   dir = _edi_test_runner_build_dir_get();
+   path = malloc(PATH_MAX);
+   snprintf(path, PATH_MAX, "%s/meson-logs/" EDI_TEST_RUNNER_MESON_LOG ".json", dir);
+   free(dir);
+
+   return path;
+}
+
+static char *
+_edi_test_runner_report_path_get(void)
+{
+   char *dir, *path;
+
+   dir = malloc(PATH_MAX);
+   snprintf(dir, PATH_MAX, "%s/%s/%s", efreet_cache_home_get(), PACKAGE_NAME,
+            edi_project_name_get());
+   if (!ecore_file_exists(dir) && !ecore_file_mkpath(dir))
+     {
+        free(dir);
+        return NULL;
+     }
+
+   path = edi_path_append(dir, "test-results.xml");
+   free(dir);
+   return path;
+}
+
+// Meson prefixes the suites of a test when a project has several of them.
+static const char *
+_edi_test_runner_meson_name_get(const char *name)
+{
+   const char *pos, *last = name;
+
+   while ((pos = strstr(last, " / ")))
+     last = pos + 3;
+
+   return last;
+}
+
+static Eina_Bool
+_edi_test_runner_go_name_is(const char *line, size_t length)
+{
+   size_t i;
+
+   if (length > 4 && !strncmp(line, "Test", 4))
+     ;
+   else if (length > 7 && !strncmp(line, "Example", 7))
+     ;
+   else if (length > 4 && !strncmp(line, "Fuzz", 4))
+     ;
+   else
+     return EINA_FALSE;
+
+   for (i = 0; i < length; i++)
+     {
+        if (!isalnum(line[i]) && line[i] != '_')
+          return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+EAPI const char *
+edi_test_runner_list_line_parse(const char *provider, const char *line, size_t length)
+{
+   if (!provider || !line)
+     return NULL;
+
+   while (length && (line[length - 1] == '\r' || line[length - 1] == ' '))
+     length--;
+
+   // Benchmarks are listed too, but only run when asked for.
+   if (!strcmp(provider, "go"))
+     {
+        if (_edi_test_runner_go_name_is(line, length))
+          return eina_stringshare_add_length(line, length);
+     }
+   else if (!strcmp(provider, "cargo"))
+     {
+        if (length > 6 && !strncmp(line + length - 6, ": test", 6))
+          return eina_stringshare_add_length(line, length - 6);
+     }
+
+   return NULL;
+}
+
+static Edi_Test_Case *
+_edi_test_runner_case_new(const char *name, size_t length, Edi_Test_Result result, double duration)
+{
+   Edi_Test_Case *test;
+
+   test = calloc(1, sizeof(Edi_Test_Case));
+   test->name = eina_stringshare_add_length(name, length);
+   test->result = result;
+   test->duration = duration;
+
+   return test;
+}
+
+static Edi_Test_Case *
+_edi_test_runner_go_parse(const char *line, size_t length)
+{
+   Edi_Test_Case *test = NULL;
+   char *action, *name, *elapsed;
+   Edi_Test_Result result;
+
+   action = _edi_json_field_get(line, length, "Action");
+   if (!action)
+     return NULL;
+
+   if (!strcmp(action, "pass"))
+     result = EDI_TEST_RESULT_PASS;
+   else if (!strcmp(action, "fail"))
+     result = EDI_TEST_RESULT_FAIL;
+   else if (!strcmp(action, "skip"))
+     result = EDI_TEST_RESULT_SKIP;
+   else
+     {
+        free(action);
+        return NULL;
+     }
+   free(action);
+
+   // Package results have no test and subtests are part of their parent.
+   name = _edi_json_field_get(line, length, "Test");
+   if (name && !strchr(name, '/'))
+     {
+        elapsed = _edi_json_field_get(line, length, "Elapsed");
+        test = _edi_test_runner_case_new(name, strlen(name), result, elapsed ? atof(elapsed) : -1.0);
+        free(elapsed);
+     }
+   free(name);
+
+   return test;
+}
+
+static Edi_Test_Case *
+_edi_test_runner_cargo_parse(const char *line, size_t length)
+{
+   const char *pos, *outcome = NULL;
+   Edi_Test_Result result;
+   size_t name_length;
+
+   if (length < 5 || strncmp(line, "test ", 5))
+     return NULL;
+
+   for (pos = line + 5; pos + 5 <= line + length; pos++)
+     {
+        if (!strncmp(pos, " ... ", 5))
+          outcome = pos;
+     }
+   if (!outcome)
+     return NULL;
+   name_length = outcome - line - 5;
+   outcome += 5;
+   length -= outcome - line;
+
+   if (length >= 2 && !strncmp(outcome, "ok", 2))
+     result = EDI_TEST_RESULT_PASS;
+   else if (length >= 6 && !strncmp(outcome, "FAILED", 6))
+     result = EDI_TEST_RESULT_FAIL;
+   else if (length >= 7 && !strncmp(outcome, "ignored", 7))
+     result = EDI_TEST_RESULT_SKIP;
+   else
+     return NULL;
+
+   // libtest does not report durations, the runner times the results as they arrive.
+   return _edi_test_runner_case_new(line + 5, name_length, result, -1.0);
+}
+
+static Edi_Test_Case *
+_edi_test_runner_meson_parse(const char *line, size_t length)
+{
+   Edi_Test_Case *test;
+   char *name, *outcome, *duration;
+   const char *short_name;
+   Edi_Test_Result result;
+
+   name = _edi_json_field_get(line, length, "name");
+   outcome = _edi_json_field_get(line, length, "result");
+   if (!name || !outcome)
+     {
+        free(name);
+        free(outcome);
+        return NULL;
+     }
+
+   if (!strcmp(outcome, "OK") || !strcmp(outcome, "EXPECTEDFAIL"))
+     result = EDI_TEST_RESULT_PASS;
+   else if (!strcmp(outcome, "SKIP"))
+     result = EDI_TEST_RESULT_SKIP;
+   else
+     result = EDI_TEST_RESULT_FAIL;
+
+   duration = _edi_json_field_get(line, length, "duration");
+   short_name = _edi_test_runner_meson_name_get(name);
+   test = _edi_test_runner_case_new(short_name, strlen(short_name), result, duration ? atof(duration) : -1.0);
+
+   free(duration);
+   free(outcome);
+   free(name);
+   return test;
+}
+
+EAPI Edi_Test_Case *
+edi_test_runner_result_line_parse(const char *provider, const char *line, size_t length)
+{
+   if (!provider || !line)
+     return NULL;
+
+   while (length && line[length - 1] == '\r')
+     length--;
+
+   if (!strcmp(provider, "go"))
+     return _edi_test_runner_go_parse(line, length);
+   if (!strcmp(provider, "cargo"))
+     return _edi_test_runner_cargo_parse(line, length);
+   if (!strcmp(provider, "meson"))
+     return _edi_test_runner_meson_parse(line, length);
+
+   return NULL;
+}
+
+EAPI void
+edi_test_runner_case_free(Edi_Test_Case *test)
+{
+   if (!test)
+     return;
+
+   eina_stringshare_del(test->name);
+   free(test);
+}
+
+static void
+_edi_test_runner_xml_escape(FILE *file, const char *text)
+{
+   for (; *text; text++)
+     {
+        switch (*text)
+          {
+           case '&': fputs("&amp;", file); break;
+           case '<': fputs("&lt;", file); break;
+           case '>': fputs("&gt;", file); break;
+           case '"': fputs("&quot;", file); break;
+           default: fputc(*text, file); break;
+          }
+     }
+}
+
+EAPI Eina_Bool
+edi_test_runner_junit_write(const Eina_List *results, const char *path)
+{
+   const Eina_List *l;
+   Edi_Test_Case *test;
+   unsigned int failures = 0, skipped = 0;
+   double time = 0.0;
+   FILE *file;
+
+   if (!path)
+     return EINA_FALSE;
+
+   file = fopen(path, "w");
+   if (!file)
+     return EINA_FALSE;
+
+   EINA_LIST_FOREACH(results, l, test)
+     {
+        if (test->result == EDI_TEST_RESULT_FAIL)
+          failures++;
+        else if (test->result == EDI_TEST_RESULT_SKIP)
+          skipped++;
+        if (test->duration > 0)
+          time += test->duration;
+     }
+
+   fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+   fprintf(file, "<testsuites tests=\"%u\" failures=\"%u\" skipped=\"%u\" time=\"%.3f\">\n",
+           eina_list_count(results), failures, skipped, time);
+   fprintf(file, "  <testsuite name=\"");
+   _edi_test_runner_xml_escape(file, edi_project_name_get() ?: PACKAGE_NAME);
+   fprintf(file, "\" tests=\"%u\" failures=\"%u\" skipped=\"%u\" time=\"%.3f\">\n",
+           eina_list_count(results), failures, skipped, time);
+
+   EINA_LIST_FOREACH(results, l, test)
+     {
+        fprintf(file, "    <testcase name=\"");
+        _edi_test_runner_xml_escape(file, test->name);
+        fprintf(file, "\" time=\"%.3f\"", test->duration > 0 ? test->duration : 0.0);
+
+        if (test->result == EDI_TEST_RESULT_FAIL)
+          fprintf(file, ">\n      <failure/>\n    </testcase>\n");
+        else if (test->result == EDI_TEST_RESULT_SKIP)
+          fprintf(file, ">\n      <skipped/>\n    </testcase>\n");
+        else
+          fprintf(file, "/>\n");
+     }
+
+   fprintf(file, "  </testsuite>\n</testsuites>\n");
+
+   return !fclose(file);
+}
+
+static void
+_edi_test_runner_case_add(Edi_Test_Runner_Shard *shard, Edi_Test_Case *test)
+{
+   double now, *duration;
+
+   // Without a duration the test ran since the previous result of its shard.
+   now = ecore_time_get();
+   if (test->duration < 0 && shard->last > 0)
+     test->duration = now - shard->last;
+   shard->last = now;
+
+   if (test->duration >= 0)
+     {
+        duration = eina_hash_find(_edi_test_runner.durations, test->name);
+        if (!duration)
+          {
+             duration = malloc(sizeof(double));
+             eina_hash_add(_edi_test_runner.durations, test->name, duration);
+          }
+        *duration = test->duration;
+     }
+
+   _edi_test_runner.results = eina_list_append(_edi_test_runner.results, test);
+   if (_edi_test_runner.case_cb)
+     _edi_test_runner.case_cb(_edi_test_runner.data, test);
+}
+
+static void
+_edi_test_runner_shard_line_cb(Edi_Test_Runner_Shard *shard, const char *line, Eina_Bool err)
+{
+   Edi_Test_Case *test;
+   char *output;
+   size_t length;
+
+   length = strlen(line);
+   test = edi_test_runner_result_line_parse(_edi_test_runner.provider, line, length);
+   if (test)
+     _edi_test_runner_case_add(shard, test);
+   // Each test binary announces its tests once it has been built and started.
+   else if (!err && !strncmp(line, "running ", 8))
+     shard->last = ecore_time_get();
+
+   // Show what go tests print rather than the events it is wrapped in.
+   if (!err && !strcmp(_edi_test_runner.provider, "go") && line[0] == '{')
+     {
+        output = _edi_json_field_get(line, length, "Output");
+        if (output)
+          {
+             length = strlen(output);
+             if (length && output[length - 1] == '\n')
+               output[length - 1] = '\0';
+             _edi_test_runner_output(output, EINA_FALSE);
+             free(output);
+          }
+        return;
+     }
+
+   _edi_test_runner_output(line, err);
+}
+
+static void
+_edi_test_runner_list_line_cb(Edi_Test_Runner_Shard *shard EINA_UNUSED, const char *line, Eina_Bool err)
+{
+   const char *name;
+
+   name = err ? NULL : edi_test_runner_list_line_parse(_edi_test_runner.provider, line, strlen(line));
+   if (!name)
+     {
+        _edi_test_runner_output(line, err);
+        return;
+     }
+
+   // The same test name can be found in several packages, -run matches them all.
+   if (eina_list_data_find(_edi_test_runner.names, name))
+     eina_stringshare_del(name);
+   else
+     _edi_test_runner.names = eina_list_append(_edi_test_runner.names, name);
+}
+
+static void
+_edi_test_runner_lines_read(Edi_Test_Runner_Shard *shard, Edi_Exe_Stream stream, const char *buf,
+                            size_t length, Edi_Test_Runner_Line_Cb cb)
+{
+   Eina_Strbuf *partial;
+   const char *start, *end;
+   char *line;
+
+   partial = shard->partial[stream];
+   if (buf)
+     eina_strbuf_append_length(partial, buf, length);
+
+   start = eina_strbuf_string_get(partial);
+   while ((end = strchr(start, '\n')) || (!buf && *start))
+     {
+        if (!end)
+          end = start + strlen(start);
+
+        line = strndup(start, end - start);
+        if (end > start && line[end - start - 1] == '\r')
+          line[end - start - 1] = '\0';
+        cb(shard, line, stream == EDI_EXE_STREAM_ERROR);
+        free(line);
+
+        start = *end ? end + 1 : end;
+     }
+
+   eina_strbuf_remove(partial, 0, start - eina_strbuf_string_get(partial));
+}
+
+static void
+_edi_test_runner_shard_data_cb(void *data, Edi_Exe_Stream stream, const char *buf, size_t length)
+{
+   _edi_test_runner_lines_read(data, stream, buf, length, _edi_test_runner_shard_line_cb);
+}
+
+static void
+_edi_test_runner_list_data_cb(void *data, Edi_Exe_Stream stream, const char *buf, size_t length)
+{
+   _edi_test_runner_lines_read(data, stream, buf, length, _edi_test_runner_list_line_cb);
+}
+
+static void
+_edi_test_runner_shard_clear(Edi_Test_Runner_Shard *shard)
+{
+   eina_strbuf_free(shard->partial[EDI_EXE_STREAM_OUTPUT]);
+   eina_strbuf_free(shard->partial[EDI_EXE_STREAM_ERROR]);
+   memset(shard, 0, sizeof(Edi_Test_Runner_Shard));
+}
+
+static void
+_edi_test_runner_shard_init(Edi_Test_Runner_Shard *shard)
+{
+   shard->partial[EDI_EXE_STREAM_OUTPUT] = eina_strbuf_new();
+   shard->partial[EDI_EXE_STREAM_ERROR] = eina_strbuf_new();
+   shard->last = ecore_time_get();
+}
+
+static void
+_edi_test_runner_meson_log_read(Edi_Test_Runner_Shard *shard)
+{
+   Eina_File *file;
+   Eina_File_Line *line;
+   Eina_Iterator *it;
+   Edi_Test_Case *test;
+   char *path;
+
+   path = _edi_test_runner_meson_log_get();
+   file = eina_file_open(path, EINA_FALSE);
+   free(path);
+   if (!file)
+     return;
+
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        test = _edi_test_runner_meson_parse(line->start, line->length);
+        if (test)
+          _edi_test_runner_case_add(shard, test);
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+}
+
+static void
+_edi_test_runner_reset(void)
+{
+   const char *name;
+
+   EINA_LIST_FREE(_edi_test_runner.names, name)
+     eina_stringshare_del(name);
+
+   _edi_test_runner.provider = NULL;
+   _edi_test_runner.running = EINA_FALSE;
+   _edi_test_runner.cancelled = EINA_FALSE;
+   _edi_test_runner.status = 0;
+   _edi_test_runner.done_cb = NULL;
+   _edi_test_runner.done_data = NULL;
+}
+
+static void
+_edi_test_runner_finish(void)
+{
+   Edi_Test_Runner_Done_Cb done_cb;
+   Edi_Test_Case *test;
+   const char *name;
+   Eina_List *l;
+   void *done_data;
+   int status;
+
+   status = _edi_test_runner.status;
+
+   // A run that was stopped, or ran nothing, leaves the failures to run again as they were.
+   if (!_edi_test_runner.cancelled && _edi_test_runner.results)
+     {
+        EINA_LIST_FREE(_edi_test_runner.failed, name)
+          eina_stringshare_del(name);
+        EINA_LIST_FOREACH(_edi_test_runner.results, l, test)
+          {
+             if (test->result == EDI_TEST_RESULT_FAIL)
+               _edi_test_runner.failed = eina_list_append(_edi_test_runner.failed,
+                                                          eina_stringshare_ref(test->name));
+          }
+        if (!status && _edi_test_runner.failed)
+          status = 1;
+
+        free(_edi_test_runner.report);
+        _edi_test_runner.report = _edi_test_runner_report_path_get();
+        if (!edi_test_runner_junit_write(_edi_test_runner.results, _edi_test_runner.report))
+          {
+             free(_edi_test_runner.report);
+             _edi_test_runner.report = NULL;
+          }
+     }
+
+   if (_edi_test_runner.finished_cb)
+     _edi_test_runner.finished_cb(_edi_test_runner.data, _edi_test_runner.results);
+
+   done_cb = _edi_test_runner.done_cb;
+   done_data = _edi_test_runner.done_data;
+   _edi_test_runner_reset();
+
+   if (done_cb)
+     done_cb(status, done_data);
+}
+
+static void
+_edi_test_runner_shard_done_cb(void *data, int code, Eina_Bool timed_out EINA_UNUSED)
+{
+   Edi_Test_Runner_Shard *shard = data;
+
+   _edi_test_runner_lines_read(shard, EDI_EXE_STREAM_OUTPUT, NULL, 0, _edi_test_runner_shard_line_cb);
+   _edi_test_runner_lines_read(shard, EDI_EXE_STREAM_ERROR, NULL, 0, _edi_test_runner_shard_line_cb);
+
+   if (!strcmp(_edi_test_runner.provider, "meson"))
+     _edi_test_runner_meson_log_read(shard);
+
+   if (code && !_edi_test_runner.status)
+     _edi_test_runner.status = code;
+
+   _edi_test_runner.shards = eina_list_remove(_edi_test_runner.shards, shard);
+   _edi_test_runner_shard_clear(shard);
+   free(shard);
+
+   if (!_edi_test_runner.shards)
+     _edi_test_runner_finish();
+}
+
+static void
+_edi_test_runner_name_append(Eina_Strbuf *command, const char *name)
+{
+   char *escaped;
+
+   escaped = ecore_file_escape_name(name);
+   eina_strbuf_append_printf(command, " %s", escaped);
+   free(escaped);
+}
+
+static char *
+_edi_test_runner_command_get(const Eina_List *names)
+{
+   Eina_Strbuf *command;
+   const Eina_List *l;
+   const char *name;
+   char *dir;
+
+   command = eina_strbuf_new();
+   if (!strcmp(_edi_test_runner.provider, "meson"))
+     {
+        dir = _edi_test_runner_build_dir_get();
+        eina_strbuf_append(command, "meson test -C ");
+        _edi_test_runner_name_append(command, dir);
+        eina_strbuf_append(command, " --print-errorlogs --logbase " EDI_TEST_RUNNER_MESON_LOG);
+        free(dir);
+
+        EINA_LIST_FOREACH(names, l, name)
+          _edi_test_runner_name_append(command, name);
+     }
+   else if (!strcmp(_edi_test_runner.provider, "go"))
+     {
+        eina_strbuf_append(command, "go test -json");
+        EINA_LIST_FOREACH(names, l, name)
+          eina_strbuf_append_printf(command, "%s%s", l == names ? " -run '^(" : "|", name);
+        if (names)
+          eina_strbuf_append(command, ")$'");
+        eina_strbuf_append(command, " ./...");
+     }
+   else
+     {
+        // One thread keeps the results of a shard in the order they ran, for timing them.
+        eina_strbuf_append(command, "cargo test -- --test-threads=1");
+        if (names)
+          eina_strbuf_append(command, " --exact");
+        EINA_LIST_FOREACH(names, l, name)
+          _edi_test_runner_name_append(command, name);
+     }
+
+   return eina_strbuf_release(command);
+}
+
+static double
+_edi_test_runner_duration_get(const char *name)
+{
+   double *duration;
+
+   duration = eina_hash_find(_edi_test_runner.durations, name);
+
+   return duration ? *duration : 0.0;
+}
+
+static int
+_edi_test_runner_duration_cmp(const void *data1, const void *data2)
+{
+   double duration1, duration2;
+
+   duration1 = _edi_test_runner_duration_get(data1);
+   duration2 = _edi_test_runner_duration_get(data2);
+
+   return (duration1 < duration2) - (duration1 > duration2);
+}
+
+// Deal the slowest tests first, each to the shard with the least work so far.
+static Eina_List **
+_edi_test_runner_shards_split(const Eina_List *names, unsigned int *count)
+{
+   Eina_List **shards, *sorted, *l;
+   double *load;
+   const char *name;
+   unsigned int i, least;
+
+   *count = eina_cpu_count();
+   if (*count > eina_list_count(names))
+     *count = eina_list_count(names);
+   if (*count < 1)
+     *count = 1;
+
+   shards = calloc(*count, sizeof(Eina_List *));
+   load = calloc(*count, sizeof(double));
+
+   sorted = eina_list_sort(eina_list_clone(names), 0, _edi_test_runner_duration_cmp);
+   EINA_LIST_FOREACH(sorted, l, name)
+     {
+        least = 0;
+        for (i = 1; i < *count; i++)
+          {
+             if (load[i] < load[least])
+               least = i;
+          }
+
+        // Tests never timed still count for something, so they are spread evenly.
+        load[least] += _edi_test_runner_duration_get(name) + 0.001;
+        shards[least] = eina_list_append(shards[least], name);
+     }
+
+   eina_list_free(sorted);
+   free(load);
+   return shards;
+}
+
+static unsigned int
+_edi_test_runner_shards_start(const Eina_List *names)
+{
+   Edi_Test_Runner_Shard *shard;
+   Eina_List **split;
+   unsigned int count, i;
+   char *command;
+
+   // Meson runs its tests in parallel, a shard each would rebuild concurrently.
+   if (!strcmp(_edi_test_runner.provider, "meson") || !names)
+     {
+        split = calloc(1, sizeof(Eina_List *));
+        split[0] = eina_list_clone(names);
+        count = 1;
+     }
+   else
+     split = _edi_test_runner_shards_split(names, &count);
+
+   for (i = 0; i < count; i++)
+     {
+        shard = calloc(1, sizeof(Edi_Test_Runner_Shard));
+        _edi_test_runner_shard_init(shard);
+
+        command = _edi_test_runner_command_get(split[i]);
+        shard->process = edi_exe_run(edi_project_get(), NULL, command, 0,
+                                     _edi_test_runner_shard_data_cb,
+                                     _edi_test_runner_shard_done_cb, shard);
+        free(command);
+        eina_list_free(split[i]);
+
+        if (!shard->process)
+          {
+             _edi_test_runner_shard_clear(shard);
+             free(shard);
+             _edi_test_runner.status = -1;
+             continue;
+          }
+
+        _edi_test_runner.shards = eina_list_append(_edi_test_runner.shards, shard);
+     }
+
+   free(split);
+   return eina_list_count(_edi_test_runner.shards);
+}
+
+static void
+_edi_test_runner_list_done_cb(void *data EINA_UNUSED, int code, Eina_Bool timed_out EINA_UNUSED)
+{
+   Edi_Test_Runner_Shard *list = &_edi_test_runner.list;
+
+   _edi_test_runner_lines_read(list, EDI_EXE_STREAM_OUTPUT, NULL, 0, _edi_test_runner_list_line_cb);
+   _edi_test_runner_lines_read(list, EDI_EXE_STREAM_ERROR, NULL, 0, _edi_test_runner_list_line_cb);
+   _edi_test_runner_shard_clear(list);
+
+   if (_edi_test_runner.cancelled || code)
+     {
+        _edi_test_runner.status = code ? code : -1;
+        _edi_test_runner_finish();
+        return;
+     }
+
+   // Nothing listed is run whole, which still reports what it finds.
+   if (!_edi_test_runner_shards_start(_edi_test_runner.names))
+     _edi_test_runner_finish();
+}
+
+static const char *
+_edi_test_runner_list_command_get(void)
+{
+   if (!strcmp(_edi_test_runner.provider, "go"))
+     return "go test -list . ./...";
+   if (!strcmp(_edi_test_runner.provider, "cargo"))
+     return "cargo test -- --list";
+
+   return NULL;
+}
+
+static void
+_edi_test_runner_duration_free(void *data)
+{
+   free(data);
+}
+
+EAPI void
+edi_test_runner_callbacks_set(Edi_Test_Runner_Output_Cb output_cb,
+                              Edi_Test_Runner_Case_Cb case_cb,
+                              Edi_Test_Runner_Finished_Cb finished_cb, void *data)
+{
+   _edi_test_runner.output_cb = output_cb;
+   _edi_test_runner.case_cb = case_cb;
+   _edi_test_runner.finished_cb = finished_cb;
+   _edi_test_runner.data = data;
+}
+
+static const char *
+_edi_test_runner_provider_get(void)
+{
+   Edi_Build_Provider *provider;
+
+   provider = edi_build_provider_for_project_get();
+   if (!provider)
+     return NULL;
+
+   if (!strcmp(provider->id, "meson") || !strcmp(provider->id, "go") ||
+       !strcmp(provider->id, "cargo"))
+     return provider->id;
+
+   return NULL;
+}
+
+EAPI Eina_Bool
+edi_test_runner_supported(void)
+{
+   return !!_edi_test_runner_provider_get();
+}
+
+static Eina_Bool
+_edi_test_runner_all_start(void)
+{
+   const char *command;
+
+   // Meson shards are not split, so its tests need not be known beforehand.
+   command = _edi_test_runner_list_command_get();
+   if (!command)
+     return _edi_test_runner_shards_start(NULL) > 0;
+
+   _edi_test_runner_shard_init(&_edi_test_runner.list);
+   _edi_test_runner.list.process = edi_exe_run(edi_project_get(), NULL, command, 0,
+                                               _edi_test_runner_list_data_cb,
+                                               _edi_test_runner_list_done_cb, &_edi_test_runner.list);
+   if (!_edi_test_runner.list.process)
+     {
+        _edi_test_runner_shard_clear(&_edi_test_runner.list);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_test_runner_affected_thread_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Test_Runner_Affected *affected = data;
+   Edi_Scm_Engine *engine;
+   Edi_Scm_Status *status;
+   Eina_Inarray *statuses;
+   Eina_List *changed = NULL;
+   const char *path;
+
+   engine = edi_scm_engine_get();
+   statuses = edi_scm_status_array_get();
+   if (!statuses)
+     return;
+
+   // Modified, added and removed files alike, staged or not.
+   EINA_INARRAY_FOREACH(statuses, status)
+     changed = eina_list_append(changed, eina_stringshare_printf("%s/%s", engine->root_directory,
+                                                                 status->unescaped));
+   edi_scm_status_array_free(statuses);
+
+   affected->found = edi_test_affected_get(changed, &affected->tests);
+
+   EINA_LIST_FREE(changed, path)
+     eina_stringshare_del(path);
+}
+
+static void
+_edi_test_runner_affected_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Test_Runner_Affected *affected = data;
+   const char *name;
+   char message[128];
+
+   if (_edi_test_runner.cancelled)
+     {
+        _edi_test_runner.status = -1;
+        _edi_test_runner_finish();
+     }
+   else if (!affected->found)
+     {
+        _edi_test_runner_output("The tests affected by the changes could not be found, running them all.", EINA_FALSE);
+        if (!_edi_test_runner_all_start())
+          {
+             _edi_test_runner.status = -1;
+             _edi_test_runner_finish();
+          }
+     }
+   else if (!affected->tests)
+     {
+        _edi_test_runner_output("No tests are affected by the changes.", EINA_FALSE);
+        _edi_test_runner_finish();
+     }
+   else
+     {
+        snprintf(message, sizeof(message), "Running the %u tests affected by the changes.",
+                 eina_list_count(affected->tests));
+        _edi_test_runner_output(message, EINA_FALSE);
+        if (!_edi_test_runner_shards_start(affected->tests))
+          _edi_test_runner_finish();
+     }
+
+   EINA_LIST_FREE(affected->tests, name)
+     eina_stringshare_del(name);
+   free(affected);
+}
+
+EAPI Eina_Bool
+edi_test_runner_run(Edi_Test_Runner_Mode mode, Edi_Test_Runner_Done_Cb done_cb, void *data)
+{
+   Edi_Test_Case *test;
+   char *log;
+
+   if (_edi_test_runner.running)
+     return EINA_FALSE;
+
+   _edi_test_runner.provider = _edi_test_runner_provider_get();
+   if (!_edi_test_runner.provider || (mode == EDI_TEST_RUNNER_MODE_FAILED && !_edi_test_runner.failed))
+     return EINA_FALSE;
+
+   if (!_edi_test_runner.durations)
+     _edi_test_runner.durations = eina_hash_string_superfast_new(_edi_test_runner_duration_free);
+   EINA_LIST_FREE(_edi_test_runner.results, test)
+     edi_test_runner_case_free(test);
+
+   _edi_test_runner.running = EINA_TRUE;
+   _edi_test_runner.done_cb = done_cb;
+   _edi_test_runner.done_data = data;
+
+   if (!strcmp(_edi_test_runner.provider, "meson"))
+     {
+        log = _edi_test_runner_meson_log_get();
+        unlink(log);
+        free(log);
+     }
+
+   if (mode == EDI_TEST_RUNNER_MODE_FAILED)
+     {
+        if (_edi_test_runner_shards_start(_edi_test_runner.failed))
+          return EINA_TRUE;
+
+        _edi_test_runner_reset();
+        return EINA_FALSE;
+     }
+
+   // Following the build graph runs ninja and meson, which can take a moment on large projects.
+   if (mode == EDI_TEST_RUNNER_MODE_AFFECTED)
+     {
+        if (edi_scm_engine_get() && edi_test_affected_supported())
+          {
+             ecore_thread_run(_edi_test_runner_affected_thread_cb, _edi_test_runner_affected_end_cb,
+                              NULL, calloc(1, sizeof(Edi_Test_Runner_Affected)));
+             return EINA_TRUE;
+          }
+
+        _edi_test_runner_output("The tests affected by changes can only be found for meson projects"
+                                " that have been built, running them all.", EINA_FALSE);
+     }
+
+   if (_edi_test_runner_all_start())
+     return EINA_TRUE;
+
+   _edi_test_runner_reset();
+   return EINA_FALSE;
+}
+
+EAPI Eina_Bool
+edi_test_runner_cancel(void)
+{
+   Edi_Test_Runner_Shard *shard;
+   Eina_List *l;
+
+   if (!_edi_test_runner.running)
+     return EINA_FALSE;
+
+   _edi_test_runner.cancelled = EINA_TRUE;
+   if (_edi_test_runner.list.process)
+     edi_exe_process_cancel(_edi_test_runner.list.process);
+   EINA_LIST_FOREACH(_edi_test_runner.shards, l, shard)
+     edi_exe_process_cancel(shard->process);
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_Bool
+edi_test_runner_running_get(void)
+{
+   return _edi_test_runner.running;
+}
+
+EAPI unsigned int
+edi_test_runner_failed_count(void)
+{
+   return eina_list_count(_edi_test_runner.failed);
+}
+
+EAPI const char *
+edi_test_runner_report_path_get(void)
+{
+   return _edi_test_runner.report;
+}
+
+void
+_edi_test_runner_shutdown(void)
+{
+   Edi_Test_Case *test;
+   const char *name;
+
+   EINA_LIST_FREE(_edi_test_runner.results, test)
+     edi_test_runner_case_free(test);
+   EINA_LIST_FREE(_edi_test_runner.failed, name)
+     eina_stringshare_del(name);
+   if (_edi_test_runner.durations)
+     eina_hash_free(_edi_test_runner.durations);
+   free(_edi_test_runner.report);
+
+   _edi_test_runner_reset();
+   memset(&_edi_test_runner, 0, sizeof(_edi_test_runner));
+}
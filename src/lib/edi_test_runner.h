@@ -0,0 +1,216 @@
+#ifndef EDI_TEST_RUNNER_H_
+# define EDI_TEST_RUNNER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for running the tests of a project and collecting their results.
+ */
+
+/**
+ * The outcome of a single test.
+ */
+typedef enum {
+   EDI_TEST_RESULT_PASS,
+   EDI_TEST_RESULT_FAIL,
+   EDI_TEST_RESULT_SKIP,
+} Edi_Test_Result;
+
+/**
+ * Which of the tests of a project to run.
+ */
+typedef enum {
+   EDI_TEST_RUNNER_MODE_ALL, /**< Every test */
+   EDI_TEST_RUNNER_MODE_FAILED, /**< The tests that failed in the previous run */
+   EDI_TEST_RUNNER_MODE_AFFECTED, /**< The tests built from files changed since the last commit */
+} Edi_Test_Runner_Mode;
+
+/**
+ * A test that has been run.
+ */
+typedef struct _Edi_Test_Case
+{
+   const char *name; /**< The name the test was discovered by */
+   Edi_Test_Result result; /**< How the test ended */
+   double duration; /**< The seconds the test ran for, negative if not known */
+} Edi_Test_Case;
+
+/**
+ * Called for each line the tests write.
+ *
+ * @param data The data passed to edi_test_runner_callbacks_set.
+ * @param line The line written, without its newline.
+ * @param err Whether the line was written to the error stream.
+ */
+typedef void (*Edi_Test_Runner_Output_Cb)(void *data, const char *line, Eina_Bool err);
+
+/**
+ * Called as soon as the result of a test is known.
+ *
+ * @param data The data passed to edi_test_runner_callbacks_set.
+ * @param test The test that completed.
+ */
+typedef void (*Edi_Test_Runner_Case_Cb)(void *data, const Edi_Test_Case *test);
+
+/**
+ * Called once every test of a run has completed.
+ *
+ * @param data The data passed to edi_test_runner_callbacks_set.
+ * @param results The Edi_Test_Case of each test run.
+ */
+typedef void (*Edi_Test_Runner_Finished_Cb)(void *data, const Eina_List *results);
+
+/**
+ * Called when a run is over.
+ *
+ * @param status 0 if every test passed.
+ * @param data The data passed to edi_test_runner_run.
+ */
+typedef void (*Edi_Test_Runner_Done_Cb)(int status, void *data);
+
+/**
+ * @brief Test runner
+ * @defgroup Test_Runner
+ *
+ * @{
+ *
+ * Discover the tests of a project and run them spread over the cores of the machine.
+ *
+ */
+
+/**
+ * Set the functions told about the progress of the tests.
+ *
+ * @param output_cb Called for the output of the tests, or NULL.
+ * @param case_cb Called as each test completes, or NULL.
+ * @param finished_cb Called once all the tests have completed, or NULL.
+ * @param data The data passed to the callbacks.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI void edi_test_runner_callbacks_set(Edi_Test_Runner_Output_Cb output_cb,
+                                        Edi_Test_Runner_Case_Cb case_cb,
+                                        Edi_Test_Runner_Finished_Cb finished_cb, void *data);
+
+/**
+ * Check if the tests of the current project can be listed and run one by one.
+ *
+ * @return EINA_TRUE for meson, go and cargo projects.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI Eina_Bool edi_test_runner_supported(void);
+
+/**
+ * Start running the tests of the current project.
+ *
+ * Go and cargo tests are split into a shard for each core, slower tests
+ * are spread first using the durations of earlier runs. Meson is asked
+ * to run its tests in parallel itself.
+ *
+ * The tests affected by changes are found from the build graph, running
+ * them all when that is not possible.
+ *
+ * @param mode Which of the tests to run.
+ * @param done_cb Called once the run is over.
+ * @param data The data passed to done_cb.
+ * @return EINA_TRUE if the run started, EINA_FALSE if there was nothing to run.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI Eina_Bool edi_test_runner_run(Edi_Test_Runner_Mode mode, Edi_Test_Runner_Done_Cb done_cb, void *data);
+
+/**
+ * Stop the tests running, terminating every process they started.
+ *
+ * The done callback is still called once the processes have exited.
+ *
+ * @return EINA_TRUE if tests were running.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI Eina_Bool edi_test_runner_cancel(void);
+
+/**
+ * Check if tests are running.
+ *
+ * @return EINA_TRUE while a run is in progress.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI Eina_Bool edi_test_runner_running_get(void);
+
+/**
+ * Get the number of tests that failed in the last run.
+ *
+ * @return The number of failures that edi_test_runner_run can run again.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI unsigned int edi_test_runner_failed_count(void);
+
+/**
+ * Get the path the results of the last run were written to as JUnit XML.
+ *
+ * @return The path of the report, or NULL if no run has completed.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI const char *edi_test_runner_report_path_get(void);
+
+/**
+ * Write a list of results to a file as JUnit XML.
+ *
+ * @param results A list of Edi_Test_Case.
+ * @param path The file to write.
+ * @return EINA_TRUE if the file was written.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI Eina_Bool edi_test_runner_junit_write(const Eina_List *results, const char *path);
+
+/**
+ * Read the name of a test from a line printed when listing the tests of a project.
+ *
+ * @param provider The id of the build provider, such as "go" or "cargo".
+ * @param line The line printed.
+ * @param length The length of the line in bytes.
+ * @return The name of the test as a stringshare, or NULL if the line names no test.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI const char *edi_test_runner_list_line_parse(const char *provider, const char *line, size_t length);
+
+/**
+ * Read the result of a test from a line printed by the tests of a project.
+ *
+ * @param provider The id of the build provider, such as "go", "cargo" or "meson".
+ * @param line The line printed, a JSON object for go and meson.
+ * @param length The length of the line in bytes.
+ * @return The result, free with edi_test_runner_case_free, or NULL if the line has none.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI Edi_Test_Case *edi_test_runner_result_line_parse(const char *provider, const char *line, size_t length);
+
+/**
+ * Free a test result.
+ *
+ * @param test The result to free.
+ *
+ * @ingroup Test_Runner
+ */
+EAPI void edi_test_runner_case_free(Edi_Test_Case *test);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_TEST_RUNNER_H_ */
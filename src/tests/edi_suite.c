@@ -18,7 +18,17 @@ static const struct {
   { "basic", edi_test_basic },
   { "path", edi_test_path },
   { "create", edi_test_create },
+  { "build_cache", edi_test_build_cache },
+  { "build_provider", edi_test_build_provider },
+  { "build_queue", edi_test_build_queue },
+  { "build_server", edi_test_build_server },
+  { "build_timing", edi_test_build_timing },
+  { "compile_command", edi_test_compile_command },
+  { "diagnostic", edi_test_diagnostic },
   { "exe", edi_test_exe },
+  { "scm", edi_test_scm },
+  { "test_affected", edi_test_test_affected },
+  { "test_runner", edi_test_test_runner },
   { "content_provider", edi_test_content_provider },
   { "language_provider", edi_test_language_provider },
   { "language_provider_c", edi_test_language_provider_c }
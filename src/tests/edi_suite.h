@@ -9,7 +9,17 @@ void edi_test_basic(TCase *tc);
 void edi_test_console(TCase *tc);
 void edi_test_path(TCase *tc);
 void edi_test_create(TCase *tc);
+void edi_test_build_cache(TCase *tc);
+void edi_test_build_provider(TCase *tc);
+void edi_test_build_queue(TCase *tc);
+void edi_test_build_server(TCase *tc);
+void edi_test_build_timing(TCase *tc);
+void edi_test_compile_command(TCase *tc);
+void edi_test_diagnostic(TCase *tc);
 void edi_test_exe(TCase *tc);
+void edi_test_scm(TCase *tc);
+void edi_test_test_affected(TCase *tc);
+void edi_test_test_runner(TCase *tc);
 void edi_test_content_provider(TCase *tc);
 void edi_test_language_provider(TCase *tc);
 void edi_test_language_provider_c(TCase *tc);
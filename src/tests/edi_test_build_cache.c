@@ -0,0 +1,120 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+START_TEST (edi_build_cache_test_ccache)
+{
+   Edi_Build_Cache_Stats stats;
+   const char *output =
+      "stats_updated_timestamp\t1700000000\n"
+      "direct_cache_hit\t12\n"
+      "direct_cache_miss\t7\n"
+      "preprocessed_cache_hit\t3\n"
+      "preprocessed_cache_miss\t5\n"
+      "cache_miss\t5\n"
+      "files_in_cache\t240\n";
+
+   ck_assert(edi_build_cache_stats_parse(EDI_BUILD_CACHE_CCACHE, output, &stats));
+   ck_assert_int_eq(15, stats.hits);
+   ck_assert_int_eq(5, stats.misses);
+
+   ck_assert(!edi_build_cache_stats_parse(EDI_BUILD_CACHE_CCACHE, "ccache: invalid option -- 'print-stats'\n", &stats));
+}
+END_TEST
+
+START_TEST (edi_build_cache_test_sccache)
+{
+   Edi_Build_Cache_Stats stats;
+   const char *output =
+      "Compile requests                      14\n"
+      "Compile requests executed             11\n"
+      "Cache hits                             8\n"
+      "Cache hits (C/C++)                     8\n"
+      "Cache misses                           3\n"
+      "Cache misses (C/C++)                   3\n"
+      "Cache hits rate                    72.73 %\n"
+      "Cache location                  Local disk: \"/home/user/.cache/sccache\"\n";
+
+   ck_assert(edi_build_cache_stats_parse(EDI_BUILD_CACHE_SCCACHE, output, &stats));
+   ck_assert_int_eq(8, stats.hits);
+   ck_assert_int_eq(3, stats.misses);
+
+   ck_assert(!edi_build_cache_stats_parse(EDI_BUILD_CACHE_NONE, output, &stats));
+}
+END_TEST
+
+static void
+_edi_build_cache_test_stats_cb(void *data, const Edi_Build_Cache_Stats *stats)
+{
+   Edi_Build_Cache_Stats *result = data;
+
+   ck_assert(stats != NULL);
+   *result = *stats;
+   ecore_main_loop_quit();
+}
+
+START_TEST (edi_build_cache_test_stats)
+{
+   Edi_Build_Cache_Stats stats = { 0, 0 };
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+   FILE *f;
+
+   edi_init();
+
+   // A ccache that gains three hits each time it is asked, found first in the PATH.
+   ck_assert(eina_file_mkdtemp("edi_build_cache_XXXXXX", &dir));
+   snprintf(path, sizeof(path), "%s/ccache", dir);
+   f = fopen(path, "w");
+   ck_assert(f != NULL);
+   fprintf(f, "#!/bin/sh\n"
+              "count=\"$(dirname \"$0\")/count\"\n"
+              "n=$(cat \"$count\" 2>/dev/null || echo 0)\n"
+              "echo $((n + 3)) > \"$count\"\n"
+              "printf 'direct_cache_hit\\t%%s\\ncache_miss\\t1\\n' \"$n\"\n");
+   fclose(f);
+   ck_assert(!chmod(path, 0755));
+   setenv("PATH", eina_slstr_printf("%s:%s", dir, getenv("PATH")), 1);
+
+   ecore_file_init();
+
+   edi_build_cache_enabled_set(EINA_TRUE);
+   ck_assert_int_eq(EDI_BUILD_CACHE_CCACHE, edi_build_cache_type_get());
+   ck_assert_str_eq(" CC=\"$CC\" CXX=\"$CXX\"", edi_build_cache_make_args_get());
+
+   // The end waits for the start to be read.
+   edi_build_cache_stats_begin();
+   ck_assert(edi_build_cache_stats_end(_edi_build_cache_test_stats_cb, &stats));
+   ecore_main_loop_begin();
+   ck_assert_int_eq(3, stats.hits);
+   ck_assert_int_eq(0, stats.misses);
+
+   edi_build_cache_enabled_set(EINA_FALSE);
+   ck_assert_str_eq("", edi_build_cache_make_args_get());
+   edi_build_cache_stats_begin();
+   ck_assert(!edi_build_cache_stats_end(_edi_build_cache_test_stats_cb, &stats));
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+
+   edi_shutdown();
+   ecore_file_shutdown();
+}
+END_TEST
+
+void edi_test_build_cache(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_cache_test_ccache);
+   tcase_add_test(tc, edi_build_cache_test_sccache);
+   tcase_add_test(tc, edi_build_cache_test_stats);
+}
@@ -0,0 +1,83 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static void
+_edi_build_provider_test_mkdir(const char *dir, const char *name, const char *marker)
+{
+   char path[PATH_MAX];
+   FILE *file;
+
+   snprintf(path, sizeof(path), "%s/%s", dir, name);
+   ck_assert_int_eq(0, mkdir(path, 0700));
+   if (!marker)
+     return;
+
+   snprintf(path, sizeof(path), "%s/%s/%s", dir, name, marker);
+   file = fopen(path, "w");
+   ck_assert(file != NULL);
+   fclose(file);
+}
+
+static void
+_edi_build_provider_test_rmdir(const char *dir, const char *name, const char *marker)
+{
+   char path[PATH_MAX];
+
+   if (marker)
+     {
+        snprintf(path, sizeof(path), "%s/%s/%s", dir, name, marker);
+        unlink(path);
+     }
+   snprintf(path, sizeof(path), "%s/%s", dir, name);
+   rmdir(path);
+}
+
+START_TEST (edi_build_provider_test_build_dir)
+{
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_build_provider_XXXXXX", &dir));
+   _edi_build_provider_test_mkdir(dir, "builddir", "build.ninja");
+   _edi_build_provider_test_mkdir(dir, "cmake-out", "CMakeCache.txt");
+   _edi_build_provider_test_mkdir(dir, "out", "CACHEDIR.TAG");
+   _edi_build_provider_test_mkdir(dir, "src", NULL);
+
+   snprintf(path, sizeof(path), "%s/builddir", dir);
+   ck_assert(edi_build_provider_build_dir_is(path));
+   snprintf(path, sizeof(path), "%s/cmake-out", dir);
+   ck_assert(edi_build_provider_build_dir_is(path));
+   snprintf(path, sizeof(path), "%s/out", dir);
+   ck_assert(edi_build_provider_build_dir_is(path));
+   snprintf(path, sizeof(path), "%s/src", dir);
+   ck_assert(!edi_build_provider_build_dir_is(path));
+   snprintf(path, sizeof(path), "%s/builddir/build.ninja", dir);
+   ck_assert(!edi_build_provider_build_dir_is(path));
+   snprintf(path, sizeof(path), "%s/missing", dir);
+   ck_assert(!edi_build_provider_build_dir_is(path));
+
+   _edi_build_provider_test_rmdir(dir, "builddir", "build.ninja");
+   _edi_build_provider_test_rmdir(dir, "cmake-out", "CMakeCache.txt");
+   _edi_build_provider_test_rmdir(dir, "out", "CACHEDIR.TAG");
+   _edi_build_provider_test_rmdir(dir, "src", NULL);
+   rmdir(dir);
+   eina_tmpstr_del(dir);
+
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_build_provider(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_provider_test_build_dir);
+}
@@ -0,0 +1,135 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static const char *_edi_build_queue_test_names[] = { "build", "test", "clean", "compile" };
+
+static void
+_edi_build_queue_test_done_cb(void *data, const Edi_Build_Job *job, int status)
+{
+   Eina_Strbuf *log = data;
+
+   eina_strbuf_append_printf(log, "%s:%s|", _edi_build_queue_test_names[job->type],
+                             job->cancelled ? "cancelled" : status ? "failed" : "ok");
+}
+
+static void
+_edi_build_queue_test_changed_cb(void *data EINA_UNUSED)
+{
+   if (!edi_build_queue_running_get() && !edi_build_queue_pending_count())
+     ecore_main_loop_quit();
+}
+
+static Eina_Bool
+_edi_build_queue_test_cancel_cb(void *data EINA_UNUSED)
+{
+   ck_assert(edi_build_queue_cancel());
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Tmpstr *
+_edi_build_queue_test_project(void)
+{
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+   FILE *makefile;
+
+   ck_assert(eina_file_mkdtemp("edi_build_queue_XXXXXX", &dir));
+   snprintf(path, sizeof(path), "%s/Makefile", dir);
+   makefile = fopen(path, "w");
+   ck_assert(makefile != NULL);
+   fputs("all:\n\tsleep 0.2\n\nclean:\n\ttrue\n\ncheck:\n\tsleep 10\n", makefile);
+   fclose(makefile);
+
+   ck_assert(edi_project_set(dir));
+
+   return dir;
+}
+
+static void
+_edi_build_queue_test_project_del(Eina_Tmpstr *dir)
+{
+   char path[PATH_MAX];
+
+   snprintf(path, sizeof(path), "%s/Makefile", dir);
+   unlink(path);
+   rmdir(dir);
+   eina_tmpstr_del(dir);
+}
+
+START_TEST (edi_build_queue_test_coalesce)
+{
+   Eina_Strbuf *log;
+   Eina_Tmpstr *dir;
+
+   edi_init();
+   dir = _edi_build_queue_test_project();
+
+   log = eina_strbuf_new();
+   edi_build_queue_callbacks_set(NULL, _edi_build_queue_test_done_cb,
+                                 _edi_build_queue_test_changed_cb, log);
+
+   ck_assert(edi_build_queue_add(EDI_BUILD_JOB_BUILD, NULL));
+   ck_assert(edi_build_queue_running_get() != NULL);
+   ck_assert_int_eq(0, edi_build_queue_pending_count());
+
+   ck_assert(edi_build_queue_add(EDI_BUILD_JOB_BUILD, NULL));
+   ck_assert(!edi_build_queue_add(EDI_BUILD_JOB_BUILD, NULL));
+   ck_assert(!edi_build_queue_add(EDI_BUILD_JOB_COMPILE_FILE, "missing.c"));
+   ck_assert(edi_build_queue_add(EDI_BUILD_JOB_CLEAN, NULL));
+   ck_assert_int_eq(2, edi_build_queue_pending_count());
+
+   ecore_main_loop_begin();
+   ck_assert_str_eq("build:ok|build:ok|clean:ok|", eina_strbuf_string_get(log));
+
+   // Nothing can compile the file, so the job fails without waiting.
+   eina_strbuf_reset(log);
+   edi_build_queue_callbacks_set(NULL, _edi_build_queue_test_done_cb, NULL, log);
+   ck_assert(edi_build_queue_add(EDI_BUILD_JOB_COMPILE_FILE, "missing.c"));
+   ck_assert(edi_build_queue_running_get() == NULL);
+   ck_assert_str_eq("compile:failed|", eina_strbuf_string_get(log));
+
+   eina_strbuf_free(log);
+   _edi_build_queue_test_project_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_queue_test_cancel)
+{
+   Eina_Strbuf *log;
+   Eina_Tmpstr *dir;
+
+   edi_init();
+   dir = _edi_build_queue_test_project();
+
+   log = eina_strbuf_new();
+   edi_build_queue_callbacks_set(NULL, _edi_build_queue_test_done_cb,
+                                 _edi_build_queue_test_changed_cb, log);
+
+   ck_assert(edi_build_queue_add(EDI_BUILD_JOB_TEST, NULL));
+   ck_assert(edi_build_queue_add(EDI_BUILD_JOB_CLEAN, NULL));
+   ecore_timer_add(0.2, _edi_build_queue_test_cancel_cb, NULL);
+
+   ecore_main_loop_begin();
+   ck_assert_str_eq("test:cancelled|", eina_strbuf_string_get(log));
+   ck_assert(!edi_build_queue_cancel());
+
+   eina_strbuf_free(log);
+   _edi_build_queue_test_project_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_build_queue(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_queue_test_coalesce);
+   tcase_add_test(tc, edi_build_queue_test_cancel);
+}
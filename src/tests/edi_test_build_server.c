@@ -0,0 +1,252 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+typedef struct
+{
+   Eina_Strbuf *out;
+   Eina_Bool reached;
+   int status;
+} Edi_Build_Server_Test_Result;
+
+static unsigned int _edi_build_server_test_waiting;
+static Edi_Build_Server_Test_Result _edi_build_server_test_clean, _edi_build_server_test_stop;
+
+START_TEST (edi_build_server_test_parse)
+{
+   Edi_Build_Job_Type type;
+   const char *path;
+
+   ck_assert(edi_build_server_request_parse("build", &type, &path));
+   ck_assert_int_eq(EDI_BUILD_JOB_BUILD, type);
+   ck_assert(!path);
+
+   ck_assert(edi_build_server_request_parse("test-affected", &type, &path));
+   ck_assert_int_eq(EDI_BUILD_JOB_TEST_AFFECTED, type);
+
+   ck_assert(edi_build_server_request_parse("compile /project/src/main file.c", &type, &path));
+   ck_assert_int_eq(EDI_BUILD_JOB_COMPILE_FILE, type);
+   ck_assert_str_eq("/project/src/main file.c", path);
+
+   ck_assert(!edi_build_server_request_parse("compile", &type, &path));
+   ck_assert(!edi_build_server_request_parse("build now", &type, &path));
+   ck_assert(!edi_build_server_request_parse("tests", &type, &path));
+   ck_assert(!edi_build_server_request_parse("stop", &type, &path));
+}
+END_TEST
+
+START_TEST (edi_build_server_test_request)
+{
+   Edi_Build_Job_Type type;
+   const char *path;
+
+   eina_init();
+
+   ck_assert_str_eq("test-failed", edi_build_server_request_get(EDI_BUILD_JOB_TEST_FAILED, NULL));
+   ck_assert_str_eq("compile /project/main.c", edi_build_server_request_get(EDI_BUILD_JOB_COMPILE_FILE, "/project/main.c"));
+   ck_assert(!edi_build_server_request_get(EDI_BUILD_JOB_COMPILE_FILE, NULL));
+
+   ck_assert(edi_build_server_request_parse(edi_build_server_request_get(EDI_BUILD_JOB_CLEAN, NULL), &type, &path));
+   ck_assert_int_eq(EDI_BUILD_JOB_CLEAN, type);
+
+   eina_shutdown();
+}
+END_TEST
+
+static void
+_edi_build_server_test_output_cb(void *data, const char *line, Eina_Bool err)
+{
+   Edi_Build_Server_Test_Result *result = data;
+
+   if (!err)
+     eina_strbuf_append_printf(result->out, "%s\n", line);
+}
+
+static void
+_edi_build_server_test_done_cb(void *data, Eina_Bool reached, int status)
+{
+   Edi_Build_Server_Test_Result *result = data;
+
+   result->reached = reached;
+   result->status = status;
+
+   if (!--_edi_build_server_test_waiting)
+     ecore_main_loop_quit();
+}
+
+static Eina_Tmpstr *
+_edi_build_server_test_project(const char *file, const char *content)
+{
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+   FILE *f;
+
+   ck_assert(eina_file_mkdtemp("edi_build_server_XXXXXX", &dir));
+   snprintf(path, sizeof(path), "%s/%s", dir, file);
+   f = fopen(path, "w");
+   ck_assert(f != NULL);
+   fputs(content, f);
+   fclose(f);
+   ck_assert(!chmod(path, 0755));
+
+   ck_assert(edi_project_set(dir));
+
+   return dir;
+}
+
+START_TEST (edi_build_server_test_loopback)
+{
+   Edi_Build_Server_Test_Result result = { NULL, EINA_FALSE, 0 };
+   Eina_Tmpstr *dir;
+
+   edi_init();
+
+   // The configure step writes the Makefile, its output is streamed with the build's.
+   dir = _edi_build_server_test_project("configure",
+      "#!/bin/sh\necho configured\nprintf 'all:\\n\\t@echo built\\n' > Makefile\n");
+   ck_assert(edi_build_server_start());
+
+   result.out = eina_strbuf_new();
+   _edi_build_server_test_waiting = 1;
+   ck_assert(edi_build_server_submit("build", _edi_build_server_test_output_cb,
+                                     _edi_build_server_test_done_cb, &result));
+   ecore_main_loop_begin();
+
+   ck_assert(result.reached);
+   ck_assert_int_eq(0, result.status);
+   ck_assert(strstr(eina_strbuf_string_get(result.out), "configured\n") != NULL);
+   ck_assert(strstr(eina_strbuf_string_get(result.out), "built\n") != NULL);
+   ck_assert(!edi_build_queue_running_get());
+
+   ck_assert(!edi_build_server_submit("tests", NULL, _edi_build_server_test_done_cb, &result));
+
+   // With nothing serving the project the request is done without reaching it.
+   edi_build_server_stop();
+   _edi_build_server_test_waiting = 1;
+   ck_assert(edi_build_server_submit("clean", NULL, _edi_build_server_test_done_cb, &result));
+   if (_edi_build_server_test_waiting)
+     ecore_main_loop_begin();
+
+   ck_assert(!result.reached);
+   ck_assert_int_eq(-1, result.status);
+
+   eina_strbuf_free(result.out);
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_server_test_single)
+{
+   Eina_Tmpstr *dir;
+   pid_t pid;
+   int fds[2], status;
+   char c;
+
+   edi_init();
+
+   dir = _edi_build_server_test_project("Makefile", "all:\n\ttrue\n");
+   ck_assert(!pipe(fds));
+
+   // The second server is forked before the first starts, so it has no state of its own yet.
+   pid = fork();
+   ck_assert(pid >= 0);
+   if (pid == 0)
+     {
+        close(fds[1]);
+        if (read(fds[0], &c, 1) != 1)
+          _exit(2);
+        _exit(edi_build_server_start() ? 1 : 0);
+     }
+
+   close(fds[0]);
+   ck_assert(edi_build_server_start());
+   ck_assert_int_eq(1, write(fds[1], "s", 1));
+   close(fds[1]);
+
+   ck_assert_int_eq(pid, waitpid(pid, &status, 0));
+   ck_assert(WIFEXITED(status));
+   ck_assert_int_eq(0, WEXITSTATUS(status));
+
+   // Once stopped the project can be served again.
+   edi_build_server_stop();
+   ck_assert(edi_build_server_start());
+   edi_build_server_stop();
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+static Eina_Bool
+_edi_build_server_test_stop_cb(void *data EINA_UNUSED)
+{
+   ck_assert(edi_build_server_submit("stop", NULL, _edi_build_server_test_done_cb,
+                                     &_edi_build_server_test_stop));
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_build_server_test_started_cb(void *data EINA_UNUSED, const Edi_Build_Job *job)
+{
+   if (job->type != EDI_BUILD_JOB_TEST)
+     return;
+
+   // Queued behind the tests, then dropped when they are stopped.
+   ck_assert(edi_build_server_submit("clean", NULL, _edi_build_server_test_done_cb,
+                                     &_edi_build_server_test_clean));
+   ecore_timer_add(0.5, _edi_build_server_test_stop_cb, NULL);
+}
+
+START_TEST (edi_build_server_test_cancel)
+{
+   Edi_Build_Server_Test_Result result = { NULL, EINA_FALSE, 0 };
+   Eina_Tmpstr *dir;
+
+   edi_init();
+
+   dir = _edi_build_server_test_project("Makefile", "all:\n\ttrue\n\nclean:\n\ttrue\n\ncheck:\n\tsleep 10\n");
+   ck_assert(edi_build_server_start());
+   edi_build_queue_callbacks_set(_edi_build_server_test_started_cb, NULL, NULL, NULL);
+
+   _edi_build_server_test_waiting = 3;
+   ck_assert(edi_build_server_submit("test", NULL, _edi_build_server_test_done_cb, &result));
+   ecore_main_loop_begin();
+
+   ck_assert(result.reached);
+   ck_assert_int_eq(-1, result.status);
+   ck_assert(_edi_build_server_test_clean.reached);
+   ck_assert_int_eq(-1, _edi_build_server_test_clean.status);
+   ck_assert(_edi_build_server_test_stop.reached);
+   ck_assert_int_eq(0, _edi_build_server_test_stop.status);
+   ck_assert(!edi_build_queue_running_get());
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_build_server(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_server_test_parse);
+   tcase_add_test(tc, edi_build_server_test_request);
+   tcase_add_test(tc, edi_build_server_test_loopback);
+   tcase_add_test(tc, edi_build_server_test_single);
+   tcase_add_test(tc, edi_build_server_test_cancel);
+}
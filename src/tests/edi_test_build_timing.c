@@ -0,0 +1,230 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <Ecore_File.h>
+#include <Efreet.h>
+
+#include "edi_suite.h"
+
+static Eina_Tmpstr *
+_edi_build_timing_test_file(const char *content)
+{
+   Eina_Tmpstr *path;
+   int fd;
+
+   fd = eina_file_mkstemp("edi_build_timing_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   ck_assert_int_eq(strlen(content), write(fd, content, strlen(content)));
+   close(fd);
+
+   return path;
+}
+
+static void
+_edi_build_timing_test_step(const Edi_Build_Timing_Step *step, const char *target,
+                            double start, double end)
+{
+   ck_assert(step != NULL);
+   ck_assert_str_eq(target, step->target);
+   ck_assert(step->start > start - 0.001 && step->start < start + 0.001);
+   ck_assert(step->end > end - 0.001 && step->end < end + 0.001);
+}
+
+START_TEST (edi_build_timing_test_ninja)
+{
+   Edi_Build_Timing *timing;
+   Eina_Tmpstr *path;
+   const char *previous = "# ninja log v5\n"
+                          "0\t900\t0\told.o\t1\n";
+
+   edi_init();
+
+   path = _edi_build_timing_test_file("# ninja log v5\n"
+                                      "0\t900\t0\told.o\t1\n"
+                                      "100\t1100\t0\ta.o\t2\n"
+                                      "100\t1100\t0\ta.d\t2\n"
+                                      "150\t400\t0\tb.o\t3\n"
+                                      "1100\t1600\t0\tapp\t4\n");
+
+   timing = edi_build_timing_ninja_read(path, strlen(previous));
+   ck_assert(timing != NULL);
+   ck_assert_int_eq(3, timing->count);
+   ck_assert(timing->wall > 1.499 && timing->wall < 1.501);
+   ck_assert(timing->busy > 1.749 && timing->busy < 1.751);
+
+   _edi_build_timing_test_step(eina_list_nth(timing->steps, 0), "a.o", 0.0, 1.0);
+   _edi_build_timing_test_step(eina_list_nth(timing->steps, 2), "b.o", 0.05, 0.3);
+
+   ck_assert_int_eq(2, eina_list_count(timing->critical));
+   _edi_build_timing_test_step(eina_list_nth(timing->critical, 0), "a.o", 0.0, 1.0);
+   _edi_build_timing_test_step(eina_list_nth(timing->critical, 1), "app", 1.0, 1.5);
+
+   edi_build_timing_free(timing);
+   unlink(path);
+   eina_tmpstr_del(path);
+
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_timing_test_make)
+{
+   Edi_Build_Timing *timing;
+   Eina_Tmpstr *path;
+
+   edi_init();
+
+   path = _edi_build_timing_test_file("1000.50\t1002.00\tcc -c -o src/a.o src/a.c\n"
+                                      "1000.50\tbroken\n"
+                                      "1002.00\t1002.25\techo done\n");
+
+   timing = edi_build_timing_make_read(path);
+   ck_assert(timing != NULL);
+   ck_assert_int_eq(2, timing->count);
+   _edi_build_timing_test_step(eina_list_nth(timing->steps, 0), "src/a.o", 0.0, 1.5);
+   _edi_build_timing_test_step(eina_list_nth(timing->steps, 1), "echo done", 1.5, 1.75);
+   ck_assert_int_eq(2, eina_list_count(timing->critical));
+
+   edi_build_timing_free(timing);
+   unlink(path);
+   eina_tmpstr_del(path);
+
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_timing_test_make_file)
+{
+   Edi_Build_Timing *timing;
+   Eina_Tmpstr *dir;
+   const char *makefile;
+   char path[PATH_MAX], *out;
+   FILE *f;
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_build_timing_XXXXXX", &dir));
+   ck_assert(edi_project_set(dir));
+
+   // A recipe that only bash can run, the shell the makefile sets is kept.
+   snprintf(path, sizeof(path), "%s/Makefile", dir);
+   f = fopen(path, "w");
+   ck_assert(f != NULL);
+   fprintf(f, "SHELL := /bin/bash\n"
+              "all:\n"
+              "\t[[ -n \"$$BASH_VERSION\" ]] && echo bash > shell\n");
+   fclose(f);
+
+   makefile = edi_build_timing_make_file_get();
+   ck_assert(makefile != NULL);
+
+   edi_build_timing_begin();
+   ck_assert_int_eq(0, edi_exe_wait_in(dir, eina_slstr_printf("make -s -f '%s'", makefile)));
+   timing = edi_build_timing_end();
+
+   out = edi_exe_response_in(dir, "cat shell");
+   ck_assert_str_eq("bash", out);
+   free(out);
+
+   ck_assert(timing != NULL);
+   ck_assert_int_eq(1, timing->count);
+   edi_build_timing_free(timing);
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_timing_test_history)
+{
+   Edi_Build_Timing *timing;
+   Eina_List *history;
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX], line[128], *cache;
+   int i, lines = 0;
+   FILE *f;
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_build_timing_XXXXXX", &dir));
+   ck_assert(edi_project_set(dir));
+
+   // The file keeps the last 50 builds however many ran.
+   for (i = 0; i < 60; i++)
+     {
+        edi_build_timing_begin();
+        edi_build_timing_free(edi_build_timing_end());
+     }
+
+   history = edi_build_timing_history_get();
+   ck_assert_int_eq(50, eina_list_count(history));
+   EINA_LIST_FREE(history, timing)
+     edi_build_timing_free(timing);
+
+   snprintf(path, sizeof(path), "%s/%s/%s/build-times", efreet_cache_home_get(), PACKAGE_NAME,
+            edi_project_name_get());
+   f = fopen(path, "r");
+   ck_assert(f != NULL);
+   while (fgets(line, sizeof(line), f))
+     lines++;
+   fclose(f);
+   ck_assert_int_eq(50, lines);
+
+   cache = ecore_file_dir_get(path);
+   ecore_file_recursive_rm(cache);
+   free(cache);
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_timing_test_cargo)
+{
+   Edi_Build_Timing *timing;
+   Eina_Tmpstr *path;
+
+   edi_init();
+
+   path = _edi_build_timing_test_file("<script>\n"
+                                      "const UNIT_DATA = [\n"
+                                      "  {\"i\": 0, \"name\": \"libc\", \"version\": \"0.2.1\", "
+                                      "\"target\": \" build script\", \"start\": 0.10, \"duration\": 0.50, "
+                                      "\"unlocked_units\": [1]},\n"
+                                      "  {\"i\": 1, \"name\": \"app\", \"version\": \"1.0.0\", "
+                                      "\"target\": \"\", \"start\": 0.60, \"duration\": 2.00, "
+                                      "\"unlocked_units\": []}\n"
+                                      "];\n"
+                                      "const CONCURRENCY_DATA = [{\"t\": 0.0}];\n"
+                                      "</script>\n");
+
+   timing = edi_build_timing_cargo_read(path);
+   ck_assert(timing != NULL);
+   ck_assert_int_eq(2, timing->count);
+   _edi_build_timing_test_step(eina_list_nth(timing->steps, 0), "app v1.0.0", 0.5, 2.5);
+   _edi_build_timing_test_step(eina_list_nth(timing->steps, 1), "libc v0.2.1 build script", 0.0, 0.5);
+
+   edi_build_timing_free(timing);
+   unlink(path);
+   eina_tmpstr_del(path);
+
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_build_timing(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_timing_test_ninja);
+   tcase_add_test(tc, edi_build_timing_test_make);
+   tcase_add_test(tc, edi_build_timing_test_make_file);
+   tcase_add_test(tc, edi_build_timing_test_history);
+   tcase_add_test(tc, edi_build_timing_test_cargo);
+}
@@ -0,0 +1,108 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static void
+_edi_compile_command_test_write(const char *path, const char *content)
+{
+   FILE *file;
+
+   file = fopen(path, "w");
+   ck_assert(file != NULL);
+   fputs(content, file);
+   fclose(file);
+}
+
+START_TEST (edi_compile_command_test_get)
+{
+   Edi_Compile_Command *command;
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX], build[PATH_MAX], source[PATH_MAX], spaced[PATH_MAX], database[PATH_MAX * 4];
+   char expected[PATH_MAX * 2];
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_compile_command_XXXXXX", &dir));
+   snprintf(build, sizeof(build), "%s/build", dir);
+   ck_assert_int_eq(0, mkdir(build, 0700));
+   snprintf(path, sizeof(path), "%s/src", dir);
+   ck_assert_int_eq(0, mkdir(path, 0700));
+   snprintf(source, sizeof(source), "%s/src/a.c", dir);
+   _edi_compile_command_test_write(source, "");
+   snprintf(spaced, sizeof(spaced), "%s/src/b c.c", dir);
+   _edi_compile_command_test_write(spaced, "");
+
+   snprintf(database, sizeof(database),
+            "[\n"
+            "  {\n"
+            "    \"directory\": \"%s\",\n"
+            "    \"command\": \"cc -Isrc -o src/a.o -c ../src/a.c\",\n"
+            "    \"file\": \"../src/a.c\",\n"
+            "    \"output\": \"src/a.o\"\n"
+            "  },\n"
+            "  {\n"
+            "    \"directory\": \"%s\",\n"
+            "    \"extra\": {\"flags\": [1, \"]\", {}]},\n"
+            "    \"arguments\": [\"cc\", \"-DNAME=\\\"x\\\"\", \"-c\", \"%s\"],\n"
+            "    \"file\": \"%s\"\n"
+            "  }\n"
+            "]\n", build, build, spaced, spaced);
+   snprintf(path, sizeof(path), "%s/compile_commands.json", build);
+   _edi_compile_command_test_write(path, database);
+
+   command = edi_compile_command_get(build, source);
+   ck_assert(command != NULL);
+   ck_assert_str_eq(build, command->directory);
+   ck_assert_str_eq("cc -Isrc -o src/a.o -c ../src/a.c", command->command);
+   ck_assert_str_eq("src/a.o", command->output);
+   edi_compile_command_free(command);
+
+   command = edi_compile_command_get(build, spaced);
+   ck_assert(command != NULL);
+   snprintf(expected, sizeof(expected), "cc '-DNAME=\"x\"' -c '%s'", spaced);
+   ck_assert_str_eq(expected, command->command);
+   ck_assert(command->output == NULL);
+   edi_compile_command_free(command);
+
+   snprintf(path, sizeof(path), "%s/src/missing.c", dir);
+   ck_assert(edi_compile_command_get(build, path) == NULL);
+   ck_assert(edi_compile_command_get(dir, source) == NULL);
+
+   // A database written again is read again.
+   snprintf(database, sizeof(database),
+            "[{\"directory\": \"%s\", \"command\": \"cc -O2 -c ../src/a.c\", \"file\": \"../src/a.c\"}]\n",
+            build);
+   snprintf(path, sizeof(path), "%s/compile_commands.json", build);
+   _edi_compile_command_test_write(path, database);
+
+   command = edi_compile_command_get(build, source);
+   ck_assert(command != NULL);
+   ck_assert_str_eq("cc -O2 -c ../src/a.c", command->command);
+   edi_compile_command_free(command);
+   ck_assert(edi_compile_command_get(build, spaced) == NULL);
+
+   unlink(source);
+   unlink(spaced);
+   snprintf(path, sizeof(path), "%s/compile_commands.json", build);
+   unlink(path);
+   rmdir(build);
+   snprintf(path, sizeof(path), "%s/src", dir);
+   rmdir(path);
+   rmdir(dir);
+   eina_tmpstr_del(dir);
+
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_compile_command(TCase *tc)
+{
+   tcase_add_test(tc, edi_compile_command_test_get);
+}
@@ -0,0 +1,84 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "edi_suite.h"
+
+static void
+_edi_diagnostic_test_feed(Edi_Diagnostic_Parser *parser, const char *line, const char *path,
+                          unsigned int number, unsigned int col,
+                          Edi_Diagnostic_Severity severity, const char *message)
+{
+   Edi_Diagnostic *diagnostic;
+
+   diagnostic = edi_diagnostic_parser_feed(parser, line, strlen(line));
+   if (!path)
+     {
+        ck_assert(diagnostic == NULL);
+        return;
+     }
+
+   ck_assert(diagnostic != NULL);
+   ck_assert_str_eq(path, diagnostic->path);
+   ck_assert_int_eq(number, diagnostic->line);
+   ck_assert_int_eq(col, diagnostic->col);
+   ck_assert_int_eq(severity, diagnostic->severity);
+   ck_assert_str_eq(message, diagnostic->message);
+   edi_diagnostic_free(diagnostic);
+}
+
+START_TEST (edi_diagnostic_test_formats)
+{
+   Edi_Diagnostic_Parser *parser;
+
+   edi_init();
+
+   parser = edi_diagnostic_parser_new("/project");
+   _edi_diagnostic_test_feed(parser, "src/a.c:12:5: warning: unused variable 'x'",
+                             "/project/src/a.c", 12, 5, EDI_DIAGNOSTIC_SEVERITY_WARNING, "unused variable 'x'");
+   _edi_diagnostic_test_feed(parser, "/usr/include/b.h:3:10: fatal error: 'c.h' file not found",
+                             "/usr/include/b.h", 3, 10, EDI_DIAGNOSTIC_SEVERITY_ERROR, "'c.h' file not found");
+   _edi_diagnostic_test_feed(parser, "error[E0308]: mismatched types", NULL, 0, 0, 0, NULL);
+   _edi_diagnostic_test_feed(parser, " --> src/main.rs:2:18",
+                             "/project/src/main.rs", 2, 18, EDI_DIAGNOSTIC_SEVERITY_ERROR, "mismatched types");
+   _edi_diagnostic_test_feed(parser, "./main.go:5:2: undefined: x",
+                             "/project/main.go", 5, 2, EDI_DIAGNOSTIC_SEVERITY_ERROR, "undefined: x");
+   _edi_diagnostic_test_feed(parser, "meson.build:12:0: ERROR: Unknown variable",
+                             "/project/meson.build", 12, 0, EDI_DIAGNOSTIC_SEVERITY_ERROR, "Unknown variable");
+
+   _edi_diagnostic_test_feed(parser, "[1/2] Compiling C object a.o", NULL, 0, 0, 0, NULL);
+   _edi_diagnostic_test_feed(parser, "In file included from a.c:1:", NULL, 0, 0, 0, NULL);
+   _edi_diagnostic_test_feed(parser, "a.c:(.text+0x1): undefined reference to 'f'", NULL, 0, 0, 0, NULL);
+   _edi_diagnostic_test_feed(parser, "12:30:45 started", NULL, 0, 0, 0, NULL);
+
+   _edi_diagnostic_test_feed(parser, "ninja: Entering directory `build'", NULL, 0, 0, 0, NULL);
+   _edi_diagnostic_test_feed(parser, "../src/c.c:7:1: error: expected ';'",
+                             "/project/src/c.c", 7, 1, EDI_DIAGNOSTIC_SEVERITY_ERROR, "expected ';'");
+   edi_diagnostic_parser_free(parser);
+
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_diagnostic_test_parse)
+{
+   Edi_Diagnostic *diagnostic;
+   const char *line = "edi_test_path.c:23:F:path:test:0: Assertion failed";
+
+   edi_init();
+
+   diagnostic = edi_diagnostic_parse(NULL, line, strlen(line));
+   ck_assert(diagnostic != NULL);
+   ck_assert_str_eq("edi_test_path.c", diagnostic->path);
+   ck_assert_int_eq(23, diagnostic->line);
+   edi_diagnostic_free(diagnostic);
+
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_diagnostic(TCase *tc)
+{
+   tcase_add_test(tc, edi_diagnostic_test_formats);
+   tcase_add_test(tc, edi_diagnostic_test_parse);
+}
@@ -2,6 +2,11 @@
 # include "config.h"
 #endif
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+
 #include "edi_suite.h"
 
 START_TEST (edi_exe_test_wait)
@@ -15,8 +20,240 @@ START_TEST (edi_exe_test_wait)
 }
 END_TEST
 
+START_TEST (edi_exe_test_wait_in)
+{
+   char *out;
+
+   edi_init();
+
+   ck_assert(1 != edi_exe_wait_in("/", "false"));
+   ck_assert_int_eq(0, edi_exe_wait_in("/", "test \"$(pwd)\" = /"));
+
+   out = edi_exe_response_in("/", "pwd");
+   ck_assert_str_eq("/", out);
+   free(out);
+
+   edi_shutdown();
+}
+END_TEST
+
+static void
+_edi_exe_test_wait_thread_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   int *exits = data, status, i;
+
+   for (i = 0; i < 20; i++)
+     {
+        status = edi_exe_wait_in("/", "exit 3");
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 3)
+          (*exits)++;
+     }
+}
+
+static void
+_edi_exe_test_wait_end_cb(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+START_TEST (edi_exe_test_wait_thread)
+{
+   int exits = 0;
+
+   edi_init();
+
+   // The main loop reaps children on SIGCHLD while the thread waits for them.
+   ck_assert(NULL != ecore_thread_run(_edi_exe_test_wait_thread_cb, _edi_exe_test_wait_end_cb,
+                                      _edi_exe_test_wait_end_cb, &exits));
+   ecore_main_loop_begin();
+   ck_assert_int_eq(20, exits);
+
+   edi_shutdown();
+}
+END_TEST
+
+static Eina_Bool
+_edi_exe_test_lines_cb(void *data, const char *line, size_t length)
+{
+   Eina_Strbuf *lines = data;
+
+   eina_strbuf_append_length(lines, line, length);
+   eina_strbuf_append_char(lines, '|');
+
+   return eina_strbuf_length_get(lines) < 8;
+}
+
+START_TEST (edi_exe_test_lines_in)
+{
+   Eina_Strbuf *lines;
+
+   edi_init();
+
+   lines = eina_strbuf_new();
+   ck_assert_int_eq(0, edi_exe_lines_in("/", "printf 'a\\n\\nbc'", _edi_exe_test_lines_cb, lines));
+   ck_assert_str_eq("a||bc|", eina_strbuf_string_get(lines));
+
+   eina_strbuf_reset(lines);
+   edi_exe_lines_in(NULL, "yes abc", _edi_exe_test_lines_cb, lines);
+   ck_assert_str_eq("abc|abc|", eina_strbuf_string_get(lines));
+   eina_strbuf_free(lines);
+
+   edi_shutdown();
+}
+END_TEST
+
+static void
+_edi_exe_test_started_cb(void *data EINA_UNUSED, pid_t pid)
+{
+   ck_assert(pid > 0);
+   ck_assert_int_eq(pid, getpgid(pid));
+}
+
+START_TEST (edi_exe_test_progress_in)
+{
+   Eina_Strbuf *lines;
+
+   edi_init();
+
+   lines = eina_strbuf_new();
+   ck_assert_int_eq(0, edi_exe_progress_in("/", "printf 'a\\rb\\r\\n'; printf c >&2",
+                                           _edi_exe_test_started_cb, _edi_exe_test_lines_cb, lines));
+   ck_assert_str_eq("a|b|c|", eina_strbuf_string_get(lines));
+   eina_strbuf_free(lines);
+
+   edi_shutdown();
+}
+END_TEST
+
+typedef struct {
+   Eina_Strbuf *out, *err;
+   int code;
+   Eina_Bool timed_out;
+} Edi_Exe_Test_Run;
+
+static void
+_edi_exe_test_run_data_cb(void *data, Edi_Exe_Stream stream, const char *buf, size_t length)
+{
+   Edi_Exe_Test_Run *run = data;
+
+   if (stream == EDI_EXE_STREAM_OUTPUT)
+     eina_strbuf_append_length(run->out, buf, length);
+   else
+     eina_strbuf_append_length(run->err, buf, length);
+}
+
+static void
+_edi_exe_test_run_done_cb(void *data, int code, Eina_Bool timed_out)
+{
+   Edi_Exe_Test_Run *run = data;
+
+   run->code = code;
+   run->timed_out = timed_out;
+   ecore_main_loop_quit();
+}
+
+START_TEST (edi_exe_test_run)
+{
+   const char *env[] = { "EDI_EXE_TEST=env", NULL };
+   Edi_Exe_Test_Run run;
+
+   edi_init();
+
+   run.out = eina_strbuf_new();
+   run.err = eina_strbuf_new();
+
+   ck_assert(NULL != edi_exe_run("/", env, "printf \"$(pwd) $EDI_EXE_TEST\"; printf e >&2; exit 3", 0,
+                                 _edi_exe_test_run_data_cb, _edi_exe_test_run_done_cb, &run));
+   ecore_main_loop_begin();
+   ck_assert_str_eq("/ env", eina_strbuf_string_get(run.out));
+   ck_assert_str_eq("e", eina_strbuf_string_get(run.err));
+   ck_assert_int_eq(3, run.code);
+   ck_assert(!run.timed_out);
+
+   ck_assert(NULL != edi_exe_run(NULL, NULL, "sleep 10", 0.1,
+                                 NULL, _edi_exe_test_run_done_cb, &run));
+   ecore_main_loop_begin();
+   ck_assert(run.timed_out);
+
+   eina_strbuf_free(run.out);
+   eina_strbuf_free(run.err);
+
+   edi_shutdown();
+}
+END_TEST
+
+static void
+_edi_exe_test_notify_cb(int status, void *data)
+{
+   Eina_Strbuf *codes = data;
+
+   eina_strbuf_append_printf(codes, "%d|", status);
+   if (eina_strbuf_length_get(codes) == 4)
+     ecore_main_loop_quit();
+}
+
+START_TEST (edi_exe_test_notify)
+{
+   Eina_Strbuf *codes;
+
+   edi_init();
+
+   codes = eina_strbuf_new();
+   ck_assert(edi_exe_notify_handle("edi_test_exe", _edi_exe_test_notify_cb, codes));
+   ck_assert(edi_exe_notify_handle("edi_test_exe", _edi_exe_test_notify_cb, codes));
+   edi_exe_notify("edi_test_exe", "exit 2");
+   edi_exe_notify("edi_test_exe", "sleep 0.1; exit 3");
+   ecore_main_loop_begin();
+   ck_assert_str_eq("2|3|", eina_strbuf_string_get(codes));
+   eina_strbuf_free(codes);
+
+   edi_shutdown();
+}
+END_TEST
+
+static Eina_Bool
+_edi_exe_test_terminate_cb(void *data EINA_UNUSED)
+{
+   ck_assert(edi_exe_notify_terminate("edi_test_exe"));
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+START_TEST (edi_exe_test_notify_cancel)
+{
+   Eina_Strbuf *codes;
+
+   edi_init();
+
+   codes = eina_strbuf_new();
+   ck_assert(edi_exe_notify_handle("edi_test_exe", _edi_exe_test_notify_cb, codes));
+   ck_assert(edi_exe_notify_handle_del("edi_test_exe", _edi_exe_test_notify_cb, codes));
+   ck_assert(!edi_exe_notify_handle_del("edi_test_exe", _edi_exe_test_notify_cb, codes));
+
+   // The shell and its sleep are both in the group that is terminated.
+   ck_assert(edi_exe_notify_handle("edi_test_exe", _edi_exe_test_notify_cb, codes));
+   ck_assert(edi_exe_notify_handle("edi_test_exe", _edi_exe_test_notify_cb, codes));
+   edi_exe_notify("edi_test_exe", "sleep 10; exit 0");
+   edi_exe_notify("edi_test_exe", "sleep 10 & wait");
+   ck_assert(!edi_exe_notify_terminate("edi_test_none"));
+   ecore_timer_add(0.2, _edi_exe_test_terminate_cb, NULL);
+   ecore_main_loop_begin();
+   ck_assert_str_eq("143|143|", eina_strbuf_string_get(codes));
+   eina_strbuf_free(codes);
+
+   edi_shutdown();
+}
+END_TEST
+
 void edi_test_exe(TCase *tc)
 {
    tcase_add_test(tc, edi_exe_test_wait);
+   tcase_add_test(tc, edi_exe_test_wait_in);
+   tcase_add_test(tc, edi_exe_test_wait_thread);
+   tcase_add_test(tc, edi_exe_test_lines_in);
+   tcase_add_test(tc, edi_exe_test_progress_in);
+   tcase_add_test(tc, edi_exe_test_run);
+   tcase_add_test(tc, edi_exe_test_notify);
+   tcase_add_test(tc, edi_exe_test_notify_cancel);
 }
 
@@ -0,0 +1,228 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+#include <Ecore_Con.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+#define EDI_SCM_TEST_GIT "git -c user.name=Edi -c user.email=edi@example.com "
+
+typedef struct
+{
+   int status;
+   Eina_Bool cancelled;
+   unsigned int lines;
+} Edi_Scm_Test_Result;
+
+static void
+_edi_scm_test_line_cb(void *data, const char *line EINA_UNUSED)
+{
+   Edi_Scm_Test_Result *result = data;
+
+   result->lines++;
+}
+
+static void
+_edi_scm_test_end_cb(void *data, int status, Eina_Bool cancelled)
+{
+   Edi_Scm_Test_Result *result = data;
+
+   result->status = status;
+   result->cancelled = cancelled;
+   ecore_main_loop_quit();
+}
+
+static int
+_edi_scm_test_job_wait(Edi_Scm_Job *job, Edi_Scm_Test_Result *result)
+{
+   ck_assert(job != NULL);
+   ecore_main_loop_begin();
+   ck_assert(!result->cancelled);
+
+   return result->status;
+}
+
+START_TEST (edi_scm_test_jobs)
+{
+   Edi_Scm_Test_Result result = { -1, EINA_FALSE, 0 };
+   Eina_Tmpstr *dir;
+   char remote[PATH_MAX], seed[PATH_MAX], work[PATH_MAX], path[PATH_MAX];
+
+   edi_init();
+
+   // A bare repository on disk stands in for the server.
+   ck_assert(eina_file_mkdtemp("edi_scm_XXXXXX", &dir));
+   snprintf(remote, sizeof(remote), "%s/remote.git", dir);
+   snprintf(seed, sizeof(seed), "%s/seed", dir);
+   snprintf(work, sizeof(work), "%s/work", dir);
+
+   ck_assert_int_eq(0, edi_exe_wait_in(dir, "git init -q --bare remote.git && "
+                                       "git --git-dir=remote.git symbolic-ref HEAD refs/heads/main"));
+   ck_assert_int_eq(0, edi_exe_wait_in(dir, "git init -q seed && cd seed && echo one > one && git add one && "
+                                       EDI_SCM_TEST_GIT "commit -q -m one && "
+                                       "git push -q ../remote.git HEAD:refs/heads/main"));
+
+   ck_assert_int_eq(0, _edi_scm_test_job_wait(edi_scm_git_clone_job(remote, work, _edi_scm_test_line_cb,
+                                                                     NULL, _edi_scm_test_end_cb, &result),
+                                              &result));
+   snprintf(path, sizeof(path), "%s/one", work);
+   ck_assert(ecore_file_exists(path));
+   ck_assert(result.lines > 0);
+
+   ck_assert(edi_scm_init_path(work) != NULL);
+
+   // Pull a commit pushed from elsewhere.
+   ck_assert_int_eq(0, edi_exe_wait_in(seed, "echo two > two && git add two && "
+                                       EDI_SCM_TEST_GIT "commit -q -m two && "
+                                       "git push -q ../remote.git HEAD:refs/heads/main"));
+   ck_assert_int_eq(0, _edi_scm_test_job_wait(edi_scm_pull_job(_edi_scm_test_line_cb, NULL,
+                                                               _edi_scm_test_end_cb, &result),
+                                              &result));
+   snprintf(path, sizeof(path), "%s/two", work);
+   ck_assert(ecore_file_exists(path));
+
+   // Push a commit back and find it in the bare repository.
+   ck_assert_int_eq(0, edi_exe_wait_in(work, "echo three > three && git add three && "
+                                       EDI_SCM_TEST_GIT "commit -q -m three"));
+   ck_assert_int_eq(0, _edi_scm_test_job_wait(edi_scm_push_job(_edi_scm_test_line_cb, NULL,
+                                                               _edi_scm_test_end_cb, &result),
+                                              &result));
+   ck_assert_int_eq(0, edi_exe_wait_in(remote, "test \"$(git log --format=%s -1 main)\" = three"));
+
+   // Cloning something that does not exist fails.
+   snprintf(path, sizeof(path), "%s/missing.git", dir);
+   snprintf(work, sizeof(work), "%s/missing", dir);
+   ck_assert(0 != _edi_scm_test_job_wait(edi_scm_git_clone_job(path, work, NULL, NULL,
+                                                                _edi_scm_test_end_cb, &result),
+                                         &result));
+
+   edi_scm_shutdown();
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+#define EDI_SCM_TEST_AVATAR "not really a jpeg"
+
+typedef struct
+{
+   Ecore_Con_Server *server;
+   Eina_Strbuf *request;
+   Eina_Bool success;
+   Eina_Bool done;
+} Edi_Scm_Test_Http;
+
+// Answer a single request per connection, the avatar for "/avatar" and a 404 otherwise.
+static Eina_Bool
+_edi_scm_test_http_data_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   Edi_Scm_Test_Http *http = data;
+   Ecore_Con_Event_Client_Data *ev = event;
+   const char *request;
+   char reply[256];
+
+   if (ecore_con_client_server_get(ev->client) != http->server)
+     return ECORE_CALLBACK_PASS_ON;
+
+   eina_strbuf_append_length(http->request, ev->data, ev->size);
+   request = eina_strbuf_string_get(http->request);
+   if (!strstr(request, "\r\n\r\n"))
+     return ECORE_CALLBACK_DONE;
+
+   if (!strncmp(request, "GET /avatar ", 12))
+     snprintf(reply, sizeof(reply), "HTTP/1.0 200 OK\r\nContent-Type: image/jpeg\r\n"
+              "Content-Length: %d\r\nConnection: close\r\n\r\n%s",
+              (int) strlen(EDI_SCM_TEST_AVATAR), EDI_SCM_TEST_AVATAR);
+   else
+     snprintf(reply, sizeof(reply), "HTTP/1.0 404 Not Found\r\nContent-Length: 9\r\n"
+              "Connection: close\r\n\r\nnot found");
+
+   ecore_con_client_send(ev->client, reply, strlen(reply));
+   ecore_con_client_flush(ev->client);
+   eina_strbuf_reset(http->request);
+
+   return ECORE_CALLBACK_DONE;
+}
+
+static void
+_edi_scm_test_avatar_cb(void *data, const char *path EINA_UNUSED, Eina_Bool success)
+{
+   Edi_Scm_Test_Http *http = data;
+
+   http->success = success;
+   http->done = EINA_TRUE;
+   ecore_main_loop_quit();
+}
+
+START_TEST (edi_scm_test_avatar_download)
+{
+   Edi_Scm_Test_Http http = { NULL, NULL, EINA_FALSE, EINA_FALSE };
+   Ecore_Event_Handler *handler;
+   Eina_Tmpstr *dir;
+   char url[PATH_MAX], path[PATH_MAX], *content;
+   int port;
+
+   edi_init();
+   ecore_con_init();
+   ecore_file_init();
+
+   // A local server stands in for gravatar, bypassing any proxy of the environment.
+   setenv("no_proxy", "127.0.0.1", 1);
+   port = 20000 + getpid() % 20000;
+   http.server = ecore_con_server_add(ECORE_CON_REMOTE_TCP, "127.0.0.1", port, NULL);
+   ck_assert(http.server != NULL);
+   http.request = eina_strbuf_new();
+   handler = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA, _edi_scm_test_http_data_cb, &http);
+
+   ck_assert(eina_file_mkdtemp("edi_scm_avatar_XXXXXX", &dir));
+
+   // The directory of the cache is created on the way.
+   snprintf(url, sizeof(url), "http://127.0.0.1:%d/avatar", port);
+   snprintf(path, sizeof(path), "%s/avatars/edi@example.com.jpeg", dir);
+   ck_assert(edi_scm_avatar_download(url, path, _edi_scm_test_avatar_cb, &http));
+   ecore_main_loop_begin();
+   ck_assert(http.done);
+   ck_assert(http.success);
+   content = edi_exe_response_in(dir, "cat avatars/edi@example.com.jpeg");
+   ck_assert_str_eq(EDI_SCM_TEST_AVATAR, content);
+   free(content);
+
+   // A user without an avatar leaves nothing in the cache.
+   http.done = EINA_FALSE;
+   snprintf(url, sizeof(url), "http://127.0.0.1:%d/missing", port);
+   snprintf(path, sizeof(path), "%s/avatars/nobody@example.com.jpeg", dir);
+   ck_assert(edi_scm_avatar_download(url, path, _edi_scm_test_avatar_cb, &http));
+   ecore_main_loop_begin();
+   ck_assert(http.done);
+   ck_assert(!http.success);
+   ck_assert(!ecore_file_exists(path));
+
+   ck_assert(!edi_scm_avatar_download(NULL, path, _edi_scm_test_avatar_cb, &http));
+
+   ecore_event_handler_del(handler);
+   ecore_con_server_del(http.server);
+   eina_strbuf_free(http.request);
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+
+   ecore_file_shutdown();
+   ecore_con_shutdown();
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_scm(TCase *tc)
+{
+   tcase_add_test(tc, edi_scm_test_jobs);
+   tcase_add_test(tc, edi_scm_test_avatar_download);
+}
@@ -0,0 +1,142 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdarg.h>
+
+#include "edi_suite.h"
+
+static Eina_Hash *
+_edi_test_affected_test_hash(const char *path, ...)
+{
+   Eina_Hash *hash;
+   va_list args;
+
+   hash = eina_hash_string_superfast_new(NULL);
+   va_start(args, path);
+   for (; path; path = va_arg(args, const char *))
+     eina_hash_add(hash, path, path);
+   va_end(args);
+
+   return hash;
+}
+
+static void
+_edi_test_affected_test_list_free(Eina_List *list)
+{
+   const char *name;
+
+   EINA_LIST_FREE(list, name)
+     eina_stringshare_del(name);
+}
+
+START_TEST (edi_test_affected_test_deps)
+{
+   Eina_Hash *changed;
+   Eina_List *outputs;
+   const char *deps =
+      "src/lib/libedi.so.p/edi_exe.c.o: #deps 3, deps mtime 1700000000 (VALID)\n"
+      "    ../src/lib/edi_exe.c\n"
+      "    ../src/lib/edi_private.h\n"
+      "    /usr/include/stdio.h\n"
+      "\n"
+      "src/lib/libedi.so.p/edi_path.c.o: #deps 2, deps mtime 1700000000 (VALID)\n"
+      "    ../src/lib/./edi_path.c\n"
+      "    ../src/lib/edi_path.h\n"
+      "\n"
+      "src/bin/edi.p/edi_main.c.o: #deps 2, deps mtime 1700000000 (STALE)\n"
+      "    ../src/bin/../lib/edi_private.h\n"
+      "    ../src/bin/edi_main.c\n"
+      "\n";
+
+   eina_init();
+
+   changed = _edi_test_affected_test_hash("/project/src/lib/edi_private.h", NULL);
+   outputs = edi_test_affected_deps_find("/project/build", deps, changed);
+   ck_assert_int_eq(2, eina_list_count(outputs));
+   ck_assert_str_eq("src/lib/libedi.so.p/edi_exe.c.o", eina_list_nth(outputs, 0));
+   ck_assert_str_eq("src/bin/edi.p/edi_main.c.o", eina_list_nth(outputs, 1));
+   _edi_test_affected_test_list_free(outputs);
+   eina_hash_free(changed);
+
+   changed = _edi_test_affected_test_hash("/project/src/lib/edi_path.c", NULL);
+   outputs = edi_test_affected_deps_find("/project/build", deps, changed);
+   ck_assert_int_eq(1, eina_list_count(outputs));
+   ck_assert_str_eq("src/lib/libedi.so.p/edi_path.c.o", eina_list_nth(outputs, 0));
+   _edi_test_affected_test_list_free(outputs);
+   eina_hash_free(changed);
+
+   changed = _edi_test_affected_test_hash("/project/README.md", NULL);
+   ck_assert(!edi_test_affected_deps_find("/project/build", deps, changed));
+   eina_hash_free(changed);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST (edi_test_affected_test_query)
+{
+   Eina_List *outputs;
+   const char *query =
+      "src/lib/libedi.so.p/edi_exe.c.o:\n"
+      "  input: c_COMPILER\n"
+      "    ../src/lib/edi_exe.c\n"
+      "    | src/lib/edi_config.h\n"
+      "  outputs:\n"
+      "    src/lib/libedi.so\n"
+      "src/lib/libedi.so:\n"
+      "  input: c_LINKER\n"
+      "    src/lib/libedi.so.p/edi_exe.c.o\n"
+      "  outputs:\n"
+      "    src/tests/edi_suite\n"
+      "    all\n";
+
+   eina_init();
+
+   outputs = edi_test_affected_query_outputs_get(query);
+   ck_assert_int_eq(3, eina_list_count(outputs));
+   ck_assert_str_eq("src/lib/libedi.so", eina_list_nth(outputs, 0));
+   ck_assert_str_eq("src/tests/edi_suite", eina_list_nth(outputs, 1));
+   ck_assert_str_eq("all", eina_list_nth(outputs, 2));
+   _edi_test_affected_test_list_free(outputs);
+
+   ck_assert(!edi_test_affected_query_outputs_get("all:\n  input: phony\n    src/bin/edi\n  outputs:\n"));
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST (edi_test_affected_test_tests)
+{
+   Eina_Hash *used;
+   Eina_List *tests;
+   const char *introspect =
+      "[{\"name\": \"suite\", \"suite\": [\"edi\"], \"cmd\": [\"/project/build/src/tests/edi_suite\"],"
+      " \"env\": {}, \"timeout\": 30, \"workdir\": null},"
+      " {\"name\": \"script\", \"cmd\": [\"/usr/bin/python3\", \"/project/build/../scripts/check.py\", \"-v\"]},"
+      " {\"name\": \"other\", \"cmd\": [\"/project/build/src/tests/other\"]}]";
+
+   eina_init();
+
+   used = _edi_test_affected_test_hash("/project/build/src/tests/edi_suite", "/project/scripts/check.py", NULL);
+   tests = edi_test_affected_tests_find(introspect, used);
+   ck_assert_int_eq(2, eina_list_count(tests));
+   ck_assert_str_eq("suite", eina_list_nth(tests, 0));
+   ck_assert_str_eq("script", eina_list_nth(tests, 1));
+   _edi_test_affected_test_list_free(tests);
+   eina_hash_free(used);
+
+   used = _edi_test_affected_test_hash("/project/README.md", NULL);
+   ck_assert(!edi_test_affected_tests_find(introspect, used));
+   eina_hash_free(used);
+
+   eina_shutdown();
+}
+END_TEST
+
+void edi_test_test_affected(TCase *tc)
+{
+   tcase_add_test(tc, edi_test_affected_test_deps);
+   tcase_add_test(tc, edi_test_affected_test_query);
+   tcase_add_test(tc, edi_test_affected_test_tests);
+}
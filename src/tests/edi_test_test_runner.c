@@ -0,0 +1,127 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static Edi_Test_Case *
+_edi_test_runner_test_parse(const char *provider, const char *line)
+{
+   return edi_test_runner_result_line_parse(provider, line, strlen(line));
+}
+
+START_TEST (edi_test_runner_test_list)
+{
+   const char *name;
+
+   eina_init();
+
+   name = edi_test_runner_list_line_parse("go", "TestParse", 9);
+   ck_assert_str_eq("TestParse", name);
+   eina_stringshare_del(name);
+   name = edi_test_runner_list_line_parse("go", "ExampleJoin\r", 12);
+   ck_assert_str_eq("ExampleJoin", name);
+   eina_stringshare_del(name);
+   ck_assert(!edi_test_runner_list_line_parse("go", "BenchmarkParse", 14));
+   ck_assert(!edi_test_runner_list_line_parse("go", "ok  \tpkg\t0.003s", 15));
+
+   name = edi_test_runner_list_line_parse("cargo", "tests::parse: test", 18);
+   ck_assert_str_eq("tests::parse", name);
+   eina_stringshare_del(name);
+   ck_assert(!edi_test_runner_list_line_parse("cargo", "tests::fast: bench", 18));
+   ck_assert(!edi_test_runner_list_line_parse("cargo", "2 tests, 0 benchmarks", 21));
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST (edi_test_runner_test_results)
+{
+   Edi_Test_Case *test;
+
+   eina_init();
+
+   test = _edi_test_runner_test_parse("go", "{\"Time\":\"2024-01-01T00:00:00Z\",\"Action\":\"fail\",\"Package\":\"example.com/p\",\"Test\":\"TestParse\",\"Elapsed\":0.25}");
+   ck_assert(test != NULL);
+   ck_assert_str_eq("TestParse", test->name);
+   ck_assert_int_eq(EDI_TEST_RESULT_FAIL, test->result);
+   ck_assert(test->duration > 0.249 && test->duration < 0.251);
+   edi_test_runner_case_free(test);
+
+   ck_assert(!_edi_test_runner_test_parse("go", "{\"Action\":\"pass\",\"Package\":\"example.com/p\",\"Elapsed\":0.3}"));
+   ck_assert(!_edi_test_runner_test_parse("go", "{\"Action\":\"pass\",\"Test\":\"TestParse/sub\",\"Elapsed\":0.1}"));
+   ck_assert(!_edi_test_runner_test_parse("go", "{\"Action\":\"output\",\"Test\":\"TestParse\",\"Output\":\"--- PASS\\n\"}"));
+
+   test = _edi_test_runner_test_parse("cargo", "test tests::parse ... ok");
+   ck_assert(test != NULL);
+   ck_assert_str_eq("tests::parse", test->name);
+   ck_assert_int_eq(EDI_TEST_RESULT_PASS, test->result);
+   ck_assert(test->duration < 0);
+   edi_test_runner_case_free(test);
+
+   test = _edi_test_runner_test_parse("cargo", "test src/lib.rs - join (line 3) ... ignored");
+   ck_assert(test != NULL);
+   ck_assert_str_eq("src/lib.rs - join (line 3)", test->name);
+   ck_assert_int_eq(EDI_TEST_RESULT_SKIP, test->result);
+   edi_test_runner_case_free(test);
+   ck_assert(!_edi_test_runner_test_parse("cargo", "test result: ok. 1 passed; 0 failed"));
+
+   test = _edi_test_runner_test_parse("meson", "{\"name\": \"unit / parse\", \"stdout\": \"a, \\\"b\\\"\", \"result\": \"TIMEOUT\", \"duration\": 1.5}");
+   ck_assert(test != NULL);
+   ck_assert_str_eq("parse", test->name);
+   ck_assert_int_eq(EDI_TEST_RESULT_FAIL, test->result);
+   ck_assert(test->duration > 1.49 && test->duration < 1.51);
+   edi_test_runner_case_free(test);
+
+   eina_shutdown();
+}
+END_TEST
+
+START_TEST (edi_test_runner_test_junit)
+{
+   Edi_Test_Case *test;
+   Eina_List *results = NULL;
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX], content[1024];
+   size_t length;
+   FILE *file;
+
+   edi_init();
+
+   results = eina_list_append(results, _edi_test_runner_test_parse("cargo", "test a<b ... ok"));
+   results = eina_list_append(results, _edi_test_runner_test_parse("cargo", "test c ... FAILED"));
+
+   ck_assert(eina_file_mkdtemp("edi_test_runner_XXXXXX", &dir));
+   snprintf(path, sizeof(path), "%s/results.xml", dir);
+   ck_assert(edi_test_runner_junit_write(results, path));
+
+   file = fopen(path, "r");
+   ck_assert(file != NULL);
+   length = fread(content, 1, sizeof(content) - 1, file);
+   content[length] = '\0';
+   fclose(file);
+
+   ck_assert(strstr(content, "<testsuites tests=\"2\" failures=\"1\" skipped=\"0\""));
+   ck_assert(strstr(content, "<testcase name=\"a&lt;b\""));
+   ck_assert(strstr(content, "<testcase name=\"c\" time=\"0.000\">\n      <failure/>"));
+
+   EINA_LIST_FREE(results, test)
+     edi_test_runner_case_free(test);
+   unlink(path);
+   rmdir(dir);
+   eina_tmpstr_del(dir);
+
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_test_runner(TCase *tc)
+{
+   tcase_add_test(tc, edi_test_runner_test_list);
+   tcase_add_test(tc, edi_test_runner_test_results);
+   tcase_add_test(tc, edi_test_runner_test_junit);
+}